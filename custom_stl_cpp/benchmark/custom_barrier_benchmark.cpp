@@ -0,0 +1,74 @@
+#include <barrier>
+#include <chrono>
+#include <cstdio>
+#include <pthread.h>
+
+#include "custom/vector.h"
+#include "custom/barrier.h"     // unit to be measured
+
+
+// Phase-stepped simulation: N threads do a sliver of work and meet at a barrier every step,
+// a completion function advances the global clock once per step.
+// Baselines are pthread_barrier_t (the previous custom::barrier) and std::barrier.
+// Usage: Custom_STL_CPP_BARRIER_Benchmark
+
+
+struct _Pthread_Barrier
+{
+    pthread_barrier_t _Barrier;
+
+    explicit _Pthread_Barrier(int expected) { pthread_barrier_init(&_Barrier, nullptr, expected); }
+    ~_Pthread_Barrier()                     { pthread_barrier_destroy(&_Barrier); }
+
+    void arrive_and_wait() { pthread_barrier_wait(&_Barrier); }
+};
+
+
+template<class Barrier, class... Completion>
+static double _ms_for_steps(const int threads, const int steps, Completion... completion)
+{
+    using clock = std::chrono::steady_clock;
+
+    Barrier sync(threads, completion...);
+    custom::vector<custom::thread> workers;
+    custom::vector<long> state(static_cast<size_t>(threads) * 16);    // one cache line per thread
+
+    auto start = clock::now();
+    for (int t = 0; t < threads; ++t)
+        workers.emplace_back([&sync, &state, t, steps]()
+        {
+            for (int step = 0; step < steps; ++step)
+            {
+                state[t * 16] += step;
+                sync.arrive_and_wait();
+            }
+        });
+
+    for (auto& worker : workers)
+        worker.join();
+    auto stop = clock::now();
+
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+
+int main()
+{
+    long clockTicks = 0;
+    auto tick       = [&clockTicks]() noexcept { ++clockTicks; };
+
+    std::printf("ms (lower is better)        %10s %10s %10s\n", "pthread", "std", "custom");
+    for (int threads : {4, 16, 64})
+    {
+        const int steps = 64000 / threads;
+
+        std::printf("  %2d threads x %5d steps %10.1f %10.1f %10.1f\n", threads, steps,
+                    _ms_for_steps<_Pthread_Barrier>(threads, steps),
+                    _ms_for_steps<std::barrier<decltype(tick)>>(threads, steps, tick),
+                    _ms_for_steps<custom::barrier<decltype(tick)>>(threads, steps, tick));
+    }
+
+    std::printf("%s", clockTicks == 42 ? " " : "");    // keep the result alive
+
+    return 0;
+}
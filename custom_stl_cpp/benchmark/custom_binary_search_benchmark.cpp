@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+
+#include "custom/algorithm.h"
+#include "custom/sorted_index.h"    // units to be measured
+
+
+// Random lookups in sorted tables: std::lower_bound, branchless custom::lower_bound and sorted_index.
+// Small tables fit in cache and show branch misprediction costs, large ones show memory latency.
+// Usage: Custom_STL_CPP_BINARY_SEARCH_Benchmark
+
+
+static std::vector<uint32_t> _make_values(const size_t count, uint64_t seed)
+{
+    std::vector<uint32_t> values(count);
+    for (auto& value : values)
+    {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        value = static_cast<uint32_t>(seed >> 32);
+    }
+
+    return values;
+}
+
+
+template<class Search>
+static double _ns_per_lookup(const std::vector<uint32_t>& keys, Search search)
+{
+    using clock = std::chrono::steady_clock;
+
+    uint64_t sink = 0;
+
+    auto start = clock::now();
+    for (uint32_t key : keys)
+        sink += search(key);
+    auto stop = clock::now();
+
+    std::printf("%s", sink == 42 ? " " : "");       // keep the result alive
+
+    return std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(keys.size());
+}
+
+
+int main()
+{
+    constexpr size_t lookups = 1u << 21;
+
+    std::printf("ns per lookup (lower is better)\n");
+    std::printf("  %-10s %10s %12s %14s\n", "entries", "std", "branchless", "sorted_index");
+
+    for (size_t count : {size_t(1) << 10, size_t(1) << 16, size_t(1) << 22})
+    {
+        std::vector<uint32_t> table = _make_values(count, 1);
+        std::sort(table.begin(), table.end());
+
+        custom::sorted_index<uint32_t> index(table.data(), table.data() + table.size());
+        std::vector<uint32_t> keys = _make_values(lookups, 2);
+
+        const uint32_t* first   = table.data();
+        const uint32_t* last    = table.data() + table.size();
+
+        double stdTime      = _ns_per_lookup(keys, [&](uint32_t key) { return *std::lower_bound(first, last - 1, key); });
+        double customTime   = _ns_per_lookup(keys, [&](uint32_t key) { return *custom::lower_bound(first, last - 1, key); });
+        double indexTime    = _ns_per_lookup(keys, [&](uint32_t key) { auto it = index.lower_bound(key); return it == index.end() ? 0u : *it; });
+
+        std::printf("  %-10zu %10.2f %12.2f %14.2f\n", count, stdTime, customTime, indexTime);
+    }
+
+    return 0;
+}
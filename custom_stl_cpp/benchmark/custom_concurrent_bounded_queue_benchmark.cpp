@@ -0,0 +1,100 @@
+#include <chrono>
+#include <cstdio>
+
+#include "custom/vector.h"
+#include "custom/queue.h"
+#include "custom/mutex.h"
+#include "custom/condition_variable.h"
+#include "custom/concurrent_bounded_queue.h"    // unit to be measured
+
+
+// Network-to-worker hand-off: producers push small messages into a bounded queue,
+// consumers pop and process them. Baseline is custom::queue guarded by a mutex, with two
+// condition variables for the full and empty cases.
+// Usage: Custom_STL_CPP_CONCURRENT_BOUNDED_QUEUE_Benchmark
+
+
+class _Locked_Queue
+{
+private:
+    custom::queue<long> _queue;
+    custom::mutex _mutex;
+    custom::condition_variable _notEmpty;
+    custom::condition_variable _notFull;
+    size_t _capacity;
+
+public:
+    explicit _Locked_Queue(size_t capacity)
+        : _capacity(capacity) { /*Empty*/ }
+
+    void push(long value)
+    {
+        custom::unique_lock<custom::mutex> lock(_mutex);
+        _notFull.wait(lock, [this]() { return _queue.size() < _capacity; });
+        _queue.push(value);
+        lock.unlock();
+        _notEmpty.notify_one();
+    }
+
+    void pop(long& value)
+    {
+        custom::unique_lock<custom::mutex> lock(_mutex);
+        _notEmpty.wait(lock, [this]() { return !_queue.empty(); });
+        value = _queue.front();
+        _queue.pop();
+        lock.unlock();
+        _notFull.notify_one();
+    }
+};
+
+
+template<class Queue>
+static double _mops_for(const int producers, const int consumers, const long messages)
+{
+    using clock = std::chrono::steady_clock;
+
+    Queue queue(1024);
+    custom::vector<custom::thread> threads;
+    custom::vector<long> sums(static_cast<size_t>(consumers) * 16);   // one cache line per consumer
+
+    auto start = clock::now();
+    for (int p = 0; p < producers; ++p)
+        threads.emplace_back([&queue, producers, messages]()
+        {
+            for (long i = 0; i < messages / producers; ++i)
+                queue.push(i);
+        });
+
+    for (int c = 0; c < consumers; ++c)
+        threads.emplace_back([&queue, &sums, c, consumers, messages]()
+        {
+            long value;
+            for (long i = 0; i < messages / consumers; ++i)
+            {
+                queue.pop(value);
+                sums[c * 16] += value;
+            }
+        });
+
+    for (auto& thread : threads)
+        thread.join();
+    auto stop = clock::now();
+
+    std::printf("%s", sums[0] == 42 ? " " : "");    // keep the result alive
+
+    return messages / std::chrono::duration<double, std::micro>(stop - start).count();
+}
+
+
+int main()
+{
+    constexpr long messages = 4000000;     // divisible by every thread count below
+
+    std::printf("million messages/s (higher is better)  %10s %10s\n", "mutex", "lock-free");
+    for (int threads : {1, 2, 4})
+        std::printf("  %d producers, %d consumers             %10.2f %10.2f\n", threads, threads,
+                    _mops_for<_Locked_Queue>(threads, threads, messages),
+                    _mops_for<custom::concurrent_bounded_queue<long>>(threads, threads, messages));
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+
+#include "custom/vector.h"
+#include "custom/thread.h"
+#include "custom/future.h"      // unit to be measured
+
+
+// Fan-out/fan-in aggregation: a request sends 32 calls and sums the replies.
+// One waiting thread per pending call (each blocks on its future and forwards the reply)
+// vs when_all(...).then(...), which blocks no thread while the replies are pending.
+// The replies are produced by the main thread in both cases.
+// Usage: Custom_STL_CPP_FUTURE_Benchmark
+
+
+static constexpr size_t _CALLS = 32;
+
+
+static double _ms_for_waiting_threads(const size_t requests)
+{
+    using clock = std::chrono::steady_clock;
+
+    uint64_t sink = 0;
+
+    auto start = clock::now();
+    for (size_t request = 0; request < requests; ++request)
+    {
+        custom::vector<custom::promise<int>> calls(_CALLS);
+        custom::vector<custom::promise<int>> forwarded(_CALLS);
+        custom::vector<custom::future<int>> sums;
+        custom::vector<custom::thread> waiters;
+
+        for (size_t call = 0; call < _CALLS; ++call)
+        {
+            sums.push_back(forwarded[call].get_future());
+            waiters.emplace_back([reply = calls[call].get_future(), &out = forwarded[call]]() mutable
+            {
+                out.set_value(reply.get());
+            });
+        }
+
+        for (size_t call = 0; call < _CALLS; ++call)
+            calls[call].set_value(static_cast<int>(call));
+
+        for (auto& sum : sums)
+            sink += sum.get();
+
+        for (auto& waiter : waiters)
+            waiter.join();
+    }
+    auto stop = clock::now();
+
+    std::printf("%s", sink == 42 ? " " : "");       // keep the result alive
+
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+
+static double _ms_for_when_all(const size_t requests)
+{
+    using clock = std::chrono::steady_clock;
+
+    uint64_t sink = 0;
+
+    auto start = clock::now();
+    for (size_t request = 0; request < requests; ++request)
+    {
+        custom::vector<custom::promise<int>> calls(_CALLS);
+        custom::vector<custom::future<int>> replies;
+        for (auto& call : calls)
+            replies.push_back(call.get_future());
+
+        auto total = custom::when_all(replies.begin(), replies.end()).then(
+            [](custom::future<custom::vector<custom::future<int>>> ready)
+            {
+                uint64_t sum = 0;
+                for (auto& reply : ready.get())
+                    sum += reply.get();
+
+                return sum;
+            });
+
+        for (size_t call = 0; call < _CALLS; ++call)
+            calls[call].set_value(static_cast<int>(call));
+
+        sink += total.get();
+    }
+    auto stop = clock::now();
+
+    std::printf("%s", sink == 42 ? " " : "");       // keep the result alive
+
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+
+int main()
+{
+    constexpr size_t requests = 2000;
+
+    std::printf("ms for %zu requests of %zu calls (lower is better)\n", requests, _CALLS);
+    std::printf("  thread per pending call  %10.1f\n", _ms_for_waiting_threads(requests));
+    std::printf("  when_all + then          %10.1f\n", _ms_for_when_all(requests));
+
+    return 0;
+}
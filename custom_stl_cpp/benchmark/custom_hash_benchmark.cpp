@@ -0,0 +1,131 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+
+#include "custom/functional.h"  // unit to be measured
+
+
+// Quality and throughput of the byte-range hashes behind custom::hash.
+// Both FNV-1a and the wyhash-style hash are measured regardless of CUSTOM_HASH_FNV1A.
+// Usage: Custom_STL_CPP_HASH_Benchmark
+
+
+using _Byte_Hash = uint64_t (*)(const unsigned char*, size_t);
+
+static uint64_t _fnv1a(const unsigned char* first, size_t count)
+{
+    return custom::detail::_fnv1a_append_bytes(custom::detail::_FNVOffsetBasis, first, count);
+}
+
+static uint64_t _wyhash(const unsigned char* first, size_t count)
+{
+    return custom::detail::_wyhash_bytes(first, count, 0);
+}
+
+
+// Flip every input bit and record how often each output bit changes.
+// An ideal hash changes each output bit with probability 0.5, the reported value is the worst deviation.
+static double _avalanche_bias(_Byte_Hash hashFunc, const size_t keyLength)
+{
+    constexpr size_t trials     = 2000;
+    constexpr int outputBits    = 64;
+
+    std::vector<unsigned char> key(keyLength);
+    std::vector<size_t> flips(keyLength * 8 * outputBits, 0);
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+    for (size_t t = 0; t < trials; ++t)
+    {
+        for (auto& byte : key)
+        {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            byte  = static_cast<unsigned char>(state >> 56);
+        }
+
+        const uint64_t original = hashFunc(key.data(), keyLength);
+
+        for (size_t bit = 0; bit < keyLength * 8; ++bit)
+        {
+            key[bit / 8] ^= static_cast<unsigned char>(1u << (bit % 8));
+            uint64_t diff = original ^ hashFunc(key.data(), keyLength);
+            key[bit / 8] ^= static_cast<unsigned char>(1u << (bit % 8));
+
+            for (int out = 0; out < outputBits; ++out)
+                flips[bit * outputBits + out] += (diff >> out) & 1;
+        }
+    }
+
+    double worst = 0.0;
+    for (size_t count : flips)
+    {
+        double bias = static_cast<double>(count) / trials - 0.5;
+        worst = (bias < 0 ? -bias : bias) > worst ? (bias < 0 ? -bias : bias) : worst;
+    }
+
+    return worst;
+}
+
+
+// Hash sequential integers into a power-of-2 bucket array (low bits) and report the fullest bucket
+static size_t _max_bucket_load(_Byte_Hash hashFunc, const size_t keys, const size_t buckets)
+{
+    std::vector<size_t> load(buckets, 0);
+
+    for (uint64_t i = 0; i < keys; ++i)
+        ++load[hashFunc(reinterpret_cast<const unsigned char*>(&i), sizeof(i)) & (buckets - 1)];
+
+    size_t worst = 0;
+    for (size_t count : load)
+        worst = count > worst ? count : worst;
+
+    return worst;
+}
+
+
+static double _throughput_gbps(_Byte_Hash hashFunc, const size_t keyLength)
+{
+    using clock = std::chrono::steady_clock;
+
+    const size_t totalBytes = 256u << 20;
+    const size_t iterations = totalBytes / keyLength;
+    std::vector<unsigned char> key(keyLength, 0x5A);
+    uint64_t sink = 0;
+
+    auto start = clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        key[0] = static_cast<unsigned char>(sink);  // data dependency between iterations
+        sink += hashFunc(key.data(), keyLength);
+    }
+    auto stop = clock::now();
+
+    double seconds = std::chrono::duration<double>(stop - start).count();
+    std::printf("%s", sink == 42 ? " " : "");       // keep the result alive
+
+    return static_cast<double>(iterations * keyLength) / seconds / 1e9;
+}
+
+
+int main()
+{
+    struct { const char* name; _Byte_Hash func; } hashes[] = { {"fnv1a", _fnv1a}, {"wyhash", _wyhash} };
+
+    std::printf("avalanche worst bias (0 is ideal)\n");
+    for (const auto& h : hashes)
+        std::printf("  %-8s 4B=%.3f 8B=%.3f 16B=%.3f 64B=%.3f\n", h.name,
+                    _avalanche_bias(h.func, 4), _avalanche_bias(h.func, 8),
+                    _avalanche_bias(h.func, 16), _avalanche_bias(h.func, 64));
+
+    std::printf("max bucket load, 1M sequential integers in 1M buckets (low bits)\n");
+    for (const auto& h : hashes)
+        std::printf("  %-8s %zu\n", h.name, _max_bucket_load(h.func, 1u << 20, 1u << 20));
+
+    std::printf("throughput (GB/s)\n");
+    for (const auto& h : hashes)
+        std::printf("  %-8s 8B=%.2f 32B=%.2f 256B=%.2f 4KB=%.2f\n", h.name,
+                    _throughput_gbps(h.func, 8), _throughput_gbps(h.func, 32),
+                    _throughput_gbps(h.func, 256), _throughput_gbps(h.func, 4096));
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+
+#include "custom/unordered_map.h"   // unit to be measured
+
+
+// Insert latency distribution of unordered_map with and without incremental rehash.
+// A full rehash shows up as a spike in the high percentiles and in the max.
+// Usage: Custom_STL_CPP_HASH_TABLE_Benchmark [element_count]
+
+
+static void _report(const char* name, std::vector<long long>& latencies)
+{
+    std::sort(latencies.begin(), latencies.end());
+
+    auto percentile = [&latencies](double p) {
+        return latencies[static_cast<size_t>(p * static_cast<double>(latencies.size() - 1))];
+    };
+
+    std::printf("%-24s p50=%6lldns p99=%6lldns p999=%8lldns max=%10lldns\n",
+                name, percentile(0.5), percentile(0.99), percentile(0.999), latencies.back());
+}
+
+
+static void _measure_insert(const char* name, const size_t count, const bool incremental)
+{
+    using clock = std::chrono::steady_clock;
+
+    custom::unordered_map<size_t, size_t> umap;
+    umap.incremental_rehash(incremental);
+
+    std::vector<long long> latencies;
+    latencies.reserve(count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto start = clock::now();
+        umap.try_emplace(i * 2654435761u, i);
+        auto stop = clock::now();
+
+        latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+    }
+
+    _report(name, latencies);
+}
+
+
+int main(int argc, char** argv)
+{
+    const size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+
+    std::printf("insert latency, %zu elements\n", count);
+    _measure_insert("full rehash", count, false);
+    _measure_insert("incremental rehash", count, true);
+
+    return 0;
+}
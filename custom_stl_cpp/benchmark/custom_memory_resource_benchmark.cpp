@@ -0,0 +1,81 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+
+#include "custom/memory_resource.h"     // unit to be measured
+
+
+// A "request handler" that fills a map, a hash map, a list and a vector and then drops them,
+// run with the default (new/delete) resource, a reused monotonic arena and a pool resource.
+// Usage: Custom_STL_CPP_MEMORY_RESOURCE_Benchmark
+
+
+static uint64_t _handle_request(custom::pmr::memory_resource* resource, const int request)
+{
+    custom::pmr::map<int, int> ordered(resource);
+    custom::pmr::unordered_map<int, int> hashed(resource);
+    custom::pmr::list<int> items(resource);
+    custom::pmr::vector<int> values(resource);
+
+    for (int i = 0; i < 200; ++i)
+    {
+        const int key = (i * 7919 + request) % 1000;
+        ordered[key] = i;
+        hashed[key] = i;
+        items.push_back(key);
+        values.push_back(key);
+    }
+
+    return ordered.size() + hashed.size() + items.size() + values.size();
+}
+
+
+template<class Run>
+static double _ns_per_request(const int requests, Run run)
+{
+    using clock = std::chrono::steady_clock;
+
+    uint64_t sink = 0;
+
+    auto start = clock::now();
+    for (int request = 0; request < requests; ++request)
+        sink += run(request);
+    auto stop = clock::now();
+
+    std::printf("%s", sink == 42 ? " " : "");       // keep the result alive
+
+    return std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(requests);
+}
+
+
+int main()
+{
+    constexpr int requests = 20000;
+
+    custom::pmr::monotonic_buffer_resource arena;
+    custom::pmr::unsynchronized_pool_resource pool;
+
+    double defaultTime  = _ns_per_request(requests, [](int request)
+                            {
+                                return _handle_request(custom::pmr::get_default_resource(), request);
+                            });
+
+    double arenaTime    = _ns_per_request(requests, [&arena](int request)
+                            {
+                                uint64_t result = _handle_request(&arena, request);
+                                arena.release();    // everything from this request at once
+                                return result;
+                            });
+
+    double poolTime     = _ns_per_request(requests, [&pool](int request)
+                            {
+                                return _handle_request(&pool, request);
+                            });
+
+    std::printf("ns per request (lower is better)\n");
+    std::printf("  %-12s %10.0f\n", "new/delete", defaultTime);
+    std::printf("  %-12s %10.0f\n", "monotonic", arenaTime);
+    std::printf("  %-12s %10.0f\n", "pool", poolTime);
+
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdint>
+#include <mutex>
+#include <semaphore>
+
+#include "custom/vector.h"
+#include "custom/condition_variable.h"
+#include "custom/counting_semaphore.h"
+#include "custom/mutex.h"       // unit to be measured
+
+
+// Lock-heavy service paths: uncontended lock/unlock, 4 threads sharing one counter,
+// a condition variable hand-off between two threads, and a semaphore releasing a batch
+// of 8 permits to 8 sleepers. std types (glibc pthread) are the baseline.
+// Usage: Custom_STL_CPP_MUTEX_Benchmark
+
+
+template<class Mutex>
+static double _ms_for_uncontended(const int operations)
+{
+    using clock = std::chrono::steady_clock;
+
+    Mutex mutex;
+    uint64_t counter = 0;
+
+    auto start = clock::now();
+    for (int i = 0; i < operations; ++i)
+    {
+        mutex.lock();
+        ++counter;
+        mutex.unlock();
+    }
+    auto stop = clock::now();
+
+    std::printf("%s", counter == 42 ? " " : "");    // keep the result alive
+
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+
+template<class Mutex>
+static double _ms_for_contended(const int threads, const int operations)
+{
+    using clock = std::chrono::steady_clock;
+
+    Mutex mutex;
+    uint64_t counter = 0;
+    custom::vector<custom::thread> workers;
+
+    auto start = clock::now();
+    for (int t = 0; t < threads; ++t)
+        workers.emplace_back([&mutex, &counter, operations]()
+        {
+            for (int i = 0; i < operations; ++i)
+            {
+                mutex.lock();
+                ++counter;
+                mutex.unlock();
+            }
+        });
+
+    for (auto& worker : workers)
+        worker.join();
+    auto stop = clock::now();
+
+    std::printf("%s", counter == 42 ? " " : "");    // keep the result alive
+
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+
+template<class Mutex, class ConditionVariable, template<class> class Lock>
+static double _ms_for_hand_off(const int rounds)
+{
+    using clock = std::chrono::steady_clock;
+
+    Mutex mutex;
+    ConditionVariable cv;
+    int turn = 0;
+
+    auto start = clock::now();
+    custom::thread other([&]()
+    {
+        for (int round = 0; round < rounds; ++round)
+        {
+            Lock<Mutex> lock(mutex);
+            cv.wait(lock, [&turn]() { return turn == 1; });
+            turn = 0;
+            cv.notify_one();
+        }
+    });
+
+    for (int round = 0; round < rounds; ++round)
+    {
+        Lock<Mutex> lock(mutex);
+        turn = 1;
+        cv.notify_one();
+        cv.wait(lock, [&turn]() { return turn == 0; });
+    }
+
+    other.join();
+    auto stop = clock::now();
+
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+
+template<class Semaphore, class ReleaseBatch>
+static double _ms_for_batches(const int batches, ReleaseBatch releaseBatch)
+{
+    using clock = std::chrono::steady_clock;
+
+    constexpr int sleepers = 8;
+
+    Semaphore permits(0);
+    Semaphore done(0);
+    custom::vector<custom::thread> workers;
+
+    for (int t = 0; t < sleepers; ++t)
+        workers.emplace_back([&permits, &done, batches]()
+        {
+            for (int b = 0; b < batches; ++b)
+            {
+                permits.acquire();
+                done.release();
+            }
+        });
+
+    auto start = clock::now();
+    for (int b = 0; b < batches; ++b)
+    {
+        releaseBatch(permits, sleepers);
+        for (int t = 0; t < sleepers; ++t)
+            done.acquire();
+    }
+    auto stop = clock::now();
+
+    for (auto& worker : workers)
+        worker.join();
+
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+
+int main()
+{
+    constexpr int operations    = 10000000;
+    constexpr int perThread     = 1000000;
+    constexpr int rounds        = 50000;
+    constexpr int batches       = 20000;
+
+    auto releaseLoop    = [](auto& semaphore, int count) { for (int i = 0; i < count; ++i) semaphore.release(); };
+    auto releaseOnce    = [](auto& semaphore, int count) { semaphore.release(count); };
+
+    custom::thread([]() { /*Empty*/ }).join();  // glibc skips the lock prefix until a second thread existed
+
+    std::printf("sizeof mutex: std %zu, custom %zu; condition_variable: std %zu, custom %zu\n",
+                sizeof(std::mutex), sizeof(custom::mutex), sizeof(std::condition_variable), sizeof(custom::condition_variable));
+
+    std::printf("ms (lower is better)                  %10s %10s\n", "std", "custom");
+    std::printf("  %d uncontended lock/unlock   %10.1f %10.1f\n", operations,
+                _ms_for_uncontended<std::mutex>(operations), _ms_for_uncontended<custom::mutex>(operations));
+    std::printf("  4 threads x %d lock/unlock    %10.1f %10.1f\n", perThread,
+                _ms_for_contended<std::mutex>(4, perThread), _ms_for_contended<custom::mutex>(4, perThread));
+    std::printf("  %d condition variable hand-offs %10.1f %10.1f\n", rounds,
+                _ms_for_hand_off<std::mutex, std::condition_variable, std::unique_lock>(rounds),
+                _ms_for_hand_off<custom::mutex, custom::condition_variable, custom::unique_lock>(rounds));
+    std::printf("  %d batches of 8 permits       %10.1f %10.1f (std releases one by one)\n", batches,
+                _ms_for_batches<std::counting_semaphore<>>(batches, releaseLoop),
+                _ms_for_batches<custom::counting_semaphore<>>(batches, releaseOnce));
+
+    return 0;
+}
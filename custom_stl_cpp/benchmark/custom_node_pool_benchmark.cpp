@@ -0,0 +1,76 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+
+#include "custom/list.h"
+#include "custom/map.h"
+#include "custom/unordered_map.h"
+#include "custom/node_pool_allocator.h"     // unit to be measured
+
+
+// Node churn in list, map and unordered_map with custom::allocator vs node_pool_allocator:
+// fill, erase every other element, refill, then destroy the container.
+// Usage: Custom_STL_CPP_NODE_POOL_Benchmark
+
+
+template<class Container, class Insert>
+static double _ms_for_churn(Insert insert)
+{
+    using clock = std::chrono::steady_clock;
+
+    constexpr int rounds    = 20;
+    constexpr int count     = 50000;
+    uint64_t sink           = 0;
+
+    auto start = clock::now();
+    for (int r = 0; r < rounds; ++r)
+    {
+        Container container;
+        for (int i = 0; i < count; ++i)
+            insert(container, i);
+
+        for (auto it = container.begin(); it != container.end(); /*Empty*/)
+        {
+            it = container.erase(it);
+            if (it != container.end())
+                ++it;
+        }
+
+        for (int i = count; i < 2 * count; ++i)
+            insert(container, i);
+
+        sink += container.size();
+    }
+    auto stop = clock::now();
+
+    std::printf("%s", sink == 42 ? " " : "");       // keep the result alive
+
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+
+int main()
+{
+    using _Pair = custom::pair<int, int>;
+
+    auto listInsert = [](auto& list, int i) { list.push_back(i); };
+    auto mapInsert  = [](auto& map, int i) { map.emplace(i * 7919, i); };
+
+    double list     = _ms_for_churn<custom::list<int>>(listInsert);
+    double listPool = _ms_for_churn<custom::list<int, custom::node_pool_allocator<int>>>(listInsert);
+
+    double map      = _ms_for_churn<custom::map<int, int>>(mapInsert);
+    double mapPool  = _ms_for_churn<custom::map<int, int, custom::less<int>, custom::node_pool_allocator<_Pair>>>(mapInsert);
+
+    double umap     = _ms_for_churn<custom::unordered_map<int, int>>(mapInsert);
+    double umapPool = _ms_for_churn<custom::unordered_map<int, int, custom::hash<int>, custom::equal_to<int>,
+                                                            custom::node_pool_allocator<_Pair>>>(mapInsert);
+
+    std::printf("ms for node churn (lower is better)\n");
+    std::printf("  %-15s %10s %10s\n", "container", "allocator", "node pool");
+    std::printf("  %-15s %10.1f %10.1f\n", "list", list, listPool);
+    std::printf("  %-15s %10.1f %10.1f\n", "map", map, mapPool);
+    std::printf("  %-15s %10.1f %10.1f\n", "unordered_map", umap, umapPool);
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+
+#include "custom/memory.h"              // unit to be measured
+#include "custom/local_shared_ptr.h"    // unit to be measured
+#include "custom/memory_resource.h"
+
+
+// Short-lived shared objects: create, copy once and drop, with shared_ptr(new T),
+// make_shared (one allocation) and allocate_shared from a pool resource.
+// Handle churn: copy and destroy handles to one object, shared_ptr vs local_shared_ptr.
+// Usage: Custom_STL_CPP_SHARED_PTR_Benchmark
+
+
+struct _Message
+{
+    uint64_t id;
+    uint64_t payload[6];
+
+    explicit _Message(uint64_t id) : id(id), payload{} { /*Empty*/ }
+};
+
+
+template<class Make>
+static double _ns_per_object(Make make)
+{
+    using clock = std::chrono::steady_clock;
+
+    constexpr int count = 2000000;
+    uint64_t sink       = 0;
+
+    auto start = clock::now();
+    for (int i = 0; i < count; ++i)
+    {
+        custom::shared_ptr<_Message> ptr    = make(static_cast<uint64_t>(i));
+        custom::shared_ptr<_Message> copy   = ptr;
+        sink += copy->id + static_cast<uint64_t>(ptr.use_count());
+    }
+    auto stop = clock::now();
+
+    std::printf("%s", sink == 42 ? " " : "");       // keep the result alive
+
+    return std::chrono::duration<double, std::nano>(stop - start).count() / count;
+}
+
+
+template<class SharedPtr>
+static double _ns_per_copy(const SharedPtr& source)
+{
+    using clock = std::chrono::steady_clock;
+
+    constexpr int count     = 10000000;
+    constexpr int handles   = 8;
+    uint64_t sink           = 0;
+
+    SharedPtr slots[handles];
+
+    auto start = clock::now();
+    for (int i = 0; i < count; ++i)
+    {
+        SharedPtr& slot = slots[i % handles];
+        slot = source;                          // copy, destroy the previous handle
+        sink += static_cast<uint64_t>(slot->id);
+    }
+    auto stop = clock::now();
+
+    std::printf("%s", sink == 42 ? " " : "");   // keep the result alive
+
+    return std::chrono::duration<double, std::nano>(stop - start).count() / count;
+}
+
+
+int main()
+{
+    custom::pmr::unsynchronized_pool_resource pool;
+    custom::pmr::polymorphic_allocator<_Message> poolAlloc(&pool);
+
+    double separate = _ns_per_object([](uint64_t id)
+                        {
+                            return custom::shared_ptr<_Message>(new _Message(id));
+                        });
+
+    double combined = _ns_per_object([](uint64_t id)
+                        {
+                            return custom::make_shared<_Message>(id);
+                        });
+
+    double pooled   = _ns_per_object([&poolAlloc](uint64_t id)
+                        {
+                            return custom::allocate_shared<_Message>(poolAlloc, id);
+                        });
+
+    std::printf("ns per object (lower is better)\n");
+    std::printf("  %-24s %8.1f\n", "shared_ptr(new T)", separate);
+    std::printf("  %-24s %8.1f\n", "make_shared", combined);
+    std::printf("  %-24s %8.1f\n", "allocate_shared (pool)", pooled);
+
+    double atomicCopy   = _ns_per_copy(custom::make_shared<_Message>(1));
+    double localCopy    = _ns_per_copy(custom::make_local_shared<_Message>(1));
+
+    std::printf("ns per handle copy and destroy (lower is better)\n");
+    std::printf("  %-24s %8.2f\n", "shared_ptr", atomicCopy);
+    std::printf("  %-24s %8.2f\n", "local_shared_ptr", localCopy);
+
+    return 0;
+}
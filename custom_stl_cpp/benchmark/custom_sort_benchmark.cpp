@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+
+#include "custom/algorithm.h"   // unit to be measured
+
+
+// custom::sort / stable_sort vs std on random, sorted, reversed and many-duplicates inputs.
+// Usage: Custom_STL_CPP_SORT_Benchmark
+
+
+static std::vector<uint32_t> _make_input(const char* kind, const size_t count)
+{
+    std::vector<uint32_t> values(count);
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        values[i] = static_cast<uint32_t>(state >> 33);
+    }
+
+    switch (kind[0])
+    {
+        case 's': std::sort(values.begin(), values.end()); break;                           // sorted
+        case 'r': std::sort(values.begin(), values.end(), std::greater<>{}); break;         // reversed
+        case 'd': for (auto& value : values) value %= 16; break;                            // duplicates
+        default: break;                                                                     // random
+    }
+
+    return values;
+}
+
+
+template<class Sort>
+static double _ns_per_element(const std::vector<uint32_t>& input, Sort sort)
+{
+    using clock = std::chrono::steady_clock;
+
+    constexpr size_t rounds = 10;
+    std::vector<uint32_t> values;
+    double ns = 0;
+
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        values = input;
+
+        auto start = clock::now();
+        sort(values.data(), values.data() + values.size());
+        auto stop = clock::now();
+
+        ns += std::chrono::duration<double, std::nano>(stop - start).count();
+    }
+
+    if (!std::is_sorted(values.begin(), values.end()))
+        std::printf("  not sorted!\n");
+
+    return ns / static_cast<double>(rounds * input.size());
+}
+
+
+int main()
+{
+    constexpr size_t count = 1u << 20;
+
+    std::printf("ns per element, %zu uint32 (lower is better)\n", count);
+    std::printf("  %-12s %10s %10s %12s %12s\n", "input", "custom", "std", "custom stbl", "std stbl");
+
+    for (const char* kind : {"random", "sorted", "reversed", "duplicates"})
+    {
+        auto input = _make_input(kind, count);
+
+        double customSort   = _ns_per_element(input, [](uint32_t* first, uint32_t* last) { custom::sort(first, last); });
+        double stdSort      = _ns_per_element(input, [](uint32_t* first, uint32_t* last) { std::sort(first, last); });
+        double customStable = _ns_per_element(input, [](uint32_t* first, uint32_t* last) { custom::stable_sort(first, last); });
+        double stdStable    = _ns_per_element(input, [](uint32_t* first, uint32_t* last) { std::stable_sort(first, last); });
+
+        std::printf("  %-12s %10.2f %10.2f %12.2f %12.2f\n", kind, customSort, stdSort, customStable, stdStable);
+    }
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "custom/string_view.h"  // unit to be measured
+
+
+// string_view search throughput on log-like lines, custom vs std.
+// Build with -DCUSTOM_SIMD_ENABLED=0 to measure the scalar loops.
+// Usage: Custom_STL_CPP_STRING_SEARCH_Benchmark
+
+
+static std::vector<std::string> _make_lines(const size_t count, const size_t lineLength)
+{
+    const char* words[] = {"INFO", "request", "served", "user=", "id:", "latency", "ms", "path=/api/v1/items", "status=200"};
+    std::vector<std::string> lines(count);
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+    for (auto& line : lines)
+    {
+        while (line.size() < lineLength)
+        {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            line += words[(state >> 33) % (sizeof(words) / sizeof(words[0]))];
+            line += ' ';
+        }
+
+        line.resize(lineLength);
+        line.back() = '\n';
+    }
+
+    return lines;
+}
+
+
+template<class Search>
+static double _lines_per_us(const std::vector<std::string>& lines, Search search)
+{
+    using clock = std::chrono::steady_clock;
+
+    constexpr size_t rounds = 2000;
+    size_t sink = 0;
+
+    auto start = clock::now();
+    for (size_t r = 0; r < rounds; ++r)
+        for (const auto& line : lines)
+            sink += search(line.data(), line.size());
+    auto stop = clock::now();
+
+    double us = std::chrono::duration<double, std::micro>(stop - start).count();
+    std::printf("%s", sink == 42 ? " " : "");       // keep the result alive
+
+    return static_cast<double>(rounds * lines.size()) / us;
+}
+
+
+int main()
+{
+    std::printf("lines searched per microsecond (higher is better)\n");
+    std::printf("  %-22s %10s %10s\n", "operation / length", "custom", "std");
+
+    for (size_t lineLength : {32, 128, 1024})
+    {
+        auto lines = _make_lines((256u << 10) / lineLength, lineLength);  // 256KB of text stays in cache
+
+        double customChr = _lines_per_us(lines, [](const char* p, size_t n) { return custom::string_view(p, n).find('\n'); });
+        double stdChr    = _lines_per_us(lines, [](const char* p, size_t n) { return std::string_view(p, n).find('\n'); });
+        std::printf("  find(char) %-11zu %10.2f %10.2f\n", lineLength, customChr, stdChr);
+
+        double customStr = _lines_per_us(lines, [](const char* p, size_t n) { return custom::string_view(p, n).find("status=500"); });
+        double stdStr    = _lines_per_us(lines, [](const char* p, size_t n) { return std::string_view(p, n).find("status=500"); });
+        std::printf("  find(str) %-12zu %10.2f %10.2f\n", lineLength, customStr, stdStr);
+
+        double customSet = _lines_per_us(lines, [](const char* p, size_t n) { return custom::string_view(p, n).find_first_of("=:\n"); });
+        double stdSet    = _lines_per_us(lines, [](const char* p, size_t n) { return std::string_view(p, n).find_first_of("=:\n"); });
+        std::printf("  find_first_of %-8zu %10.2f %10.2f\n", lineLength, customSet, stdSet);
+    }
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+
+#include "custom/vector.h"
+#include "custom/thread.h"
+#include "custom/thread_pool.h"     // unit to be measured
+
+
+// Many small parallel jobs, like a request handler splitting each request over the cores:
+// one custom::thread per piece started and joined for every job vs parallel_for on a pool.
+// Also measures submit/get round trips of tiny tasks.
+// Usage: Custom_STL_CPP_THREAD_POOL_Benchmark
+
+
+static void _work(const size_t piece, uint64_t* out) noexcept
+{
+    uint64_t value = piece;
+    for (int i = 0; i < 2000; ++i)
+        value = value * 6364136223846793005ull + 1442695040888963407ull;
+
+    *out = value;
+}
+
+
+static double _ms_for_threads(const size_t jobs, const size_t pieces)
+{
+    using clock = std::chrono::steady_clock;
+
+    custom::vector<uint64_t> results(pieces);
+    uint64_t sink = 0;
+
+    auto start = clock::now();
+    for (size_t job = 0; job < jobs; ++job)
+    {
+        custom::vector<custom::thread> threads;
+        for (size_t piece = 0; piece < pieces; ++piece)
+            threads.emplace_back(_work, piece, &results[piece]);
+
+        for (auto& thread : threads)
+            thread.join();
+
+        sink += results[0];
+    }
+    auto stop = clock::now();
+
+    std::printf("%s", sink == 42 ? " " : "");       // keep the result alive
+
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+
+static double _ms_for_pool(custom::thread_pool& pool, const size_t jobs, const size_t pieces)
+{
+    using clock = std::chrono::steady_clock;
+
+    custom::vector<uint64_t> results(pieces);
+    uint64_t sink = 0;
+
+    auto start = clock::now();
+    for (size_t job = 0; job < jobs; ++job)
+    {
+        pool.parallel_for(size_t(0), pieces, [&results](size_t piece) { _work(piece, &results[piece]); }, 1);
+        sink += results[0];
+    }
+    auto stop = clock::now();
+
+    std::printf("%s", sink == 42 ? " " : "");       // keep the result alive
+
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+
+static double _ms_for_submit(custom::thread_pool& pool, const size_t tasks)
+{
+    using clock = std::chrono::steady_clock;
+
+    uint64_t sink = 0;
+
+    auto start = clock::now();
+    for (size_t task = 0; task < tasks; ++task)
+        sink += pool.submit([task]() { return task * 3; }).get();
+    auto stop = clock::now();
+
+    std::printf("%s", sink == 42 ? " " : "");       // keep the result alive
+
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+
+int main()
+{
+    constexpr size_t jobs   = 2000;
+    constexpr size_t tasks  = 100000;
+
+    const size_t workers = custom::thread::hardware_concurrency() > 0 ? custom::thread::hardware_concurrency() : 1;
+    const size_t pieces  = workers * 4;
+
+    custom::thread_pool pool(workers);
+
+    std::printf("ms for %zu jobs of %zu pieces on %zu workers (lower is better)\n", jobs, pieces, workers);
+    std::printf("  thread per piece   %10.1f\n", _ms_for_threads(jobs, pieces));
+    std::printf("  pool parallel_for  %10.1f\n", _ms_for_pool(pool, jobs, pieces));
+    std::printf("ms for %zu submit/get round trips: %.1f\n", tasks, _ms_for_submit(pool, tasks));
+
+    return 0;
+}
@@ -0,0 +1,141 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+
+#include "custom/string.h"
+#include "custom/small_vector.h"
+#include "custom/vector.h"      // unit to be measured
+
+
+// Ingest of decoded batches: append 10k record batches to a vector one push_back at a time
+// vs append_range, for a trivially copyable record and for a string.
+// The vector is cleared between rounds and keeps its capacity, like a reused ingest buffer.
+// Also measures reallocating a vector of strings, which relocates them with memcpy,
+// and building many short lists with vector vs small_vector.
+// Usage: Custom_STL_CPP_VECTOR_Benchmark
+
+
+struct _Record
+{
+    uint64_t id;
+    double value;
+    int flags;
+};
+
+
+template<class Type, class Append>
+static double _ms_for_ingest(const custom::vector<Type>& batch, Append append)
+{
+    using clock = std::chrono::steady_clock;
+
+    constexpr int rounds    = 20;
+    constexpr int batches   = 50;
+    uint64_t sink           = 0;
+
+    custom::vector<Type> records;
+
+    auto start = clock::now();
+    for (int r = 0; r < rounds; ++r)
+    {
+        records.clear();
+        for (int b = 0; b < batches; ++b)
+            append(records, batch);
+
+        sink += records.size();
+    }
+    auto stop = clock::now();
+
+    std::printf("%s", sink == 42 ? " " : "");       // keep the result alive
+
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+
+static double _ms_for_string_relocation()
+{
+    using clock = std::chrono::steady_clock;
+
+    constexpr int rounds    = 20;
+    constexpr int count     = 100000;
+    uint64_t sink           = 0;
+
+    custom::vector<custom::string> strings;
+    for (int i = 0; i < count; ++i)
+        strings.push_back(i % 2 == 0 ? "short" : "a string too long for the inline buffer");
+
+    auto start = clock::now();
+    for (int r = 0; r < rounds; ++r)
+    {
+        strings.reserve(strings.capacity() + 1);   // reallocate and relocate every element
+        sink += strings.size();
+    }
+    auto stop = clock::now();
+
+    std::printf("%s", sink == 42 ? " " : "");       // keep the result alive
+
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+
+template<class Container>
+static double _ms_for_short_lists()
+{
+    using clock = std::chrono::steady_clock;
+
+    constexpr int lists     = 1000000;
+    uint64_t sink           = 0;
+
+    auto start = clock::now();
+    for (int l = 0; l < lists; ++l)
+    {
+        Container tags;
+        for (int i = 0; i < (l & 7); ++i)          // 0 to 7 elements, like header lists or tag sets
+            tags.push_back(l + i);
+
+        sink += tags.size();
+    }
+    auto stop = clock::now();
+
+    std::printf("%s", sink == 42 ? " " : "");       // keep the result alive
+
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+
+int main()
+{
+    constexpr int batchSize = 10000;
+
+    custom::vector<_Record> records;
+    custom::vector<custom::string> strings;
+    for (int i = 0; i < batchSize; ++i)
+    {
+        records.push_back(_Record{static_cast<uint64_t>(i), i * 0.5, i & 7});
+        strings.push_back("record");
+    }
+
+    auto pushBack = [](auto& vector, const auto& batch)
+    {
+        for (const auto& value : batch)
+            vector.push_back(value);
+    };
+
+    auto appendRange = [](auto& vector, const auto& batch) { vector.append_range(batch); };
+
+    double recordPush   = _ms_for_ingest(records, pushBack);
+    double recordAppend = _ms_for_ingest(records, appendRange);
+    double stringPush   = _ms_for_ingest(strings, pushBack);
+    double stringAppend = _ms_for_ingest(strings, appendRange);
+
+    std::printf("ms for %d batches of %d (lower is better)\n", 50 * 20, batchSize);
+    std::printf("  %-10s %12s %12s\n", "type", "push_back", "append_range");
+    std::printf("  %-10s %12.1f %12.1f\n", "record", recordPush, recordAppend);
+    std::printf("  %-10s %12.1f %12.1f\n", "string", stringPush, stringAppend);
+    std::printf("ms for 20 reallocations of 100000 strings: %.1f\n", _ms_for_string_relocation());
+
+    double vectorLists  = _ms_for_short_lists<custom::vector<int>>();
+    double smallLists   = _ms_for_short_lists<custom::small_vector<int, 8>>();
+    std::printf("ms for 1000000 lists of 0-7 ints: vector %.1f, small_vector %.1f\n", vectorLists, smallLists);
+
+    return 0;
+}
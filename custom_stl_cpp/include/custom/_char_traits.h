@@ -2,13 +2,18 @@
 #include <cstring>
 #include <cwchar>
 #include "custom/utility.h"
+#include "custom/_simd_utils.h"
 
 
 CUSTOM_BEGIN
 
+template<class Type>
+struct char_traits;
+
 CUSTOM_DETAIL_BEGIN
 
 // char traits implementation
+// length, find and compare use the SSE2/AVX2 kernels at runtime and plain loops during constant evaluation
 template<class Type, class Integer>
 struct _Char_Traits
 {
@@ -37,13 +42,32 @@ struct _Char_Traits
 									size_t count) noexcept
 	{
 		// the sign of the result is the sign of
-		// the difference between the values of the first pair of bytes
+		// the difference between the values of the first pair of chars
 		// that differ in the objects being compared.
-		return ::memcmp(first1, first2, count * sizeof(char_type));
+		if (!custom::is_constant_evaluated())
+		{
+			if constexpr (sizeof(char_type) == 1)
+				return ::memcmp(first1, first2, count);	// byte order is char order only for 1 byte chars
+
+			size_t index = _vectorized_mismatch(first1, first2, count);
+			if (index == count)
+				return 0;
+
+			return lt(first1[index], first2[index]) ? -1 : 1;
+		}
+
+		for (/*Empty*/; 0 < count; --count, ++first1, ++first2)
+			if (!eq(*first1, *first2))
+				return lt(*first1, *first2) ? -1 : 1;
+
+		return 0;
 	}
 
 	static constexpr size_t length(const char_type* cstr) noexcept
 	{
+		if (!custom::is_constant_evaluated())
+			return _vectorized_length(cstr);
+
 		size_t count = 0;
 		for (/*Empty*/; *cstr != NULLCHR; ++count, ++cstr) { /*do nothing*/ }
 		return count;
@@ -54,6 +78,9 @@ struct _Char_Traits
 											size_t count,
 											const char_type& ch) noexcept
 	{
+		if (!custom::is_constant_evaluated())
+			return _vectorized_find(cstr, count, ch);
+
 		for (/*Empty*/; 0 < count; --count, ++cstr)
             if (*cstr == ch)
                 return cstr;
@@ -125,27 +152,49 @@ public:
 };	// END _WChar_Traits
 
 // helper functions
+
+// the search helpers below call the vectorized kernels directly only for the library traits,
+// user traits keep their own eq/compare semantics
+template<class Traits>
+constexpr bool _Is_Default_Char_Traits_v = is_same_v<Traits, char_traits<typename Traits::char_type>>;
+
 template<class Traits>
 constexpr int _traits_cstring_compare(	const typename Traits::char_type* cstringLeft,
 										size_t pos, size_t len,
 										const typename Traits::char_type* cstringRight,
 										size_t subpos, size_t sublen) noexcept
-{	
-	if (len != sublen)
-		return len - sublen;
+{
+	// lexicographic compare: common prefix first, then the shorter string is smaller
+	int result = Traits::compare(cstringLeft + pos, cstringRight + subpos, (len < sublen) ? len : sublen);
+	if (result != 0)
+		return result;
+
+	if (len == sublen)
+		return 0;
 
-	return Traits::compare(cstringLeft + pos, cstringRight + subpos, len);	// same length
+	return (len < sublen) ? -1 : 1;
 }
 
 template<class Traits>
 constexpr size_t _traits_cstring_find(	const typename Traits::char_type* cstringLeft,
+										size_t leftSize,
 										const typename Traits::char_type* cstringRight,
 										size_t pos, size_t len) noexcept
 {
-	// search in [cstringLeft + pos, end) the string [cstringRight, cstringRight + len]
+	// search in [cstringLeft + pos, cstringLeft + leftSize) the string [cstringRight, cstringRight + len)
+
+	if (pos > leftSize || len > leftSize - pos)
+		return static_cast<size_t>(-1);	// npos
+
+	if constexpr (_Is_Default_Char_Traits_v<Traits>)
+		if (!custom::is_constant_evaluated())
+		{
+			size_t index = _vectorized_search(cstringLeft + pos, leftSize - pos, cstringRight, len);
+			return (index == static_cast<size_t>(-1)) ? index : pos + index;
+		}
 
 	// last pos from which a substring of length len can be formed
-	size_t lastSubstrPos = Traits::length(cstringLeft) - len;
+	size_t lastSubstrPos = leftSize - len;
 
 	for (size_t i = pos; i <= lastSubstrPos; ++i)
 		if (Traits::compare(cstringLeft + i, cstringRight, len) == 0)
@@ -156,22 +205,51 @@ constexpr size_t _traits_cstring_find(	const typename Traits::char_type* cstring
 
 template<class Traits>
 constexpr size_t _traits_cstring_rfind(	const typename Traits::char_type* cstringLeft,
+										size_t leftSize,
 										const typename Traits::char_type* cstringRight,
 										size_t pos, size_t len) noexcept
 {
-	// search in [cstringLeft, cstringLeft + pos) the string [cstringRight, cstringRight + len]
+	// search in [cstringLeft, cstringLeft + pos] the start of the string [cstringRight, cstringRight + len)
 	// from right to left
 
-	size_t leftSize 		= Traits::length(cstringLeft);
-	size_t lastSubstrPos 	= (pos > leftSize) ? leftSize - len : pos;
+	if (len > leftSize)
+		return static_cast<size_t>(-1);	// npos
+
 	// last pos from which a substring of length len can be formed
+	size_t lastSubstrPos = (pos > leftSize - len) ? leftSize - len : pos;
 
-	for (size_t i = lastSubstrPos; i > 0; --i)
-		if (Traits::compare(cstringLeft + i, cstringRight, len) == 0)
-			return i;
+	if constexpr (_Is_Default_Char_Traits_v<Traits>)
+		if (!custom::is_constant_evaluated())
+			return _vectorized_rsearch(cstringLeft, lastSubstrPos, cstringRight, len);
+
+	for (size_t i = lastSubstrPos + 1; i > 0; --i)
+		if (Traits::compare(cstringLeft + i - 1, cstringRight, len) == 0)
+			return i - 1;
+
+    return static_cast<size_t>(-1);	// npos
+}
+
+template<class Traits>
+constexpr size_t _traits_cstring_find_first_of(	const typename Traits::char_type* cstringLeft,
+												size_t leftSize,
+												const typename Traits::char_type* cstringSet,
+												size_t pos, size_t setSize) noexcept
+{
+	// search in [cstringLeft + pos, cstringLeft + leftSize) any char from [cstringSet, cstringSet + setSize)
 
-	if (Traits::compare(cstringLeft, cstringRight, len) == 0)	// case for i == 0
-		return static_cast<size_t>(0);
+	if (pos >= leftSize)
+		return static_cast<size_t>(-1);	// npos
+
+	if constexpr (_Is_Default_Char_Traits_v<Traits>)
+		if (!custom::is_constant_evaluated())
+		{
+			size_t index = _vectorized_find_first_of(cstringLeft + pos, leftSize - pos, cstringSet, setSize);
+			return (index == leftSize - pos) ? static_cast<size_t>(-1) : pos + index;
+		}
+
+	for (size_t i = pos; i < leftSize; ++i)
+		if (Traits::find(cstringSet, setSize, cstringLeft[i]) != nullptr)
+			return i;
 
     return static_cast<size_t>(-1);	// npos
 }
@@ -0,0 +1,989 @@
+#pragma once
+#include "custom/_memory_utils.h"
+#include "custom/pair.h"
+#include "custom/utility.h"
+#include "custom/functional.h"	// EqualTo, Hash
+#include "custom/bit.h"			// countr_zero, bit_ceil
+#include <cmath>				// std::ceil
+
+#if CUSTOM_SIMD_ENABLED && defined __AVX2__
+#include <immintrin.h>
+#define CUSTOM_FLAT_GROUP_AVX2
+#elif CUSTOM_SIMD_ENABLED && (defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define CUSTOM_FLAT_GROUP_SSE2
+#endif
+
+
+CUSTOM_BEGIN
+
+CUSTOM_DETAIL_BEGIN
+
+// Control byte stored for each slot of _Flat_Hash_Table
+// Full slots hold the lower 7 bits of the hash (H2) so the sign bit is clear.
+// Special values have the sign bit set and are ordered so that
+// ctrl < _CTRL_SENTINEL means "empty or deleted".
+using _Ctrl_Type = signed char;
+
+constexpr _Ctrl_Type _CTRL_EMPTY		= -128;		// 0b10000000
+constexpr _Ctrl_Type _CTRL_DELETED		= -2;		// 0b11111110
+constexpr _Ctrl_Type _CTRL_SENTINEL		= -1;		// 0b11111111 - marks the end of the control array
+
+// Control array used by tables without allocated slots (moved-from or empty state)
+inline _Ctrl_Type _FLAT_EMPTY_CTRL[1] = { _CTRL_SENTINEL };
+
+// A group of WIDTH consecutive control bytes matched together
+// Each match returns a bitmask where bit i is set if ctrl[i] matches
+struct _Flat_Group_Portable
+{
+	using _Mask_Type = unsigned int;
+
+	static constexpr size_t WIDTH = 16;
+
+	const _Ctrl_Type* _Ctrl;
+
+	explicit _Flat_Group_Portable(const _Ctrl_Type* ctrl) noexcept
+		: _Ctrl(ctrl) { /*Empty*/ }
+
+	_Mask_Type match(const _Ctrl_Type h2) const noexcept
+	{
+		_Mask_Type mask = 0;
+		for (size_t i = 0; i < WIDTH; ++i)
+			if (_Ctrl[i] == h2)
+				mask |= (_Mask_Type(1) << i);
+
+		return mask;
+	}
+
+	_Mask_Type match_empty() const noexcept
+	{
+		return match(_CTRL_EMPTY);
+	}
+
+	_Mask_Type match_empty_or_deleted() const noexcept
+	{
+		_Mask_Type mask = 0;
+		for (size_t i = 0; i < WIDTH; ++i)
+			if (_Ctrl[i] < _CTRL_SENTINEL)
+				mask |= (_Mask_Type(1) << i);
+
+		return mask;
+	}
+};	// END _Flat_Group_Portable
+
+#if defined CUSTOM_FLAT_GROUP_SSE2
+// Matches 16 control bytes with one compare and one movemask
+struct _Flat_Group_SSE2
+{
+	using _Mask_Type = unsigned int;
+
+	static constexpr size_t WIDTH = 16;
+
+	__m128i _Ctrl;
+
+	explicit _Flat_Group_SSE2(const _Ctrl_Type* ctrl) noexcept
+		: _Ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) { /*Empty*/ }
+
+	_Mask_Type match(const _Ctrl_Type h2) const noexcept
+	{
+		return static_cast<_Mask_Type>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), _Ctrl)));
+	}
+
+	_Mask_Type match_empty() const noexcept
+	{
+		return match(_CTRL_EMPTY);
+	}
+
+	_Mask_Type match_empty_or_deleted() const noexcept
+	{
+		return static_cast<_Mask_Type>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(_CTRL_SENTINEL), _Ctrl)));
+	}
+};	// END _Flat_Group_SSE2
+#endif	// CUSTOM_FLAT_GROUP_SSE2
+
+#if defined CUSTOM_FLAT_GROUP_AVX2
+// Matches 32 control bytes with one compare and one movemask
+struct _Flat_Group_AVX2
+{
+	using _Mask_Type = unsigned int;
+
+	static constexpr size_t WIDTH = 32;
+
+	__m256i _Ctrl;
+
+	explicit _Flat_Group_AVX2(const _Ctrl_Type* ctrl) noexcept
+		: _Ctrl(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ctrl))) { /*Empty*/ }
+
+	_Mask_Type match(const _Ctrl_Type h2) const noexcept
+	{
+		return static_cast<_Mask_Type>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_set1_epi8(h2), _Ctrl)));
+	}
+
+	_Mask_Type match_empty() const noexcept
+	{
+		return match(_CTRL_EMPTY);
+	}
+
+	_Mask_Type match_empty_or_deleted() const noexcept
+	{
+		return static_cast<_Mask_Type>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_set1_epi8(_CTRL_SENTINEL), _Ctrl)));
+	}
+};	// END _Flat_Group_AVX2
+#endif	// CUSTOM_FLAT_GROUP_AVX2
+
+// Group implementation used by _Flat_Hash_Table (define CUSTOM_SIMD_ENABLED 0 to benchmark the scalar path)
+#if defined CUSTOM_FLAT_GROUP_AVX2
+using _Flat_Group = _Flat_Group_AVX2;
+#elif defined CUSTOM_FLAT_GROUP_SSE2
+using _Flat_Group = _Flat_Group_SSE2;
+#else
+using _Flat_Group = _Flat_Group_Portable;
+#endif
+
+template<class Type, class Alloc>
+struct _Flat_Hash_Data
+{
+	using _Alloc_Traits		= allocator_traits<Alloc>;
+
+	using value_type		= typename _Alloc_Traits::value_type;
+	using difference_type	= typename _Alloc_Traits::difference_type;
+	using reference			= typename _Alloc_Traits::reference;
+	using const_reference	= typename _Alloc_Traits::const_reference;
+	using pointer			= typename _Alloc_Traits::pointer;
+	using const_pointer		= typename _Alloc_Traits::const_pointer;
+
+	_Ctrl_Type* _Ctrl		= _FLAT_EMPTY_CTRL;		// _Capacity + 1 control bytes (last one is _CTRL_SENTINEL)
+	pointer _Slots			= nullptr;				// _Capacity contiguous slots
+	size_t _Capacity		= 0;					// power of 2, multiple of _Flat_Group::WIDTH
+	size_t _Size			= 0;					// number of full slots
+	size_t _GrowthLeft		= 0;					// number of empty slots that can be filled before rehash
+};	// END _Flat_Hash_Data
+
+template<class FlatData>
+class _Flat_Hash_Const_Iterator
+{
+private:
+	using _Data				= FlatData;
+
+public:
+	using iterator_category	= forward_iterator_tag;
+	using value_type		= typename _Data::value_type;
+	using difference_type	= typename _Data::difference_type;
+	using reference			= typename _Data::const_reference;
+	using pointer			= typename _Data::const_pointer;
+
+	const _Ctrl_Type* _Ctrl	= nullptr;
+	value_type* _Ptr		= nullptr;
+	const _Data* _RefData	= nullptr;
+
+public:
+
+	_Flat_Hash_Const_Iterator() noexcept = default;
+
+	explicit _Flat_Hash_Const_Iterator(const _Ctrl_Type* ctrl, value_type* ptr, const _Data* data) noexcept
+		:_Ctrl(ctrl), _Ptr(ptr), _RefData(data) { /*Empty*/ }
+
+	_Flat_Hash_Const_Iterator& operator++() noexcept
+	{
+		CUSTOM_ASSERT(*_Ctrl != _CTRL_SENTINEL, "Cannot increment end iterator.");
+		++_Ctrl;
+		++_Ptr;
+		_skip_empty_slots();
+		return *this;
+	}
+
+	_Flat_Hash_Const_Iterator operator++(int) noexcept
+	{
+		_Flat_Hash_Const_Iterator temp = *this;
+		++(*this);
+		return temp;
+	}
+
+	pointer operator->() const noexcept
+	{
+		CUSTOM_ASSERT(*_Ctrl != _CTRL_SENTINEL, "Cannot access end iterator.");
+		return _Ptr;
+	}
+
+	reference operator*() const noexcept
+	{
+		CUSTOM_ASSERT(*_Ctrl != _CTRL_SENTINEL, "Cannot dereference end iterator.");
+		return *_Ptr;
+	}
+
+	bool operator==(const _Flat_Hash_Const_Iterator& other) const noexcept
+	{
+		return _Ctrl == other._Ctrl;
+	}
+
+	bool operator!=(const _Flat_Hash_Const_Iterator& other) const noexcept
+	{
+		return !(*this == other);
+	}
+
+public:
+
+	bool is_end() const noexcept
+	{
+		return *_Ctrl == _CTRL_SENTINEL;
+	}
+
+	// Advance until a full slot or the sentinel is reached
+	void _skip_empty_slots() noexcept
+	{
+		while (*_Ctrl < _CTRL_SENTINEL)
+		{
+			++_Ctrl;
+			++_Ptr;
+		}
+	}
+
+	friend void _verify_range(const _Flat_Hash_Const_Iterator& first, const _Flat_Hash_Const_Iterator& last) noexcept
+	{
+		CUSTOM_ASSERT(first._RefData == last._RefData, "flat hash iterators in range are from different containers");
+		CUSTOM_ASSERT(first._Ctrl <= last._Ctrl, "flat hash iterator range transposed");
+	}
+}; // END _Flat_Hash_Const_Iterator
+
+template<class FlatData>
+class _Flat_Hash_Iterator : public _Flat_Hash_Const_Iterator<FlatData>
+{
+private:
+	using _Base				= _Flat_Hash_Const_Iterator<FlatData>;
+	using _Data				= FlatData;
+
+public:
+	using iterator_category	= forward_iterator_tag;
+	using value_type		= typename _Data::value_type;
+	using difference_type	= typename _Data::difference_type;
+	using reference			= typename _Data::reference;
+	using pointer			= typename _Data::pointer;
+
+public:
+
+	_Flat_Hash_Iterator() noexcept = default;
+
+	explicit _Flat_Hash_Iterator(const _Ctrl_Type* ctrl, value_type* ptr, const _Data* data) noexcept
+		:_Base(ctrl, ptr, data) { /*Empty*/ }
+
+	_Flat_Hash_Iterator& operator++() noexcept
+	{
+		_Base::operator++();
+		return *this;
+	}
+
+	_Flat_Hash_Iterator operator++(int) noexcept
+	{
+		_Flat_Hash_Iterator temp = *this;
+		_Base::operator++();
+		return temp;
+	}
+
+	pointer operator->() const noexcept
+	{
+		return const_cast<pointer>(_Base::operator->());
+	}
+
+	reference operator*() const noexcept
+	{
+		return const_cast<reference>(_Base::operator*());
+	}
+}; // END _Flat_Hash_Iterator
+
+
+// _Flat_Hash_Table Template implemented with open addressing
+// Values are stored in a contiguous slot array and each slot has a control byte.
+// Lookup probes whole groups of control bytes (SwissTable style) and compares
+// keys only for slots whose control byte matches the 7 bit hash fragment.
+// Iterators and references are invalidated by rehash.
+template<class Traits>
+class _Flat_Hash_Table
+{
+protected:
+	using _Data					= _Flat_Hash_Data<typename Traits::value_type, typename Traits::allocator_type>;
+	using _Alloc_Traits			= typename _Data::_Alloc_Traits;
+	using _Alloc_Ctrl			= typename _Alloc_Traits::template rebind_alloc<_Ctrl_Type>;
+	using _Alloc_Ctrl_Traits	= allocator_traits<_Alloc_Ctrl>;
+	using _Group				= _Flat_Group;
+	using _Mask_Type			= typename _Group::_Mask_Type;
+
+	using key_type				= typename Traits::key_type;
+	using mapped_type			= typename Traits::mapped_type;
+	using hasher				= typename Traits::hasher;
+	using key_compare			= typename Traits::key_compare;
+
+	using value_type			= typename _Data::value_type;
+	using difference_type		= typename _Data::difference_type;
+	using reference				= typename _Data::reference;
+	using const_reference		= typename _Data::const_reference;
+	using pointer				= typename _Data::pointer;
+	using const_pointer			= typename _Data::const_pointer;
+	using allocator_type		= typename Traits::allocator_type;
+
+	using iterator				= _Flat_Hash_Iterator<_Data>;
+	using const_iterator		= _Flat_Hash_Const_Iterator<_Data>;
+
+protected:
+	hasher _hash;														// Used for initial(non-compressed) hash value
+	key_compare _compare;												// Used for comparison between keys
+	_Data _data;														// Control bytes and slots
+	allocator_type _alloc;												// Used to allocate slots
+	_Alloc_Ctrl _allocCtrl;												// Used to allocate control bytes
+
+	static constexpr float _TABLE_LOAD_FACTOR	= 0.875;				// The maximum load factor admitted before rehashing
+	static constexpr size_t _DEFAULT_CAPACITY	= _Group::WIDTH;		// Default number of slots (one group)
+
+protected:
+	// Constructors
+
+	_Flat_Hash_Table()
+	{
+		rehash(_DEFAULT_CAPACITY);
+	}
+
+	_Flat_Hash_Table(const size_t noBuckets)
+	{
+		rehash((noBuckets < _DEFAULT_CAPACITY) ? _DEFAULT_CAPACITY : noBuckets);
+	}
+
+	_Flat_Hash_Table(const _Flat_Hash_Table& other)
+		: _hash(other._hash), _compare(other._compare)
+	{
+		_copy(other);
+	}
+
+	_Flat_Hash_Table(_Flat_Hash_Table&& other) noexcept
+		: _hash(custom::move(other._hash)), _compare(custom::move(other._compare))
+	{
+		_move(custom::move(other));
+	}
+
+	virtual ~_Flat_Hash_Table()
+	{
+		_clean_up_table();
+	}
+
+protected:
+	// Operators
+
+	_Flat_Hash_Table& operator=(const _Flat_Hash_Table& other)
+	{
+		if (_data._Ctrl != other._data._Ctrl)
+		{
+			_clean_up_table();
+			_hash		= other._hash;
+			_compare	= other._compare;
+			_copy(other);
+		}
+
+		return *this;
+	}
+
+	_Flat_Hash_Table& operator=(_Flat_Hash_Table&& other) noexcept
+	{
+		if (_data._Ctrl != other._data._Ctrl)
+		{
+			_clean_up_table();
+			_hash		= custom::move(other._hash);
+			_compare	= custom::move(other._compare);
+			_move(custom::move(other));
+		}
+
+		return *this;
+	}
+
+public:
+	// Main Functions
+
+	template<class... Args>
+	iterator emplace(Args&&... args)
+	{
+		// The key is known only after construction, so build the value aside first
+		alignas(value_type) unsigned char buffer[sizeof(value_type)];
+		value_type* newValue = reinterpret_cast<value_type*>(buffer);
+		_Alloc_Traits::construct(_alloc, newValue, custom::forward<Args>(args)...);
+
+		try
+		{
+			const key_type& newKey	= Traits::extract_key(*newValue);
+			const size_t hashVal	= _hash(newKey);
+			size_t index			= _find_index(newKey, hashVal);
+
+			if (index == _data._Capacity)	// key not found, move value in a free slot
+			{
+				index = _prepare_insert(hashVal);
+				_Alloc_Traits::construct(_alloc, _data._Slots + index, custom::move(*newValue));
+				_commit_insert(index, hashVal);
+			}
+
+			_Alloc_Traits::destroy(_alloc, newValue);
+			return _make_iter(index);
+		}
+		catch (...)
+		{
+			_Alloc_Traits::destroy(_alloc, newValue);
+			CUSTOM_RERAISE;
+		}
+	}
+
+	iterator erase(const key_type& key)
+	{
+		size_t index = _find_index(key, _hash(key));
+
+		if (index == _data._Capacity)
+			return end();
+
+		_erase_index(index);
+
+		iterator it = _make_iter(index);
+		it._skip_empty_slots();
+		return it;
+	}
+
+	iterator erase(iterator where)
+	{
+		if (where == end())
+			throw std::out_of_range("erase iterator outside range.");
+
+		return erase(Traits::extract_key(*where));
+	}
+
+	iterator erase(const_iterator where)
+	{
+		if (where == end())
+			throw std::out_of_range("erase iterator outside range.");
+
+		return erase(Traits::extract_key(*where));
+	}
+
+	iterator find(const key_type& key)
+	{
+		return _make_iter(_find_index(key, _hash(key)));
+	}
+
+	const_iterator find(const key_type& key) const
+	{
+		return _make_iter(_find_index(key, _hash(key)));
+	}
+
+	bool contains(const key_type& key) const
+	{
+		return _find_index(key, _hash(key)) != _data._Capacity;
+	}
+
+	size_t count(const key_type& key) const
+	{
+		return contains(key) ? 1 : 0;
+	}
+
+	pair<iterator, iterator> equal_range(const key_type& key)
+	{
+		iterator first = find(key);
+		iterator last = first;
+		if (last != end())
+			++last;
+
+		return {first, last};
+	}
+
+	pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+	{
+		const_iterator first = find(key);
+		const_iterator last = first;
+		if (last != end())
+			++last;
+
+		return {first, last};
+	}
+
+	// Heterogeneous lookup: enabled only when both hasher and key_compare are transparent
+	template<class KeyType, class Hash = hasher, class Compare = key_compare,
+	enable_if_t<_Is_Transparent_v<Hash> && _Is_Transparent_v<Compare>, bool> = true>
+	iterator find(const KeyType& key)
+	{
+		return _make_iter(_find_index(key, _hash(key)));
+	}
+
+	template<class KeyType, class Hash = hasher, class Compare = key_compare,
+	enable_if_t<_Is_Transparent_v<Hash> && _Is_Transparent_v<Compare>, bool> = true>
+	const_iterator find(const KeyType& key) const
+	{
+		return _make_iter(_find_index(key, _hash(key)));
+	}
+
+	template<class KeyType, class Hash = hasher, class Compare = key_compare,
+	enable_if_t<_Is_Transparent_v<Hash> && _Is_Transparent_v<Compare>, bool> = true>
+	bool contains(const KeyType& key) const
+	{
+		return _find_index(key, _hash(key)) != _data._Capacity;
+	}
+
+	template<class KeyType, class Hash = hasher, class Compare = key_compare,
+	enable_if_t<_Is_Transparent_v<Hash> && _Is_Transparent_v<Compare>, bool> = true>
+	size_t count(const KeyType& key) const
+	{
+		return contains(key) ? 1 : 0;
+	}
+
+	template<class KeyType, class Hash = hasher, class Compare = key_compare,
+	enable_if_t<_Is_Transparent_v<Hash> && _Is_Transparent_v<Compare>, bool> = true>
+	pair<iterator, iterator> equal_range(const KeyType& key)
+	{
+		iterator first = find(key);
+		iterator last = first;
+		if (last != end())
+			++last;
+
+		return {first, last};
+	}
+
+	template<class KeyType, class Hash = hasher, class Compare = key_compare,
+	enable_if_t<_Is_Transparent_v<Hash> && _Is_Transparent_v<Compare>, bool> = true>
+	pair<const_iterator, const_iterator> equal_range(const KeyType& key) const
+	{
+		const_iterator first = find(key);
+		const_iterator last = first;
+		if (last != end())
+			++last;
+
+		return {first, last};
+	}
+
+	// rebuild table with at least noBuckets slots
+	void rehash(const size_t noBuckets)
+	{
+		size_t newCapacity = _normalize_capacity((custom::max)(_min_load_factor_buckets(size()), noBuckets));	// don't violate bucket_count() >= size() / max_load_factor()
+		if (newCapacity > bucket_count())
+			_force_rehash(newCapacity);
+	}
+
+	// rehash for at least "size" elements
+	void reserve(const size_t size)
+	{
+		rehash(_min_load_factor_buckets(size));
+	}
+
+	void clear()
+	{
+		if (_data._Capacity == 0)
+			return;
+
+		_destroy_full_slots(_data);
+
+		for (size_t i = 0; i < _data._Capacity; ++i)
+			_data._Ctrl[i] = _CTRL_EMPTY;
+
+		_data._Size			= 0;
+		_data._GrowthLeft	= _max_growth(_data._Capacity);
+	}
+
+	size_t bucket_count() const
+	{
+		return _data._Capacity;
+	}
+
+	size_t size() const
+	{
+		return _data._Size;
+	}
+
+	size_t max_size() const noexcept
+	{
+		return _Alloc_Traits::max_size(_alloc);
+	}
+
+	bool empty() const
+	{
+		return _data._Size == 0;
+	}
+
+	float load_factor() const
+	{
+		if (_data._Capacity == 0)
+			return 0.0F;
+
+		return static_cast<float>(size()) / static_cast<float>(bucket_count());
+	}
+
+	float max_load_factor() const
+	{
+		return _TABLE_LOAD_FACTOR;
+	}
+
+public:
+	// iterator functions
+
+	iterator begin()
+	{
+		iterator it = _make_iter(0);
+		it._skip_empty_slots();
+		return it;
+	}
+
+	const_iterator begin() const
+	{
+		const_iterator it = _make_iter(0);
+		it._skip_empty_slots();
+		return it;
+	}
+
+	iterator end()
+	{
+		return _make_iter(_data._Capacity);
+	}
+
+	const_iterator end() const
+	{
+		return _make_iter(_data._Capacity);
+	}
+
+protected:
+	// Others
+
+	// Force construction with known key and given arguments for object
+	template<class _KeyType, class... Args>
+	pair<iterator, bool> _try_emplace(_KeyType&& key, Args&&... args)
+	{
+		const size_t hashVal	= _hash(key);
+		size_t index			= _find_index(key, hashVal);		// Check key and decide to construct or not
+
+		if (index != _data._Capacity)
+			return {_make_iter(index), false};
+
+		index = _prepare_insert(hashVal);
+		_Alloc_Traits::construct(	_alloc,
+									_data._Slots + index,
+									custom::piecewise_construct,
+									custom::forward_as_tuple(custom::forward<_KeyType>(key)),
+									custom::forward_as_tuple(custom::forward<Args>(args)...));
+		_commit_insert(index, hashVal);
+
+		return {_make_iter(index), true};
+	}
+
+	const mapped_type& _at(const key_type& key) const
+	{
+		size_t index = _find_index(key, _hash(key));
+
+		if (index == _data._Capacity)
+			throw std::out_of_range("Invalid key.");
+
+		return Traits::extract_mapval(_data._Slots[index]);
+	}
+
+	mapped_type& _at(const key_type& key)
+	{
+		size_t index = _find_index(key, _hash(key));
+
+		if (index == _data._Capacity)
+			throw std::out_of_range("Invalid key.");
+
+		return const_cast<mapped_type&>(Traits::extract_mapval(_data._Slots[index]));
+	}
+
+private:
+	// Helpers
+
+	// H1 selects the starting group, H2 is stored in the control byte
+	static size_t _h1(const size_t hashVal) noexcept
+	{
+		return hashVal >> 7;
+	}
+
+	static _Ctrl_Type _h2(const size_t hashVal) noexcept
+	{
+		return static_cast<_Ctrl_Type>(hashVal & 0x7F);
+	}
+
+	// Number of elements that can be held by a table with given capacity
+	static size_t _max_growth(const size_t capacity) noexcept
+	{
+		return capacity - capacity / 8;
+	}
+
+	// Round up to a power of 2 that is a multiple of the group width
+	static size_t _normalize_capacity(const size_t capacity) noexcept
+	{
+		return (capacity <= _Group::WIDTH) ? _Group::WIDTH : custom::bit_ceil(capacity);
+	}
+
+	iterator _make_iter(const size_t index) noexcept
+	{
+		return iterator(_data._Ctrl + index, _data._Slots + index, &_data);
+	}
+
+	const_iterator _make_iter(const size_t index) const noexcept
+	{
+		return const_iterator(_data._Ctrl + index, _data._Slots + index, &_data);
+	}
+
+	// Returns the slot index of key or _Capacity if not found
+	template<class KeyType>
+	size_t _find_index(const KeyType& key, const size_t hashVal) const
+	{
+		if (_data._Size == 0)
+			return _data._Capacity;
+
+		const _Ctrl_Type h2		= _h2(hashVal);
+		const size_t groupMask	= _data._Capacity / _Group::WIDTH - 1;
+		size_t groupIndex		= _h1(hashVal) & groupMask;
+
+		for (size_t step = 1; /*Empty*/; ++step)
+		{
+			const size_t offset = groupIndex * _Group::WIDTH;
+			const _Group group(_data._Ctrl + offset);
+
+			for (_Mask_Type mask = group.match(h2); mask != 0; mask &= mask - 1)
+			{
+				size_t index = offset + static_cast<size_t>(custom::countr_zero(mask));
+				if (_compare(Traits::extract_key(_data._Slots[index]), key))
+					return index;
+			}
+
+			if (group.match_empty() != 0)	// the key would have been placed in this group
+				return _data._Capacity;
+
+			groupIndex = (groupIndex + step) & groupMask;	// triangular probing visits every group
+		}
+	}
+
+	// Returns the first empty or deleted slot on the probe sequence of hashVal
+	size_t _find_insert_index(const size_t hashVal) const noexcept
+	{
+		return _find_insert_index(_data, hashVal);
+	}
+
+	static size_t _find_insert_index(const _Data& data, const size_t hashVal) noexcept
+	{
+		const size_t groupMask	= data._Capacity / _Group::WIDTH - 1;
+		size_t groupIndex		= _h1(hashVal) & groupMask;
+
+		for (size_t step = 1; /*Empty*/; ++step)
+		{
+			const size_t offset		= groupIndex * _Group::WIDTH;
+			const _Mask_Type mask	= _Group(data._Ctrl + offset).match_empty_or_deleted();
+
+			if (mask != 0)
+				return offset + static_cast<size_t>(custom::countr_zero(mask));
+
+			groupIndex = (groupIndex + step) & groupMask;
+		}
+	}
+
+	// Find a free slot for a new key (rehash if needed). The slot is not marked as full.
+	size_t _prepare_insert(const size_t hashVal)
+	{
+		if (_data._Capacity == 0)
+			_force_rehash(_DEFAULT_CAPACITY);
+
+		size_t index = _find_insert_index(hashVal);
+
+		if (_data._GrowthLeft == 0 && _data._Ctrl[index] != _CTRL_DELETED)
+		{
+			_rehash_if_overload();
+			index = _find_insert_index(hashVal);
+		}
+
+		return index;
+	}
+
+	// Mark the slot as full after the value was constructed
+	void _commit_insert(const size_t index, const size_t hashVal) noexcept
+	{
+		if (_data._Ctrl[index] == _CTRL_EMPTY)	// reusing a deleted slot doesn't consume growth
+			--_data._GrowthLeft;
+
+		_data._Ctrl[index] = _h2(hashVal);
+		++_data._Size;
+	}
+
+	void _erase_index(const size_t index)
+	{
+		_Alloc_Traits::destroy(_alloc, _data._Slots + index);
+		--_data._Size;
+
+		// If the group still has an empty slot, no probe sequence went past it
+		// so the slot can become empty again instead of a tombstone.
+		const size_t offset = index & ~(_Group::WIDTH - 1);
+		if (_Group(_data._Ctrl + offset).match_empty() != 0)
+		{
+			_data._Ctrl[index] = _CTRL_EMPTY;
+			++_data._GrowthLeft;
+		}
+		else
+			_data._Ctrl[index] = _CTRL_DELETED;
+	}
+
+	// The new arrays are built aside and replace _data only when every value was moved.
+	// If a hash or a move throws, the values already moved are lost, but _data stays valid:
+	// their old slots are marked deleted as they go.
+	void _force_rehash(const size_t newCapacity)
+	{
+		_Data newData;
+		_allocate_arrays(newData, newCapacity);
+
+		for (size_t i = 0; i < newCapacity; ++i)
+			newData._Ctrl[i] = _CTRL_EMPTY;
+		newData._Ctrl[newCapacity] = _CTRL_SENTINEL;
+
+		try
+		{
+			// move full slots in the new table (all keys are known to be unique)
+			for (size_t i = 0; i < _data._Capacity; ++i)
+				if (_data._Ctrl[i] >= 0)
+				{
+					const size_t hashVal	= _hash(Traits::extract_key(_data._Slots[i]));
+					const size_t index		= _find_insert_index(newData, hashVal);
+
+					_Alloc_Traits::construct(_alloc, newData._Slots + index, custom::move(_data._Slots[i]));
+					newData._Ctrl[index] = _h2(hashVal);
+					++newData._Size;
+
+					_Alloc_Traits::destroy(_alloc, _data._Slots + i);
+					_data._Ctrl[i] = _CTRL_DELETED;
+					--_data._Size;
+				}
+		}
+		catch (...)
+		{
+			_destroy_full_slots(newData);
+			_deallocate_arrays(newData);
+			CUSTOM_RERAISE;
+		}
+
+		newData._GrowthLeft = _max_growth(newCapacity) - newData._Size;
+
+		_deallocate_arrays(_data);
+		_data = newData;
+	}
+
+	// Called when no growth is left. Drop tombstones if there are many, otherwise double the capacity.
+	void _rehash_if_overload()
+	{
+		if (_data._Size < _max_growth(_data._Capacity) / 2)
+			_force_rehash(_data._Capacity);
+		else
+			_force_rehash(2 * _data._Capacity);
+	}
+
+	// returns the minimum number of slots necessary for the elements in table
+	size_t _min_load_factor_buckets(const size_t size) const
+	{
+		return static_cast<size_t>(std::ceil(static_cast<float>(size) / max_load_factor()));
+	}
+
+	void _destroy_full_slots(const _Data& data)
+	{
+		for (size_t i = 0; i < data._Capacity; ++i)
+			if (data._Ctrl[i] >= 0)
+				_Alloc_Traits::destroy(_alloc, data._Slots + i);
+	}
+
+	// Set capacity and allocate both arrays, the control bytes are left uninitialized
+	void _allocate_arrays(_Data& data, const size_t capacity)
+	{
+		data._Ctrl = _allocCtrl.allocate(capacity + 1);
+
+		try
+		{
+			data._Slots = _alloc.allocate(capacity);
+		}
+		catch (...)
+		{
+			_allocCtrl.deallocate(data._Ctrl, capacity + 1);
+			CUSTOM_RERAISE;
+		}
+
+		data._Capacity = capacity;
+	}
+
+	void _deallocate_arrays(const _Data& data)
+	{
+		if (data._Capacity != 0)
+		{
+			_allocCtrl.deallocate(data._Ctrl, data._Capacity + 1);
+			_alloc.deallocate(data._Slots, data._Capacity);
+		}
+	}
+
+	// Control bytes are copied only after every slot was built, _data takes the copy at the end
+	void _copy(const _Flat_Hash_Table& other)
+	{
+		const _Data& otherData = other._data;
+
+		if (otherData._Capacity == 0)
+			return;
+
+		_Data newData;
+		_allocate_arrays(newData, otherData._Capacity);
+
+		size_t i = 0;
+		try
+		{
+			for (/*Empty*/; i < otherData._Capacity; ++i)
+				if (otherData._Ctrl[i] >= 0)
+					_Alloc_Traits::construct(_alloc, newData._Slots + i, otherData._Slots[i]);
+		}
+		catch (...)
+		{
+			while (i-- > 0)		// roll back the slots built so far
+				if (otherData._Ctrl[i] >= 0)
+					_Alloc_Traits::destroy(_alloc, newData._Slots + i);
+
+			_deallocate_arrays(newData);
+			CUSTOM_RERAISE;
+		}
+
+		for (size_t j = 0; j <= otherData._Capacity; ++j)
+			newData._Ctrl[j] = otherData._Ctrl[j];
+
+		newData._Size		= otherData._Size;
+		newData._GrowthLeft	= otherData._GrowthLeft;
+		_data				= newData;
+	}
+
+	void _move(_Flat_Hash_Table&& other) noexcept
+	{
+		_data		= other._data;
+		other._data	= _Data();
+	}
+
+	// Destroy values and deallocate arrays
+	void _clean_up_table()
+	{
+		if (_data._Capacity != 0)
+		{
+			_destroy_full_slots(_data);
+			_deallocate_arrays(_data);
+			_data = _Data();
+		}
+	}
+};	// END _Flat_Hash_Table
+
+// _Flat_Hash_Table binary operators
+template<class Traits>
+bool operator==(const _Flat_Hash_Table<Traits>& left, const _Flat_Hash_Table<Traits>& right)
+{
+	// Contains the same elems, but not the same hashtable
+	if (left.size() != right.size())
+		return false;
+
+	for (const auto& val : right)
+	{
+		auto it = left.find(Traits::extract_key(val));	// Search for key
+		if (it == left.end() || Traits::extract_mapval(*it) != Traits::extract_mapval(val))
+			return false;
+	}
+
+	return true;
+}
+
+template<class Traits>
+bool operator!=(const _Flat_Hash_Table<Traits>& left, const _Flat_Hash_Table<Traits>& right)
+{
+	return !(left == right);
+}
+
+CUSTOM_DETAIL_END
+
+CUSTOM_END
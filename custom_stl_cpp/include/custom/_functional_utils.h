@@ -1,5 +1,11 @@
 #pragma once
 #include "custom/type_traits.h"
+#include <cstdint>      // uint64_t
+#include <cstring>      // memcpy
+
+#if defined _MSC_VER && defined _M_X64
+#include <intrin.h>     // _umul128
+#endif
 
 
 CUSTOM_BEGIN
@@ -16,7 +22,8 @@ CUSTOM_DETAIL_BEGIN
 struct _Invoker_Non_Member_Function
 {
     template<class Callable, class... Args>
-    static constexpr auto invoke_impl(Callable&& func, Args&&... args) noexcept
+    static constexpr auto invoke_impl(Callable&& func, Args&&... args)
+    noexcept(noexcept(static_cast<Callable&&>(func)(static_cast<Args&&>(args)...)))
     -> decltype(static_cast<Callable&&>(func)(static_cast<Args&&>(args)...))
     {
         return static_cast<Callable&&>(func)(static_cast<Args&&>(args)...);
@@ -26,7 +33,8 @@ struct _Invoker_Non_Member_Function
 struct _Invoker_PMF_Object
 {
     template<class Callable, class Type, class... Args>
-    static constexpr auto invoke_impl(Callable&& pmf, Type&& typeObj, Args&&... args) noexcept
+    static constexpr auto invoke_impl(Callable&& pmf, Type&& typeObj, Args&&... args)
+    noexcept(noexcept((static_cast<Type&&>(typeObj).*pmf)(static_cast<Args&&>(args)...)))
     -> decltype((static_cast<Type&&>(typeObj).*pmf)(static_cast<Args&&>(args)...))
     {
         return (static_cast<Type&&>(typeObj).*pmf)(static_cast<Args&&>(args)...);
@@ -36,7 +44,8 @@ struct _Invoker_PMF_Object
 struct _Invoker_PMF_Refwrap
 {
     template<class Callable, class Refwrap, class... Args>
-    static constexpr auto invoke_impl(Callable&& pmf, Refwrap&& rw, Args&&... args) noexcept
+    static constexpr auto invoke_impl(Callable&& pmf, Refwrap&& rw, Args&&... args)
+    noexcept(noexcept((rw.get().*pmf)(static_cast<Args&&>(args)...)))
     -> decltype((rw.get().*pmf)(static_cast<Args&&>(args)...))
     {
         return (rw.get().*pmf)(static_cast<Args&&>(args)...);
@@ -46,7 +55,8 @@ struct _Invoker_PMF_Refwrap
 struct _Invoker_PMF_Pointer
 {
     template<class Callable, class Type, class... Args>
-    static constexpr auto invoke_impl(Callable&& pmf, Type&& typeObj, Args&&... args) noexcept
+    static constexpr auto invoke_impl(Callable&& pmf, Type&& typeObj, Args&&... args)
+    noexcept(noexcept(((*static_cast<Type&&>(typeObj)).*pmf)(static_cast<Args&&>(args)...)))
     -> decltype(((*static_cast<Type&&>(typeObj)).*pmf)(static_cast<Args&&>(args)...))
     {
         return ((*static_cast<Type&&>(typeObj)).*pmf)(static_cast<Args&&>(args)...);
@@ -56,7 +66,8 @@ struct _Invoker_PMF_Pointer
 struct _Invoker_PMD_Object
 {
     template<class Callable, class Type>
-    static constexpr auto invoke_impl(Callable&& pmd, Type&& typeObj) noexcept
+    static constexpr auto invoke_impl(Callable&& pmd, Type&& typeObj)
+    noexcept(noexcept(static_cast<Type&&>(typeObj).*pmd))
     -> decltype(static_cast<Type&&>(typeObj).*pmd)
     {
         return static_cast<Type&&>(typeObj).*pmd;
@@ -66,7 +77,8 @@ struct _Invoker_PMD_Object
 struct _Invoker_PMD_Refwrap
 {
     template<class Callable, class Refwrap>
-    static constexpr auto invoke_impl(Callable&& pmd, Refwrap&& rw) noexcept 
+    static constexpr auto invoke_impl(Callable&& pmd, Refwrap&& rw)
+    noexcept(noexcept(rw.get().*pmd))
     -> decltype(rw.get().*pmd)
     {
         return rw.get().*pmd;
@@ -76,7 +88,8 @@ struct _Invoker_PMD_Refwrap
 struct _Invoker_PMD_Pointer
 {
     template<class Callable, class Type>
-    static constexpr auto invoke_impl(Callable&& pmd, Type&& typeObj) noexcept
+    static constexpr auto invoke_impl(Callable&& pmd, Type&& typeObj)
+    noexcept(noexcept((*static_cast<Type&&>(typeObj)).*pmd))
     -> decltype((*static_cast<Type&&>(typeObj)).*pmd)
     {
         return (*static_cast<Type&&>(typeObj)).*pmd;
@@ -164,13 +177,13 @@ struct _Refwrap_Has_Constructor_From<Ty, Base, void_t<decltype(_Refwrap_Construc
 
 // hash representation helpers
 
-#ifdef _WIN64
+#if SIZE_MAX > UINT32_MAX   // 64-bit size_t
 constexpr size_t _FNVOffsetBasis    = 14695981039346656037ULL;
 constexpr size_t _FNVPrime          = 1099511628211ULL;
 #else
 constexpr size_t _FNVOffsetBasis    = 2166136261U;
 constexpr size_t _FNVPrime          = 16777619U;
-#endif // _WIN64
+#endif // SIZE_MAX > UINT32_MAX
 
 // accumulate range [first, first + count) into partial FNV-1a hash val
 inline size_t _fnv1a_append_bytes(  size_t val,
@@ -210,11 +223,150 @@ size_t _fnv1a_append_value( const size_t val,
     return _fnv1a_append_bytes(val, &reinterpret_cast<const unsigned char&>(key), sizeof(Key));
 }
 
+// wyhash-style 64-bit hash: reads 8 bytes per load and mixes with 64x64->128 bit multiplies
+
+constexpr uint64_t _WyPrime0 = 0x2d358dccaa6c78a5ULL;
+constexpr uint64_t _WyPrime1 = 0x8bb84b93962eacc9ULL;
+constexpr uint64_t _WyPrime2 = 0x4b33a62ed433d4a3ULL;
+constexpr uint64_t _WyPrime3 = 0x4d5a2da51de1aa47ULL;
+
+// multiply a and b, low 64 bits in a, high 64 bits in b
+inline void _wy_multiply(uint64_t& a, uint64_t& b) noexcept
+{
+#if defined __SIZEOF_INT128__
+    __uint128_t result = static_cast<__uint128_t>(a) * b;
+    a = static_cast<uint64_t>(result);
+    b = static_cast<uint64_t>(result >> 64);
+#elif defined _MSC_VER && defined _M_X64
+    a = _umul128(a, b, &b);
+#else
+    const uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+    const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    const uint64_t t = rl + (rm0 << 32);
+    const uint64_t lo = t + (rm1 << 32);
+    const uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + (t < rl) + (lo < t);
+    a = lo;
+    b = hi;
+#endif
+}
+
+inline uint64_t _wy_mix(uint64_t a, uint64_t b) noexcept
+{
+    _wy_multiply(a, b);
+    return a ^ b;
+}
+
+inline uint64_t _wy_read8(const unsigned char* const ptr) noexcept
+{
+    uint64_t val;
+    std::memcpy(&val, ptr, sizeof(val));
+    return val;
+}
+
+inline uint64_t _wy_read4(const unsigned char* const ptr) noexcept
+{
+    uint32_t val;
+    std::memcpy(&val, ptr, sizeof(val));
+    return val;
+}
+
+// hash range [first, first + count) with given seed
+inline uint64_t _wyhash_bytes(  const unsigned char* first,
+                                const size_t count,
+                                uint64_t seed) noexcept
+{
+    uint64_t a = 0;
+    uint64_t b = 0;
+
+    seed ^= _wy_mix(seed ^ _WyPrime0, _WyPrime1);
+
+    if (count <= 16)
+    {
+        if (count >= 4)     // two overlapping 4 byte reads from each end
+        {
+            const size_t shift = (count >> 3) << 2;
+            a = (_wy_read4(first) << 32) | _wy_read4(first + shift);
+            b = (_wy_read4(first + count - 4) << 32) | _wy_read4(first + count - 4 - shift);
+        }
+        else if (count > 0)
+        {
+            a = (static_cast<uint64_t>(first[0]) << 16) | (static_cast<uint64_t>(first[count >> 1]) << 8) | first[count - 1];
+        }
+    }
+    else
+    {
+        size_t remaining = count;
+
+        if (remaining > 48)     // 48 bytes per step in three independent lanes
+        {
+            uint64_t seed1 = seed;
+            uint64_t seed2 = seed;
+
+            do
+            {
+                seed    = _wy_mix(_wy_read8(first) ^ _WyPrime1, _wy_read8(first + 8) ^ seed);
+                seed1   = _wy_mix(_wy_read8(first + 16) ^ _WyPrime2, _wy_read8(first + 24) ^ seed1);
+                seed2   = _wy_mix(_wy_read8(first + 32) ^ _WyPrime3, _wy_read8(first + 40) ^ seed2);
+                first       += 48;
+                remaining   -= 48;
+            } while (remaining > 48);
+
+            seed ^= seed1 ^ seed2;
+        }
+
+        while (remaining > 16)
+        {
+            seed        = _wy_mix(_wy_read8(first) ^ _WyPrime1, _wy_read8(first + 8) ^ seed);
+            first       += 16;
+            remaining   -= 16;
+        }
+
+        a = _wy_read8(first + remaining - 16);     // last 16 bytes (may overlap already mixed ones)
+        b = _wy_read8(first + remaining - 8);
+    }
+
+    a ^= _WyPrime1;
+    b ^= seed;
+    _wy_multiply(a, b);
+
+    return _wy_mix(a ^ _WyPrime0 ^ count, b ^ _WyPrime1);
+}
+
+// hash a single integer value (two 64x64->128 multiply-mixes, full avalanche)
+inline uint64_t _wyhash_integer(const uint64_t val) noexcept
+{
+    uint64_t a = val ^ _WyPrime0;
+    uint64_t b = _WyPrime1;
+    _wy_multiply(a, b);
+
+    return _wy_mix(a ^ _WyPrime0, b ^ _WyPrime1);
+}
+
+// default hash for byte ranges
+inline size_t _hash_bytes(  const unsigned char* const first,
+                            const size_t count) noexcept
+{
+#if CUSTOM_HASH_FNV1A
+    return _fnv1a_append_bytes(_FNVOffsetBasis, first, count);
+#else
+    return static_cast<size_t>(_wyhash_bytes(first, count, 0));
+#endif  // CUSTOM_HASH_FNV1A
+}
+
 // bitwise hashes the representation of a key
 template<class Key>
 size_t _hash_representation(const Key& key) noexcept
 {
-    return _fnv1a_append_value(_FNVOffsetBasis, key);
+    static_assert(is_trivial_v<Key>, "Only trivial types can be directly hashed.");
+
+#if !CUSTOM_HASH_FNV1A
+    if constexpr ((is_integral_v<Key> || is_enum_v<Key>) && sizeof(Key) <= sizeof(uint64_t))
+        return static_cast<size_t>(_wyhash_integer(static_cast<uint64_t>(key)));
+    else if constexpr (is_pointer_v<Key> && sizeof(Key) <= sizeof(uint64_t))
+        return static_cast<size_t>(_wyhash_integer(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(key))));
+    else
+#endif  // !CUSTOM_HASH_FNV1A
+        return _hash_bytes(&reinterpret_cast<const unsigned char&>(key), sizeof(Key));
 }
 
 // bitwise hashes the representation of an array
@@ -224,9 +376,19 @@ size_t _hash_array_representation(  const Key* const first,
 {
     static_assert(is_trivial_v<Key>, "Only trivial types can be directly hashed.");
 
-    return _fnv1a_append_bytes(_FNVOffsetBasis, reinterpret_cast<const unsigned char*>(first), count * sizeof(Key));
+    return _hash_bytes(reinterpret_cast<const unsigned char*>(first), count * sizeof(Key));
 }
 
+// checks for Ty::is_transparent (enables heterogeneous lookup in associative containers)
+template<class Ty, class = void>
+struct _Is_Transparent : false_type {};
+
+template<class Ty>
+struct _Is_Transparent<Ty, void_t<typename Ty::is_transparent>> : true_type {};
+
+template<class Ty>
+constexpr bool _Is_Transparent_v = _Is_Transparent<Ty>::value;
+
 template<class Key, bool Enabled>
 struct _Base_Hash_Enabler  // conditionally enabled hash base
 {
@@ -252,14 +414,16 @@ CUSTOM_DETAIL_END
 
 // invoke
 template<class Callable>
-constexpr auto invoke(Callable&& func) noexcept
+constexpr auto invoke(Callable&& func)
+noexcept(noexcept(detail::_Invoker<Callable>::invoke_impl(static_cast<Callable&&>(func))))
 -> decltype(detail::_Invoker<Callable>::invoke_impl(static_cast<Callable&&>(func)))
 {
     return detail::_Invoker<Callable>::invoke_impl(static_cast<Callable&&>(func));
 }
 
 template<class Callable, class Type, class... Args>
-constexpr auto invoke(Callable&& func, Type&& arg1, Args&&... args) noexcept
+constexpr auto invoke(Callable&& func, Type&& arg1, Args&&... args)
+noexcept(noexcept(detail::_Invoker<Callable, Type>::invoke_impl(static_cast<Callable&&>(func), static_cast<Type&&>(arg1), static_cast<Args&&>(args)...)))
 -> decltype(detail::_Invoker<Callable, Type>::invoke_impl(static_cast<Callable&&>(func), static_cast<Type&&>(arg1), static_cast<Args&&>(args)...))
 {
     return detail::_Invoker<Callable, Type>::invoke_impl(static_cast<Callable&&>(func), static_cast<Type&&>(arg1), static_cast<Args&&>(args)...);
@@ -0,0 +1,84 @@
+#pragma once
+
+#if defined __linux__
+#include "custom/chrono.h"
+
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+
+CUSTOM_BEGIN
+
+CUSTOM_DETAIL_BEGIN
+
+// Thin wrappers over futex(2). Every futex in the library lives in one process, so all of them
+// use the private operations. The kernel compares and sleeps on the 32-bit word behind the atomic.
+using _Futex_Word = std::atomic<uint32_t>;
+
+static_assert(sizeof(_Futex_Word) == sizeof(uint32_t) && _Futex_Word::is_always_lock_free,
+                "futex requires a plain lock-free 32-bit word!");
+
+inline long _futex(const _Futex_Word* address, const int operation, const uint32_t value,
+                    const struct timespec* timeout, const _Futex_Word* address2, const uint32_t value3) noexcept
+{
+    return ::syscall(   SYS_futex, reinterpret_cast<const uint32_t*>(address), operation | FUTEX_PRIVATE_FLAG,
+                        value, timeout, reinterpret_cast<const uint32_t*>(address2), value3);
+}
+
+inline void _futex_wait(const _Futex_Word* address, const uint32_t expected) noexcept
+{
+    // returns when woken, when *address != expected, or spuriously, callers re-check their condition
+    (void)_futex(address, FUTEX_WAIT, expected, nullptr, nullptr, 0);
+}
+
+template<class Rep, class Period>
+bool _futex_wait_for(const _Futex_Word* address, const uint32_t expected,
+                        const custom::chrono::duration<Rep, Period>& relativeTime) noexcept     // false on timeout
+{
+    if (relativeTime <= relativeTime.zero())
+        return false;
+
+    const auto nanoseconds  = custom::chrono::duration_cast<custom::chrono::nanoseconds>(relativeTime).count();
+    const struct timespec timeout   =   {
+                                            static_cast<std::time_t>(nanoseconds / 1000000000),
+                                            static_cast<long>(nanoseconds % 1000000000)
+                                        };
+
+    return !(_futex(address, FUTEX_WAIT, expected, &timeout, nullptr, 0) == -1 && errno == ETIMEDOUT);
+}
+
+inline void _futex_wake(const _Futex_Word* address, const int count) noexcept
+{
+    (void)_futex(address, FUTEX_WAKE, static_cast<uint32_t>(count), nullptr, nullptr, 0);
+}
+
+// Wakes wakeCount waiters on address and moves the rest to target without waking them.
+// Fails, doing nothing, when *address is no longer expected.
+inline bool _futex_requeue(const _Futex_Word* address, const int wakeCount,
+                            const _Futex_Word* target, const uint32_t expected) noexcept
+{
+    // the requeue count travels in the timeout argument
+    const auto requeueCount = reinterpret_cast<const struct timespec*>(static_cast<uintptr_t>(INT_MAX));
+    return _futex(address, FUTEX_CMP_REQUEUE, static_cast<uint32_t>(wakeCount), requeueCount, target, expected) != -1;
+}
+
+inline void _cpu_relax() noexcept     // spin-wait hint, lets the sibling hyperthread run
+{
+#if defined __x86_64__ || defined __i386__
+    __builtin_ia32_pause();
+#elif defined __aarch64__
+    asm volatile("yield");
+#endif
+}
+
+CUSTOM_DETAIL_END
+
+CUSTOM_END
+
+#endif  // __linux__
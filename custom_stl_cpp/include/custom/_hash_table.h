@@ -13,6 +13,8 @@ CUSTOM_DETAIL_BEGIN
 
 // _Hash_Table Template implemented as vector of nodes stored in a list
 // The vector holds pairs for bucket count and the first node in bucket
+// In incremental rehash mode, growing keeps the old bucket vector next to the new one
+// and each insert/find/erase migrates a few old buckets, so no single call re-buckets every node.
 template<class Traits>
 class _Hash_Table
 {
@@ -22,7 +24,8 @@ protected:
 	using _Alloc_Node_Traits	= typename _Iter_List::_Alloc_Node_Traits;
 	using _NodePtr 				= typename _Iter_List::_NodePtr;
 	using _Bucket 				= pair<size_t, _NodePtr>;
-	using _Hash_Vector			= vector<_Bucket>;						// vector of pairs
+	using _Alloc_Bucket			= typename _Alloc_Node_Traits::template rebind_alloc<_Bucket>;
+	using _Hash_Vector			= vector<_Bucket, _Alloc_Bucket>;		// vector of pairs
 
 	using key_type           	= typename Traits::key_type;
     using mapped_type        	= typename Traits::mapped_type;
@@ -45,10 +48,13 @@ protected:
 	key_compare _compare;												// Used for comparison between keys
 	_Iter_List _elems;													// Used to iterate through container
 	_Hash_Vector _buckets;												// Used to map elems from _Iter_List
-	_Alloc_Node _alloc;													// Used to allocate nodes
+	_Hash_Vector _oldBuckets;											// Buckets not yet migrated during incremental rehash
+	size_t _migrateIndex	= 0;										// Next bucket in _oldBuckets to migrate
+	bool _incremental		= false;									// Spread rehash work across operations
 
 	static constexpr float _TABLE_LOAD_FACTOR	= 0.75;					// The maximum load factor admitted before rehashing
 	static constexpr size_t _DEFAULT_BUCKETS	= 8;					// Default number of buckets
+	static constexpr size_t _MIGRATION_STEP		= 4;					// Old buckets migrated per operation (must outpace inserts until next growth)
 
 protected:
     // Constructors
@@ -58,16 +64,53 @@ protected:
 		rehash(_DEFAULT_BUCKETS);
 	}
 
-	_Hash_Table(const size_t noBuckets)
+	explicit _Hash_Table(const allocator_type& alloc)
+		: _elems(alloc), _buckets(alloc), _oldBuckets(alloc)
+	{
+		rehash(_DEFAULT_BUCKETS);
+	}
+
+	_Hash_Table(const size_t noBuckets, const allocator_type& alloc = allocator_type())
+		: _elems(alloc), _buckets(alloc), _oldBuckets(alloc)
 	{
 		rehash((noBuckets < _DEFAULT_BUCKETS) ? _DEFAULT_BUCKETS : noBuckets);
 	}
 
 	_Hash_Table(const _Hash_Table& other)
-		: _elems(other._elems), _buckets(other._buckets) { /*Empty*/ }
+		:	_elems(other._elems),
+			_buckets(_elems.get_allocator()),
+			_oldBuckets(_elems.get_allocator()),
+			_incremental(other._incremental)
+	{
+		_force_rehash(other.bucket_count());	// buckets must point to the copied nodes
+	}
+
+	_Hash_Table(const _Hash_Table& other, const allocator_type& alloc)
+		: _elems(other._elems, alloc), _buckets(alloc), _oldBuckets(alloc), _incremental(other._incremental)
+	{
+		_force_rehash(other.bucket_count());
+	}
 
 	_Hash_Table(_Hash_Table&& other) noexcept
-		: _elems(custom::move(other._elems)), _buckets(custom::move(other._buckets)) { /*Empty*/ }
+		:	_elems(custom::move(other._elems)),
+			_buckets(custom::move(other._buckets)),
+			_oldBuckets(custom::move(other._oldBuckets)),
+			_migrateIndex(custom::exchange(other._migrateIndex, 0)),
+			_incremental(other._incremental) { /*Empty*/ }
+
+	_Hash_Table(_Hash_Table&& other, const allocator_type& alloc)
+		: _elems(alloc), _buckets(alloc), _oldBuckets(alloc), _incremental(other._incremental)
+	{
+		if (_elems._alloc == other._elems._alloc)
+		{
+			_elems 			= custom::move(other._elems);
+			_buckets 		= custom::move(other._buckets);
+			_oldBuckets		= custom::move(other._oldBuckets);
+			_migrateIndex	= custom::exchange(other._migrateIndex, 0);
+		}
+		else
+			_move_elements(other);
+	}
 
 	virtual ~_Hash_Table() = default;
 
@@ -78,19 +121,36 @@ protected:
 	{
 		if (_elems._data._Head != other._elems._data._Head)
 		{
-			_elems 		= other._elems;
-			_buckets 	= other._buckets;
+			_end_migration();
+			_elems 			= other._elems;
+			_incremental	= other._incremental;
+			_force_rehash(other.bucket_count());	// buckets must point to the copied nodes
 		}
 
 		return *this;
 	}
 
-	_Hash_Table& operator=(_Hash_Table&& other) noexcept
+	_Hash_Table& operator=(_Hash_Table&& other)
+		noexcept(	_Alloc_Node_Traits::propagate_on_container_move_assignment::value ||
+					_Alloc_Node_Traits::is_always_equal::value)
 	{
 		if (_elems._data._Head != other._elems._data._Head)
 		{
-			_elems 		= custom::move(other._elems);
-			_buckets 	= custom::move(other._buckets);
+			_incremental = other._incremental;
+
+			if (_Alloc_Node_Traits::propagate_on_container_move_assignment::value ||
+				_elems._alloc == other._elems._alloc)
+			{
+				_elems 			= custom::move(other._elems);
+				_buckets 		= custom::move(other._buckets);
+				_oldBuckets		= custom::move(other._oldBuckets);
+				_migrateIndex	= custom::exchange(other._migrateIndex, 0);
+			}
+			else
+			{
+				_end_migration();
+				_move_elements(other);
+			}
 		}
 
 		return *this;
@@ -102,20 +162,21 @@ public:
     template<class... Args>
 	iterator emplace(Args&&... args)
 	{
-		_NodePtr newNode 		= _alloc.allocate(1);
-		_Alloc_Node_Traits::construct(_alloc, &(newNode->_Value), custom::forward<Args>(args)...);
+		_NodePtr newNode 		= _elems._alloc.allocate(1);
+		_Alloc_Node_Traits::construct(_elems._alloc, &(newNode->_Value), custom::forward<Args>(args)...);
 		const key_type& newKey 	= Traits::extract_key(newNode->_Value);
 		iterator it 			= find(newKey);
 
 		if (it != end())	// Destroy newly-created Node if key exists
 		{
-			_Alloc_Node_Traits::destroy(_alloc, &(newNode->_Value));
-			_alloc.deallocate(newNode, 1);
+			_Alloc_Node_Traits::destroy(_elems._alloc, &(newNode->_Value));
+			_elems._alloc.deallocate(newNode, 1);
 			return it;
 		}
 		else
 		{
 			_rehash_if_overload();
+			_migrate_key_bucket(newKey);
 			_map_and_link_node(bucket(newKey), newNode);
 
 			return iterator(newNode, &_elems._data);
@@ -124,6 +185,7 @@ public:
 
 	iterator erase(const key_type& key)
 	{
+		_migrate_key_bucket(key);
 		iterator it = find(key);
 
 		if (it == end())
@@ -162,6 +224,7 @@ public:
 
 	iterator find(const key_type& key)
 	{
+		_migrate_step();
 		return iterator(_find(key), &_elems._data);
 	}
 
@@ -175,9 +238,75 @@ public:
 		return find(key) != end();
 	}
 
-	// rebuild table with at least noBuckets
+	size_t count(const key_type& key) const
+	{
+		return contains(key) ? 1 : 0;
+	}
+
+	pair<iterator, iterator> equal_range(const key_type& key)
+	{
+		iterator first = find(key);
+		return {first, (first == end()) ? first : custom::next(first)};
+	}
+
+	pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+	{
+		const_iterator first = find(key);
+		return {first, (first == end()) ? first : custom::next(first)};
+	}
+
+	// Heterogeneous lookup: enabled only when both hasher and key_compare are transparent,
+	// so a key convertible to key_type (ex: string_view for string) is hashed without building a key_type
+	template<class KeyType, class Hash = hasher, class Compare = key_compare,
+	enable_if_t<_Is_Transparent_v<Hash> && _Is_Transparent_v<Compare>, bool> = true>
+	iterator find(const KeyType& key)
+	{
+		_migrate_step();
+		return iterator(_find(key), &_elems._data);
+	}
+
+	template<class KeyType, class Hash = hasher, class Compare = key_compare,
+	enable_if_t<_Is_Transparent_v<Hash> && _Is_Transparent_v<Compare>, bool> = true>
+	const_iterator find(const KeyType& key) const
+	{
+		return const_iterator(_find(key), &_elems._data);
+	}
+
+	template<class KeyType, class Hash = hasher, class Compare = key_compare,
+	enable_if_t<_Is_Transparent_v<Hash> && _Is_Transparent_v<Compare>, bool> = true>
+	bool contains(const KeyType& key) const
+	{
+		return _find(key) != _elems._data._Head;
+	}
+
+	template<class KeyType, class Hash = hasher, class Compare = key_compare,
+	enable_if_t<_Is_Transparent_v<Hash> && _Is_Transparent_v<Compare>, bool> = true>
+	size_t count(const KeyType& key) const
+	{
+		return contains(key) ? 1 : 0;
+	}
+
+	template<class KeyType, class Hash = hasher, class Compare = key_compare,
+	enable_if_t<_Is_Transparent_v<Hash> && _Is_Transparent_v<Compare>, bool> = true>
+	pair<iterator, iterator> equal_range(const KeyType& key)
+	{
+		iterator first = find(key);
+		return {first, (first == end()) ? first : custom::next(first)};
+	}
+
+	template<class KeyType, class Hash = hasher, class Compare = key_compare,
+	enable_if_t<_Is_Transparent_v<Hash> && _Is_Transparent_v<Compare>, bool> = true>
+	pair<const_iterator, const_iterator> equal_range(const KeyType& key) const
+	{
+		const_iterator first = find(key);
+		return {first, (first == end()) ? first : custom::next(first)};
+	}
+
+	// rebuild table with at least noBuckets (an explicit rehash is never incremental)
 	void rehash(const size_t noBuckets)
 	{
+		_finish_migration();
+
 		size_t newBucketCount = (custom::max)(_min_load_factor_buckets(size()), noBuckets);	// don't violate bucket_count() >= size() / max_load_factor()
 		if (newBucketCount > bucket_count())
 			_force_rehash(newBucketCount);
@@ -191,6 +320,7 @@ public:
 
 	void clear()
 	{
+		_end_migration();
 		_elems.clear();						// Delete all Node* with values
 
 		for (auto& val : _buckets)			// Update _buckets to empty
@@ -207,7 +337,23 @@ public:
 
 	size_t bucket_size(const size_t index) const
 	{
-		return _buckets[index].first;
+		if (!_is_migrating())
+			return _buckets[index].first;
+
+		// Incremental growth always doubles, so new bucket "index" is fed by a single old bucket
+		size_t count 				= _buckets[index].first;
+		const _Bucket& oldBucket	= _oldBuckets[index % _oldBuckets.size()];
+		_NodePtr currentNode		= oldBucket.second;
+
+		for (size_t remainingNodes = oldBucket.first; remainingNodes > 0; --remainingNodes)
+		{
+			if (bucket(Traits::extract_key(currentNode->_Value)) == index)
+				++count;
+
+			currentNode = currentNode->_Next;
+		}
+
+		return count;
 	}
 
 	size_t bucket(const key_type& key) const
@@ -220,6 +366,11 @@ public:
 		return _elems.size();
 	}
 
+	allocator_type get_allocator() const noexcept
+	{
+		return _elems.get_allocator();
+	}
+
 	size_t max_size() const noexcept
 	{
 		return _elems.max_size();
@@ -240,9 +391,25 @@ public:
 		return _TABLE_LOAD_FACTOR;
 	}
 
+	// Enable/disable amortized growth. Disabling completes a pending migration.
+	void incremental_rehash(const bool enable)
+	{
+		_incremental = enable;
+
+		if (!_incremental)
+			_finish_migration();
+	}
+
+	bool incremental_rehash() const noexcept
+	{
+		return _incremental;
+	}
+
 	// For Debugging
 	void print_details() 
 	{
+		_finish_migration();
+
 		std::cout << "Capacity= " << _buckets.size() << ' ' << "Size= " << _elems.size() << '\n';
 
 		for (size_t i = 0; i < _buckets.size(); ++i)
@@ -295,9 +462,9 @@ protected:
 			return {it, false};
 		else
 		{
-			_NodePtr newNode = _alloc.allocate(1);
+			_NodePtr newNode = _elems._alloc.allocate(1);
 			_Alloc_Node_Traits::construct(
-										_alloc,
+										_elems._alloc,
 										&(newNode->_Value),
 										custom::piecewise_construct,
 										custom::forward_as_tuple(custom::forward<_KeyType>(key)),
@@ -306,6 +473,7 @@ protected:
 			const key_type& newKey = Traits::extract_key(newNode->_Value);
 
 			_rehash_if_overload();
+			_migrate_key_bucket(newKey);
 			_map_and_link_node(bucket(newKey), newNode);
 
 			return {iterator(newNode, &_elems._data), true};
@@ -335,9 +503,13 @@ protected:
 private:
 	// Helpers
 
-	_NodePtr _find(const key_type& key) const
+	template<class KeyType>
+	_NodePtr _find(const KeyType& key) const
 	{
-		const _Bucket& currentBucket 	= _buckets[bucket(key)];
+		// A non-empty old bucket still holds every key that maps to it
+		const size_t hashVal			= _hash(key);
+		const _Bucket* oldBucket 		= _is_migrating() ? &_oldBuckets[hashVal % _oldBuckets.size()] : nullptr;
+		const _Bucket& currentBucket 	= (oldBucket != nullptr && oldBucket->first != 0) ? *oldBucket : _buckets[hashVal % bucket_count()];
 		size_t remainingNodes			= currentBucket.first;
 		_NodePtr currentNode			= currentBucket.second;
 
@@ -400,7 +572,101 @@ private:
 	void _rehash_if_overload()
 	{
 		if (static_cast<float>(size() + 1) / static_cast<float>(bucket_count()) > max_load_factor())
-			_force_rehash(2 * bucket_count());
+		{
+			_finish_migration();
+
+			if (_incremental)
+				_begin_migration(2 * bucket_count());
+			else
+				_force_rehash(2 * bucket_count());
+		}
+	}
+
+	bool _is_migrating() const noexcept
+	{
+		return _migrateIndex < _oldBuckets.size();
+	}
+
+	// Keep the old buckets for lookup and start filling new empty ones
+	void _begin_migration(const size_t noBuckets)
+	{
+		_oldBuckets		= custom::move(_buckets);
+		_buckets		= _Hash_Vector(noBuckets, _oldBuckets.get_allocator());
+		_migrateIndex	= 0;
+	}
+
+	// Relink all nodes of an old bucket in the new buckets
+	void _migrate_bucket(const size_t oldIndex)
+	{
+		_Bucket& oldBucket		= _oldBuckets[oldIndex];
+		_NodePtr currentNode	= oldBucket.second;
+
+		for (size_t remainingNodes = oldBucket.first; remainingNodes > 0; --remainingNodes)
+		{
+			_NodePtr nextNode	= currentNode->_Next;
+			size_t index		= bucket(Traits::extract_key(currentNode->_Value));
+
+			if (_buckets[index].first != 0)	// relink node before the first one in bucket (if empty, leave it in place)
+			{
+				_elems._unlink_node(currentNode);
+				_elems._link_node_before(_buckets[index].second, currentNode);
+			}
+
+			++_buckets[index].first;
+			_buckets[index].second = currentNode;
+
+			currentNode = nextNode;
+		}
+
+		oldBucket.first		= 0;
+		oldBucket.second	= nullptr;
+	}
+
+	// Migrate a bounded number of old buckets
+	void _migrate_step()
+	{
+		for (size_t i = 0; i < _MIGRATION_STEP && _is_migrating(); ++i)
+			_migrate_bucket(_migrateIndex++);
+
+		if (!_is_migrating())
+			_end_migration();
+	}
+
+	// Make sure the key's old bucket is migrated before the new buckets are modified for this key
+	void _migrate_key_bucket(const key_type& key)
+	{
+		if (_is_migrating())
+			_migrate_bucket(_hash(key) % _oldBuckets.size());
+
+		_migrate_step();
+	}
+
+	void _finish_migration()
+	{
+		while (_is_migrating())
+			_migrate_bucket(_migrateIndex++);
+
+		_end_migration();
+	}
+
+	// Release the old buckets (all of them must be empty or discarded)
+	void _end_migration()
+	{
+		if (_oldBuckets.capacity() != 0)
+		{
+			_oldBuckets		= _Hash_Vector(0, _oldBuckets.get_allocator());
+			_migrateIndex	= 0;
+		}
+	}
+
+	// Nodes can't change owner when allocators differ, move element by element
+	void _move_elements(_Hash_Table& other)
+	{
+		const size_t noBuckets = other.bucket_count();
+
+		_elems = custom::move(other._elems);	// the list moves the values and empties other
+		other.clear();
+		_force_rehash(noBuckets);				// buckets must point to the new nodes
 	}
 
 	// returns the minimum number of buckets necessary for the elements in list
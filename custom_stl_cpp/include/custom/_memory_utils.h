@@ -4,6 +4,8 @@
 #include "custom/pair.h"
 #include "custom/iterator.h"
 
+#include <cstring>      // memcpy, memmove
+
 
 CUSTOM_BEGIN
 
@@ -614,6 +616,18 @@ public:
 	}
 }; // END Allocator
 
+template<class Type1, class Type2>
+constexpr bool operator==(const allocator<Type1>&, const allocator<Type2>&) noexcept
+{
+	return true;	// stateless, memory from one can be freed by any other
+}
+
+template<class Type1, class Type2>
+constexpr bool operator!=(const allocator<Type1>& left, const allocator<Type2>& right) noexcept
+{
+	return !(left == right);
+}
+
 template<class Alloc>
 struct allocator_traits						// allocator_traits any
 {
@@ -743,6 +757,62 @@ struct allocator_traits<allocator<Type>>		// allocator_traits default
 #pragma endregion Allocator
 
 
+#pragma region Relocation
+
+CUSTOM_DETAIL_BEGIN
+
+// The allocator doesn't observe construction and destruction, so byte copies can replace them
+template<class Alloc, class Type>
+constexpr bool _Uses_Default_Construct_Destroy_v =  !_Has_Construct_Member_Function<Alloc, Type>::value &&
+                                                    !_Has_Destroy_Member_Function<Alloc, Type>::value;
+
+// Objects can change address with a plain byte copy
+template<class Alloc, class Type = typename allocator_traits<Alloc>::value_type>
+constexpr bool _Is_Bitwise_Relocatable_v = is_trivially_relocatable_v<Type> && _Uses_Default_Construct_Destroy_v<Alloc, Type>;
+
+// Objects can be copied with a plain byte copy
+template<class Alloc, class Type = typename allocator_traits<Alloc>::value_type>
+constexpr bool _Is_Bitwise_Copyable_v = is_trivially_copyable_v<Type> && _Uses_Default_Construct_Destroy_v<Alloc, Type>;
+
+// Move count objects from first into uninitialized dest and end their lifetime in the source.
+// The ranges must not overlap. If a move throws, dest is left empty and the source untouched.
+template<class Alloc, class Type>
+constexpr void _uninitialized_relocate_n(Alloc& al, Type* first, const size_t count, Type* dest)
+{
+    using _Alloc_Traits = allocator_traits<Alloc>;
+
+    if constexpr (_Is_Bitwise_Relocatable_v<Alloc, Type>)
+        if (!is_constant_evaluated())
+        {
+            if (count > 0)
+                ::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), count * sizeof(Type));
+
+            return;
+        }
+
+    size_t constructed = 0;
+    try
+    {
+        for (/*Empty*/; constructed < count; ++constructed)
+            _Alloc_Traits::construct(al, dest + constructed, custom::move(first[constructed]));
+    }
+    catch (...)
+    {
+        for (size_t i = 0; i < constructed; ++i)
+            _Alloc_Traits::destroy(al, dest + i);
+
+        CUSTOM_RERAISE;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+        _Alloc_Traits::destroy(al, first + i);
+}
+
+CUSTOM_DETAIL_END
+
+#pragma endregion Relocation
+
+
 #pragma region Deleters
 
 template<class Type>
@@ -278,22 +278,46 @@ protected:
 		_create_head();
 	}
 
-	_Search_Tree(std::initializer_list<value_type> list) : _Search_Tree()
+	explicit _Search_Tree(const allocator_type& alloc)
+		: _alloc(alloc)
+	{
+		_create_head();
+	}
+
+	_Search_Tree(std::initializer_list<value_type> list, const allocator_type& alloc = allocator_type())
+		: _Search_Tree(alloc)
 	{
 		for (const auto& val : list)
 			emplace(val);
 	}
 
-	_Search_Tree(const _Search_Tree& other) : _Search_Tree()
+	_Search_Tree(const _Search_Tree& other)
+		: _Search_Tree(_Alloc_Node_Traits::select_on_container_copy_construction(other._alloc))
+	{
+		_copy(other);
+	}
+
+	_Search_Tree(const _Search_Tree& other, const allocator_type& alloc)
+		: _Search_Tree(alloc)
 	{
 		_copy(other);
 	}
 
-	_Search_Tree(_Search_Tree&& other) noexcept : _Search_Tree()
+	_Search_Tree(_Search_Tree&& other) noexcept
+		: _Search_Tree(other._alloc)
 	{
 		_move(custom::move(other));
 	}
 
+	_Search_Tree(_Search_Tree&& other, const allocator_type& alloc)
+		: _Search_Tree(alloc)
+	{
+		if (_alloc == other._alloc)
+			_move(custom::move(other));
+		else
+			_move_elements(other);
+	}
+
 	virtual ~_Search_Tree()
 	{
 		_destroy_all(_data._Head->_Parent);
@@ -308,18 +332,38 @@ protected:
 		if (_data._Head != other._data._Head)
 		{
 			clear();
+
+			if constexpr (_Alloc_Node_Traits::propagate_on_container_copy_assignment::value)
+				if (!(_alloc == other._alloc))		// the head belongs to the old allocator
+				{
+					_free_head();
+					_alloc = other._alloc;
+					_create_head();
+				}
+
 			_copy(other);
 		}
 
 		return *this;
 	}
 
-	_Search_Tree& operator=(_Search_Tree&& other) noexcept
+	_Search_Tree& operator=(_Search_Tree&& other)
+		noexcept(	_Alloc_Node_Traits::propagate_on_container_move_assignment::value ||
+					_Alloc_Node_Traits::is_always_equal::value)
 	{
 		if (_data._Head != other._data._Head)
 		{
 			clear();
-			_move(custom::move(other));
+
+			if constexpr (_Alloc_Node_Traits::propagate_on_container_move_assignment::value)
+			{
+				custom::swap(_alloc, other._alloc);		// heads are exchanged, so are their allocators
+				_move(custom::move(other));
+			}
+			else if (_alloc == other._alloc)
+				_move(custom::move(other));
+			else
+				_move_elements(other);					// nodes can't change owner, move element by element
 		}
 
 		return *this;
@@ -378,7 +422,7 @@ public:
 		return erase(Traits::extract_key(where._Ptr->_Value));
 	}
 
-	const_iterator find (const key_type& key) const
+	const_iterator find(const key_type& key) const
 	{
 		return const_iterator(_find_in_tree(key), &_data);
 	}
@@ -388,6 +432,108 @@ public:
 		return iterator(_find_in_tree(key), &_data);
 	}
 
+	bool contains(const key_type& key) const
+	{
+		return _find_in_tree(key) != _data._Head;
+	}
+
+	size_t count(const key_type& key) const
+	{
+		return contains(key) ? 1 : 0;
+	}
+
+	const_iterator lower_bound(const key_type& key) const
+	{
+		return const_iterator(_lower_bound_node(key), &_data);
+	}
+
+	iterator lower_bound(const key_type& key)
+	{
+		return iterator(_lower_bound_node(key), &_data);
+	}
+
+	const_iterator upper_bound(const key_type& key) const
+	{
+		return const_iterator(_upper_bound_node(key), &_data);
+	}
+
+	iterator upper_bound(const key_type& key)
+	{
+		return iterator(_upper_bound_node(key), &_data);
+	}
+
+	pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+	{
+		return {lower_bound(key), upper_bound(key)};
+	}
+
+	pair<iterator, iterator> equal_range(const key_type& key)
+	{
+		return {lower_bound(key), upper_bound(key)};
+	}
+
+	// Heterogeneous lookup: enabled only when key_compare is transparent (ex: less<>)
+	template<class KeyType, class Compare = key_compare, enable_if_t<_Is_Transparent_v<Compare>, bool> = true>
+	const_iterator find(const KeyType& key) const
+	{
+		return const_iterator(_find_in_tree(key), &_data);
+	}
+
+	template<class KeyType, class Compare = key_compare, enable_if_t<_Is_Transparent_v<Compare>, bool> = true>
+	iterator find(const KeyType& key)
+	{
+		return iterator(_find_in_tree(key), &_data);
+	}
+
+	template<class KeyType, class Compare = key_compare, enable_if_t<_Is_Transparent_v<Compare>, bool> = true>
+	bool contains(const KeyType& key) const
+	{
+		return _find_in_tree(key) != _data._Head;
+	}
+
+	template<class KeyType, class Compare = key_compare, enable_if_t<_Is_Transparent_v<Compare>, bool> = true>
+	size_t count(const KeyType& key) const		// a transparent key may be equivalent to several elements
+	{
+		const auto range = equal_range(key);
+		return static_cast<size_t>(custom::distance(range.first, range.second));
+	}
+
+	template<class KeyType, class Compare = key_compare, enable_if_t<_Is_Transparent_v<Compare>, bool> = true>
+	const_iterator lower_bound(const KeyType& key) const
+	{
+		return const_iterator(_lower_bound_node(key), &_data);
+	}
+
+	template<class KeyType, class Compare = key_compare, enable_if_t<_Is_Transparent_v<Compare>, bool> = true>
+	iterator lower_bound(const KeyType& key)
+	{
+		return iterator(_lower_bound_node(key), &_data);
+	}
+
+	template<class KeyType, class Compare = key_compare, enable_if_t<_Is_Transparent_v<Compare>, bool> = true>
+	const_iterator upper_bound(const KeyType& key) const
+	{
+		return const_iterator(_upper_bound_node(key), &_data);
+	}
+
+	template<class KeyType, class Compare = key_compare, enable_if_t<_Is_Transparent_v<Compare>, bool> = true>
+	iterator upper_bound(const KeyType& key)
+	{
+		return iterator(_upper_bound_node(key), &_data);
+	}
+
+	template<class KeyType, class Compare = key_compare, enable_if_t<_Is_Transparent_v<Compare>, bool> = true>
+	pair<const_iterator, const_iterator> equal_range(const KeyType& key) const
+	{
+		return {lower_bound(key), upper_bound(key)};
+	}
+
+	template<class KeyType, class Compare = key_compare, enable_if_t<_Is_Transparent_v<Compare>, bool> = true>
+	pair<iterator, iterator> equal_range(const KeyType& key)
+	{
+		return {lower_bound(key), upper_bound(key)};
+	}
+
 	size_t size() const noexcept
 	{
 		return _data._Size;
@@ -404,6 +550,11 @@ public:
 		return _data._Size == 0;
 	}
 
+	allocator_type get_allocator() const noexcept
+	{
+		return static_cast<allocator_type>(_alloc);
+	}
+
 	void clear()
 	{
 		_destroy_all(_data._Head->_Parent);
@@ -608,19 +759,37 @@ private:
 		return node;
 	}
 
-	_NodePtr _find_in_tree(const key_type& key) const
+	template<class KeyType>
+	_NodePtr _lower_bound_node(const KeyType& key) const
 	{
 		_NodePtr found = _data._Head;
 
 		for (_NodePtr iterNode = _data._Head->_Parent; !iterNode->_IsNil; )
 		{
-			if (key == Traits::extract_key(iterNode->_Value))
+			if (_less(Traits::extract_key(iterNode->_Value), key))
+				iterNode = iterNode->_Right;
+			else
 			{
-				found = iterNode;
-				iterNode = _data._Head;
+				found = iterNode;	// candidate, keep searching left
+				iterNode = iterNode->_Left;
 			}
-			else if (_less(key, Traits::extract_key(iterNode->_Value)))
+		}
+
+		return found;
+	}
+
+	template<class KeyType>
+	_NodePtr _upper_bound_node(const KeyType& key) const
+	{
+		_NodePtr found = _data._Head;
+
+		for (_NodePtr iterNode = _data._Head->_Parent; !iterNode->_IsNil; )
+		{
+			if (_less(key, Traits::extract_key(iterNode->_Value)))
+			{
+				found = iterNode;	// candidate, keep searching left
 				iterNode = iterNode->_Left;
+			}
 			else
 				iterNode = iterNode->_Right;
 		}
@@ -628,6 +797,17 @@ private:
 		return found;
 	}
 
+	template<class KeyType>
+	_NodePtr _find_in_tree(const KeyType& key) const
+	{
+		_NodePtr found = _lower_bound_node(key);
+
+		if (found != _data._Head && _less(key, Traits::extract_key(found->_Value)))
+			return _data._Head;	// not found
+
+		return found;
+	}
+
 	_Tree_Node_ID<_NodePtr> _find_insertion_slot(_NodePtr newNode) const	// Find parent for newly created node
 	{
 		_Tree_Node_ID<_NodePtr> position;
@@ -960,6 +1140,14 @@ private:
 		custom::swap(_data._Head, other._data._Head);
 		_data._Size = custom::exchange(other._data._Size, 0);
 	}
+
+	void _move_elements(_Search_Tree& other)
+	{
+		for (auto it = other.begin(); it != other.end(); ++it)
+			emplace(custom::move(*it));
+
+		other.clear();
+	}
 }; // END _Search_Tree Template
 
 
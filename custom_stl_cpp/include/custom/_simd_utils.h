@@ -0,0 +1,514 @@
+#pragma once
+#include "custom/type_traits.h"
+#include "custom/bit.h"		// countr_zero, countl_zero
+#include <cstdint>			// uintptr_t
+#include <cstring>			// memcmp
+
+#if CUSTOM_SIMD_ENABLED && (defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2))
+#if defined _MSC_VER
+#include <intrin.h>			// __cpuid, _xgetbv
+#endif
+#include <immintrin.h>
+#define CUSTOM_SIMD_X86		// SSE2 is always available, AVX2 is selected at runtime
+#endif
+
+#if defined __GNUG__
+#define CUSTOM_TARGET_AVX2			__attribute__((target("avx2")))
+#define CUSTOM_NO_SANITIZE_MEMORY	__attribute__((no_sanitize("address", "thread")))
+#else
+#define CUSTOM_TARGET_AVX2			// MSVC accepts AVX2 intrinsics without target flags
+#define CUSTOM_NO_SANITIZE_MEMORY
+#endif
+
+
+CUSTOM_BEGIN
+
+CUSTOM_DETAIL_BEGIN
+
+// Character kernels used by char_traits and the string search helpers.
+// Each _vectorized_* function picks AVX2 or SSE2 at runtime and falls back to a scalar loop
+// for other targets and for character types that are not 1, 2 or 4 byte integers.
+
+template<class CharT>
+constexpr bool _Is_Simd_Char_v = is_integral_v<CharT> && (sizeof(CharT) == 1 || sizeof(CharT) == 2 || sizeof(CharT) == 4);
+
+#ifdef CUSTOM_SIMD_X86
+
+inline bool _cpu_has_avx2() noexcept
+{
+#if defined __GNUG__
+	static const bool hasAvx2 = (__builtin_cpu_init(), __builtin_cpu_supports("avx2") != 0);
+#elif defined _MSC_VER
+	static const bool hasAvx2 = []
+	{
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+
+		__cpuid(info, 1);
+		if ((info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 0x6) != 0x6)	// OS saves the YMM registers
+			return false;
+
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+	}();
+#endif
+
+	return hasAvx2;
+}
+
+// Keeps only the lowest mask bit of each lane (movemask yields sizeof(CharT) bits per lane)
+template<class CharT>
+constexpr uint32_t _lane_bits() noexcept
+{
+	if constexpr (sizeof(CharT) == 1)
+		return 0xFFFFFFFFu;
+	else if constexpr (sizeof(CharT) == 2)
+		return 0x55555555u;
+	else
+		return 0x11111111u;
+}
+
+#pragma region SSE2
+template<class CharT>
+inline __m128i _sse2_broadcast(const CharT ch) noexcept
+{
+	if constexpr (sizeof(CharT) == 1)
+		return _mm_set1_epi8(static_cast<char>(ch));
+	else if constexpr (sizeof(CharT) == 2)
+		return _mm_set1_epi16(static_cast<short>(ch));
+	else
+		return _mm_set1_epi32(static_cast<int>(ch));
+}
+
+template<class CharT>
+inline uint32_t _sse2_match(const __m128i left, const __m128i right) noexcept
+{
+	if constexpr (sizeof(CharT) == 1)
+		return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(left, right)));
+	else if constexpr (sizeof(CharT) == 2)
+		return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi16(left, right)));
+	else
+		return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi32(left, right)));
+}
+
+template<class CharT>
+inline __m128i _sse2_load(const CharT* ptr) noexcept
+{
+	return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+}
+
+// Aligned loads never cross a page, so reading past the terminator (or before cstr) cannot fault
+template<class CharT>
+CUSTOM_NO_SANITIZE_MEMORY inline size_t _sse2_length(const CharT* cstr) noexcept
+{
+	const uintptr_t address	= reinterpret_cast<uintptr_t>(cstr);
+	const char* block		= reinterpret_cast<const char*>(address & ~uintptr_t{15});
+	const __m128i zero		= _mm_setzero_si128();
+
+	uint32_t mask = _sse2_match<CharT>(_mm_load_si128(reinterpret_cast<const __m128i*>(block)), zero) & (~0u << (address & 15));
+	while (mask == 0)
+	{
+		block += 16;
+		mask = _sse2_match<CharT>(_mm_load_si128(reinterpret_cast<const __m128i*>(block)), zero);
+	}
+
+	return static_cast<size_t>(block + custom::countr_zero(mask) - reinterpret_cast<const char*>(cstr)) / sizeof(CharT);
+}
+
+template<class CharT>
+inline const CharT* _sse2_find(const CharT* first, size_t count, const CharT ch) noexcept
+{
+	constexpr size_t step	= 16 / sizeof(CharT);
+	const __m128i target	= _sse2_broadcast(ch);
+
+	for (/*Empty*/; count >= step; count -= step, first += step)
+		if (uint32_t mask = _sse2_match<CharT>(_sse2_load(first), target); mask != 0)
+			return first + custom::countr_zero(mask) / sizeof(CharT);
+
+	for (/*Empty*/; count > 0; --count, ++first)
+		if (*first == ch)
+			return first;
+
+	return nullptr;
+}
+
+template<class CharT>
+inline size_t _sse2_mismatch(const CharT* first1, const CharT* first2, const size_t count) noexcept
+{
+	constexpr size_t step = 16 / sizeof(CharT);
+	size_t index = 0;
+
+	for (/*Empty*/; index + step <= count; index += step)
+		if (uint32_t mask = ~_sse2_match<CharT>(_sse2_load(first1 + index), _sse2_load(first2 + index)) & 0xFFFFu; mask != 0)
+			return index + custom::countr_zero(mask) / sizeof(CharT);
+
+	for (/*Empty*/; index < count && first1[index] == first2[index]; ++index) { /*do nothing*/ }
+
+	return index;
+}
+
+template<class CharT>
+inline size_t _sse2_find_first_of(const CharT* first, const size_t count, const CharT* set, const size_t setCount) noexcept
+{
+	constexpr size_t step = 16 / sizeof(CharT);
+	size_t index = 0;
+
+	for (/*Empty*/; index + step <= count; index += step)
+	{
+		const __m128i block = _sse2_load(first + index);
+		uint32_t mask = 0;
+		for (size_t i = 0; i < setCount; ++i)
+			mask |= _sse2_match<CharT>(block, _sse2_broadcast(set[i]));
+
+		if (mask != 0)
+			return index + custom::countr_zero(mask) / sizeof(CharT);
+	}
+
+	for (/*Empty*/; index < count; ++index)
+		for (size_t i = 0; i < setCount; ++i)
+			if (first[index] == set[i])
+				return index;
+
+	return count;
+}
+
+// Compares the first and last needle chars at step positions at once,
+// only the candidates that match both are checked with memcmp
+template<class CharT>
+inline size_t _sse2_search(const CharT* first, const size_t count, const CharT* needle, const size_t needleCount) noexcept
+{
+	if (count < needleCount)
+		return count;
+
+	constexpr size_t step	= 16 / sizeof(CharT);
+	const __m128i head		= _sse2_broadcast(needle[0]);
+	const __m128i tail		= _sse2_broadcast(needle[needleCount - 1]);
+	const size_t lastPos	= count - needleCount;
+	size_t index			= 0;
+
+	for (/*Empty*/; index + needleCount - 1 + step <= count; index += step)
+	{
+		uint32_t mask =	_sse2_match<CharT>(_sse2_load(first + index), head) &
+						_sse2_match<CharT>(_sse2_load(first + index + needleCount - 1), tail) &
+						_lane_bits<CharT>();
+
+		for (/*Empty*/; mask != 0; mask &= mask - 1)
+		{
+			size_t candidate = index + custom::countr_zero(mask) / sizeof(CharT);
+			if (::memcmp(first + candidate + 1, needle + 1, (needleCount - 2) * sizeof(CharT)) == 0)
+				return candidate;
+		}
+	}
+
+	for (/*Empty*/; index <= lastPos; ++index)	// same filter, one position at a time
+		if (first[index] == needle[0] && first[index + needleCount - 1] == needle[needleCount - 1] &&
+			::memcmp(first + index + 1, needle + 1, (needleCount - 2) * sizeof(CharT)) == 0)
+			return index;
+
+	return count;
+}
+
+template<class CharT>
+inline size_t _sse2_rsearch(const CharT* first, const size_t lastPos, const CharT* needle, const size_t needleCount) noexcept
+{
+	constexpr size_t step	= 16 / sizeof(CharT);
+	const __m128i head		= _sse2_broadcast(needle[0]);
+	const __m128i tail		= _sse2_broadcast(needle[needleCount - 1]);
+	size_t end				= lastPos + 1;	// candidates left to check are [0, end)
+
+	for (/*Empty*/; end >= step; end -= step)
+	{
+		const size_t index = end - step;
+		uint32_t mask =	_sse2_match<CharT>(_sse2_load(first + index), head) &
+						_sse2_match<CharT>(_sse2_load(first + index + needleCount - 1), tail) &
+						_lane_bits<CharT>();
+
+		while (mask != 0)
+		{
+			const int bit = 31 - custom::countl_zero(mask);
+			size_t candidate = index + static_cast<size_t>(bit) / sizeof(CharT);
+			if (::memcmp(first + candidate + 1, needle + 1, (needleCount - 2) * sizeof(CharT)) == 0)
+				return candidate;
+
+			mask &= ~(1u << bit);
+		}
+	}
+
+	for (/*Empty*/; end > 0; --end)
+		if (first[end - 1] == needle[0] && first[end + needleCount - 2] == needle[needleCount - 1] &&
+			::memcmp(first + end, needle + 1, (needleCount - 2) * sizeof(CharT)) == 0)
+			return end - 1;
+
+	return static_cast<size_t>(-1);
+}
+#pragma endregion SSE2
+
+#pragma region AVX2
+template<class CharT>
+CUSTOM_TARGET_AVX2 inline __m256i _avx2_broadcast(const CharT ch) noexcept
+{
+	if constexpr (sizeof(CharT) == 1)
+		return _mm256_set1_epi8(static_cast<char>(ch));
+	else if constexpr (sizeof(CharT) == 2)
+		return _mm256_set1_epi16(static_cast<short>(ch));
+	else
+		return _mm256_set1_epi32(static_cast<int>(ch));
+}
+
+template<class CharT>
+CUSTOM_TARGET_AVX2 inline uint32_t _avx2_match(const __m256i left, const __m256i right) noexcept
+{
+	if constexpr (sizeof(CharT) == 1)
+		return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(left, right)));
+	else if constexpr (sizeof(CharT) == 2)
+		return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(left, right)));
+	else
+		return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi32(left, right)));
+}
+
+template<class CharT>
+CUSTOM_TARGET_AVX2 inline __m256i _avx2_load(const CharT* ptr) noexcept
+{
+	return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+}
+
+template<class CharT>
+CUSTOM_TARGET_AVX2 CUSTOM_NO_SANITIZE_MEMORY inline size_t _avx2_length(const CharT* cstr) noexcept
+{
+	const uintptr_t address	= reinterpret_cast<uintptr_t>(cstr);
+	const char* block		= reinterpret_cast<const char*>(address & ~uintptr_t{31});
+	const __m256i zero		= _mm256_setzero_si256();
+
+	uint32_t mask = _avx2_match<CharT>(_mm256_load_si256(reinterpret_cast<const __m256i*>(block)), zero) & (~0u << (address & 31));
+	while (mask == 0)
+	{
+		block += 32;
+		mask = _avx2_match<CharT>(_mm256_load_si256(reinterpret_cast<const __m256i*>(block)), zero);
+	}
+
+	return static_cast<size_t>(block + custom::countr_zero(mask) - reinterpret_cast<const char*>(cstr)) / sizeof(CharT);
+}
+
+template<class CharT>
+CUSTOM_TARGET_AVX2 inline const CharT* _avx2_find(const CharT* first, size_t count, const CharT ch) noexcept
+{
+	constexpr size_t step	= 32 / sizeof(CharT);
+	const __m256i target	= _avx2_broadcast(ch);
+
+	for (/*Empty*/; count >= step; count -= step, first += step)
+		if (uint32_t mask = _avx2_match<CharT>(_avx2_load(first), target); mask != 0)
+			return first + custom::countr_zero(mask) / sizeof(CharT);
+
+	return _sse2_find(first, count, ch);
+}
+
+template<class CharT>
+CUSTOM_TARGET_AVX2 inline size_t _avx2_mismatch(const CharT* first1, const CharT* first2, const size_t count) noexcept
+{
+	constexpr size_t step = 32 / sizeof(CharT);
+	size_t index = 0;
+
+	for (/*Empty*/; index + step <= count; index += step)
+		if (uint32_t mask = ~_avx2_match<CharT>(_avx2_load(first1 + index), _avx2_load(first2 + index)); mask != 0)
+			return index + custom::countr_zero(mask) / sizeof(CharT);
+
+	return index + _sse2_mismatch(first1 + index, first2 + index, count - index);
+}
+
+template<class CharT>
+CUSTOM_TARGET_AVX2 inline size_t _avx2_find_first_of(const CharT* first, const size_t count, const CharT* set, const size_t setCount) noexcept
+{
+	constexpr size_t step = 32 / sizeof(CharT);
+	size_t index = 0;
+
+	for (/*Empty*/; index + step <= count; index += step)
+	{
+		const __m256i block = _avx2_load(first + index);
+		uint32_t mask = 0;
+		for (size_t i = 0; i < setCount; ++i)
+			mask |= _avx2_match<CharT>(block, _avx2_broadcast(set[i]));
+
+		if (mask != 0)
+			return index + custom::countr_zero(mask) / sizeof(CharT);
+	}
+
+	return index + _sse2_find_first_of(first + index, count - index, set, setCount);
+}
+
+template<class CharT>
+CUSTOM_TARGET_AVX2 inline size_t _avx2_search(const CharT* first, const size_t count, const CharT* needle, const size_t needleCount) noexcept
+{
+	constexpr size_t step	= 32 / sizeof(CharT);
+	const __m256i head		= _avx2_broadcast(needle[0]);
+	const __m256i tail		= _avx2_broadcast(needle[needleCount - 1]);
+	size_t index			= 0;
+
+	for (/*Empty*/; index + needleCount - 1 + step <= count; index += step)
+	{
+		uint32_t mask =	_avx2_match<CharT>(_avx2_load(first + index), head) &
+						_avx2_match<CharT>(_avx2_load(first + index + needleCount - 1), tail) &
+						_lane_bits<CharT>();
+
+		for (/*Empty*/; mask != 0; mask &= mask - 1)
+		{
+			size_t candidate = index + custom::countr_zero(mask) / sizeof(CharT);
+			if (::memcmp(first + candidate + 1, needle + 1, (needleCount - 2) * sizeof(CharT)) == 0)
+				return candidate;
+		}
+	}
+
+	return index + _sse2_search(first + index, count - index, needle, needleCount);
+}
+
+template<class CharT>
+CUSTOM_TARGET_AVX2 inline size_t _avx2_rsearch(const CharT* first, const size_t lastPos, const CharT* needle, const size_t needleCount) noexcept
+{
+	constexpr size_t step	= 32 / sizeof(CharT);
+	const __m256i head		= _avx2_broadcast(needle[0]);
+	const __m256i tail		= _avx2_broadcast(needle[needleCount - 1]);
+	size_t end				= lastPos + 1;	// candidates left to check are [0, end)
+
+	for (/*Empty*/; end >= step; end -= step)
+	{
+		const size_t index = end - step;
+		uint32_t mask =	_avx2_match<CharT>(_avx2_load(first + index), head) &
+						_avx2_match<CharT>(_avx2_load(first + index + needleCount - 1), tail) &
+						_lane_bits<CharT>();
+
+		while (mask != 0)
+		{
+			const int bit = 31 - custom::countl_zero(mask);
+			size_t candidate = index + static_cast<size_t>(bit) / sizeof(CharT);
+			if (::memcmp(first + candidate + 1, needle + 1, (needleCount - 2) * sizeof(CharT)) == 0)
+				return candidate;
+
+			mask &= ~(1u << bit);
+		}
+	}
+
+	if (end == 0)
+		return static_cast<size_t>(-1);
+
+	return _sse2_rsearch(first, end - 1, needle, needleCount);
+}
+#pragma endregion AVX2
+
+#endif	// CUSTOM_SIMD_X86
+
+// length of null-terminated cstr
+template<class CharT>
+inline size_t _vectorized_length(const CharT* cstr) noexcept
+{
+#ifdef CUSTOM_SIMD_X86
+	if constexpr (_Is_Simd_Char_v<CharT>)
+		return _cpu_has_avx2() ? _avx2_length(cstr) : _sse2_length(cstr);
+#endif
+
+	size_t count = 0;
+	for (/*Empty*/; *cstr != CharT(); ++count, ++cstr) { /*do nothing*/ }
+	return count;
+}
+
+// first ch in [first, first + count) or nullptr
+template<class CharT>
+inline const CharT* _vectorized_find(const CharT* first, size_t count, const CharT ch) noexcept
+{
+#ifdef CUSTOM_SIMD_X86
+	if constexpr (_Is_Simd_Char_v<CharT>)
+		return _cpu_has_avx2() ? _avx2_find(first, count, ch) : _sse2_find(first, count, ch);
+#endif
+
+	for (/*Empty*/; count > 0; --count, ++first)
+		if (*first == ch)
+			return first;
+
+	return nullptr;
+}
+
+// index of the first different char or count
+template<class CharT>
+inline size_t _vectorized_mismatch(const CharT* first1, const CharT* first2, const size_t count) noexcept
+{
+#ifdef CUSTOM_SIMD_X86
+	if constexpr (_Is_Simd_Char_v<CharT>)
+		return _cpu_has_avx2() ? _avx2_mismatch(first1, first2, count) : _sse2_mismatch(first1, first2, count);
+#endif
+
+	size_t index = 0;
+	for (/*Empty*/; index < count && first1[index] == first2[index]; ++index) { /*do nothing*/ }
+	return index;
+}
+
+// index of the first char in [first, first + count) that is also in [set, set + setCount) or count
+template<class CharT>
+inline size_t _vectorized_find_first_of(const CharT* first, const size_t count, const CharT* set, const size_t setCount) noexcept
+{
+#ifdef CUSTOM_SIMD_X86
+	if constexpr (_Is_Simd_Char_v<CharT>)
+		if (setCount <= 16)		// larger sets cost more compares per block than a scalar scan
+			return _cpu_has_avx2() ? _avx2_find_first_of(first, count, set, setCount) : _sse2_find_first_of(first, count, set, setCount);
+#endif
+
+	for (size_t index = 0; index < count; ++index)
+		if (_vectorized_find(set, setCount, first[index]) != nullptr)
+			return index;
+
+	return count;
+}
+
+// index of the first occurrence of [needle, needle + needleCount) in [first, first + count) or npos
+template<class CharT>
+inline size_t _vectorized_search(const CharT* first, const size_t count, const CharT* needle, const size_t needleCount) noexcept
+{
+	if (needleCount > count)
+		return static_cast<size_t>(-1);
+
+	if (needleCount == 0)
+		return 0;
+
+	if (needleCount == 1)
+	{
+		const CharT* found = _vectorized_find(first, count, needle[0]);
+		return (found == nullptr) ? static_cast<size_t>(-1) : static_cast<size_t>(found - first);
+	}
+
+#ifdef CUSTOM_SIMD_X86
+	if constexpr (_Is_Simd_Char_v<CharT>)
+	{
+		size_t index = _cpu_has_avx2() ? _avx2_search(first, count, needle, needleCount) : _sse2_search(first, count, needle, needleCount);
+		return (index == count) ? static_cast<size_t>(-1) : index;
+	}
+#endif
+
+	for (size_t index = 0; index <= count - needleCount; ++index)
+		if (::memcmp(first + index, needle, needleCount * sizeof(CharT)) == 0)
+			return index;
+
+	return static_cast<size_t>(-1);
+}
+
+// index of the last occurrence of [needle, needle + needleCount) starting in [first, first + lastPos] or npos
+template<class CharT>
+inline size_t _vectorized_rsearch(const CharT* first, const size_t lastPos, const CharT* needle, const size_t needleCount) noexcept
+{
+	if (needleCount == 0)
+		return lastPos;
+
+#ifdef CUSTOM_SIMD_X86
+	if constexpr (_Is_Simd_Char_v<CharT>)
+		if (needleCount > 1)
+			return _cpu_has_avx2() ? _avx2_rsearch(first, lastPos, needle, needleCount) : _sse2_rsearch(first, lastPos, needle, needleCount);
+#endif
+
+	for (size_t end = lastPos + 1; end > 0; --end)
+		if (::memcmp(first + end - 1, needle, needleCount * sizeof(CharT)) == 0)
+			return end - 1;
+
+	return static_cast<size_t>(-1);
+}
+
+CUSTOM_DETAIL_END
+
+CUSTOM_END
@@ -19,6 +19,14 @@
 
 #define CUSTOM_OPTIMAL_IMPLEMENTATION 0    // some implementations are easier to understand, but have lower performance
 
+#ifndef CUSTOM_HASH_FNV1A
+#define CUSTOM_HASH_FNV1A 0                 // custom::hash uses FNV-1a instead of the wyhash-style hash (1 for compatibility)
+#endif
+
+#ifndef CUSTOM_SIMD_ENABLED
+#define CUSTOM_SIMD_ENABLED 1               // use SSE2/AVX2 kernels when the target supports them (0 forces the scalar path)
+#endif
+
 #ifdef _MSC_VER
 // This is a Microsoft Specific. This is a __declspec extended attribute.
 // This form of __declspec can be applied to any class declaration,
@@ -33,6 +41,15 @@
 #define CUSTOM_NOVTABLE_ATTR    // Defined only for _MSC_VER
 #endif
 
+#if defined __GNUG__
+#define CUSTOM_PREFETCH(Addr) __builtin_prefetch(Addr)     // hint only, never faults
+#elif defined _MSC_VER && (defined _M_X64 || defined _M_IX86)
+#include <xmmintrin.h>
+#define CUSTOM_PREFETCH(Addr) _mm_prefetch(reinterpret_cast<const char*>(Addr), _MM_HINT_T0)
+#else
+#define CUSTOM_PREFETCH(Addr) static_cast<void>(Addr)
+#endif
+
 
 CUSTOM_BEGIN
 
@@ -131,6 +131,31 @@ public:
 		return !(*this == other);
 	}
 
+	constexpr difference_type operator-(const _Basic_String_View_Iterator& other) const noexcept
+	{
+		return _Ptr - other._Ptr;
+	}
+
+	constexpr bool operator<(const _Basic_String_View_Iterator& other) const noexcept
+	{
+		return _Ptr < other._Ptr;
+	}
+
+	constexpr bool operator>(const _Basic_String_View_Iterator& other) const noexcept
+	{
+		return other < *this;
+	}
+
+	constexpr bool operator<=(const _Basic_String_View_Iterator& other) const noexcept
+	{
+		return !(other < *this);
+	}
+
+	constexpr bool operator>=(const _Basic_String_View_Iterator& other) const noexcept
+	{
+		return !(*this < other);
+	}
+
 public:
 
 	friend constexpr void _verify_range(const _Basic_String_View_Iterator& first,
@@ -364,6 +389,28 @@ public:
 	}
 	// end Rfind
 
+	// Find first of
+	constexpr size_t find_first_of(const basic_string_view& other, const size_t pos = 0) const noexcept
+	{
+		return _find_first_of_cstring(other._data._First, pos, other.size());
+	}
+
+	constexpr size_t find_first_of(const_pointer cstring, const size_t pos = 0) const noexcept
+	{
+		return _find_first_of_cstring(cstring, pos, traits_type::length(cstring));
+	}
+
+	constexpr size_t find_first_of(const_pointer cstring, size_t pos, size_t len) const noexcept
+	{
+		return _find_first_of_cstring(cstring, pos, len);
+	}
+
+	constexpr size_t find_first_of(const value_type chr, const size_t pos = 0) const noexcept
+	{
+		return find(chr, pos);
+	}
+	// END Find first of
+
 	// Contains
 	constexpr bool contains(const basic_string_view& other) const noexcept
 	{
@@ -488,20 +535,19 @@ private:
 			cstring, subpos, sublen);
 	}
 
-	constexpr size_t _find_cstring(const_pointer cstring, size_t pos, size_t len) const
+	constexpr size_t _find_cstring(const_pointer cstring, size_t pos, size_t len) const noexcept
 	{
-		if (pos > size() || len > traits_type::length(cstring))
-			throw std::out_of_range("Invalid length or starting position.");
-
-		return detail::_traits_cstring_find<traits_type>(_data._First, cstring, pos, len);
+		return detail::_traits_cstring_find<traits_type>(_data._First, size(), cstring, pos, len);
 	}
 
-	constexpr size_t _rfind_cstring(const_pointer cstring, size_t pos, size_t len) const
+	constexpr size_t _rfind_cstring(const_pointer cstring, size_t pos, size_t len) const noexcept
 	{
-		if (len > traits_type::length(cstring))
-			throw std::out_of_range("Invalid length.");
+		return detail::_traits_cstring_rfind<traits_type>(_data._First, size(), cstring, pos, len);
+	}
 
-		return detail::_traits_cstring_rfind<traits_type>(_data._First, cstring, pos, len);
+	constexpr size_t _find_first_of_cstring(const_pointer cstring, size_t pos, size_t len) const noexcept
+	{
+		return detail::_traits_cstring_find_first_of<traits_type>(_data._First, size(), cstring, pos, len);
 	}
 };  // END basic_string_view
 
@@ -514,13 +560,41 @@ constexpr bool operator==(	const basic_string_view<Type, Traits>& left,
 	return left.compare(right) == 0;
 }
 
-template<class Type, class Alloc, class Traits>
+template<class Type, class Traits>
 constexpr bool operator!=(	const basic_string_view<Type, Traits>& left,
 							const basic_string_view<Type, Traits>& right)
 {
 	return !(left == right);
 }
 
+template<class Type, class Traits>
+constexpr bool operator==(	const basic_string_view<Type, Traits>& left,
+							const Type* right)
+{
+	return left.compare(right) == 0;
+}
+
+template<class Type, class Traits>
+constexpr bool operator<(	const basic_string_view<Type, Traits>& left,
+							const basic_string_view<Type, Traits>& right)
+{
+	return left.compare(right) < 0;
+}
+
+template<class Type, class Traits>
+constexpr bool operator<(	const basic_string_view<Type, Traits>& left,
+							const Type* right)
+{
+	return left.compare(right) < 0;
+}
+
+template<class Type, class Traits>
+constexpr bool operator<(	const Type* left,
+							const basic_string_view<Type, Traits>& right)
+{
+	return right.compare(left) > 0;
+}
+
 
 CUSTOM_DETAIL_BEGIN
 
@@ -537,9 +611,44 @@ struct _Basic_String_Data
 	using const_pointer		= typename _Alloc_Traits::const_pointer;
 
 
-	pointer _First			= nullptr;			// Actual container array
-	pointer _Last			= nullptr;			// pointer to end
-	pointer _Final			= nullptr;			// pointer to capacity end
+	// Short strings are stored in place (15 chars + NULLCHR for char)
+	static constexpr size_t _BUF_SIZE		= (16 / sizeof(value_type) < 1) ? 1 : 16 / sizeof(value_type);
+	static constexpr size_t _SSO_CAPACITY	= _BUF_SIZE - 1;
+
+	union _Storage						// inline buffer shares storage with the heap pointer
+	{
+		value_type _Buf[_BUF_SIZE];
+		pointer _Ptr;
+	};
+
+	_Storage _Bx			= {};				// Actual container array (inline or allocated)
+	size_t _Size			= 0;				// Number of chars (without NULLCHR)
+	size_t _Capacity		= _SSO_CAPACITY;	// Max number of chars (without NULLCHR)
+
+	constexpr bool _is_small() const noexcept
+	{
+		return _Capacity <= _SSO_CAPACITY;
+	}
+
+	constexpr pointer _first() noexcept
+	{
+		return _is_small() ? _Bx._Buf : _Bx._Ptr;
+	}
+
+	constexpr const_pointer _first() const noexcept
+	{
+		return _is_small() ? _Bx._Buf : _Bx._Ptr;
+	}
+
+	constexpr pointer _last() noexcept
+	{
+		return _first() + _Size;
+	}
+
+	constexpr const_pointer _last() const noexcept
+	{
+		return _first() + _Size;
+	}
 };	// END _Basic_String_Data
 
 
@@ -568,7 +677,7 @@ public:
 
 	constexpr _Basic_String_Const_Iterator& operator++() noexcept
 	{
-		CUSTOM_ASSERT(_Ptr < _RefData->_Last, "Cannot increment end iterator.");
+		CUSTOM_ASSERT(_Ptr < _RefData->_last(), "Cannot increment end iterator.");
 		++_Ptr;
 		return *this;
 	}
@@ -582,7 +691,7 @@ public:
 
 	constexpr _Basic_String_Const_Iterator& operator+=(const difference_type diff) noexcept
 	{
-		CUSTOM_ASSERT(_Ptr + diff <= _RefData->_Last, "Cannot increment end iterator.");
+		CUSTOM_ASSERT(_Ptr + diff <= _RefData->_last(), "Cannot increment end iterator.");
 		_Ptr += diff;
 		return *this;
 	}
@@ -596,7 +705,7 @@ public:
 
 	constexpr _Basic_String_Const_Iterator& operator--() noexcept
 	{
-		CUSTOM_ASSERT(_Ptr > _RefData->_First, "Cannot decrement begin iterator.");
+		CUSTOM_ASSERT(_Ptr > _RefData->_first(), "Cannot decrement begin iterator.");
 		--_Ptr;
 		return *this;
 	}
@@ -610,7 +719,7 @@ public:
 
 	constexpr _Basic_String_Const_Iterator& operator-=(const difference_type diff) noexcept
 	{
-		CUSTOM_ASSERT(_Ptr - diff >= _RefData->_First, "Cannot decrement begin iterator.");
+		CUSTOM_ASSERT(_Ptr - diff >= _RefData->_first(), "Cannot decrement begin iterator.");
 		_Ptr -= diff;
 		return *this;
 	}
@@ -624,13 +733,13 @@ public:
 
 	constexpr pointer operator->() const noexcept
 	{
-		CUSTOM_ASSERT(_Ptr < _RefData->_Last, "Cannot access end iterator.");
+		CUSTOM_ASSERT(_Ptr < _RefData->_last(), "Cannot access end iterator.");
 		return pointer_traits<pointer>::pointer_to(**this);
 	}
 
 	constexpr reference operator*() const noexcept
 	{
-		CUSTOM_ASSERT(_Ptr < _RefData->_Last, "Cannot dereference end iterator.");
+		CUSTOM_ASSERT(_Ptr < _RefData->_last(), "Cannot dereference end iterator.");
 		return *_Ptr;
 	}
 
@@ -649,21 +758,46 @@ public:
 		return !(*this == other);
 	}
 
+	constexpr difference_type operator-(const _Basic_String_Const_Iterator& other) const noexcept
+	{
+		return _Ptr - other._Ptr;
+	}
+
+	constexpr bool operator<(const _Basic_String_Const_Iterator& other) const noexcept
+	{
+		return _Ptr < other._Ptr;
+	}
+
+	constexpr bool operator>(const _Basic_String_Const_Iterator& other) const noexcept
+	{
+		return other < *this;
+	}
+
+	constexpr bool operator<=(const _Basic_String_Const_Iterator& other) const noexcept
+	{
+		return !(other < *this);
+	}
+
+	constexpr bool operator>=(const _Basic_String_Const_Iterator& other) const noexcept
+	{
+		return !(*this < other);
+	}
+
 public:
 
 	constexpr size_t get_index() const noexcept	// Get the position for the element in array from iterator
 	{
-		return static_cast<size_t>(_Ptr - _RefData->_First);
+		return static_cast<size_t>(_Ptr - _RefData->_first());
 	}
 
 	constexpr bool is_begin() const noexcept
 	{
-		return _Ptr == _RefData->_First;
+		return _Ptr == _RefData->_first();
 	}
 
 	constexpr bool is_end() const noexcept
 	{
-		return _Ptr == _RefData->_Last;
+		return _Ptr == _RefData->_last();
 	}
 
 	friend constexpr void _verify_range(const _Basic_String_Const_Iterator& first, const _Basic_String_Const_Iterator& last) noexcept
@@ -747,6 +881,8 @@ public:
 		return temp;
 	}
 
+	using _Base::operator-;
+
 	constexpr pointer operator->() const noexcept
 	{
 		return const_cast<pointer>(_Base::operator->());
@@ -801,8 +937,6 @@ public:
 	static constexpr size_t npos = static_cast<size_t>(-1);
 
 private:
-	static constexpr size_t _DEFAULT_CAPACITY = 15;
-
 	_Data _data;
 	allocator_type _alloc;
 
@@ -858,24 +992,24 @@ public:
     constexpr operator basic_string_view<value_type, traits_type>() const noexcept
 	{
         // return a string_view around *this's character-type sequence
-        return basic_string_view<value_type, traits_type> {_data._First, size()};
+        return basic_string_view<value_type, traits_type> {_data._first(), size()};
     }
 
 	constexpr const_reference operator[](const size_t index) const noexcept
 	{
 		CUSTOM_ASSERT(index < size(), "Index out of bounds.");
-		return _data._First[index];
+		return _data._first()[index];
 	}
 
 	constexpr reference operator[](const size_t index) noexcept
 	{
 		CUSTOM_ASSERT(index < size(), "Index out of bounds.");
-		return _data._First[index];
+		return _data._first()[index];
 	}
 
 	constexpr basic_string& operator=(const basic_string& other)
 	{
-		if (_data._First != other._data._First)
+		if (this != &other)
 		{
 			_clean_up_string();
 			_copy(other);
@@ -886,7 +1020,7 @@ public:
 
 	constexpr basic_string& operator=(basic_string&& other) noexcept
 	{
-		if (_data._First != other._data._First)
+		if (this != &other)
 		{
 			_clean_up_string();
 			_move(custom::move(other));
@@ -919,17 +1053,32 @@ public:
 	constexpr void reserve(const size_t newCapacity)
 	{
 		if (newCapacity < size())		// Can also shrink
-			_data._Last = _data._First + newCapacity;
+			_data._Size = newCapacity;
 
-		size_t newSize		= size();
-		pointer newString 	= _alloc.allocate(newCapacity + 1);
-		(void)traits_type::copy(newString, _data._First, size());
-		_clean_up_string();
+		if (newCapacity <= _Data::_SSO_CAPACITY)	// fits in place
+		{
+			if (!_data._is_small())
+			{
+				pointer oldString		= _data._Bx._Ptr;
+				size_t oldCapacity		= _data._Capacity;
+				(void)traits_type::copy(_data._Bx._Buf, oldString, size());
+				_alloc.deallocate(oldString, oldCapacity + 1);
+				_data._Capacity			= _Data::_SSO_CAPACITY;
+			}
+		}
+		else
+		{
+			pointer newString 	= _alloc.allocate(newCapacity + 1);
+			(void)traits_type::copy(newString, _data._first(), size());
+
+			if (!_data._is_small())
+				_alloc.deallocate(_data._Bx._Ptr, _data._Capacity + 1);
 
-		_data._First 		= newString;
-		_data._Last			= _data._First + newSize;
-		_data._Final 		= _data._First + newCapacity;
-		_data._Last[0] 		= traits_type::NULLCHR;
+			_data._Bx._Ptr		= newString;
+			_data._Capacity		= newCapacity;
+		}
+
+		_data._last()[0] = traits_type::NULLCHR;
 	}
 
 	constexpr void shrink_to_fit()
@@ -940,18 +1089,18 @@ public:
 	constexpr void push_back(value_type chr)
 	{
 		_extend_if_full();
-		*(_data._Last++)	= chr;
-		_data._Last[0] 		= traits_type::NULLCHR;
+		_data._first()[_data._Size++]	= chr;
+		_data._last()[0] 				= traits_type::NULLCHR;
 	}
 
 	constexpr void pop_back()
 	{
-		*(--_data._Last) = traits_type::NULLCHR;
+		_data._first()[--_data._Size] = traits_type::NULLCHR;
 	}
 
 	constexpr size_t size() const noexcept
 	{
-		return static_cast<size_t>(_data._Last - _data._First);
+		return _data._Size;
 	}
 
 	constexpr size_t max_size() const noexcept
@@ -962,33 +1111,33 @@ public:
 
 	constexpr size_t capacity() const noexcept
 	{
-		return static_cast<size_t>(_data._Final - _data._First);
+		return _data._Capacity;
 	}
 
 	constexpr bool empty() const noexcept
 	{
-		return (_data._First == _data._Last);
+		return _data._Size == 0;
 	}
 
 	constexpr void clear()
 	{
-		_data._Last 	= _data._First;
-		_data._First[0] = traits_type::NULLCHR;
+		_data._Size 		= 0;
+		_data._first()[0]	= traits_type::NULLCHR;
 	}
 
 	constexpr const_pointer data() const noexcept
 	{
-		return _data._First;
+		return _data._first();
 	}
 
 	constexpr pointer data() noexcept
 	{
-		return _data._First;
+		return _data._first();
 	}
 
 	constexpr const_pointer c_str() const noexcept
 	{
-		return _data._First;
+		return _data._first();
 	}
 
 	constexpr const_reference at(const size_t index) const
@@ -996,7 +1145,7 @@ public:
 		if (index >= size())
 			throw std::out_of_range("Index out of bounds.");
 
-		return _data._First[index];
+		return _data._first()[index];
 	}
 
 	constexpr reference at(const size_t index)
@@ -1004,40 +1153,40 @@ public:
 		if (index >= size())
 			throw std::out_of_range("Index out of bounds.");
 
-		return _data._First[index];
+		return _data._first()[index];
 	}
 
 	constexpr const_reference front() const
 	{
 		CUSTOM_ASSERT(!empty(), "Container is empty.");
-		return _data._First[0];
+		return _data._first()[0];
 	}
 
 	constexpr reference front()
 	{
 		CUSTOM_ASSERT(!empty(), "Container is empty.");
-		return _data._First[0];
+		return _data._first()[0];
 	}
 
 	constexpr const_reference back() const
 	{
 		CUSTOM_ASSERT(!empty(), "Container is empty.");
-		return _data._Last[-1];
+		return _data._last()[-1];
 	}
 
 	constexpr reference back()
 	{
 		CUSTOM_ASSERT(!empty(), "Container is empty.");
-		return _data._Last[-1];
+		return _data._last()[-1];
 	}
 
     constexpr void swap(basic_string& other) noexcept
 	{
-		if (_data._First != other._data._First)
+		if (this != &other)		// the storage union is swapped as a whole (inline chars or heap pointer)
 		{
-			custom::swap(_data._First, other._data._First);
-			custom::swap(_data._Last, other._data._Last);
-			custom::swap(_data._Final, other._data._Final);
+			custom::swap(_data._Bx, other._data._Bx);
+			custom::swap(_data._Size, other._data._Size);
+			custom::swap(_data._Capacity, other._data._Capacity);
 		}
     }
 
@@ -1047,9 +1196,9 @@ public:
 			throw std::out_of_range("Invalid length or starting position.");
 
 		basic_string sub(len);	// empty string with capacity = len
-		(void)traits_type::copy(sub._data._First, _data._First + pos, len);
-		sub._data._Last		= sub._data._Final;
-		sub._data._Last[0]	= traits_type::NULLCHR;
+		(void)traits_type::copy(sub._data._first(), _data._first() + pos, len);
+		sub._data._Size		= len;
+		sub._data._last()[0]	= traits_type::NULLCHR;
 
 		return sub;
 	}
@@ -1057,13 +1206,13 @@ public:
 // Append function overload
 	constexpr basic_string& append(const basic_string& string)
 	{
-		_insert_from_cstring(size(), string._data._First, 0, string.size());
+		_insert_from_cstring(size(), string._data._first(), 0, string.size());
 		return *this;
 	}
 
 	constexpr basic_string& append(const basic_string& string, size_t subpos, size_t sublen)	// Appends a copy of a substring of string.
 	{
-		_insert_from_cstring(size(), string._data._First, subpos, sublen);
+		_insert_from_cstring(size(), string._data._first(), subpos, sublen);
 		return *this;
 	}
 
@@ -1089,13 +1238,13 @@ public:
 // Insert function overload
 	constexpr basic_string& insert(size_t pos, const basic_string& string)
 	{
-		_insert_from_cstring(pos, string._data._First, 0, string.size());
+		_insert_from_cstring(pos, string._data._first(), 0, string.size());
 		return *this;
 	}
 
 	constexpr basic_string& insert(size_t pos, const basic_string& string, size_t subpos, size_t sublen)
 	{
-		_insert_from_cstring(pos, string._data._First, subpos, sublen);
+		_insert_from_cstring(pos, string._data._first(), subpos, sublen);
 		return *this;	
 	}
 
@@ -1122,7 +1271,7 @@ public:
 		size_t pos = where.get_index();
 		_insert_char(pos, 1, chr);
 
-		return iterator(_data._First + pos, &_data);
+		return iterator(_data._first() + pos, &_data);
 	}
 
 	constexpr iterator insert(const_iterator where, size_t nchar, value_type chr)
@@ -1130,22 +1279,22 @@ public:
 		size_t pos = where.get_index();
 		_insert_char(pos, nchar, chr);
 
-		return iterator(_data._First + pos, &_data);
+		return iterator(_data._first() + pos, &_data);
 	}
 
 	constexpr iterator insert(const_iterator where, const_iterator first, const_iterator last)
 	{
-		if (where._RefData->_First == first._RefData->_First ||
-			first._RefData->_First != last._RefData->_First)	// Check if pos string != first/last string
+		if (where._RefData == first._RefData ||
+			first._RefData != last._RefData)	// Check if pos string != first/last string
 			throw std::domain_error("basic_string provided by first and last must be the same, but different from the one provided by where");
 
 		size_t pos 				= where.get_index();
 		size_t posFrom 			= first.get_index();
 		size_t posTo 			= last.get_index();
-		const_pointer cstring 	= first._RefData->_First;
+		const_pointer cstring 	= first._RefData->_first();
 		_insert_from_cstring(pos, cstring, posFrom, posTo - posFrom);
 
-		return iterator(_data._First + pos, &_data);
+		return iterator(_data._first() + pos, &_data);
 	}
 // end Insert
 
@@ -1164,7 +1313,7 @@ public:
 		size_t pos = where.get_index();
 		_remove_from_cstring(pos, 1);
 
-		return iterator(_data._First + pos, &_data);
+		return iterator(_data._first() + pos, &_data);
 	}
 
 	constexpr iterator erase(const_iterator first, const_iterator last)
@@ -1176,19 +1325,19 @@ public:
 		size_t posTo	= last.get_index();
 		_remove_from_cstring(posFrom, posTo - posFrom);
 
-		return iterator(_data._First + posFrom, &_data);
+		return iterator(_data._first() + posFrom, &_data);
 	}
 // end Erase
 
 // Compare function overload
 	constexpr int compare(const basic_string& string) const
 	{
-		return _compare_with_cstring(0, size(), string._data._First, 0, string.size());
+		return _compare_with_cstring(0, size(), string._data._first(), 0, string.size());
 	}
 
 	constexpr int compare(size_t pos, size_t len, const basic_string& string, size_t subpos, size_t sublen) const
 	{
-		return _compare_with_cstring(pos, len, string._data._First, subpos, sublen);
+		return _compare_with_cstring(pos, len, string._data._first(), subpos, sublen);
 	}
 
 	constexpr int compare(const_pointer cstring) const
@@ -1205,7 +1354,7 @@ public:
 // Find function overload
 	constexpr size_t find(const basic_string& string, size_t pos = 0) const
 	{
-		return _find_cstring(string._data._First, pos, string.size());
+		return _find_cstring(string._data._first(), pos, string.size());
 	}
 
 	constexpr size_t find(const_pointer cstring, size_t pos = 0) const
@@ -1227,7 +1376,7 @@ public:
 // Rfind function overload
 	constexpr size_t rfind(const basic_string& string, size_t pos = npos) const
 	{
-		return _rfind_cstring(string._data._First, pos, string.size());
+		return _rfind_cstring(string._data._first(), pos, string.size());
 	}
 
 	constexpr size_t rfind(const_pointer cstring, size_t pos = npos) const
@@ -1246,6 +1395,28 @@ public:
 	}
 // end Rfind
 
+// Find first of function overload
+	constexpr size_t find_first_of(const basic_string& string, size_t pos = 0) const
+	{
+		return _find_first_of_cstring(string._data._first(), pos, string.size());
+	}
+
+	constexpr size_t find_first_of(const_pointer cstring, size_t pos = 0) const
+	{
+		return _find_first_of_cstring(cstring, pos, traits_type::length(cstring));
+	}
+
+	constexpr size_t find_first_of(const_pointer cstring, size_t pos, size_t len) const
+	{
+		return _find_first_of_cstring(cstring, pos, len);
+	}
+
+	constexpr size_t find_first_of(value_type chr, size_t pos = 0) const
+	{
+		return find(chr, pos);
+	}
+// end Find first of
+
 // Contains
     constexpr bool contains(const basic_string_view<value_type, traits_type>& sv) const noexcept
 	{
@@ -1266,34 +1437,34 @@ public:
 // Starts With overload
 	constexpr bool starts_with(const basic_string_view<value_type, traits_type>& sv) const noexcept
 	{
-        return basic_string_view<value_type, traits_type> {_data._First, size()}.starts_with(sv);
+        return basic_string_view<value_type, traits_type> {_data._first(), size()}.starts_with(sv);
     }
 
     constexpr bool starts_with(const value_type chr) const noexcept
 	{
-        return basic_string_view<value_type, traits_type> {_data._First, size()}.starts_with(chr);
+        return basic_string_view<value_type, traits_type> {_data._first(), size()}.starts_with(chr);
     }
 
     constexpr bool starts_with(const_pointer cstring) const noexcept
 	{
-        return basic_string_view<value_type, traits_type> {_data._First, size()}.starts_with(cstring);
+        return basic_string_view<value_type, traits_type> {_data._first(), size()}.starts_with(cstring);
     }
 // END Starts With
 
 // Ends With overload
 	constexpr bool ends_with(const basic_string_view<value_type, traits_type>& sv) const noexcept
 	{
-        return basic_string_view<value_type, traits_type> {_data._First, size()}.ends_with(sv);
+        return basic_string_view<value_type, traits_type> {_data._first(), size()}.ends_with(sv);
     }
 
     constexpr bool ends_with(const value_type chr) const noexcept
 	{
-        return basic_string_view<value_type, traits_type> {_data._First, size()}.ends_with(chr);
+        return basic_string_view<value_type, traits_type> {_data._first(), size()}.ends_with(chr);
     }
 
     constexpr bool ends_with(const_pointer cstring) const noexcept
 	{
-        return basic_string_view<value_type, traits_type> {_data._First, size()}.ends_with(cstring);
+        return basic_string_view<value_type, traits_type> {_data._first(), size()}.ends_with(cstring);
     }
 // END Ends With
 
@@ -1303,7 +1474,7 @@ public:
 		size_t currentCapacity 	= capacity();
 
 		std::cout << currentSize << ' ' << currentCapacity << '\n';
-		std::cout << _data._First << '\n';
+		std::cout << _data._first() << '\n';
 	}
 
 public:
@@ -1311,12 +1482,12 @@ public:
 
 	constexpr iterator begin() noexcept
 	{
-		return iterator(_data._First, &_data);
+		return iterator(_data._first(), &_data);
 	}
 
 	constexpr const_iterator begin() const noexcept
 	{
-		return const_iterator(_data._First, &_data);
+		return const_iterator(const_cast<pointer>(_data._first()), &_data);
 	}
 
 	constexpr reverse_iterator rbegin() noexcept
@@ -1331,12 +1502,12 @@ public:
 
 	constexpr iterator end() noexcept
 	{
-		return iterator(_data._Last, &_data);
+		return iterator(_data._last(), &_data);
 	}
 
 	constexpr const_iterator end() const noexcept
 	{
-		return const_iterator(_data._Last, &_data);
+		return const_iterator(const_cast<pointer>(_data._last()), &_data);
 	}
 
 	constexpr reverse_iterator rend() noexcept
@@ -1352,63 +1523,66 @@ public:
 private:
 	// Helpers
 
-	constexpr void _alloc_empty(const size_t capacity)
+	constexpr void _alloc_empty(const size_t capacity)	// Expects empty in place string
 	{
-		_data._First	= _alloc.allocate(capacity + 1);
-		_data._Last		= _data._First;
-		_data._Final	= _data._First + capacity;
-		_data._Last[0]	= traits_type::NULLCHR;
+		if (capacity > _Data::_SSO_CAPACITY)	// doesn't fit in place
+		{
+			_data._Bx._Ptr		= _alloc.allocate(capacity + 1);
+			_data._Capacity		= capacity;
+		}
+
+		_data._Size				= 0;
+		_data._first()[0]		= traits_type::NULLCHR;
 	}
 
 	constexpr void _initialize_from_cstring(const_pointer cstring)
 	{
 		if (cstring == nullptr)
-			_alloc_empty(_DEFAULT_CAPACITY);
+			_alloc_empty(0);
 		else
 		{
-			size_t len		= traits_type::length(cstring);
-			_data._First	= _alloc.allocate(len + 1);
-			_data._Last		= _data._First + len;
-			_data._Final	= _data._First + len;
-			(void)traits_type::copy(_data._First, cstring, len);
-			_data._Last[0] = traits_type::NULLCHR;
+			size_t len			= traits_type::length(cstring);
+			_alloc_empty(len);
+			(void)traits_type::copy(_data._first(), cstring, len);
+			_data._Size			= len;
+			_data._last()[0]	= traits_type::NULLCHR;
 		}
 	}
 
-	constexpr void _clean_up_string()
+	constexpr void _clean_up_string()	// Leaves empty in place string
 	{
-		if (_data._First != nullptr)
-		{
-			_alloc.deallocate(_data._First, capacity() + 1);
-			_data._First	= nullptr;
-			_data._Last		= nullptr;
-			_data._Final	= nullptr;
-		}
+		if (!_data._is_small())
+			_alloc.deallocate(_data._Bx._Ptr, _data._Capacity + 1);
+
+		_data._Capacity		= _Data::_SSO_CAPACITY;
+		_data._Size			= 0;
+		_data._Bx._Buf[0]	= traits_type::NULLCHR;
 	}
 
 	constexpr void _extend_if_full()	// Reserve 50% more capacity when full
 	{
-		if (_data._Last == _data._Final)
+		if (_data._Size == _data._Capacity)
 			reserve(capacity() + capacity() / 2 + 1);
 	}
 
 	constexpr void _copy(const basic_string& other)
 	{
-		_alloc_empty(other.capacity());
-		(void)traits_type::copy(_data._First, other._data._First, other.size());
+		_alloc_empty(other.size());
+		(void)traits_type::copy(_data._first(), other._data._first(), other.size());
 
-		_data._Last		= _data._First + other.size();
-		_data._Final	= _data._First + other.capacity();
-		_data._Last[0]	= traits_type::NULLCHR;
+		_data._Size			= other.size();
+		_data._last()[0]	= traits_type::NULLCHR;
 	}
 
 	constexpr void _move(basic_string&& other)
 	{
-		_data._First	= other._data._First;
-		_data._Last		= other._data._Last;
-		_data._Final	= other._data._Final;
+		_data._Bx			= other._data._Bx;		// steals the heap pointer or copies the inline chars
+		_data._Size			= other._data._Size;
+		_data._Capacity		= other._data._Capacity;
 
-		other._initialize_from_cstring(nullptr);
+		other._data._Capacity	= _Data::_SSO_CAPACITY;
+		other._data._Size		= 0;
+		other._data._Bx._Buf[0]	= traits_type::NULLCHR;
 	}
 
 	constexpr void _insert_from_cstring(size_t pos, const_pointer cstring, size_t subpos, size_t sublen)
@@ -1420,10 +1594,10 @@ private:
 		if (newSize > capacity())
 			reserve(newSize);
 
-		(void)traits_type::move(_data._First + pos + sublen, _data._First + pos, size() - pos);	// copy last sublen positions to right
-		(void)traits_type::move(_data._First + pos, cstring + subpos, sublen);					// add substr from cstring between
-		_data._Last 	= _data._First + newSize;
-		_data._Last[0] 	= traits_type::NULLCHR;
+		(void)traits_type::move(_data._first() + pos + sublen, _data._first() + pos, size() - pos);	// copy last sublen positions to right
+		(void)traits_type::move(_data._first() + pos, cstring + subpos, sublen);						// add substr from cstring between
+		_data._Size 		= newSize;
+		_data._last()[0] 	= traits_type::NULLCHR;
 	}
 
 	constexpr void _insert_char(size_t pos, size_t nchar, value_type chr)
@@ -1435,10 +1609,10 @@ private:
 		if (newSize > capacity())
 			reserve(newSize);
 
-		(void)traits_type::move(_data._First + pos + nchar, _data._First + pos, size() - pos);	// copy last nchar positions to right
-		(void)traits_type::assign(_data._First + pos, nchar, chr);								// add nchar * chr in between
-		_data._Last 	= _data._First + newSize;
-		_data._Last[0] 	= traits_type::NULLCHR;
+		(void)traits_type::move(_data._first() + pos + nchar, _data._first() + pos, size() - pos);	// copy last nchar positions to right
+		(void)traits_type::assign(_data._first() + pos, nchar, chr);									// add nchar * chr in between
+		_data._Size 		= newSize;
+		_data._last()[0] 	= traits_type::NULLCHR;
 	}
 
 	constexpr void _remove_from_cstring(size_t pos, size_t len)
@@ -1446,9 +1620,9 @@ private:
 		if (pos + len > size())
 			throw std::out_of_range("Invalid length or starting position.");
 
-		(void)traits_type::move(_data._First + pos, _data._First + pos + len, size() - pos - len);
-		_data._Last 	= _data._First + size() - len;
-		_data._Last[0] 	= traits_type::NULLCHR;
+		(void)traits_type::move(_data._first() + pos, _data._first() + pos + len, size() - pos - len);
+		_data._Size 		= size() - len;
+		_data._last()[0] 	= traits_type::NULLCHR;
 	}
 
 	constexpr int _compare_with_cstring(size_t pos, size_t len, const_pointer cstring, size_t subpos, size_t sublen) const
@@ -1456,26 +1630,32 @@ private:
 		if (pos + len > size() || subpos + sublen > Traits::length(cstring))
 			throw std::out_of_range("Invalid length or starting position.");
 
-		return detail::_traits_cstring_compare<traits_type>(_data._First, pos, len, cstring, subpos, sublen);
+		return detail::_traits_cstring_compare<traits_type>(_data._first(), pos, len, cstring, subpos, sublen);
 	}
 
 	constexpr size_t _find_cstring(const_pointer cstring, size_t pos, size_t len) const
 	{
-		if (pos > size() || len > traits_type::length(cstring))
-			throw std::out_of_range("Invalid length or starting position.");
+		if (pos > size())
+			throw std::out_of_range("Invalid starting position.");
 
-		return detail::_traits_cstring_find<traits_type>(_data._First, cstring, pos, len);
+		return detail::_traits_cstring_find<traits_type>(_data._first(), size(), cstring, pos, len);
 	}
 
-	constexpr size_t _rfind_cstring(const_pointer cstring, size_t pos, size_t len) const
+	constexpr size_t _rfind_cstring(const_pointer cstring, size_t pos, size_t len) const noexcept
 	{
-		if (len > traits_type::length(cstring))
-			throw std::out_of_range("Invalid length.");
+		return detail::_traits_cstring_rfind<traits_type>(_data._first(), size(), cstring, pos, len);
+	}
 
-		return detail::_traits_cstring_rfind<traits_type>(_data._First, cstring, pos, len);
+	constexpr size_t _find_first_of_cstring(const_pointer cstring, size_t pos, size_t len) const noexcept
+	{
+		return detail::_traits_cstring_find_first_of<traits_type>(_data._first(), size(), cstring, pos, len);
 	}
 };	// END basic_string
 
+// The inline buffer is found through the capacity, never through a pointer to itself
+template<class Type, class Alloc, class Traits>
+struct is_trivially_relocatable<basic_string<Type, Alloc, Traits>> : is_trivially_relocatable<Alloc> {};
+
 
 // basic_string binary operators
 template<class Type, class Alloc, class Traits>
@@ -1492,6 +1672,57 @@ constexpr bool operator!=(	const basic_string<Type, Alloc, Traits>& left,
 	return !(left == right);
 }
 
+// mixed comparisons used by transparent functors (equal_to<>, less<>)
+// operator== is also found with reversed arguments (C++20), operator< is declared for both orders
+template<class Type, class Alloc, class Traits>
+constexpr bool operator==(	const basic_string<Type, Alloc, Traits>& left,
+							const basic_string_view<Type, Traits>& right)
+{
+	return static_cast<basic_string_view<Type, Traits>>(left).compare(right) == 0;
+}
+
+template<class Type, class Alloc, class Traits>
+constexpr bool operator==(	const basic_string<Type, Alloc, Traits>& left,
+							const Type* right)
+{
+	return left.compare(right) == 0;
+}
+
+template<class Type, class Alloc, class Traits>
+constexpr bool operator<(	const basic_string<Type, Alloc, Traits>& left,
+							const basic_string<Type, Alloc, Traits>& right)
+{
+	return left.compare(right) < 0;
+}
+
+template<class Type, class Alloc, class Traits>
+constexpr bool operator<(	const basic_string<Type, Alloc, Traits>& left,
+							const basic_string_view<Type, Traits>& right)
+{
+	return static_cast<basic_string_view<Type, Traits>>(left).compare(right) < 0;
+}
+
+template<class Type, class Alloc, class Traits>
+constexpr bool operator<(	const basic_string_view<Type, Traits>& left,
+							const basic_string<Type, Alloc, Traits>& right)
+{
+	return left.compare(static_cast<basic_string_view<Type, Traits>>(right)) < 0;
+}
+
+template<class Type, class Alloc, class Traits>
+constexpr bool operator<(	const basic_string<Type, Alloc, Traits>& left,
+							const Type* right)
+{
+	return left.compare(right) < 0;
+}
+
+template<class Type, class Alloc, class Traits>
+constexpr bool operator<(	const Type* left,
+							const basic_string<Type, Alloc, Traits>& right)
+{
+	return right.compare(left) > 0;
+}
+
 template<class Type, class Alloc, class Traits>
 constexpr basic_string<Type, Alloc, Traits> operator+(	const basic_string<Type, Alloc, Traits>& left,
 														const basic_string<Type, Alloc, Traits>& right)
@@ -469,12 +469,478 @@ custom::pair<OutputIt1, OutputIt2> partition_copy(  InputIt first, InputIt last,
 
 
 #pragma region Sorting operations
-// TODO: implement
+// is_sorted, is_sorted_until
+template<class ForwardIt, class Compare>
+constexpr ForwardIt is_sorted_until(ForwardIt first, ForwardIt last, Compare comp)
+{
+    detail::_verify_iteration_range(first, last);
+
+    if (first == last)
+        return last;
+
+    for (ForwardIt next = custom::next(first); next != last; ++first, ++next)
+        if (comp(*next, *first))
+            return next;
+
+    return last;
+}
+
+template<class ForwardIt>
+constexpr ForwardIt is_sorted_until(ForwardIt first, ForwardIt last)
+{
+    return custom::is_sorted_until(first, last, less<>{});
+}
+
+template<class ForwardIt, class Compare>
+constexpr bool is_sorted(ForwardIt first, ForwardIt last, Compare comp)
+{
+    return custom::is_sorted_until(first, last, comp) == last;
+}
+
+template<class ForwardIt>
+constexpr bool is_sorted(ForwardIt first, ForwardIt last)
+{
+    return custom::is_sorted_until(first, last, less<>{}) == last;
+}
+// END is_sorted, is_sorted_until
+
+
+// Heap operations are defined below, sort and select fall back on them
+template<class RandomIt, class Compare>
+constexpr void make_heap(RandomIt first, RandomIt last, Compare comp);
+
+template<class RandomIt, class Compare>
+constexpr void sort_heap(RandomIt first, RandomIt last, Compare comp);
+
+CUSTOM_DETAIL_BEGIN
+
+template<class RandomIt, class Compare>
+constexpr void _heap_select(RandomIt first, RandomIt middle, RandomIt last, Compare comp);
+
+constexpr ptrdiff_t _INSERTION_SORT_MAX = 16;     // ranges up to this size are insertion sorted
+constexpr ptrdiff_t _MERGE_RUN_SIZE     = 32;     // stable_sort insertion sorts runs of this size before merging
+
+template<class RandomIt, class Compare>
+constexpr void _insertion_sort(RandomIt first, RandomIt last, Compare comp)
+{
+    if (first == last)
+        return;
+
+    for (RandomIt it = first + 1; it != last; ++it)
+    {
+        typename iterator_traits<RandomIt>::value_type value = custom::move(*it);
+        RandomIt hole = it;
+
+        try
+        {
+            if (comp(value, *first))    // new minimum, shift the whole prefix
+            {
+                custom::move_backward(first, it, it + 1);
+                hole = first;
+            }
+            else                        // *first stops the scan, no bounds check needed
+                for (RandomIt prev = it - 1; comp(value, *prev); --prev)
+                {
+                    *hole = custom::move(*prev);
+                    hole = prev;
+                }
+        }
+        catch (...)
+        {
+            *hole = custom::move(value);    // a throwing comp leaves no hole behind
+            CUSTOM_RERAISE;
+        }
+
+        *hole = custom::move(value);
+    }
+}
+
+template<class RandomIt, class Compare>
+constexpr void _move_median_to_first(RandomIt result, RandomIt a, RandomIt b, RandomIt c, Compare comp)
+{
+    if (comp(*a, *b))
+    {
+        if (comp(*b, *c))
+            custom::iter_swap(result, b);
+        else if (comp(*a, *c))
+            custom::iter_swap(result, c);
+        else
+            custom::iter_swap(result, a);
+    }
+    else if (comp(*a, *c))
+        custom::iter_swap(result, a);
+    else if (comp(*b, *c))
+        custom::iter_swap(result, c);
+    else
+        custom::iter_swap(result, b);
+}
+
+// Hoare partition around *pivot, stopping on equal elements keeps duplicates balanced
+template<class RandomIt, class Compare>
+constexpr RandomIt _unguarded_partition(RandomIt first, RandomIt last, RandomIt pivot, Compare comp)
+{
+    while (true)
+    {
+        while (comp(*first, *pivot))
+            ++first;
+
+        --last;
+        while (comp(*pivot, *last))
+            --last;
+
+        if (!(first < last))
+            return first;
+
+        custom::iter_swap(first, last);
+        ++first;
+    }
+}
+
+template<class RandomIt, class Compare>
+constexpr RandomIt _partition_pivot(RandomIt first, RandomIt last, Compare comp)
+{
+    RandomIt middle = first + (last - first) / 2;
+    detail::_move_median_to_first(first, first + 1, middle, last - 1, comp);
+    return detail::_unguarded_partition(first + 1, last, first, comp);
+}
+
+template<class RandomIt>
+constexpr typename iterator_traits<RandomIt>::difference_type _introsort_depth(RandomIt first, RandomIt last)
+{
+    typename iterator_traits<RandomIt>::difference_type depth = 0;
+    for (auto count = last - first; count > 1; count >>= 1)
+        depth += 2;
+
+    return depth;   // 2 * log2(n)
+}
+
+template<class RandomIt, class Compare>
+constexpr void _introsort_loop( RandomIt first, RandomIt last,
+                                typename iterator_traits<RandomIt>::difference_type depthLimit,
+                                Compare comp)
+{
+    while (last - first > _INSERTION_SORT_MAX)
+    {
+        if (depthLimit == 0)    // quicksort is degrading, heapsort the rest
+        {
+            custom::make_heap(first, last, comp);
+            custom::sort_heap(first, last, comp);
+            return;
+        }
+
+        --depthLimit;
+        RandomIt cut = detail::_partition_pivot(first, last, comp);
+        detail::_introsort_loop(cut, last, depthLimit, comp);     // recurse right, loop left
+        last = cut;
+    }
+}
+
+template<class Type>
+struct _Merge_Buffer        // uninitialized storage for stable_sort, released on every exit path
+{
+    allocator<Type> _Alloc;
+    size_t _Size;
+    Type* _Ptr;
+
+    explicit _Merge_Buffer(const size_t size)
+        : _Size(size), _Ptr(_Alloc.allocate(size)) { /*Empty*/ }
+
+    _Merge_Buffer(const _Merge_Buffer&)             = delete;
+    _Merge_Buffer& operator=(const _Merge_Buffer&)  = delete;
+
+    ~_Merge_Buffer()
+    {
+        _Alloc.deallocate(_Ptr, _Size);
+    }
+};  // END _Merge_Buffer
+
+// Moves the shorter run into buffer and merges back into [first, last)
+// If comp throws, the buffered elements still waiting are moved back into the gap,
+// so [first, last) keeps all its elements (in unspecified order) and buffer is left empty.
+template<class RandomIt, class Type, class Compare>
+void _buffered_merge(RandomIt first, RandomIt middle, RandomIt last, Type* buffer, Compare comp)
+{
+    if (middle - first <= last - middle)
+    {
+        Type* bufferLast    = custom::uninitialized_move(first, middle, buffer);
+        Type* left          = buffer;
+        RandomIt out        = first;
+
+        try
+        {
+            while (left != bufferLast && middle != last)
+                *out++ = comp(*middle, *left) ? custom::move(*middle++) : custom::move(*left++);   // ties keep the left one first
+        }
+        catch (...)
+        {
+            custom::move(left, bufferLast, out);    // the gap is [out, middle), as long as the rest
+            custom::destroy(buffer, bufferLast);
+            CUSTOM_RERAISE;
+        }
+
+        custom::move(left, bufferLast, out);
+        custom::destroy(buffer, bufferLast);
+    }
+    else
+    {
+        Type* bufferLast    = custom::uninitialized_move(middle, last, buffer);
+        Type* right         = bufferLast;
+        RandomIt out        = last;
+
+        try
+        {
+            while (right != buffer && middle != first)
+                *--out = comp(*(right - 1), *(middle - 1)) ? custom::move(*--middle) : custom::move(*--right);
+        }
+        catch (...)
+        {
+            custom::move_backward(buffer, right, out);  // the gap is [middle, out)
+            custom::destroy(buffer, bufferLast);
+            CUSTOM_RERAISE;
+        }
+
+        custom::move_backward(buffer, right, out);
+        custom::destroy(buffer, bufferLast);
+    }
+}
+
+CUSTOM_DETAIL_END
+
+
+// sort - introsort: median-of-3 quicksort, heapsort when too deep, insertion sort for small ranges
+template<class RandomIt, class Compare>
+constexpr void sort(RandomIt first, RandomIt last, Compare comp)
+{
+    detail::_verify_iteration_range(first, last);
+
+    if (first == last)
+        return;
+
+    detail::_introsort_loop(first, last, detail::_introsort_depth(first, last), comp);
+    detail::_insertion_sort(first, last, comp);     // every element is at most _INSERTION_SORT_MAX away from its place
+}
+
+template<class RandomIt>
+constexpr void sort(RandomIt first, RandomIt last)
+{
+    custom::sort(first, last, less<>{});
+}
+// END sort
+
+
+// partial_sort - sorts the smallest (middle - first) elements into [first, middle)
+template<class RandomIt, class Compare>
+constexpr void partial_sort(RandomIt first, RandomIt middle, RandomIt last, Compare comp)
+{
+    detail::_verify_iteration_range(first, middle);
+    detail::_verify_iteration_range(middle, last);
+
+    detail::_heap_select(first, middle, last, comp);
+    custom::sort_heap(first, middle, comp);
+}
+
+template<class RandomIt>
+constexpr void partial_sort(RandomIt first, RandomIt middle, RandomIt last)
+{
+    custom::partial_sort(first, middle, last, less<>{});
+}
+// END partial_sort
+
+
+// stable_sort - insertion sorted runs merged bottom-up through a buffer of at most n / 2 elements
+template<class RandomIt, class Compare>
+void stable_sort(RandomIt first, RandomIt last, Compare comp)
+{
+    using _Value    = typename iterator_traits<RandomIt>::value_type;
+    using _Diff     = typename iterator_traits<RandomIt>::difference_type;
+
+    detail::_verify_iteration_range(first, last);
+
+    const _Diff count = last - first;
+    if (count <= detail::_MERGE_RUN_SIZE)
+    {
+        detail::_insertion_sort(first, last, comp);
+        return;
+    }
+
+    for (_Diff low = 0; low < count; low += detail::_MERGE_RUN_SIZE)
+        detail::_insertion_sort(first + low, first + ((count - low < detail::_MERGE_RUN_SIZE) ? count : low + detail::_MERGE_RUN_SIZE), comp);
+
+    detail::_Merge_Buffer<_Value> buffer(static_cast<size_t>(count / 2));
+
+    for (_Diff width = detail::_MERGE_RUN_SIZE; width < count; width *= 2)
+        for (_Diff low = 0; low < count - width; low += 2 * width)
+        {
+            RandomIt runFirst   = first + low;
+            RandomIt middle     = runFirst + width;
+            RandomIt runLast    = first + ((count - low < 2 * width) ? count : low + 2 * width);
+
+            if (comp(*middle, *(middle - 1)))   // runs not already in order
+                detail::_buffered_merge(runFirst, middle, runLast, buffer._Ptr, comp);
+        }
+}
+
+template<class RandomIt>
+void stable_sort(RandomIt first, RandomIt last)
+{
+    custom::stable_sort(first, last, less<>{});
+}
+// END stable_sort
+
+
+// nth_element - introselect: quickselect partitions, heap select when too deep
+template<class RandomIt, class Compare>
+constexpr void nth_element(RandomIt first, RandomIt nth, RandomIt last, Compare comp)
+{
+    detail::_verify_iteration_range(first, nth);
+    detail::_verify_iteration_range(nth, last);
+
+    if (nth == last)
+        return;
+
+    auto depthLimit = detail::_introsort_depth(first, last);
+
+    while (last - first > 3)
+    {
+        if (depthLimit == 0)
+        {
+            detail::_heap_select(first, nth + 1, last, comp);
+            custom::iter_swap(first, nth);     // heap top is the largest of the nth + 1 smallest
+            return;
+        }
+
+        --depthLimit;
+        RandomIt cut = detail::_partition_pivot(first, last, comp);
+        if (cut <= nth)
+            first = cut;
+        else
+            last = cut;
+    }
+
+    detail::_insertion_sort(first, last, comp);
+}
+
+template<class RandomIt>
+constexpr void nth_element(RandomIt first, RandomIt nth, RandomIt last)
+{
+    custom::nth_element(first, nth, last, less<>{});
+}
+// END nth_element
 #pragma endregion Sorting operations
 
 
 #pragma region Binary search operations // (on sorted ranges)
-// TODO: implement
+CUSTOM_DETAIL_BEGIN
+
+template<class RandomIt>
+constexpr void _prefetch_element(const RandomIt& it) noexcept
+{
+    if (!custom::is_constant_evaluated())
+        CUSTOM_PREFETCH(&*it);
+}
+
+// partition_point for random access ranges: the comparison result selects the next base
+// through a conditional move instead of a branch, and both candidate midpoints of the next
+// step are prefetched while the current one is compared
+template<class RandomIt, class UnaryPredicate>
+constexpr RandomIt _branchless_partition_point(RandomIt first, RandomIt last, UnaryPredicate pred)
+{
+    using _Diff = typename iterator_traits<RandomIt>::difference_type;
+
+    detail::_verify_iteration_range(first, last);
+
+    _Diff length = last - first;
+    if (length == 0)
+        return first;
+
+    _Diff base = 0;
+    while (length > 1)
+    {
+        const _Diff half = length / 2;
+        detail::_prefetch_element(first + (base + half / 2));
+        detail::_prefetch_element(first + (base + half + half / 2));
+
+        base    += static_cast<bool>(pred(*(first + (base + half)))) ? half : 0;
+        length  -= half;
+    }
+
+    return first + (base + static_cast<bool>(pred(*(first + base))));
+}
+
+template<class ForwardIt, class UnaryPredicate>
+constexpr ForwardIt _sorted_partition_point(ForwardIt first, ForwardIt last, UnaryPredicate pred)
+{
+    if constexpr (is_random_access_iterator_v<ForwardIt>)
+        return detail::_branchless_partition_point(first, last, pred);
+    else
+        return custom::partition_point(first, last, pred);
+}
+
+CUSTOM_DETAIL_END
+
+
+// lower_bound - first element not less than value
+template<class ForwardIt, class Type, class Compare>
+constexpr ForwardIt lower_bound(ForwardIt first, ForwardIt last, const Type& value, Compare comp)
+{
+    return detail::_sorted_partition_point(first, last,
+                                            [&value, &comp](const auto& elem) { return static_cast<bool>(comp(elem, value)); });
+}
+
+template<class ForwardIt, class Type>
+constexpr ForwardIt lower_bound(ForwardIt first, ForwardIt last, const Type& value)
+{
+    return custom::lower_bound(first, last, value, less<>{});
+}
+// END lower_bound
+
+
+// upper_bound - first element greater than value
+template<class ForwardIt, class Type, class Compare>
+constexpr ForwardIt upper_bound(ForwardIt first, ForwardIt last, const Type& value, Compare comp)
+{
+    return detail::_sorted_partition_point(first, last,
+                                            [&value, &comp](const auto& elem) { return !static_cast<bool>(comp(value, elem)); });
+}
+
+template<class ForwardIt, class Type>
+constexpr ForwardIt upper_bound(ForwardIt first, ForwardIt last, const Type& value)
+{
+    return custom::upper_bound(first, last, value, less<>{});
+}
+// END upper_bound
+
+
+// equal_range
+template<class ForwardIt, class Type, class Compare>
+constexpr custom::pair<ForwardIt, ForwardIt> equal_range(ForwardIt first, ForwardIt last, const Type& value, Compare comp)
+{
+    ForwardIt lower = custom::lower_bound(first, last, value, comp);
+    return {lower, custom::upper_bound(lower, last, value, comp)};
+}
+
+template<class ForwardIt, class Type>
+constexpr custom::pair<ForwardIt, ForwardIt> equal_range(ForwardIt first, ForwardIt last, const Type& value)
+{
+    return custom::equal_range(first, last, value, less<>{});
+}
+// END equal_range
+
+
+// binary_search
+template<class ForwardIt, class Type, class Compare>
+constexpr bool binary_search(ForwardIt first, ForwardIt last, const Type& value, Compare comp)
+{
+    first = custom::lower_bound(first, last, value, comp);
+    return first != last && !static_cast<bool>(comp(value, *first));
+}
+
+template<class ForwardIt, class Type>
+constexpr bool binary_search(ForwardIt first, ForwardIt last, const Type& value)
+{
+    return custom::binary_search(first, last, value, less<>{});
+}
+// END binary_search
 #pragma endregion Binary search operations
 
 
@@ -557,80 +1023,174 @@ constexpr OutputIt set_intersection(InputIt1 first1, InputIt1 last1,
 
 
 #pragma region Heap operations
-template<class RandomIt>
-constexpr void make_heap(RandomIt first, RandomIt last)
+CUSTOM_DETAIL_BEGIN
+
+// Moves value up from hole while its parent compares less (max heap)
+template<class RandomIt, class Diff, class Type, class Compare>
+constexpr void _push_heap_by_index(RandomIt first, Diff hole, const Diff top, Type&& value, Compare comp)
+{
+    for (Diff parent = (hole - 1) / 2; hole > top && comp(*(first + parent), value); parent = (hole - 1) / 2)
+    {
+        *(first + hole) = custom::move(*(first + parent));
+        hole = parent;
+    }
+
+    *(first + hole) = custom::move(value);
+}
+
+// Moves the hole down to a leaf through the larger children, then pushes value back up (fewer compares than sift down)
+template<class RandomIt, class Diff, class Type, class Compare>
+constexpr void _pop_heap_hole_by_index(RandomIt first, Diff hole, const Diff count, Type&& value, Compare comp)
+{
+    const Diff top  = hole;
+    Diff child      = hole;
+
+    while (child < (count - 1) / 2)
+    {
+        child = 2 * (child + 1);                        // right child
+        if (comp(*(first + child), *(first + (child - 1))))
+            --child;                                    // left child is larger
+
+        *(first + hole) = custom::move(*(first + child));
+        hole = child;
+    }
+
+    if ((count & 1) == 0 && child == (count - 2) / 2)   // last parent has only a left child
+    {
+        child = 2 * (child + 1);
+        *(first + hole) = custom::move(*(first + (child - 1)));
+        hole = child - 1;
+    }
+
+    detail::_push_heap_by_index(first, hole, top, custom::move(value), comp);
+}
+
+template<class RandomIt, class Compare>
+constexpr void _heap_select(RandomIt first, RandomIt middle, RandomIt last, Compare comp)
 {
-    // TODO: implement
+    // keep the (middle - first) smallest elements as a max heap in [first, middle)
+    if (first == middle)
+        return;
+
+    custom::make_heap(first, middle, comp);
+
+    for (RandomIt it = middle; it != last; ++it)
+        if (comp(*it, *first))
+        {
+            typename iterator_traits<RandomIt>::value_type value = custom::move(*it);
+            *it = custom::move(*first);
+            detail::_pop_heap_hole_by_index(first, typename iterator_traits<RandomIt>::difference_type(0), middle - first, custom::move(value), comp);
+        }
 }
 
+CUSTOM_DETAIL_END
+
+
 template<class RandomIt, class Compare>
 constexpr void make_heap(RandomIt first, RandomIt last, Compare comp)
 {
-    // TODO: implement
+    detail::_verify_iteration_range(first, last);
+
+    const auto count = last - first;
+    for (auto hole = count / 2; hole > 0; )     // heapify from the last parent up
+    {
+        --hole;
+        typename iterator_traits<RandomIt>::value_type value = custom::move(*(first + hole));
+        detail::_pop_heap_hole_by_index(first, hole, count, custom::move(value), comp);
+    }
 }
 
 template<class RandomIt>
-constexpr void push_heap(RandomIt first, RandomIt last)
+constexpr void make_heap(RandomIt first, RandomIt last)
 {
-    // TODO: implement
+    custom::make_heap(first, last, less<>{});
 }
 
+// push *(last - 1) into the heap [first, last - 1)
 template<class RandomIt, class Compare>
 constexpr void push_heap(RandomIt first, RandomIt last, Compare comp)
 {
-    // TODO: implement
+    detail::_verify_iteration_range(first, last);
+
+    const auto count = last - first;
+    if (count < 2)
+        return;
+
+    typename iterator_traits<RandomIt>::value_type value = custom::move(*(last - 1));
+    detail::_push_heap_by_index(first, count - 1, decltype(count)(0), custom::move(value), comp);
 }
 
 template<class RandomIt>
-constexpr void pop_heap(RandomIt first, RandomIt last)
+constexpr void push_heap(RandomIt first, RandomIt last)
 {
-    // TODO: implement
+    custom::push_heap(first, last, less<>{});
 }
 
+// move the largest element to *(last - 1) and make [first, last - 1) a heap
 template<class RandomIt, class Compare>
 constexpr void pop_heap(RandomIt first, RandomIt last, Compare comp)
 {
-    // TODO: implement
+    detail::_verify_iteration_range(first, last);
+
+    if (last - first < 2)
+        return;
+
+    --last;
+    typename iterator_traits<RandomIt>::value_type value = custom::move(*last);
+    *last = custom::move(*first);
+    detail::_pop_heap_hole_by_index(first, decltype(last - first)(0), last - first, custom::move(value), comp);
 }
 
 template<class RandomIt>
-constexpr void sort_heap(RandomIt first, RandomIt last)
+constexpr void pop_heap(RandomIt first, RandomIt last)
 {
-    // TODO: implement
+    custom::pop_heap(first, last, less<>{});
 }
 
 template<class RandomIt, class Compare>
 constexpr void sort_heap(RandomIt first, RandomIt last, Compare comp)
 {
-    // TODO: implement
+    detail::_verify_iteration_range(first, last);
+
+    for (/*Empty*/; last - first > 1; --last)
+        custom::pop_heap(first, last, comp);
 }
 
 template<class RandomIt>
-constexpr bool is_heap(RandomIt first, RandomIt last)
+constexpr void sort_heap(RandomIt first, RandomIt last)
 {
-    // TODO: implement
-    return false;
+    custom::sort_heap(first, last, less<>{});
 }
 
 template<class RandomIt, class Compare>
-constexpr bool is_heap(RandomIt first, RandomIt last, Compare comp)
+constexpr RandomIt is_heap_until(RandomIt first, RandomIt last, Compare comp)
 {
-    // TODO: implement
-    return false;
+    detail::_verify_iteration_range(first, last);
+
+    const auto count = last - first;
+    for (decltype(last - first) child = 1; child < count; ++child)
+        if (comp(*(first + (child - 1) / 2), *(first + child)))
+            return first + child;
+
+    return last;
 }
 
 template<class RandomIt>
 constexpr RandomIt is_heap_until(RandomIt first, RandomIt last)
 {
-    // TODO: implement
-    return RandomIt();
+    return custom::is_heap_until(first, last, less<>{});
 }
 
 template<class RandomIt, class Compare>
-constexpr RandomIt is_heap_until(RandomIt first, RandomIt last, Compare comp)
+constexpr bool is_heap(RandomIt first, RandomIt last, Compare comp)
+{
+    return custom::is_heap_until(first, last, comp) == last;
+}
+
+template<class RandomIt>
+constexpr bool is_heap(RandomIt first, RandomIt last)
 {
-    // TODO: implement
-    return RandomIt();
+    return custom::is_heap_until(first, last, less<>{}) == last;
 }
 #pragma endregion Heap operations
 
@@ -111,6 +111,31 @@ public:
 		return !(*this == other);
 	}
 
+	constexpr difference_type operator-(const _Array_Const_Iterator& other) const noexcept
+	{
+		return static_cast<difference_type>(_Index) - static_cast<difference_type>(other._Index);
+	}
+
+	constexpr bool operator<(const _Array_Const_Iterator& other) const noexcept
+	{
+		return _Index < other._Index;
+	}
+
+	constexpr bool operator>(const _Array_Const_Iterator& other) const noexcept
+	{
+		return other < *this;
+	}
+
+	constexpr bool operator<=(const _Array_Const_Iterator& other) const noexcept
+	{
+		return !(other < *this);
+	}
+
+	constexpr bool operator>=(const _Array_Const_Iterator& other) const noexcept
+	{
+		return !(*this < other);
+	}
+
 public:
 
 	// Get the position for the element in array from iterator
@@ -208,6 +233,8 @@ public:
 		return temp;
 	}
 
+	using _Base::operator-;
+
 	constexpr pointer operator->() const noexcept
 	{
 		return const_cast<pointer>(_Base::operator->());
@@ -0,0 +1,180 @@
+#pragma once
+
+#if defined __GNUG__
+#include "custom/thread.h"
+
+#if defined __linux__
+#include "custom/_futex.h"
+#endif  // __linux__
+
+#include <atomic>
+
+
+CUSTOM_BEGIN
+
+CUSTOM_DETAIL_BEGIN
+
+constexpr size_t _CACHE_LINE_SIZE = 64;     // keeps data written by different threads on different lines
+
+#if defined __linux__
+// Parking for atomic<Type>::wait. A 4-byte atomic is its own futex word: waiters sleep on it
+// and the kernel re-checks the value. Other sizes sleep on the version word of a bucket picked
+// by address, notify bumps the version and wakes the whole bucket, every sleeper re-checks its
+// own object. The bucket waiter count lets notify skip the syscall when nobody sleeps.
+// Before sleeping a waiter spins briefly (only with another core to change the value) and then
+// yields a few times, so a notifier that is merely runnable costs no sleep and wake pair.
+// Nothing is allocated per atomic and notify never touches more than the object's address,
+// so an object may be destroyed by a waiter that returned before notify finished.
+
+constexpr size_t _WAIT_BUCKET_COUNT = 16;
+constexpr int _WAIT_SPIN_LIMIT      = 100;
+constexpr int _WAIT_YIELD_LIMIT     = 8;
+
+struct alignas(_CACHE_LINE_SIZE) _Wait_Bucket
+{
+    _Futex_Word _Version            = 0;
+    std::atomic<uint32_t> _Waiters  = 0;
+};
+
+inline _Wait_Bucket& _wait_bucket(const void* const address) noexcept
+{
+    static _Wait_Bucket buckets[_WAIT_BUCKET_COUNT];
+
+    const uintptr_t key = reinterpret_cast<uintptr_t>(address);
+    return buckets[((key >> 2) ^ (key >> 8)) % _WAIT_BUCKET_COUNT];
+}
+
+template<class Type>
+constexpr bool _Is_Futex_Sized =    sizeof(std::atomic<Type>) == sizeof(uint32_t) &&
+                                    std::atomic<Type>::is_always_lock_free;
+
+template<class Type>
+bool _same_value(const Type& left, const Type& right) noexcept     // wait compares value representations
+{
+    return __builtin_memcmp(std::addressof(left), std::addressof(right), sizeof(Type)) == 0;
+}
+
+inline int _wait_spin_limit() noexcept
+{
+    static const int limit = thread::hardware_concurrency() > 1 ? _WAIT_SPIN_LIMIT : 0;
+    return limit;
+}
+
+template<class Type>
+void _atomic_wait(const std::atomic<Type>& object, const Type& old, const std::memory_order order) noexcept
+{
+    for (int spin = _wait_spin_limit(); spin > 0; --spin)    // a short wait is cheaper than a sleep
+    {
+        if (!_same_value(object.load(order), old))
+            return;
+
+        _cpu_relax();
+    }
+
+    for (int yield = _WAIT_YIELD_LIMIT; yield > 0; --yield)     // lets the notifier run on a busy core
+    {
+        if (!_same_value(object.load(order), old))
+            return;
+
+        this_thread::yield();
+    }
+
+    _Wait_Bucket& bucket = _wait_bucket(std::addressof(object));
+
+    while (_same_value(object.load(order), old))
+    {
+        bucket._Waiters.fetch_add(1, std::memory_order_seq_cst);
+
+        if constexpr (_Is_Futex_Sized<Type>)
+        {
+            uint32_t expected;
+            __builtin_memcpy(&expected, std::addressof(old), sizeof(uint32_t));
+            _futex_wait(reinterpret_cast<const _Futex_Word*>(std::addressof(object)), expected);
+        }
+        else
+        {
+            const uint32_t version = bucket._Version.load(std::memory_order_seq_cst);
+            if (_same_value(object.load(std::memory_order_seq_cst), old))
+                _futex_wait(&bucket._Version, version);
+        }
+
+        bucket._Waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+template<class Type>
+void _atomic_notify(const std::atomic<Type>& object, const bool all) noexcept
+{
+    _Wait_Bucket& bucket = _wait_bucket(std::addressof(object));
+
+    // An RMW reads the latest count. If it is 0, a later waiter synchronizes with it
+    // and is bound to see the value stored before this notify.
+    if (bucket._Waiters.fetch_add(0, std::memory_order_seq_cst) == 0)
+        return;
+
+    if constexpr (_Is_Futex_Sized<Type>)
+        _futex_wake(reinterpret_cast<const _Futex_Word*>(std::addressof(object)), all ? INT_MAX : 1);
+    else
+    {
+        bucket._Version.fetch_add(1, std::memory_order_seq_cst);
+        _futex_wake(&bucket._Version, INT_MAX);     // the bucket is shared, waking one could pick the wrong waiter
+    }
+}
+#endif  // __linux__
+
+CUSTOM_DETAIL_END
+
+template<class Type>
+struct atomic : public std::atomic<Type>        // std::atomic with futex-backed wait and notify
+{
+private:
+    using _Base = std::atomic<Type>;
+
+public:
+    // Constructors & Operators
+
+    using std::atomic<Type>::atomic;
+    using _Base::operator=;
+
+    atomic() = default;
+
+    atomic(const atomic&)                       = delete;
+    atomic& operator=(const atomic&)            = delete;
+    atomic& operator=(const atomic&) volatile   = delete;
+
+public:
+    // Main functions
+
+    void wait(const Type old, const std::memory_order order = std::memory_order_seq_cst) const noexcept
+    {
+#if defined __linux__
+        detail::_atomic_wait<Type>(*this, old, order);
+#else
+        _Base::wait(old, order);
+#endif
+    }
+
+    void notify_one() noexcept
+    {
+#if defined __linux__
+        detail::_atomic_notify<Type>(*this, false);
+#else
+        _Base::notify_one();
+#endif
+    }
+
+    void notify_all() noexcept
+    {
+#if defined __linux__
+        detail::_atomic_notify<Type>(*this, true);
+#else
+        _Base::notify_all();
+#endif
+    }
+}; // END atomic
+
+CUSTOM_END
+
+#elif defined _MSC_VER
+#error NO Atomic implementation
+#endif      // __GNUG__ and _MSC_VER
@@ -1,29 +1,63 @@
 #pragma once
 
 #if defined __GNUG__
-#include "custom/thread.h"
+#include "custom/atomic.h"
+
 
 CUSTOM_BEGIN
 
-// template<class CompletionFunction /*TODO: check*/>
-class barrier                       // barrier adaptor for pthread_barrier_t
+CUSTOM_DETAIL_BEGIN
+
+struct _Empty_Completion
+{
+    void operator()() noexcept { /*Empty*/ }
+};
+
+CUSTOM_DETAIL_END
+
+template<class CompletionFunction = detail::_Empty_Completion>
+class barrier                       // phase-counting barrier, waiters sleep on the phase word
 {
+// _state packs the current phase (high half) with the arrivals it still expects (low half),
+// so one fetch_sub both counts an arrival and tells which phase it belongs to.
+// The last arrival runs the completion, re-arms _state with the participants left after
+// arrive_and_drop and publishes the phase in _phase, a 4-byte futex word the waiters sleep on.
+// _phase has its own cache line, spinning waiters are not disturbed by late arrivals.
+
+    static_assert(is_nothrow_invocable_v<CompletionFunction&>, "Barrier completion must be nothrow invocable.");
+
+public:
+    class arrival_token
+    {
+    private:
+        friend barrier;
+
+        uint32_t _Phase;
+
+        explicit arrival_token(const uint32_t phase) noexcept
+            : _Phase(phase) { /*Empty*/ }
+    }; // END arrival_token
+
 private:
-    pthread_barrier_t _barrier;
+    static constexpr int _PHASE_SHIFT = 32;
+    static constexpr uint64_t _COUNT_MASK = (uint64_t{1} << _PHASE_SHIFT) - 1;
+
+    alignas(detail::_CACHE_LINE_SIZE) std::atomic<uint64_t> _state;
+    std::atomic<ptrdiff_t> _expected;       // participants of the next phase
+    CompletionFunction _completion;
+
+    alignas(detail::_CACHE_LINE_SIZE) atomic<uint32_t> _phase = 0;
 
 public:
     // Constructors & Operators
 
-    explicit barrier(int expected) noexcept
+    explicit barrier(const ptrdiff_t expected, CompletionFunction completion = CompletionFunction())
+        : _state(static_cast<uint64_t>(expected)), _expected(expected), _completion(custom::move(completion))
     {
-        CUSTOM_ASSERT(expected >= 0, "Invalid expected value.");
-        pthread_barrier_init(&_barrier, nullptr, expected);
+        CUSTOM_ASSERT(expected >= 0 && expected <= (max)(), "Invalid expected value.");
     }
 
-    ~barrier() noexcept
-    {
-        pthread_barrier_destroy(&_barrier);
-    }
+    ~barrier() noexcept = default;
 
     barrier(const barrier&)            = delete;
     barrier& operator=(const barrier&) = delete;
@@ -31,24 +65,61 @@ public:
 public:
     // Main functions
 
-    static constexpr int (max)() noexcept
+    static constexpr ptrdiff_t (max)() noexcept
     {
         return INT_MAX;
     }
 
+    [[nodiscard]] arrival_token arrive(const ptrdiff_t update = 1) noexcept
+    {
+        CUSTOM_ASSERT(update > 0, "Invalid update value.");
+
+        const uint64_t old      = _state.fetch_sub(static_cast<uint64_t>(update), std::memory_order_acq_rel);
+        const uint32_t phase    = static_cast<uint32_t>(old >> _PHASE_SHIFT);
+
+        CUSTOM_ASSERT(static_cast<ptrdiff_t>(old & _COUNT_MASK) >= update, "Update exceeds the expected arrivals.");
+
+        if (static_cast<ptrdiff_t>(old & _COUNT_MASK) == update)
+            _complete_phase(phase);
+
+        return arrival_token(phase);
+    }
+
+    void wait(arrival_token&& arrival) const noexcept
+    {
+        _phase.wait(arrival._Phase, std::memory_order_acquire);
+    }
+
     void arrive_and_wait() noexcept
     {
-        pthread_barrier_wait(&_barrier);
+        wait(arrive());
     }
 
-    // void arrive();
-    // void wait();
-    // void arrive_and_drop();
+    void arrive_and_drop() noexcept
+    {
+        _expected.fetch_sub(1, std::memory_order_relaxed);     // published by the arrival below
+        (void)arrive();
+    }
+
+private:
+    // Helpers
 
+    void _complete_phase(const uint32_t phase) noexcept
+    {
+        _completion();
+
+        const uint32_t next = phase + 1;
+        _state.store(   (static_cast<uint64_t>(next) << _PHASE_SHIFT) |
+                        static_cast<uint64_t>(_expected.load(std::memory_order_relaxed)),
+                        std::memory_order_relaxed);
+
+        _phase.store(next, std::memory_order_release);      // next arrivals start after seeing it
+        _phase.notify_all();
+    }
 }; // END barrier
 
 CUSTOM_END
 
 #elif defined _MSC_VER
 #error NO Barrier implementation
-#endif      // __GNUG__ and _MSC_VER
\ No newline at end of file
+#endif      // __GNUG__ and _MSC_VER
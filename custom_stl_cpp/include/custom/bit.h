@@ -36,12 +36,25 @@ constexpr bool has_single_bit(Ty val) noexcept
 }
 
 
-// Implementation of countl_zero without using specialized CPU instructions.
-// Used at compile time and when said instructions are not supported.
+// Uses the compiler builtins (single instruction) when available.
+// Otherwise falls back to an implementation without specialized CPU instructions.
 // see "Hacker's Delight" section 5-3
 template<class Ty, enable_if_t<is_unsigned_integer_v<Ty>, bool> = true>
 constexpr int countl_zero(Ty val) noexcept
 {
+#ifdef __GNUG__
+    constexpr int digits = numeric_limits<Ty>::digits;
+
+    if (val == 0)
+        return digits;
+
+    if constexpr (digits <= numeric_limits<unsigned>::digits)
+        return __builtin_clz(val) - (numeric_limits<unsigned>::digits - digits);
+    else if constexpr (digits <= numeric_limits<unsigned long>::digits)
+        return __builtin_clzl(val) - (numeric_limits<unsigned long>::digits - digits);
+    else // (digits <= numeric_limits<unsigned long long>::digits)
+        return __builtin_clzll(val) - (numeric_limits<unsigned long long>::digits - digits);
+#else // __GNUG__
     Ty yy = 0;
 
     unsigned int nn = numeric_limits<Ty>::digits;
@@ -61,17 +74,31 @@ constexpr int countl_zero(Ty val) noexcept
     } while (cc != 0);
 
     return static_cast<int>(nn) - static_cast<int>(val);
+#endif // __GNUG__
 }
 
 
-// Implementation of countr_zero without using specialized CPU instructions.
-// Used at compile time and when said instructions are not supported.
+// Uses the compiler builtins (single instruction) when available.
+// Otherwise falls back to an implementation without specialized CPU instructions.
 // see "Hacker's Delight" section 5-4
 template<class Ty, enable_if_t<is_unsigned_integer_v<Ty>, bool> = true>
 constexpr int countr_zero(Ty val) noexcept
 {
     constexpr int digits = numeric_limits<Ty>::digits;
+
+#ifdef __GNUG__
+    if (val == 0)
+        return digits;
+
+    if constexpr (digits <= numeric_limits<unsigned>::digits)
+        return __builtin_ctz(val);
+    else if constexpr (digits <= numeric_limits<unsigned long>::digits)
+        return __builtin_ctzl(val);
+    else // (digits <= numeric_limits<unsigned long long>::digits)
+        return __builtin_ctzll(val);
+#else // __GNUG__
     return digits - countl_zero(static_cast<Ty>(static_cast<Ty>(~val) & static_cast<Ty>(val - 1)));
+#endif // __GNUG__
 }
 
 
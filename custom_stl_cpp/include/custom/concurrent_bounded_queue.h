@@ -0,0 +1,254 @@
+#pragma once
+
+#if defined __GNUG__
+#include "custom/atomic.h"
+#include "custom/memory.h"
+#include "custom/bit.h"
+
+#include <atomic>
+
+
+CUSTOM_BEGIN
+
+template<class Type>
+class concurrent_bounded_queue      // lock-free bounded MPMC queue on a power-of-two ring
+{
+// Vyukov's bounded queue: every slot carries a sequence number telling which lap of the ring
+// it is ready for. A slot at position pos accepts a push when its sequence is pos and a pop
+// when it is pos + 1; the pop re-arms it with pos + capacity for the next lap. Producers and
+// consumers claim positions with a CAS on _tail and _head, which live on their own cache lines,
+// and then only touch the claimed slot.
+// Blocking push and pop park on an epoch word (futex, see atomic::wait). The other side bumps
+// and notifies the epoch only when the waiter count is non-zero, so the hot path stays a CAS,
+// a fence and a relaxed load.
+
+    static_assert(  is_nothrow_move_constructible_v<Type> && is_nothrow_move_assignable_v<Type> &&
+                    is_nothrow_destructible_v<Type>,
+                    "A claimed slot cannot be given back, elements must move without throwing.");
+
+public:
+    using value_type        = Type;
+    using size_type         = size_t;
+    using reference         = value_type&;
+    using const_reference   = const value_type&;
+
+private:
+    struct _Slot
+    {
+        std::atomic<size_t> _Sequence;
+        union
+        {
+            value_type _Value;
+        };
+
+        _Slot() noexcept { /*Empty*/ }
+        ~_Slot() { /*Empty*/ }      // the queue destroys the values still inside
+    };
+
+    alignas(detail::_CACHE_LINE_SIZE) std::atomic<size_t> _head = 0;    // next position to pop
+    alignas(detail::_CACHE_LINE_SIZE) std::atomic<size_t> _tail = 0;    // next position to push
+
+    alignas(detail::_CACHE_LINE_SIZE) unique_ptr<_Slot[]> _slots;
+    size_t _mask;
+
+    alignas(detail::_CACHE_LINE_SIZE) atomic<uint32_t> _itemsEpoch  = 0;   // bumped for sleeping consumers
+    atomic<uint32_t> _spaceEpoch                                    = 0;   // bumped for sleeping producers
+    std::atomic<uint32_t> _popWaiters                               = 0;
+    std::atomic<uint32_t> _pushWaiters                              = 0;
+
+public:
+    // Constructors & Operators
+
+    explicit concurrent_bounded_queue(const size_type capacity)      // rounded up to a power of two, at least 2
+        : _slots(new _Slot[_ring_size(capacity)]), _mask(_ring_size(capacity) - 1)
+    {
+        for (size_t i = 0; i <= _mask; ++i)
+            _slots[i]._Sequence.store(i, std::memory_order_relaxed);
+    }
+
+    ~concurrent_bounded_queue()
+    {
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        for (size_t pos = _head.load(std::memory_order_relaxed); pos != tail; ++pos)
+            custom::destroy_at(std::addressof(_slots[pos & _mask]._Value));
+    }
+
+    concurrent_bounded_queue(const concurrent_bounded_queue&)            = delete;
+    concurrent_bounded_queue& operator=(const concurrent_bounded_queue&) = delete;
+
+public:
+    // Main functions
+
+    size_type capacity() const noexcept
+    {
+        return _mask + 1;
+    }
+
+    size_type size() const noexcept     // a snapshot, other threads may change it meanwhile
+    {
+        const size_t head = _head.load(std::memory_order_acquire);
+        const size_t tail = _tail.load(std::memory_order_acquire);
+        if (tail <= head)
+            return 0;
+
+        return tail - head < capacity() ? tail - head : capacity();
+    }
+
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    bool try_push(const value_type& copyValue)
+    {
+        return _try_emplace(value_type(copyValue));     // a throwing copy happens before a slot is claimed
+    }
+
+    bool try_push(value_type&& moveValue) noexcept
+    {
+        return _try_emplace(custom::move(moveValue));
+    }
+
+    template<class... Args>
+    bool try_emplace(Args&&... args)
+    {
+        if constexpr (is_nothrow_constructible_v<value_type, Args...>)
+            return _try_emplace(custom::forward<Args>(args)...);
+        else
+            return _try_emplace(value_type(custom::forward<Args>(args)...));
+    }
+
+    bool try_pop(value_type& destination) noexcept
+    {
+        size_t pos = _head.load(std::memory_order_relaxed);
+        _Slot* slot;
+
+        for (;;)
+        {
+            slot                    = &_slots[pos & _mask];
+            const size_t sequence   = slot->_Sequence.load(std::memory_order_acquire);
+            const ptrdiff_t lap     = static_cast<ptrdiff_t>(sequence - (pos + 1));
+
+            if (lap == 0)
+            {
+                if (_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed, std::memory_order_relaxed))
+                    break;
+            }
+            else if (lap < 0)       // not pushed yet, empty
+                return false;
+            else                    // another consumer took it, reload
+                pos = _head.load(std::memory_order_relaxed);
+        }
+
+        destination = custom::move(slot->_Value);
+        custom::destroy_at(std::addressof(slot->_Value));
+        slot->_Sequence.store(pos + _mask + 1, std::memory_order_release);
+
+        _signal(_spaceEpoch, _pushWaiters);
+        return true;
+    }
+
+    void push(const value_type& copyValue)
+    {
+        emplace(copyValue);
+    }
+
+    void push(value_type&& moveValue) noexcept
+    {
+        _wait_until(_spaceEpoch, _pushWaiters, [this, &moveValue]() { return _try_emplace(custom::move(moveValue)); });
+    }
+
+    template<class... Args>
+    void emplace(Args&&... args)
+    {
+        if constexpr (is_nothrow_constructible_v<value_type, Args...>)
+            _wait_until(_spaceEpoch, _pushWaiters, [this, &args...]() { return _try_emplace(custom::forward<Args>(args)...); });
+        else
+            push(value_type(custom::forward<Args>(args)...));
+    }
+
+    void pop(value_type& destination) noexcept
+    {
+        _wait_until(_itemsEpoch, _popWaiters, [this, &destination]() { return try_pop(destination); });
+    }
+
+private:
+    // Helpers
+
+    static size_t _ring_size(const size_type capacity) noexcept
+    {
+        return custom::bit_ceil(capacity < 2 ? size_type(2) : capacity);
+    }
+
+    template<class... Args>
+    bool _try_emplace(Args&&... args) noexcept     // args are only consumed when a slot was claimed
+    {
+        size_t pos = _tail.load(std::memory_order_relaxed);
+        _Slot* slot;
+
+        for (;;)
+        {
+            slot                    = &_slots[pos & _mask];
+            const size_t sequence   = slot->_Sequence.load(std::memory_order_acquire);
+            const ptrdiff_t lap     = static_cast<ptrdiff_t>(sequence - pos);
+
+            if (lap == 0)
+            {
+                if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed, std::memory_order_relaxed))
+                    break;
+            }
+            else if (lap < 0)       // not popped yet since the previous lap, full
+                return false;
+            else                    // another producer took it, reload
+                pos = _tail.load(std::memory_order_relaxed);
+        }
+
+        custom::construct_at(std::addressof(slot->_Value), custom::forward<Args>(args)...);
+        slot->_Sequence.store(pos + 1, std::memory_order_release);
+
+        _signal(_itemsEpoch, _popWaiters);
+        return true;
+    }
+
+    static void _signal(atomic<uint32_t>& epoch, const std::atomic<uint32_t>& waiters) noexcept
+    {
+        // pairs with the fence in _wait_until: either the waiter sees the slot we just
+        // published, or we see its registration and wake it
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (waiters.load(std::memory_order_relaxed) != 0)
+        {
+            epoch.fetch_add(1, std::memory_order_release);     // a waiter reading the bump also sees the slot
+            epoch.notify_one();
+        }
+    }
+
+    template<class Attempt>
+    static void _wait_until(atomic<uint32_t>& epoch, std::atomic<uint32_t>& waiters, Attempt attempt) noexcept
+    {
+        while (!attempt())
+        {
+            waiters.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            // Acquire pairs with the release bump in _signal and keeps the re-check after this load.
+            // If seen already includes a bump, the slot it announced is visible to attempt();
+            // if not, the bump comes later and changes the word we sleep on.
+            const uint32_t seen = epoch.load(std::memory_order_acquire);
+            const bool done     = attempt();    // re-check after registering, a signal may have been skipped
+            if (!done)
+                epoch.wait(seen, std::memory_order_relaxed);
+
+            waiters.fetch_sub(1, std::memory_order_relaxed);
+
+            if (done)
+                return;
+        }
+    }
+}; // END concurrent_bounded_queue
+
+CUSTOM_END
+
+#elif defined _MSC_VER
+#error NO Concurrent queue implementation
+#endif      // __GNUG__ and _MSC_VER
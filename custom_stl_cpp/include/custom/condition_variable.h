@@ -15,6 +15,149 @@ enum class cv_status
     timeout
 };
 
+#if defined __linux__
+class condition_variable         // condition variable on a futex sequence word
+{
+// Every notify bumps _sequence. A waiter reads it under the mutex, unlocks and sleeps
+// while it is unchanged, so a notify between the unlock and the sleep is not lost.
+// notify_all wakes a single waiter and requeues the rest onto the mutex futex: they are woken
+// one by one by the unlocks instead of all rushing for the mutex at once. For that chain to hold,
+// a waiter always takes the mutex back in the contended state.
+// The cv may be destroyed as soon as every waiter was notified, even while they still block on
+// the mutex, so a waiter never touches *this once its futex wait returned. The notifiers consume
+// _waiters instead. A waiter that timed out leaves its count behind, which only costs the next
+// notify_one a wake without a sleeper; notify_all clears the count.
+
+public:
+    using native_handle_type = detail::_Futex_Word*;
+
+private:
+    detail::_Futex_Word _sequence                   = 0;
+    std::atomic<uint32_t> _waiters                  = 0;        // added under the mutex, consumed by notify
+    std::atomic<detail::_Mutex_Base*> _waitMutex    = nullptr;  // the mutex all waiters use
+
+public:
+    // Constructors & Operators
+
+    condition_variable() noexcept = default;
+    ~condition_variable() = default;
+
+    condition_variable(const condition_variable&)            = delete;
+    condition_variable& operator=(const condition_variable&) = delete;
+
+public:
+    // Main functions
+
+    void notify_one() noexcept
+    {
+        uint32_t waiters = _waiters.load(std::memory_order_relaxed);
+        do
+        {
+            if (waiters == 0)
+                return;
+        }
+        while (!_waiters.compare_exchange_weak(waiters, waiters - 1, std::memory_order_relaxed));
+
+        _sequence.fetch_add(1, std::memory_order_relaxed);
+        detail::_futex_wake(&_sequence, 1);
+    }
+
+    void notify_all() noexcept
+    {
+        if (_waiters.load(std::memory_order_relaxed) == 0 || _waiters.exchange(0, std::memory_order_relaxed) == 0)
+            return;
+
+        const uint32_t sequence     = _sequence.fetch_add(1, std::memory_order_relaxed) + 1;
+        detail::_Mutex_Base* mutex  = _waitMutex.load(std::memory_order_relaxed);
+
+        if (mutex == nullptr || !detail::_futex_requeue(&_sequence, 1, &mutex->_state, sequence))
+            detail::_futex_wake(&_sequence, INT_MAX);   // a newer notify raced this one, wake everyone
+    }
+
+    void wait(unique_lock<mutex>& lock)
+    {
+        detail::_Mutex_Base& mutex  = *lock.mutex();
+        const uint32_t sequence     = _enter_wait(mutex);
+
+        detail::_futex_wait(&_sequence, sequence);
+        _leave_wait(mutex);
+    }
+
+    template<class Predicate>
+    void wait(unique_lock<mutex>& lock, Predicate pred)
+    {
+        while (!pred())
+            wait(lock);
+    }
+
+    template<class Clock, class Duration>
+    cv_status wait_until(unique_lock<mutex>& lock, const custom::chrono::time_point<Clock, Duration>& absoluteTime)
+    {
+        const auto now = Clock::now();
+        if (!(now < absoluteTime))
+            return cv_status::timeout;
+
+        detail::_Mutex_Base& mutex  = *lock.mutex();
+        const uint32_t sequence     = _enter_wait(mutex);
+
+        (void)detail::_futex_wait_for(&_sequence, sequence, absoluteTime - now);
+        _leave_wait(mutex);
+
+        return ((Clock::now() < absoluteTime) ? cv_status::no_timeout : cv_status::timeout);
+    }
+
+    template<class Clock, class Duration, class Predicate>
+    bool wait_until(unique_lock<mutex>& lock, const custom::chrono::time_point<Clock, Duration>& absoluteTime, Predicate pred)
+    {
+        while (!pred())
+            if (wait_until(lock, absoluteTime) == cv_status::timeout)
+                return pred();
+
+        return true;
+    }
+    
+    template<class Rep, class Period>
+    cv_status wait_for(unique_lock<mutex>& lock, const custom::chrono::duration<Rep, Period>& relativeTime)
+    {
+	    return wait_until(  lock,
+                            custom::chrono::steady_clock::now() + 
+                            custom::chrono::ceil<typename custom::chrono::steady_clock::duration>(relativeTime));
+    }
+
+    template<class Rep, class Period, class Predicate>
+    bool wait_for(unique_lock<mutex>& lock, const custom::chrono::duration<Rep, Period>& relativeTime, Predicate pred)
+    {
+	    return wait_until(  lock,
+                            custom::chrono::steady_clock::now() + 
+                            custom::chrono::ceil<typename custom::chrono::steady_clock::duration>(relativeTime),
+                            pred);
+    }
+
+    native_handle_type native_handle() noexcept
+    {
+        return &_sequence;
+    }
+
+private:
+    // Helpers
+
+    uint32_t _enter_wait(detail::_Mutex_Base& mutex) noexcept   // with the mutex held, returns it unlocked
+    {
+        _waitMutex.store(&mutex, std::memory_order_relaxed);
+        _waiters.fetch_add(1, std::memory_order_relaxed);
+
+        const uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+        mutex.unlock();
+
+        return sequence;
+    }
+
+    static void _leave_wait(detail::_Mutex_Base& mutex) noexcept     // *this may be gone already
+    {
+        mutex._lock_contended();
+    }
+}; // END condition_variable
+#else   // __linux__
 class condition_variable         // Condition variable adaptor for pthread_cond_t
 {
 public:
@@ -112,6 +255,7 @@ public:
         return _cv;
     }
 }; // END condition_variable
+#endif  // __linux__
 
 
 class condition_variable_any
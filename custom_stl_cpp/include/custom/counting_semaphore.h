@@ -2,10 +2,106 @@
 
 #if defined __GNUG__
 #include "custom/thread.h"
+
+#if defined __linux__
+#include "custom/_futex.h"
+#else
 #include <semaphore.h>
+#endif  // __linux__
 
 CUSTOM_BEGIN
 
+#if defined __linux__
+template<int LeastMaxValue = INT_MAX>
+class counting_semaphore                 // Semaphore on a futex word
+{
+// _count is the futex word: acquirers sleep while it is 0. _waiters lets release skip the
+// syscall when nobody sleeps. Both sides use seq_cst, so either release sees the waiter
+// or the waiter's futex call sees the new count.
+
+private:
+    static_assert((LeastMaxValue >= 0 && LeastMaxValue <= INT_MAX), "Invalid semaphore count.");
+
+    detail::_Futex_Word _count;
+    std::atomic<uint32_t> _waiters = 0;
+
+public:
+    // Constructors & Operators
+
+    explicit counting_semaphore(int desired) noexcept
+        : _count(static_cast<uint32_t>(desired))
+    {
+        CUSTOM_ASSERT(desired >= 0 && desired <= LeastMaxValue, "Invalid desired value.");
+    }
+
+    ~counting_semaphore() noexcept = default;
+
+    counting_semaphore(const counting_semaphore&)            = delete;
+    counting_semaphore& operator=(const counting_semaphore&) = delete;
+
+public:
+    // Main functions
+
+    static constexpr int (max)() noexcept
+    {
+        return LeastMaxValue;
+    }
+
+    void release(int update = 1) noexcept
+    {
+        CUSTOM_ASSERT(update >= 0 && update <= LeastMaxValue - static_cast<int>(_count.load(std::memory_order_relaxed)),
+                        "Invalid update value.");
+
+        _count.fetch_add(static_cast<uint32_t>(update), std::memory_order_seq_cst);
+        if (_waiters.load(std::memory_order_seq_cst) > 0)
+            detail::_futex_wake(&_count, update);       // one syscall for any update
+    }
+
+    void acquire() noexcept
+    {
+        while (!try_acquire())
+        {
+            _waiters.fetch_add(1, std::memory_order_seq_cst);
+            detail::_futex_wait(&_count, 0);
+            _waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    bool try_acquire() noexcept
+    {
+        uint32_t count = _count.load(std::memory_order_relaxed);
+        while (count > 0)
+            if (_count.compare_exchange_weak(count, count - 1, std::memory_order_acquire, std::memory_order_relaxed))
+                return true;
+
+        return false;
+    }
+
+    template<class Clock, class Duration>
+    bool try_acquire_until(const custom::chrono::time_point<Clock, Duration>& absoluteTime)
+    {
+        while (!try_acquire())
+        {
+            const auto now = Clock::now();
+            if (!(now < absoluteTime))
+                return false;
+
+            _waiters.fetch_add(1, std::memory_order_seq_cst);
+            (void)detail::_futex_wait_for(&_count, 0, absoluteTime - now);
+            _waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        return true;
+    }
+
+    template<class Rep, class Period>
+    bool try_acquire_for(const custom::chrono::duration<Rep, Period>& relativeTime)
+    {
+        return try_acquire_until(   custom::chrono::steady_clock::now() +
+                                    custom::chrono::ceil<typename custom::chrono::steady_clock::duration>(relativeTime));
+    }
+}; // END counting_semaphore
+#else   // __linux__
 template<int LeastMaxValue = INT_MAX>
 class counting_semaphore                 // Semaphore adaptor for sem_t
 {
@@ -43,7 +139,7 @@ public:
     void release(int update = 1) noexcept
     {
         for (/*Empty*/; update != 0; --update)
-            sem_post(&_semaphore);     
+            sem_post(&_semaphore);
     }
 
     void acquire() noexcept
@@ -53,7 +149,7 @@ public:
 
     bool try_acquire() noexcept
     {
-        return (sem_trywait(&_semaphore) > 0) ? true : false;
+        return sem_trywait(&_semaphore) == 0;
     }
 
     template<class Clock, class Duration,
@@ -75,10 +171,11 @@ public:
     template<class Rep, class Period>
     bool try_acquire_for(const custom::chrono::duration<Rep, Period>& relativeTime)
     {
-        return try_acquire_until(   _ReqClock::now() + 
+        return try_acquire_until(   _ReqClock::now() +
                                     custom::chrono::ceil<typename _ReqClock::duration>(relativeTime));
     }
 }; // END counting_semaphore
+#endif  // __linux__
 
 using binary_semaphore = counting_semaphore<1>;
 
@@ -86,4 +183,4 @@ CUSTOM_END
 
 #elif defined _MSC_VER
 #error NO Semaphore implementation
-#endif      // __GNUG__ and _MSC_VER
\ No newline at end of file
+#endif      // __GNUG__ and _MSC_VER
@@ -3,13 +3,24 @@
 #include "custom/utility.h"
 #include "custom/iterator.h"
 #include "custom/algorithm.h"
+#include "custom/bit.h"
 
 
 CUSTOM_BEGIN
 
 CUSTOM_DETAIL_BEGIN
 
-template<class Type, class Alloc>
+// Elements per block: a power of two filling about 4KB, but at least 16 elements for large types
+template<class Type>
+constexpr size_t _deque_block_size() noexcept
+{
+	constexpr size_t targetBytes	= 4096;
+	constexpr size_t minElements	= 16;
+
+	return (sizeof(Type) * minElements >= targetBytes) ? minElements : custom::bit_floor(targetBytes / sizeof(Type));
+}
+
+template<class Type, class Alloc, size_t BlockSize>
 struct _Deque_Data
 {
 	using _Alloc_Traits		= allocator_traits<Alloc>;
@@ -29,11 +40,11 @@ struct _Deque_Data
 	size_t _First 			= 0;
 	size_t _Size 			= 0;
 
-	static constexpr size_t _BLOCK_SIZE = 4;
+	static constexpr size_t _BLOCK_SIZE = (BlockSize != 0) ? BlockSize : _deque_block_size<value_type>();
 
 	size_t get_block(const size_t offset) const noexcept
 	{
-		return (offset / _BLOCK_SIZE) % _MapCapacity;
+		return (offset / _BLOCK_SIZE) & (_MapCapacity - 1);		// map capacity is always a power of two
     }
 };	// END _Deque_Data
 
@@ -151,6 +162,31 @@ public:
 		return !(*this == other);
 	}
 
+	difference_type operator-(const _Deque_Const_Iterator& other) const noexcept
+	{
+		return static_cast<difference_type>(_Offset) - static_cast<difference_type>(other._Offset);
+	}
+
+	bool operator<(const _Deque_Const_Iterator& other) const noexcept
+	{
+		return _Offset < other._Offset;
+	}
+
+	bool operator>(const _Deque_Const_Iterator& other) const noexcept
+	{
+		return other < *this;
+	}
+
+	bool operator<=(const _Deque_Const_Iterator& other) const noexcept
+	{
+		return !(other < *this);
+	}
+
+	bool operator>=(const _Deque_Const_Iterator& other) const noexcept
+	{
+		return !(*this < other);
+	}
+
 public:
 
 	bool is_begin() const noexcept
@@ -243,6 +279,8 @@ public:
 		return temp;
 	}
 
+	using _Base::operator-;
+
 	pointer operator->() const noexcept
 	{
 		return const_cast<pointer>(_Base::operator->());
@@ -261,11 +299,15 @@ public:
 
 CUSTOM_DETAIL_END
 
-template<class Type, class Alloc = custom::allocator<Type>>
+template<class Type, class Alloc = custom::allocator<Type>, size_t BlockSize = 0>
 class deque					// deque Template implemented as map of blocks
 {
+// BlockSize is the number of elements per block, 0 picks about 4KB per block from sizeof(Type).
+// Blocks stay in the map once allocated: popped and cleared slots are reused by later pushes,
+// and growing the map carries the spare blocks over. Only shrink_to_fit() and destruction free them.
+
 private:
-	using _Data						= detail::_Deque_Data<Type, Alloc>;
+	using _Data						= detail::_Deque_Data<Type, Alloc, BlockSize>;
 	using _Alloc_Traits				= typename _Data::_Alloc_Traits;
 	using _AllocPtr					= typename _Data::_AllocPtr;
 	using _AllocPtr_Traits			= typename _Data::_AllocPtr_Traits;
@@ -543,17 +585,34 @@ public:
 		return begin() + static_cast<difference_type>(off);
 	}
 
-	void clear()
+	void clear()	// keeps the blocks for reuse
 	{
 		while (!empty())
 			pop_back();
+	}
 
-		for (size_t i = 0; i < _data._MapCapacity; ++i)
-			if (_data._Map[i] != nullptr)
+	void shrink_to_fit()	// frees the blocks that hold no element
+	{
+		if (_data._Map == nullptr)
+			return;
+
+		const size_t firstBlock	= _data.get_block(_data._First);
+		const size_t usedBlocks	= empty() ? 0 : (_data._First % _data._BLOCK_SIZE + _data._Size - 1) / _data._BLOCK_SIZE + 1;
+
+		for (size_t i = usedBlocks; i < _data._MapCapacity; ++i)
+		{
+			size_t block = (firstBlock + i) & (_data._MapCapacity - 1);
+			if (_data._Map[block] != nullptr)
 			{
-				_alloc.deallocate(_data._Map[i], _data._BLOCK_SIZE);
-				_data._Map[i] = nullptr;
+				_alloc.deallocate(_data._Map[block], _data._BLOCK_SIZE);
+				_data._Map[block] = nullptr;
 			}
+		}
+	}
+
+	static constexpr size_t block_size() noexcept
+	{
+		return _Data::_BLOCK_SIZE;
 	}
 
 	size_t size() const noexcept
@@ -680,35 +739,21 @@ private:
 
 	void _reserve(const size_t newMapCapacity)
 	{
-		size_t newSize			= _data._Size;
-		size_t newFirst			= _data._First % _data._BLOCK_SIZE;
 		_MapPtr newMap 			= _create_empty_map(newMapCapacity);
-		size_t firstBlock		= _data.get_block(_data._First);					// block to find first elem
-		size_t lastBlock		= _data.get_block(_data._First + _data._Size - 1);	// block to find last elem (always != firstBlock)
+		size_t firstBlock		= _data.get_block(_data._First);		// block to find first elem
 
-		size_t newBlockIndex	= 0;
-		size_t oldBlockIndex	= firstBlock;
+		// unroll the ring starting at the first block: used blocks come first, spare blocks follow them
+		_AllocPtr alPtr;
+		size_t headBlocks		= _data._MapCapacity - firstBlock;		// blocks from the first one to the map end
 
-		while (oldBlockIndex != lastBlock)								// copy pointers to blocks and nullify the old ones
-		{
-			newMap[newBlockIndex++]		= _data._Map[oldBlockIndex];
-			_data._Map[oldBlockIndex]	= nullptr;
+		detail::_uninitialized_relocate_n(alPtr, _data._Map + firstBlock, headBlocks, newMap);
+		detail::_uninitialized_relocate_n(alPtr, _data._Map, firstBlock, newMap + headBlocks);
 
-			if (oldBlockIndex == _data._MapCapacity - 1)
-				oldBlockIndex = 0;
-			else
-				++oldBlockIndex;
-		}
-		newMap[newBlockIndex]		= _data._Map[oldBlockIndex];		// for lastBlock
-		_data._Map[oldBlockIndex]	= nullptr;
-
-		_data._Size = 0;												// clear the remaining empty blocks and map
-		_clean_up_map();
+		alPtr.deallocate(_data._Map, _data._MapCapacity);
 
 		_data._Map				= newMap;
 		_data._MapCapacity		= newMapCapacity;
-		_data._Size				= newSize;
-		_data._First			= newFirst;
+		_data._First			= _data._First % _data._BLOCK_SIZE;
 	}
 
 	void _extend_if_full()
@@ -746,7 +791,7 @@ private:
 
 	void _init_map(const size_t newMapCapacity)
 	{
-		size_t newCapacity 	= (newMapCapacity < _DEFAULT_CAPACITY) ? _DEFAULT_CAPACITY : newMapCapacity;
+		size_t newCapacity 	= (newMapCapacity < _DEFAULT_CAPACITY) ? _DEFAULT_CAPACITY : custom::bit_ceil(newMapCapacity);
 
 		_data._Map 			= _create_empty_map(newCapacity);
 		_data._MapCapacity	= newCapacity;
@@ -759,6 +804,11 @@ private:
 		if (_data._Map != nullptr)
 		{
 			clear();
+
+			for (size_t i = 0; i < _data._MapCapacity; ++i)
+				if (_data._Map[i] != nullptr)
+					_alloc.deallocate(_data._Map[i], _data._BLOCK_SIZE);
+
 			_AllocPtr().deallocate(_data._Map, _data._MapCapacity);
 			_data._Map = nullptr;
 		}
@@ -767,8 +817,8 @@ private:
 
 
 // deque binary operators
-template<class _Type, class _Alloc>
-bool operator==(const deque<_Type, _Alloc>& left, const deque<_Type, _Alloc>& right)
+template<class _Type, class _Alloc, size_t _BlockSize>
+bool operator==(const deque<_Type, _Alloc, _BlockSize>& left, const deque<_Type, _Alloc, _BlockSize>& right)
 {
 	if (left.size() != right.size())
 		return false;
@@ -776,8 +826,8 @@ bool operator==(const deque<_Type, _Alloc>& left, const deque<_Type, _Alloc>& ri
 	return custom::equal(left.begin(), left.end(), right.begin());
 }
 
-template<class _Type, class _Alloc>
-bool operator!=(const deque<_Type, _Alloc>& left, const deque<_Type, _Alloc>& right)
+template<class _Type, class _Alloc, size_t _BlockSize>
+bool operator!=(const deque<_Type, _Alloc, _BlockSize>& left, const deque<_Type, _Alloc, _BlockSize>& right)
 {
 	return !(left == right);
 }
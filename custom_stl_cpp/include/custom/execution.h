@@ -0,0 +1,493 @@
+#pragma once
+#include "custom/algorithm.h"
+#include "custom/numeric.h"
+
+#if defined __GNUG__
+#include "custom/thread_pool.h"
+#endif  // __GNUG__
+
+
+CUSTOM_BEGIN
+
+namespace execution
+{
+    class sequenced_policy              { /*Empty*/ };
+    class parallel_policy               { /*Empty*/ };
+    class parallel_unsequenced_policy   { /*Empty*/ };
+
+    inline constexpr sequenced_policy seq{};
+    inline constexpr parallel_policy par{};
+    inline constexpr parallel_unsequenced_policy par_unseq{};
+} // END namespace execution
+
+
+// is_execution_policy
+template<class Type>
+struct is_execution_policy : false_type {};
+
+template<>
+struct is_execution_policy<execution::sequenced_policy> : true_type {};
+
+template<>
+struct is_execution_policy<execution::parallel_policy> : true_type {};
+
+template<>
+struct is_execution_policy<execution::parallel_unsequenced_policy> : true_type {};
+
+template<class Type>
+constexpr bool is_execution_policy_v = is_execution_policy<Type>::value;
+// END is_execution_policy
+
+
+CUSTOM_DETAIL_BEGIN
+
+template<class ExecutionPolicy>
+constexpr bool _Is_Execution_Policy_v = is_execution_policy_v<remove_cv_ref_t<ExecutionPolicy>>;
+
+// true when the policy allows splitting and every iterator can jump to a chunk in O(1)
+template<class ExecutionPolicy, class... Iters>
+constexpr bool _Use_Parallel_v =    !is_same_v<remove_cv_ref_t<ExecutionPolicy>, execution::sequenced_policy> &&
+                                    (is_random_access_iterator_v<Iters> && ...);
+
+constexpr size_t _PARALLEL_MIN_CHUNK    = 2048;     // smaller ranges are not worth waking the workers
+constexpr size_t _PARALLEL_CHUNKS       = 4;        // chunks per thread, so uneven chunks balance out
+
+inline size_t _parallel_chunk_count(const size_t count) noexcept
+{
+#if defined __GNUG__
+    const size_t chunks = count / _PARALLEL_MIN_CHUNK;
+    if (chunks <= 1)
+        return 1;       // do not start the pool for small ranges
+
+    const size_t maxChunks = thread_pool::default_pool().worker_count() * _PARALLEL_CHUNKS;
+    return chunks < maxChunks ? chunks : maxChunks;
+#else
+    (void)count;
+    return 1;       // no thread support, run in the calling thread
+#endif  // __GNUG__
+}
+
+// Splits [0, count) into chunks contiguous chunks and calls func(chunk, chunkFirst, chunkLast) for each
+template<class Func>
+void _parallel_chunks(const size_t count, const size_t chunks, Func func)
+{
+    // throwing from a parallel algorithm terminates, like std
+    auto job = [count, chunks, &func](size_t chunk) noexcept
+    {
+        func(chunk, chunk * count / chunks, (chunk + 1) * count / chunks);
+    };
+
+#if defined __GNUG__
+    if (chunks == 1)
+        job(0);
+    else
+        thread_pool::default_pool().parallel_for(size_t(0), chunks, job, 1);
+#else
+    for (size_t chunk = 0; chunk < chunks; ++chunk)
+        job(chunk);
+#endif  // __GNUG__
+}
+
+// One uninitialized slot per chunk, filled concurrently and destroyed together
+template<class Type>
+class _Chunk_Results
+{
+private:
+    allocator<Type> _alloc;
+    Type* _values       = nullptr;
+    size_t _size        = 0;
+    size_t _constructed = 0;
+
+public:
+    explicit _Chunk_Results(const size_t size)
+        : _values(_alloc.allocate(size)), _size(size) { /*Empty*/ }
+
+    ~_Chunk_Results()
+    {
+        custom::destroy(_values, _values + _constructed);
+        _alloc.deallocate(_values, _size);
+    }
+
+    _Chunk_Results(const _Chunk_Results&)               = delete;
+    _Chunk_Results& operator=(const _Chunk_Results&)    = delete;
+
+    template<class... Args>
+    void construct(const size_t index, Args&&... args)
+    {
+        custom::construct_at(_values + index, custom::forward<Args>(args)...);
+    }
+
+    void set_constructed() noexcept     // call once every slot is filled
+    {
+        _constructed = _size;
+    }
+
+    Type& operator[](const size_t index) noexcept
+    {
+        return _values[index];
+    }
+};  // END _Chunk_Results
+
+// Pass 1 of the blocked scans: reduces every chunk, then turns the sums into the carry entering each chunk
+template<class RandomIt, class Type, class BinaryOperation, class UnaryOperation>
+void _parallel_scan_carries(RandomIt first, const size_t count, const size_t chunks,
+                            _Chunk_Results<Type>& carries, const Type& init,
+                            BinaryOperation& bop, UnaryOperation& uop)
+{
+    _Chunk_Results<Type> sums(chunks - 1);
+    detail::_parallel_chunks(count, chunks,
+        [first, chunks, &sums, &bop, &uop](size_t chunk, size_t chunkFirst, size_t chunkLast)
+        {
+            if (chunk + 1 == chunks)    // the last chunk feeds no carry
+                return;
+
+            Type sum = uop(*(first + chunkFirst));
+            for (size_t index = chunkFirst + 1; index < chunkLast; ++index)
+                sum = bop(custom::move(sum), uop(*(first + index)));
+
+            sums.construct(chunk, custom::move(sum));
+        });
+    sums.set_constructed();
+
+    carries.construct(0, init);
+    for (size_t chunk = 1; chunk < chunks; ++chunk)
+        carries.construct(chunk, bop(carries[chunk - 1], sums[chunk - 1]));
+
+    carries.set_constructed();
+}
+
+struct _Identity_Op
+{
+    template<class Type>
+    Type&& operator()(Type&& value) const noexcept
+    {
+        return custom::forward<Type>(value);
+    }
+};
+
+CUSTOM_DETAIL_END
+
+
+#pragma region Parallel algorithm.h operations
+// for_each
+template<class ExecutionPolicy, class ForwardIt, class UnaryFunction,
+enable_if_t<detail::_Is_Execution_Policy_v<ExecutionPolicy>, bool> = true>
+void for_each(ExecutionPolicy&&, ForwardIt first, ForwardIt last, UnaryFunction func)
+{
+    detail::_verify_iteration_range(first, last);
+
+    if constexpr (detail::_Use_Parallel_v<ExecutionPolicy, ForwardIt>)
+    {
+        const size_t count = static_cast<size_t>(last - first);
+        detail::_parallel_chunks(count, detail::_parallel_chunk_count(count),
+            [first, &func](size_t, size_t chunkFirst, size_t chunkLast)
+            {
+                custom::for_each(first + chunkFirst, first + chunkLast, func);
+            });
+    }
+    else
+        custom::for_each(first, last, func);
+}
+// END for_each
+
+
+// transform
+template<class ExecutionPolicy, class ForwardIt1, class ForwardIt2, class UnaryOperation,
+enable_if_t<detail::_Is_Execution_Policy_v<ExecutionPolicy>, bool> = true>
+ForwardIt2 transform(   ExecutionPolicy&&, ForwardIt1 first1, ForwardIt1 last1,
+                        ForwardIt2 destFirst, UnaryOperation op)
+{
+    detail::_verify_iteration_range(first1, last1);
+
+    if constexpr (detail::_Use_Parallel_v<ExecutionPolicy, ForwardIt1, ForwardIt2>)
+    {
+        const size_t count = static_cast<size_t>(last1 - first1);
+        detail::_parallel_chunks(count, detail::_parallel_chunk_count(count),
+            [first1, destFirst, &op](size_t, size_t chunkFirst, size_t chunkLast)
+            {
+                custom::transform(first1 + chunkFirst, first1 + chunkLast, destFirst + chunkFirst, op);
+            });
+
+        return destFirst + (last1 - first1);
+    }
+    else
+        return custom::transform(first1, last1, destFirst, op);
+}
+
+template<class ExecutionPolicy, class ForwardIt1, class ForwardIt2, class ForwardIt3, class BinaryOperation,
+enable_if_t<detail::_Is_Execution_Policy_v<ExecutionPolicy>, bool> = true>
+ForwardIt3 transform(   ExecutionPolicy&&, ForwardIt1 first1, ForwardIt1 last1,
+                        ForwardIt2 first2, ForwardIt3 destFirst, BinaryOperation op)
+{
+    detail::_verify_iteration_range(first1, last1);
+
+    if constexpr (detail::_Use_Parallel_v<ExecutionPolicy, ForwardIt1, ForwardIt2, ForwardIt3>)
+    {
+        const size_t count = static_cast<size_t>(last1 - first1);
+        detail::_parallel_chunks(count, detail::_parallel_chunk_count(count),
+            [first1, first2, destFirst, &op](size_t, size_t chunkFirst, size_t chunkLast)
+            {
+                custom::transform(  first1 + chunkFirst, first1 + chunkLast,
+                                    first2 + chunkFirst, destFirst + chunkFirst, op);
+            });
+
+        return destFirst + (last1 - first1);
+    }
+    else
+        return custom::transform(first1, last1, first2, destFirst, op);
+}
+// END transform
+
+
+// count_if
+template<class ExecutionPolicy, class ForwardIt, class UnaryPredicate,
+enable_if_t<detail::_Is_Execution_Policy_v<ExecutionPolicy>, bool> = true>
+typename iterator_traits<ForwardIt>::difference_type count_if(  ExecutionPolicy&&, ForwardIt first, ForwardIt last,
+                                                                UnaryPredicate pred)
+{
+    using _Diff = typename iterator_traits<ForwardIt>::difference_type;
+
+    detail::_verify_iteration_range(first, last);
+
+    if constexpr (detail::_Use_Parallel_v<ExecutionPolicy, ForwardIt>)
+    {
+        const size_t count  = static_cast<size_t>(last - first);
+        const size_t chunks = detail::_parallel_chunk_count(count);
+
+        detail::_Chunk_Results<_Diff> counts(chunks);
+        detail::_parallel_chunks(count, chunks,
+            [first, &counts, &pred](size_t chunk, size_t chunkFirst, size_t chunkLast)
+            {
+                counts.construct(chunk, custom::count_if(first + chunkFirst, first + chunkLast, pred));
+            });
+        counts.set_constructed();
+
+        _Diff total = 0;
+        for (size_t chunk = 0; chunk < chunks; ++chunk)
+            total += counts[chunk];
+
+        return total;
+    }
+    else
+        return custom::count_if(first, last, pred);
+}
+// END count_if
+#pragma endregion Parallel algorithm.h operations
+
+
+#pragma region Parallel numeric.h operations
+// transform_reduce
+template<class ExecutionPolicy, class ForwardIt, class Type, class BinaryOperation, class UnaryOperation,
+enable_if_t<detail::_Is_Execution_Policy_v<ExecutionPolicy>, bool> = true>
+Type transform_reduce(  ExecutionPolicy&&, ForwardIt first, ForwardIt last,
+                        Type init, BinaryOperation bop, UnaryOperation uop)
+{
+    detail::_verify_iteration_range(first, last);
+
+    if constexpr (detail::_Use_Parallel_v<ExecutionPolicy, ForwardIt>)
+    {
+        const size_t count  = static_cast<size_t>(last - first);
+        const size_t chunks = detail::_parallel_chunk_count(count);
+
+        if (chunks == 1)
+            return custom::transform_reduce(first, last, custom::move(init), bop, uop);
+
+        detail::_Chunk_Results<Type> sums(chunks);
+        detail::_parallel_chunks(count, chunks,
+            [first, &sums, &bop, &uop](size_t chunk, size_t chunkFirst, size_t chunkLast)
+            {
+                Type sum = uop(*(first + chunkFirst));      // chunks are never empty
+                for (size_t index = chunkFirst + 1; index < chunkLast; ++index)
+                    sum = bop(custom::move(sum), uop(*(first + index)));
+
+                sums.construct(chunk, custom::move(sum));
+            });
+        sums.set_constructed();
+
+        for (size_t chunk = 0; chunk < chunks; ++chunk)
+            init = bop(custom::move(init), custom::move(sums[chunk]));
+
+        return init;
+    }
+    else
+        return custom::transform_reduce(first, last, custom::move(init), bop, uop);
+}
+
+template<class ExecutionPolicy, class ForwardIt1, class ForwardIt2, class Type, class BinaryOperation1, class BinaryOperation2,
+enable_if_t<detail::_Is_Execution_Policy_v<ExecutionPolicy>, bool> = true>
+Type transform_reduce(  ExecutionPolicy&&, ForwardIt1 first1, ForwardIt1 last1,
+                        ForwardIt2 first2, Type init,
+                        BinaryOperation1 bop1, BinaryOperation2 bop2)
+{
+    detail::_verify_iteration_range(first1, last1);
+
+    if constexpr (detail::_Use_Parallel_v<ExecutionPolicy, ForwardIt1, ForwardIt2>)
+    {
+        const size_t count  = static_cast<size_t>(last1 - first1);
+        const size_t chunks = detail::_parallel_chunk_count(count);
+
+        if (chunks == 1)
+            return custom::transform_reduce(first1, last1, first2, custom::move(init), bop1, bop2);
+
+        detail::_Chunk_Results<Type> sums(chunks);
+        detail::_parallel_chunks(count, chunks,
+            [first1, first2, &sums, &bop1, &bop2](size_t chunk, size_t chunkFirst, size_t chunkLast)
+            {
+                Type sum = bop2(*(first1 + chunkFirst), *(first2 + chunkFirst));
+                for (size_t index = chunkFirst + 1; index < chunkLast; ++index)
+                    sum = bop1(custom::move(sum), bop2(*(first1 + index), *(first2 + index)));
+
+                sums.construct(chunk, custom::move(sum));
+            });
+        sums.set_constructed();
+
+        for (size_t chunk = 0; chunk < chunks; ++chunk)
+            init = bop1(custom::move(init), custom::move(sums[chunk]));
+
+        return init;
+    }
+    else
+        return custom::transform_reduce(first1, last1, first2, custom::move(init), bop1, bop2);
+}
+
+template<class ExecutionPolicy, class ForwardIt1, class ForwardIt2, class Type,
+enable_if_t<detail::_Is_Execution_Policy_v<ExecutionPolicy>, bool> = true>
+Type transform_reduce(  ExecutionPolicy&& policy, ForwardIt1 first1, ForwardIt1 last1,
+                        ForwardIt2 first2, Type init)
+{
+    return custom::transform_reduce(custom::forward<ExecutionPolicy>(policy), first1, last1, first2,
+                                    custom::move(init), plus<>{}, multiplies<>{});
+}
+// END transform_reduce
+
+
+// reduce - chunks are reduced concurrently, op must be associative and commutative
+template<class ExecutionPolicy, class ForwardIt, class Type, class BinaryOperation,
+enable_if_t<detail::_Is_Execution_Policy_v<ExecutionPolicy>, bool> = true>
+Type reduce(ExecutionPolicy&& policy, ForwardIt first, ForwardIt last, Type init, BinaryOperation op)
+{
+    return custom::transform_reduce(custom::forward<ExecutionPolicy>(policy), first, last,
+                                    custom::move(init), op, detail::_Identity_Op{});
+}
+
+template<class ExecutionPolicy, class ForwardIt, class Type,
+enable_if_t<detail::_Is_Execution_Policy_v<ExecutionPolicy>, bool> = true>
+Type reduce(ExecutionPolicy&& policy, ForwardIt first, ForwardIt last, Type init)
+{
+    return custom::reduce(custom::forward<ExecutionPolicy>(policy), first, last, custom::move(init), plus<>{});
+}
+
+template<class ExecutionPolicy, class ForwardIt,
+enable_if_t<detail::_Is_Execution_Policy_v<ExecutionPolicy>, bool> = true>
+typename iterator_traits<ForwardIt>::value_type reduce(ExecutionPolicy&& policy, ForwardIt first, ForwardIt last)
+{
+    return custom::reduce(  custom::forward<ExecutionPolicy>(policy), first, last,
+                            typename iterator_traits<ForwardIt>::value_type{}, plus<>{});
+}
+// END reduce
+
+
+// inclusive_scan - two pass blocked scan: chunk sums first, then every chunk scans from its carry
+template<class ExecutionPolicy, class ForwardIt1, class ForwardIt2, class BinaryOperation, class Type,
+enable_if_t<detail::_Is_Execution_Policy_v<ExecutionPolicy>, bool> = true>
+ForwardIt2 inclusive_scan(  ExecutionPolicy&&, ForwardIt1 first, ForwardIt1 last,
+                            ForwardIt2 destFirst, BinaryOperation op, Type init)
+{
+    detail::_verify_iteration_range(first, last);
+
+    if constexpr (detail::_Use_Parallel_v<ExecutionPolicy, ForwardIt1, ForwardIt2>)
+    {
+        const size_t count  = static_cast<size_t>(last - first);
+        const size_t chunks = detail::_parallel_chunk_count(count);
+
+        if (chunks == 1)
+            return custom::inclusive_scan(first, last, destFirst, op, custom::move(init));
+
+        detail::_Identity_Op identity;
+        detail::_Chunk_Results<Type> carries(chunks);
+        detail::_parallel_scan_carries(first, count, chunks, carries, init, op, identity);
+
+        detail::_parallel_chunks(count, chunks,
+            [first, destFirst, &carries, &op](size_t chunk, size_t chunkFirst, size_t chunkLast)
+            {
+                custom::inclusive_scan( first + chunkFirst, first + chunkLast,
+                                        destFirst + chunkFirst, op, carries[chunk]);
+            });
+
+        return destFirst + (last - first);
+    }
+    else
+        return custom::inclusive_scan(first, last, destFirst, op, custom::move(init));
+}
+
+template<class ExecutionPolicy, class ForwardIt1, class ForwardIt2, class BinaryOperation,
+enable_if_t<detail::_Is_Execution_Policy_v<ExecutionPolicy>, bool> = true>
+ForwardIt2 inclusive_scan(  ExecutionPolicy&& policy, ForwardIt1 first, ForwardIt1 last,
+                            ForwardIt2 destFirst, BinaryOperation op)
+{
+    detail::_verify_iteration_range(first, last);
+
+    if (first == last)
+        return destFirst;
+
+    // the first element seeds the scan of the rest
+    typename iterator_traits<ForwardIt1>::value_type init = *first;
+    *destFirst = init;
+
+    return custom::inclusive_scan(  custom::forward<ExecutionPolicy>(policy), custom::next(first), last,
+                                    custom::next(destFirst), op, custom::move(init));
+}
+
+template<class ExecutionPolicy, class ForwardIt1, class ForwardIt2,
+enable_if_t<detail::_Is_Execution_Policy_v<ExecutionPolicy>, bool> = true>
+ForwardIt2 inclusive_scan(ExecutionPolicy&& policy, ForwardIt1 first, ForwardIt1 last, ForwardIt2 destFirst)
+{
+    return custom::inclusive_scan(custom::forward<ExecutionPolicy>(policy), first, last, destFirst, plus<>{});
+}
+// END inclusive_scan
+
+
+// exclusive_scan
+template<class ExecutionPolicy, class ForwardIt1, class ForwardIt2, class Type, class BinaryOperation,
+enable_if_t<detail::_Is_Execution_Policy_v<ExecutionPolicy>, bool> = true>
+ForwardIt2 exclusive_scan(  ExecutionPolicy&&, ForwardIt1 first, ForwardIt1 last,
+                            ForwardIt2 destFirst, Type init, BinaryOperation op)
+{
+    detail::_verify_iteration_range(first, last);
+
+    if constexpr (detail::_Use_Parallel_v<ExecutionPolicy, ForwardIt1, ForwardIt2>)
+    {
+        const size_t count  = static_cast<size_t>(last - first);
+        const size_t chunks = detail::_parallel_chunk_count(count);
+
+        if (chunks == 1)
+            return custom::exclusive_scan(first, last, destFirst, custom::move(init), op);
+
+        detail::_Identity_Op identity;
+        detail::_Chunk_Results<Type> carries(chunks);
+        detail::_parallel_scan_carries(first, count, chunks, carries, init, op, identity);
+
+        detail::_parallel_chunks(count, chunks,
+            [first, destFirst, &carries, &op](size_t chunk, size_t chunkFirst, size_t chunkLast)
+            {
+                custom::exclusive_scan( first + chunkFirst, first + chunkLast,
+                                        destFirst + chunkFirst, carries[chunk], op);
+            });
+
+        return destFirst + (last - first);
+    }
+    else
+        return custom::exclusive_scan(first, last, destFirst, custom::move(init), op);
+}
+
+template<class ExecutionPolicy, class ForwardIt1, class ForwardIt2, class Type,
+enable_if_t<detail::_Is_Execution_Policy_v<ExecutionPolicy>, bool> = true>
+ForwardIt2 exclusive_scan(  ExecutionPolicy&& policy, ForwardIt1 first, ForwardIt1 last,
+                            ForwardIt2 destFirst, Type init)
+{
+    return custom::exclusive_scan(custom::forward<ExecutionPolicy>(policy), first, last, destFirst, custom::move(init), plus<>{});
+}
+// END exclusive_scan
+#pragma endregion Parallel numeric.h operations
+
+CUSTOM_END
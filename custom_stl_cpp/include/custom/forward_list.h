@@ -200,27 +200,55 @@ public:
 		_create_head();
 	}
 
-	forward_list(const size_t newSize, const value_type& value) : forward_list()	// Add multiple copies Constructor
+	explicit forward_list(const allocator_type& alloc)
+		: _alloc(alloc)
+	{
+		_create_head();
+	}
+
+	forward_list(	const size_t newSize,
+					const value_type& value,
+					const allocator_type& alloc = allocator_type())		// Add multiple copies Constructor
+		: forward_list(alloc)
 	{
 		_create_until_size(newSize, value);
 	}
 
-	forward_list(std::initializer_list<value_type> list) : forward_list()
+	forward_list(std::initializer_list<value_type> list, const allocator_type& alloc = allocator_type())
+		: _alloc(alloc)
 	{
+		_create_head();
 		for (const auto& val : list)
 			push_back(val);
 	}
 
-	forward_list(const forward_list& other) : forward_list()
+	forward_list(const forward_list& other)
+		: forward_list(_Alloc_Node_Traits::select_on_container_copy_construction(other._alloc))
+	{
+		_copy(other);
+	}
+
+	forward_list(const forward_list& other, const allocator_type& alloc)
+		: forward_list(alloc)
 	{
 		_copy(other);
 	}
 
-	forward_list(forward_list&& other) noexcept : forward_list()
+	forward_list(forward_list&& other) noexcept
+		: forward_list(other._alloc)
 	{
 		_move(custom::move(other));
 	}
 
+	forward_list(forward_list&& other, const allocator_type& alloc)
+		: forward_list(alloc)
+	{
+		if (_alloc == other._alloc)
+			_move(custom::move(other));
+		else
+			_move_elements(other);
+	}
+
 	~forward_list() noexcept
 	{
 		clear();
@@ -235,18 +263,38 @@ public:
 		if (_data._Head != other._data._Head)
 		{
 			clear();
+
+			if constexpr (_Alloc_Node_Traits::propagate_on_container_copy_assignment::value)
+				if (!(_alloc == other._alloc))		// the head belongs to the old allocator
+				{
+					_free_head();
+					_alloc = other._alloc;
+					_create_head();
+				}
+
 			_copy(other);
 		}
 
 		return *this;
 	}
 
-	forward_list& operator=(forward_list&& other) noexcept
+	forward_list& operator=(forward_list&& other)
+		noexcept(	_Alloc_Node_Traits::propagate_on_container_move_assignment::value ||
+					_Alloc_Node_Traits::is_always_equal::value)
 	{
 		if (_data._Head != other._data._Head)
 		{
 			clear();
-			_move(custom::move(other));
+
+			if constexpr (_Alloc_Node_Traits::propagate_on_container_move_assignment::value)
+			{
+				custom::swap(_alloc, other._alloc);		// heads are exchanged, so are their allocators
+				_move(custom::move(other));
+			}
+			else if (_alloc == other._alloc)
+				_move(custom::move(other));
+			else
+				_move_elements(other);					// nodes can't change owner, move element by element
 		}
 
 		return *this;
@@ -343,6 +391,11 @@ public:
 		return _data._Size == 0;
 	}
 
+	allocator_type get_allocator() const noexcept
+	{
+		return static_cast<allocator_type>(_alloc);
+	}
+
 	void clear()
 	{
 		_delete_until_size(0);
@@ -432,6 +485,8 @@ public:
 			otherFirst._RefData->_Head != otherLast._RefData->_Head)
 			throw std::domain_error("forward_list provided by otherFirst and otherLast must be the same, but different from the one provided by where");
 
+		CUSTOM_ASSERT(_alloc == other._alloc, "Nodes can be spliced only between lists with equal allocators.");
+
 		size_t count = static_cast<size_t>(custom::distance(otherFirst, otherLast) - 1);
 
 		if (max_size() - _data._Size < count)
@@ -574,6 +629,15 @@ private:
 		_data._Size = custom::exchange(other._data._Size, 0);
 	}
 
+	void _move_elements(forward_list& other)
+	{
+		const_iterator last = before_begin();
+		for (_NodePtr temp = other._data._Head->_Next; _data._Size < other._data._Size; temp = temp->_Next)
+			last = emplace_after(last, custom::move(temp->_Value));
+
+		other.clear();
+	}
+
 	template<class... Args>
 	void _create_until_size(const size_t newSize, Args&&... args)
 	{
@@ -486,10 +486,10 @@ struct plus<void>
 {
     template<class Ty1, class Ty2>
     constexpr auto operator()(Ty1&& left, Ty2&& right) const
-    noexcept(noexcept(custom::forward<Ty1>(left) + custom::forward<Ty1>(right)))
-    -> decltype(custom::forward<Ty1>(left) + custom::forward<Ty1>(right))
+    noexcept(noexcept(custom::forward<Ty1>(left) + custom::forward<Ty2>(right)))
+    -> decltype(custom::forward<Ty1>(left) + custom::forward<Ty2>(right))
     {
-        return custom::forward<Ty1>(left) + custom::forward<Ty1>(right);
+        return custom::forward<Ty1>(left) + custom::forward<Ty2>(right);
     }
 
     using is_transparent = int;
@@ -510,10 +510,10 @@ struct minus<void>
 {
     template<class Ty1, class Ty2>
     constexpr auto operator()(Ty1&& left, Ty2&& right) const
-    noexcept(noexcept(custom::forward<Ty1>(left) - custom::forward<Ty1>(right)))
-    -> decltype(custom::forward<Ty1>(left) - custom::forward<Ty1>(right))
+    noexcept(noexcept(custom::forward<Ty1>(left) - custom::forward<Ty2>(right)))
+    -> decltype(custom::forward<Ty1>(left) - custom::forward<Ty2>(right))
     {
-        return custom::forward<Ty1>(left) - custom::forward<Ty1>(right);
+        return custom::forward<Ty1>(left) - custom::forward<Ty2>(right);
     }
 
     using is_transparent = int;
@@ -534,10 +534,10 @@ struct multiplies<void>
 {
     template<class Ty1, class Ty2>
     constexpr auto operator()(Ty1&& left, Ty2&& right) const
-    noexcept(noexcept(custom::forward<Ty1>(left) * custom::forward<Ty1>(right)))
-    -> decltype(custom::forward<Ty1>(left) * custom::forward<Ty1>(right))
+    noexcept(noexcept(custom::forward<Ty1>(left) * custom::forward<Ty2>(right)))
+    -> decltype(custom::forward<Ty1>(left) * custom::forward<Ty2>(right))
     {
-        return custom::forward<Ty1>(left) * custom::forward<Ty1>(right);
+        return custom::forward<Ty1>(left) * custom::forward<Ty2>(right);
     }
 
     using is_transparent = int;
@@ -558,10 +558,10 @@ struct divides<void>
 {
     template<class Ty1, class Ty2>
     constexpr auto operator()(Ty1&& left, Ty2&& right) const
-    noexcept(noexcept(custom::forward<Ty1>(left) / custom::forward<Ty1>(right)))
-    -> decltype(custom::forward<Ty1>(left) / custom::forward<Ty1>(right))
+    noexcept(noexcept(custom::forward<Ty1>(left) / custom::forward<Ty2>(right)))
+    -> decltype(custom::forward<Ty1>(left) / custom::forward<Ty2>(right))
     {
-        return custom::forward<Ty1>(left) / custom::forward<Ty1>(right);
+        return custom::forward<Ty1>(left) / custom::forward<Ty2>(right);
     }
 
     using is_transparent = int;
@@ -582,10 +582,10 @@ struct modulus<void>
 {
     template<class Ty1, class Ty2>
     constexpr auto operator()(Ty1&& left, Ty2&& right) const
-    noexcept(noexcept(custom::forward<Ty1>(left) % custom::forward<Ty1>(right)))
-    -> decltype(custom::forward<Ty1>(left) % custom::forward<Ty1>(right))
+    noexcept(noexcept(custom::forward<Ty1>(left) % custom::forward<Ty2>(right)))
+    -> decltype(custom::forward<Ty1>(left) % custom::forward<Ty2>(right))
     {
-        return custom::forward<Ty1>(left) % custom::forward<Ty1>(right);
+        return custom::forward<Ty1>(left) % custom::forward<Ty2>(right);
     }
 
     using is_transparent = int;
@@ -0,0 +1,1194 @@
+#pragma once
+
+#if defined __GNUG__
+#include "custom/thread.h"
+#include "custom/mutex.h"
+#include "custom/condition_variable.h"
+#include "custom/intrusive_ptr.h"
+#include "custom/vector.h"
+#include "custom/tuple.h"
+
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+
+
+CUSTOM_BEGIN
+
+template<class Result>
+class future;
+
+template<class Result>
+class shared_future;
+
+template<class Result>
+class promise;
+
+template<class Signature>
+class packaged_task;     // not defined
+
+enum class future_errc
+{
+    broken_promise = 1,
+    future_already_retrieved,
+    promise_already_satisfied,
+    no_state
+};
+
+enum class future_status
+{
+    ready,
+    timeout,
+    deferred
+};
+
+enum class launch
+{
+    async       = 1,
+    deferred    = 2
+};
+
+constexpr launch operator|(const launch left, const launch right) noexcept
+{
+    return static_cast<launch>(static_cast<int>(left) | static_cast<int>(right));
+}
+
+constexpr launch operator&(const launch left, const launch right) noexcept
+{
+    return static_cast<launch>(static_cast<int>(left) & static_cast<int>(right));
+}
+
+class future_error : public std::logic_error
+{
+private:
+    future_errc _code;
+
+public:
+    explicit future_error(const future_errc code)
+        : std::logic_error(_message(code)), _code(code) { /*Empty*/ }
+
+    future_errc code() const noexcept
+    {
+        return _code;
+    }
+
+private:
+    static const char* _message(const future_errc code) noexcept
+    {
+        switch (code)
+        {
+            case future_errc::broken_promise:               return "Promise destroyed before storing a result.";
+            case future_errc::future_already_retrieved:     return "Future already retrieved.";
+            case future_errc::promise_already_satisfied:    return "Promise already satisfied.";
+            default:                                        return "No associated state.";
+        }
+    }
+};  // END future_error
+
+template<class Sequence>
+struct when_any_result
+{
+    size_t index;           // position of the first ready future, size_t(-1) for an empty input
+    Sequence futures;
+};
+
+
+CUSTOM_DETAIL_BEGIN
+
+class _Future_Continuation      // node queued on a shared state, run once the state is ready
+{
+public:
+    _Future_Continuation* _Next = nullptr;
+
+    virtual void _on_ready() noexcept = 0;
+
+protected:
+    ~_Future_Continuation() = default;
+};  // END _Future_Continuation
+
+class _Future_State_Base : public intrusive_ref_counter<_Future_State_Base>    // state shared by a promise and its futures
+{
+// Results are stored at most once. _satisfied is claimed under the mutex before the
+// result is written, _ready is published under the mutex after, so a reader that sees
+// _ready also sees the result. Continuations queued before that run on the thread that
+// makes the state ready, the ones queued after run on the thread that queues them.
+
+private:
+    mutable mutex _mutex;
+    mutable condition_variable _readyCv;
+    std::atomic<bool> _ready                = false;
+    bool _satisfied                         = false;    // guarded by _mutex
+    _Future_Continuation* _continuations    = nullptr;  // guarded by _mutex, newest first
+
+protected:
+    std::exception_ptr _exception;
+
+public:
+    std::atomic<bool> _Retrieved = false;               // a future was handed out
+
+public:
+    // Constructors & Operators
+
+    _Future_State_Base() = default;
+    virtual ~_Future_State_Base() = default;
+
+    _Future_State_Base(const _Future_State_Base&)               = delete;
+    _Future_State_Base& operator=(const _Future_State_Base&)    = delete;
+
+public:
+    // Main functions
+
+    bool _is_ready() const noexcept
+    {
+        return _ready.load(std::memory_order_acquire);
+    }
+
+    virtual bool _is_deferred() const noexcept  // true while a deferred function has not started
+    {
+        return false;
+    }
+
+    virtual void _force() noexcept { /*Empty*/ }    // starts a deferred function
+
+    void _wait()
+    {
+        _force();
+        if (_is_ready())
+            return;
+
+        unique_lock<mutex> lock(_mutex);
+        _readyCv.wait(lock, [this]() { return _ready.load(std::memory_order_relaxed); });
+    }
+
+    template<class Clock, class Duration>
+    future_status _wait_until(const custom::chrono::time_point<Clock, Duration>& absoluteTime)
+    {
+        if (_is_deferred())
+            return future_status::deferred;
+
+        if (_is_ready())
+            return future_status::ready;
+
+        unique_lock<mutex> lock(_mutex);
+        return _readyCv.wait_until(lock, absoluteTime, [this]() { return _ready.load(std::memory_order_relaxed); }) ?
+                future_status::ready : future_status::timeout;
+    }
+
+    void _attach(_Future_Continuation* continuation) noexcept
+    {
+        _force();
+        {
+            lock_guard<mutex> lock(_mutex);
+            if (!_ready.load(std::memory_order_relaxed))
+            {
+                continuation->_Next = _continuations;
+                _continuations      = continuation;
+                return;
+            }
+        }
+
+        continuation->_on_ready();
+    }
+
+    void _set_exception(std::exception_ptr exception)
+    {
+        _claim();
+        _exception = custom::move(exception);
+        _make_ready();
+    }
+
+    void _abandon() noexcept    // the producer is gone, store broken_promise unless a result is there
+    {
+        {
+            lock_guard<mutex> lock(_mutex);
+            if (_satisfied)
+                return;
+
+            _satisfied = true;
+        }
+
+        _exception = std::make_exception_ptr(future_error(future_errc::broken_promise));
+        _make_ready();
+    }
+
+protected:
+    // Helpers
+
+    void _claim()
+    {
+        lock_guard<mutex> lock(_mutex);
+        if (_satisfied)
+            throw future_error(future_errc::promise_already_satisfied);
+
+        _satisfied = true;
+    }
+
+    void _unclaim() noexcept
+    {
+        lock_guard<mutex> lock(_mutex);
+        _satisfied = false;
+    }
+
+    template<class Store>
+    void _set_result(Store store)   // an exception thrown by store becomes the result
+    {
+        _claim();
+
+        try
+        {
+            store();
+        }
+        catch (...)
+        {
+            _exception = std::current_exception();
+        }
+
+        _make_ready();
+    }
+
+    void _rethrow_if_failed() const
+    {
+        if (_exception)
+            std::rethrow_exception(_exception);
+    }
+
+    void _make_ready() noexcept
+    {
+        _Future_Continuation* newest = nullptr;
+        {
+            lock_guard<mutex> lock(_mutex);
+            _ready.store(true, std::memory_order_release);
+            newest          = _continuations;
+            _continuations  = nullptr;
+            _readyCv.notify_all();
+        }
+
+        _Future_Continuation* oldest = nullptr;     // run in the order they were queued
+        while (newest != nullptr)
+        {
+            _Future_Continuation* next  = newest->_Next;
+            newest->_Next               = oldest;
+            oldest                      = newest;
+            newest                      = next;
+        }
+
+        while (oldest != nullptr)
+        {
+            _Future_Continuation* next = oldest->_Next;    // a continuation may free itself
+            oldest->_on_ready();
+            oldest = next;
+        }
+    }
+};  // END _Future_State_Base
+
+template<class Result>
+class _Future_State : public _Future_State_Base
+{
+private:
+    union { Result _value; };   // constructed when a value is stored
+    bool _hasValue = false;
+
+public:
+    _Future_State() noexcept { /*Empty*/ }
+
+    ~_Future_State() override
+    {
+        if (_hasValue)
+            _value.~Result();
+    }
+
+    template<class... Args>
+    void _set_value(Args&&... args)     // an exception from the copy goes to the caller, the state stays empty
+    {
+        this->_claim();
+
+        try
+        {
+            custom::construct_at(std::addressof(_value), custom::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            this->_unclaim();
+            CUSTOM_RERAISE;
+        }
+
+        _hasValue = true;
+        this->_make_ready();
+    }
+
+    template<class Func>
+    void _set_from(Func& func)          // stores func() or the exception it throws
+    {
+        this->_set_result([this, &func]()
+        {
+            custom::construct_at(std::addressof(_value), func());
+            _hasValue = true;
+        });
+    }
+
+    Result _take()
+    {
+        this->_rethrow_if_failed();
+        return custom::move(_value);
+    }
+
+    const Result& _peek() const
+    {
+        this->_rethrow_if_failed();
+        return _value;
+    }
+};  // END _Future_State
+
+template<class Result>
+class _Future_State<Result&> : public _Future_State_Base
+{
+private:
+    Result* _value = nullptr;
+
+public:
+    void _set_value(Result& value)
+    {
+        this->_claim();
+        _value = std::addressof(value);
+        this->_make_ready();
+    }
+
+    template<class Func>
+    void _set_from(Func& func)
+    {
+        this->_set_result([this, &func]() { _value = std::addressof(func()); });
+    }
+
+    Result& _take()
+    {
+        this->_rethrow_if_failed();
+        return *_value;
+    }
+
+    Result& _peek() const
+    {
+        this->_rethrow_if_failed();
+        return *_value;
+    }
+};  // END _Future_State<Result&>
+
+template<>
+class _Future_State<void> : public _Future_State_Base
+{
+public:
+    void _set_value()
+    {
+        this->_claim();
+        this->_make_ready();
+    }
+
+    template<class Func>
+    void _set_from(Func& func)
+    {
+        this->_set_result([&func]() { func(); });
+    }
+
+    void _take()
+    {
+        this->_rethrow_if_failed();
+    }
+
+    void _peek() const
+    {
+        this->_rethrow_if_failed();
+    }
+};  // END _Future_State<void>
+
+// std::async keeps lvalue references and drops cv and rvalue references from the result
+template<class Type>
+using _Future_Result_t = conditional_t<is_lvalue_reference_v<Type>, Type, remove_cv_ref_t<Type>>;
+
+template<class Func, class... Args>
+auto _make_call(Func&& func, Args&&... args)     // decay-copies everything, like thread and async
+{
+    return [func = custom::forward<Func>(func), ...args = custom::forward<Args>(args)]() mutable -> decltype(auto)
+    {
+        return custom::invoke(custom::move(func), custom::move(args)...);
+    };
+}
+
+template<class Result, class Call>
+class _Deferred_State final : public _Future_State<Result>      // launch::deferred, runs on the first wait
+{
+private:
+    Call _call;
+    std::atomic<bool> _started = false;
+
+public:
+    explicit _Deferred_State(Call&& call)
+        : _call(custom::move(call)) { /*Empty*/ }
+
+    bool _is_deferred() const noexcept override
+    {
+        return !_started.load(std::memory_order_acquire);
+    }
+
+    void _force() noexcept override
+    {
+        if (!_started.exchange(true, std::memory_order_acq_rel))
+            this->_set_from(_call);
+    }
+};  // END _Deferred_State
+
+template<class Result, class Call>
+class _Async_State final : public _Future_State<Result>     // launch::async, runs on its own thread
+{
+// Like std::async, the last future to let go of the state joins the thread.
+
+private:
+    Call _call;
+    thread _thread;
+
+public:
+    explicit _Async_State(Call&& call)
+        : _call(custom::move(call))
+    {
+        _thread = thread([this]() { this->_set_from(_call); });
+    }
+
+    ~_Async_State() override
+    {
+        if (_thread.get_id() == this_thread::get_id())     // a continuation on the thread dropped the last future
+            _thread.detach();
+        else
+            _thread.join();
+    }
+};  // END _Async_State
+
+template<class Result, class... Args>
+class _Packaged_State : public _Future_State<Result>
+{
+public:
+    virtual void _call(Args&&... args) = 0;
+    virtual _Packaged_State* _fresh() = 0;      // new state owning the same callable, for reset
+};  // END _Packaged_State
+
+template<class Result, class Func, class... Args>
+class _Packaged_State_Impl final : public _Packaged_State<Result, Args...>
+{
+private:
+    Func _func;
+
+public:
+    template<class Fn>
+    explicit _Packaged_State_Impl(Fn&& func)
+        : _func(custom::forward<Fn>(func)) { /*Empty*/ }
+
+    void _call(Args&&... args) override
+    {
+        auto call = [this, &args...]() -> decltype(auto) { return custom::invoke(_func, custom::forward<Args>(args)...); };
+        this->_set_from(call);
+    }
+
+    _Packaged_State<Result, Args...>* _fresh() override
+    {
+        return new _Packaged_State_Impl(custom::move(_func));
+    }
+};  // END _Packaged_State_Impl
+
+struct _Inline_Executor     // runs continuations on the thread that makes the parent ready
+{
+    template<class Func>
+    void submit(Func&& func)
+    {
+        func();
+    }
+
+    static _Inline_Executor& instance() noexcept
+    {
+        static _Inline_Executor executor;
+        return executor;
+    }
+};  // END _Inline_Executor
+
+template<class Result, class Func, class Parent, class Executor>
+class _Then_State final : public _Future_State<Result>, public _Future_Continuation    // result of future::then
+{
+// The parent's continuation list holds one reference, dropped after the call.
+
+private:
+    Func _func;
+    Parent _parent;
+    Executor* _executor;
+
+public:
+    template<class Fn>
+    _Then_State(Fn&& func, Parent&& parent, Executor& executor)
+        : _func(custom::forward<Fn>(func)), _parent(custom::move(parent)), _executor(std::addressof(executor)) { /*Empty*/ }
+
+    void _on_ready() noexcept override
+    {
+        const intrusive_ptr<_Then_State> self(this, false);     // adopt the list reference
+
+        try
+        {
+            _executor->submit([self]() { self->_run(); });
+        }
+        catch (...)
+        {
+            _run();     // the executor refused the job, run it here rather than lose it
+        }
+    }
+
+private:
+    void _run() noexcept
+    {
+        auto call = [this]() -> decltype(auto) { return custom::invoke(custom::move(_func), custom::move(_parent)); };
+        this->_set_from(call);
+    }
+};  // END _Then_State
+
+struct _Future_Access       // reaches the state inside futures and promises
+{
+    template<class Future>
+    static auto& _state(Future& future) noexcept
+    {
+        return future._state;
+    }
+
+    template<class Result>
+    static future<Result> _make_future(intrusive_ptr<_Future_State<Result>> state) noexcept
+    {
+        return future<Result>(custom::move(state));
+    }
+};  // END _Future_Access
+
+template<class Type>
+constexpr bool _Is_Future_v = false;
+
+template<class Result>
+constexpr bool _Is_Future_v<future<Result>> = true;
+
+template<class Result>
+constexpr bool _Is_Future_v<shared_future<Result>> = true;
+
+template<class Parent, class Executor, class Func>
+auto _then(Parent&& parent, Executor& executor, Func&& func)
+{
+    using _Result   = _Future_Result_t<decltype(custom::invoke(custom::declval<decay_t<Func>>(), custom::declval<Parent>()))>;
+    using _State    = _Then_State<_Result, decay_t<Func>, Parent, Executor>;
+
+    _Future_State_Base* parentState = _Future_Access::_state(parent).get();
+    intrusive_ptr<_Future_State<_Result>> state(new _State(custom::forward<Func>(func), custom::move(parent), executor));
+
+    intrusive_ptr_add_ref(state.get());     // owned by the parent's continuation list until it runs
+    parentState->_attach(static_cast<_State*>(state.get()));
+
+    return _Future_Access::_make_future(custom::move(state));
+}
+
+template<class Future>
+Future _take_input(Future& input)       // iterator-range when_all and when_any move futures and copy shared futures
+{
+    if constexpr (is_copy_constructible_v<Future>)
+        return input;
+    else
+        return custom::move(input);
+}
+
+template<class Type, class Func>
+void _for_each_future(vector<Type>& futures, Func func)
+{
+    for (auto& future : futures)
+        func(future);
+}
+
+template<class... Types, class Func>
+void _for_each_future(tuple<Types...>& futures, Func func)
+{
+    custom::apply([&func](auto&... future) { (func(future), ...); }, futures);
+}
+
+template<class Sequence, class Derived, class Result>
+class _When_State : public _Future_State<Result>    // one continuation per input future
+{
+protected:
+    struct _Input final : _Future_Continuation
+    {
+        Derived* _Owner = nullptr;
+        size_t _Index   = 0;
+
+        void _on_ready() noexcept override
+        {
+            Derived* owner = _Owner;
+            owner->_arrive(_Index);
+            intrusive_ptr_release(owner);
+        }
+    };
+
+    Sequence _futures;
+    vector<_Input> _inputs;
+
+public:
+    explicit _When_State(Sequence&& futures)
+        : _futures(custom::move(futures)) { /*Empty*/ }
+
+    size_t _input_count() noexcept
+    {
+        size_t count = 0;
+        _for_each_future(_futures, [&count](auto&) { ++count; });
+        return count;
+    }
+
+    void _attach_inputs()
+    {
+        _inputs.resize(_input_count());
+
+        size_t index = 0;
+        _for_each_future(_futures, [this, &index](auto& future)
+        {
+            _Input& input   = _inputs[index];
+            input._Owner    = static_cast<Derived*>(this);
+            input._Index    = index++;
+
+            intrusive_ptr_add_ref(static_cast<Derived*>(this));      // owned by the input's continuation list
+            _Future_Access::_state(future)->_attach(&input);
+        });
+    }
+};  // END _When_State
+
+template<class Sequence>
+class _When_All_State final : public _When_State<Sequence, _When_All_State<Sequence>, Sequence>
+{
+private:
+    using _Base = _When_State<Sequence, _When_All_State<Sequence>, Sequence>;
+
+    std::atomic<size_t> _remaining;     // inputs plus one for _start
+
+public:
+    explicit _When_All_State(Sequence&& futures)
+        : _Base(custom::move(futures)), _remaining(this->_input_count() + 1) { /*Empty*/ }
+
+    void _start()
+    {
+        this->_attach_inputs();
+        _arrive(0);
+    }
+
+    void _arrive(size_t) noexcept
+    {
+        if (_remaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+
+        auto result = [this]() -> Sequence { return custom::move(this->_futures); };
+        this->_set_from(result);
+    }
+};  // END _When_All_State
+
+template<class Sequence>
+class _When_Any_State final : public _When_State<Sequence, _When_Any_State<Sequence>, when_any_result<Sequence>>
+{
+private:
+    using _Base = _When_State<Sequence, _When_Any_State<Sequence>, when_any_result<Sequence>>;
+
+    static constexpr size_t _NONE = static_cast<size_t>(-1);
+
+    std::atomic<size_t> _winner = _NONE;
+    std::atomic<int> _gate;             // the winner and _start, or just _start for an empty input
+
+public:
+    explicit _When_Any_State(Sequence&& futures)
+        : _Base(custom::move(futures)), _gate(this->_input_count() > 0 ? 2 : 1) { /*Empty*/ }
+
+    void _start()
+    {
+        this->_attach_inputs();
+        _open_gate();
+    }
+
+    void _arrive(const size_t index) noexcept
+    {
+        size_t none = _NONE;
+        if (_winner.compare_exchange_strong(none, index, std::memory_order_acq_rel))
+            _open_gate();
+    }
+
+private:
+    void _open_gate() noexcept      // the futures move out only after every input is attached
+    {
+        if (_gate.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+
+        auto result = [this]() -> when_any_result<Sequence>
+        {
+            return when_any_result<Sequence>{_winner.load(std::memory_order_acquire), custom::move(this->_futures)};
+        };
+
+        this->_set_from(result);
+    }
+};  // END _When_Any_State
+
+template<template<class> class State, class Result, class Sequence>
+future<Result> _make_when(Sequence&& futures)
+{
+    intrusive_ptr<State<Sequence>> state(new State<Sequence>(custom::move(futures)));
+    state->_start();
+
+    return _Future_Access::_make_future(intrusive_ptr<_Future_State<Result>>(custom::move(state)));
+}
+
+template<class Result>
+class _Promise_Base
+{
+protected:
+    intrusive_ptr<_Future_State<Result>> _state;
+
+public:
+    // Constructors & Operators
+
+    _Promise_Base()
+        : _state(new _Future_State<Result>()) { /*Empty*/ }
+
+    _Promise_Base(_Promise_Base&& other) noexcept = default;
+
+    ~_Promise_Base()
+    {
+        if (_state)
+            _state->_abandon();
+    }
+
+    _Promise_Base& operator=(_Promise_Base&& other) noexcept
+    {
+        if (_state != other._state)
+        {
+            if (_state)
+                _state->_abandon();
+
+            _state = custom::move(other._state);
+        }
+
+        return *this;
+    }
+
+public:
+    // Main functions
+
+    future<Result> get_future()
+    {
+        if (_checked_state()._Retrieved.exchange(true))
+            throw future_error(future_errc::future_already_retrieved);
+
+        return _Future_Access::_make_future(_state);
+    }
+
+    void set_exception(std::exception_ptr exception)
+    {
+        _checked_state()._set_exception(custom::move(exception));
+    }
+
+protected:
+    _Future_State<Result>& _checked_state() const
+    {
+        if (!_state)
+            throw future_error(future_errc::no_state);
+
+        return *_state;
+    }
+};  // END _Promise_Base
+
+CUSTOM_DETAIL_END
+
+
+template<class Result>
+class future    // one-shot result of an asynchronous operation
+{
+private:
+    using _State = detail::_Future_State<Result>;
+
+    intrusive_ptr<_State> _state;
+
+    friend detail::_Future_Access;
+
+public:
+    // Constructors & Operators
+
+    future() noexcept = default;
+    future(future&&) noexcept = default;
+    future& operator=(future&&) noexcept = default;
+
+    future(const future&)               = delete;
+    future& operator=(const future&)    = delete;
+
+private:
+    explicit future(intrusive_ptr<_State> state) noexcept
+        : _state(custom::move(state)) { /*Empty*/ }
+
+public:
+    // Main functions
+
+    shared_future<Result> share() noexcept
+    {
+        return shared_future<Result>(custom::move(*this));
+    }
+
+    Result get()                // waits, then gives the result (or rethrows) and leaves the future empty
+    {
+        CUSTOM_ASSERT(valid(), "Future has no state.");
+
+        const intrusive_ptr<_State> state = custom::move(_state);
+        state->_wait();
+        return state->_take();
+    }
+
+    bool valid() const noexcept
+    {
+        return _state != nullptr;
+    }
+
+    bool is_ready() const noexcept
+    {
+        CUSTOM_ASSERT(valid(), "Future has no state.");
+        return _state->_is_ready();
+    }
+
+    void wait() const
+    {
+        CUSTOM_ASSERT(valid(), "Future has no state.");
+        _state->_wait();
+    }
+
+    template<class Rep, class Period>
+    future_status wait_for(const custom::chrono::duration<Rep, Period>& relativeTime) const
+    {
+        return wait_until(custom::chrono::steady_clock::now() + relativeTime);
+    }
+
+    template<class Clock, class Duration>
+    future_status wait_until(const custom::chrono::time_point<Clock, Duration>& absoluteTime) const
+    {
+        CUSTOM_ASSERT(valid(), "Future has no state.");
+        return _state->_wait_until(absoluteTime);
+    }
+
+    // Returns the future of func(ready future). func runs on the thread that makes this future ready,
+    // or right away if it already is. A deferred future runs its function first. Leaves this future empty.
+    template<class Func>
+    auto then(Func&& func)
+    {
+        return then(detail::_Inline_Executor::instance(), custom::forward<Func>(func));
+    }
+
+    // Same, but func is handed to executor.submit (a thread_pool for example) once this future is ready
+    template<class Executor, class Func>
+    auto then(Executor& executor, Func&& func)
+    {
+        CUSTOM_ASSERT(valid(), "Future has no state.");
+        return detail::_then(custom::move(*this), executor, custom::forward<Func>(func));
+    }
+};  // END future
+
+
+template<class Result>
+class shared_future     // copyable view of a result, any number of threads can wait and read
+{
+private:
+    using _State = detail::_Future_State<Result>;
+
+    intrusive_ptr<_State> _state;
+
+    friend detail::_Future_Access;
+
+public:
+    // Constructors & Operators
+
+    shared_future() noexcept = default;
+    shared_future(const shared_future&) noexcept = default;
+    shared_future(shared_future&&) noexcept = default;
+    shared_future& operator=(const shared_future&) noexcept = default;
+    shared_future& operator=(shared_future&&) noexcept = default;
+
+    shared_future(future<Result>&& other) noexcept
+        : _state(custom::move(detail::_Future_Access::_state(other))) { /*Empty*/ }
+
+public:
+    // Main functions
+
+    decltype(auto) get() const      // const Result&, Result& or void
+    {
+        CUSTOM_ASSERT(valid(), "Future has no state.");
+
+        _state->_wait();
+        return _state->_peek();
+    }
+
+    bool valid() const noexcept
+    {
+        return _state != nullptr;
+    }
+
+    bool is_ready() const noexcept
+    {
+        CUSTOM_ASSERT(valid(), "Future has no state.");
+        return _state->_is_ready();
+    }
+
+    void wait() const
+    {
+        CUSTOM_ASSERT(valid(), "Future has no state.");
+        _state->_wait();
+    }
+
+    template<class Rep, class Period>
+    future_status wait_for(const custom::chrono::duration<Rep, Period>& relativeTime) const
+    {
+        return wait_until(custom::chrono::steady_clock::now() + relativeTime);
+    }
+
+    template<class Clock, class Duration>
+    future_status wait_until(const custom::chrono::time_point<Clock, Duration>& absoluteTime) const
+    {
+        CUSTOM_ASSERT(valid(), "Future has no state.");
+        return _state->_wait_until(absoluteTime);
+    }
+
+    template<class Func>
+    auto then(Func&& func) const    // func gets a copy of this shared_future
+    {
+        return then(detail::_Inline_Executor::instance(), custom::forward<Func>(func));
+    }
+
+    template<class Executor, class Func>
+    auto then(Executor& executor, Func&& func) const
+    {
+        CUSTOM_ASSERT(valid(), "Future has no state.");
+        return detail::_then(shared_future(*this), executor, custom::forward<Func>(func));
+    }
+};  // END shared_future
+
+
+template<class Result>
+class promise : public detail::_Promise_Base<Result>
+{
+public:
+    void set_value(const Result& value)
+    {
+        this->_checked_state()._set_value(value);
+    }
+
+    void set_value(Result&& value)
+    {
+        this->_checked_state()._set_value(custom::move(value));
+    }
+
+    void swap(promise& other) noexcept
+    {
+        this->_state.swap(other._state);
+    }
+};  // END promise
+
+template<class Result>
+class promise<Result&> : public detail::_Promise_Base<Result&>
+{
+public:
+    void set_value(Result& value)
+    {
+        this->_checked_state()._set_value(value);
+    }
+
+    void swap(promise& other) noexcept
+    {
+        this->_state.swap(other._state);
+    }
+};  // END promise<Result&>
+
+template<>
+class promise<void> : public detail::_Promise_Base<void>
+{
+public:
+    void set_value()
+    {
+        this->_checked_state()._set_value();
+    }
+
+    void swap(promise& other) noexcept
+    {
+        this->_state.swap(other._state);
+    }
+};  // END promise<void>
+
+
+template<class Result, class... Args>
+class packaged_task<Result(Args...)>    // callable and its shared state in one allocation
+{
+private:
+    using _State = detail::_Packaged_State<Result, Args...>;
+
+    intrusive_ptr<_State> _state;
+
+public:
+    // Constructors & Operators
+
+    packaged_task() noexcept = default;
+
+    template<class Func,
+    enable_if_t<!is_same_v<remove_cv_ref_t<Func>, packaged_task>, bool> = true>
+    explicit packaged_task(Func&& func)
+        : _state(new detail::_Packaged_State_Impl<Result, decay_t<Func>, Args...>(custom::forward<Func>(func))) { /*Empty*/ }
+
+    packaged_task(packaged_task&&) noexcept = default;
+
+    packaged_task& operator=(packaged_task&& other) noexcept
+    {
+        packaged_task(custom::move(other)).swap(*this);
+        return *this;
+    }
+
+    ~packaged_task()
+    {
+        if (_state)
+            _state->_abandon();
+    }
+
+    packaged_task(const packaged_task&)             = delete;
+    packaged_task& operator=(const packaged_task&)  = delete;
+
+public:
+    // Main functions
+
+    bool valid() const noexcept
+    {
+        return _state != nullptr;
+    }
+
+    void swap(packaged_task& other) noexcept
+    {
+        _state.swap(other._state);
+    }
+
+    future<Result> get_future()
+    {
+        if (_checked_state()._Retrieved.exchange(true))
+            throw future_error(future_errc::future_already_retrieved);
+
+        return detail::_Future_Access::_make_future(intrusive_ptr<detail::_Future_State<Result>>(_state));
+    }
+
+    void operator()(Args... args)
+    {
+        _checked_state()._call(custom::forward<Args>(args)...);
+    }
+
+    void reset()    // new state for the same callable, the old one gets broken_promise if not done
+    {
+        intrusive_ptr<_State> fresh(_checked_state()._fresh());
+        _state->_abandon();
+        _state = custom::move(fresh);
+    }
+
+private:
+    _State& _checked_state() const
+    {
+        if (!_state)
+            throw future_error(future_errc::no_state);
+
+        return *_state;
+    }
+};  // END packaged_task
+
+
+// async
+template<class Func, class... Args>
+auto async(const launch policy, Func&& func, Args&&... args)
+{
+    auto call       = detail::_make_call(custom::forward<Func>(func), custom::forward<Args>(args)...);
+    using _Call     = decltype(call);
+    using _Result   = detail::_Future_Result_t<decltype(call())>;
+
+    intrusive_ptr<detail::_Future_State<_Result>> state;
+    if ((policy & launch::async) == launch::async)
+        state.reset(new detail::_Async_State<_Result, _Call>(custom::move(call)));
+    else
+        state.reset(new detail::_Deferred_State<_Result, _Call>(custom::move(call)));
+
+    state->_Retrieved.store(true, std::memory_order_relaxed);
+    return detail::_Future_Access::_make_future(custom::move(state));
+}
+
+template<class Func, class... Args,
+enable_if_t<!is_same_v<remove_cv_ref_t<Func>, launch>, bool> = true>
+auto async(Func&& func, Args&&... args)     // either policy allowed, this one picks a new thread
+{
+    return custom::async(launch::async | launch::deferred, custom::forward<Func>(func), custom::forward<Args>(args)...);
+}
+// END async
+
+
+// make_ready_future
+template<class Type>
+future<detail::_Future_Result_t<Type>> make_ready_future(Type&& value)
+{
+    promise<detail::_Future_Result_t<Type>> result;
+    result.set_value(custom::forward<Type>(value));
+    return result.get_future();
+}
+
+inline future<void> make_ready_future()
+{
+    promise<void> result;
+    result.set_value();
+    return result.get_future();
+}
+// END make_ready_future
+
+
+// when_all
+template<class InputIt,
+enable_if_t<is_input_iterator_v<InputIt>, bool> = true>
+future<vector<typename iterator_traits<InputIt>::value_type>> when_all(InputIt first, InputIt last)
+{
+    using _Sequence = vector<typename iterator_traits<InputIt>::value_type>;
+    static_assert(detail::_Is_Future_v<typename _Sequence::value_type>, "when_all requires future or shared_future elements!");
+
+    _Sequence futures;
+    for (/*Empty*/; first != last; ++first)
+        futures.push_back(detail::_take_input(*first));
+
+    return detail::_make_when<detail::_When_All_State, _Sequence>(custom::move(futures));
+}
+
+template<class... Futures,
+enable_if_t<((detail::_Is_Future_v<remove_cv_ref_t<Futures>> &&
+            is_constructible_v<remove_cv_ref_t<Futures>, Futures>) && ...), bool> = true>
+future<tuple<remove_cv_ref_t<Futures>...>> when_all(Futures&&... futures)
+{
+    using _Sequence = tuple<remove_cv_ref_t<Futures>...>;
+    return detail::_make_when<detail::_When_All_State, _Sequence>(_Sequence(custom::forward<Futures>(futures)...));
+}
+// END when_all
+
+
+// when_any
+template<class InputIt,
+enable_if_t<is_input_iterator_v<InputIt>, bool> = true>
+future<when_any_result<vector<typename iterator_traits<InputIt>::value_type>>> when_any(InputIt first, InputIt last)
+{
+    using _Sequence = vector<typename iterator_traits<InputIt>::value_type>;
+    static_assert(detail::_Is_Future_v<typename _Sequence::value_type>, "when_any requires future or shared_future elements!");
+
+    _Sequence futures;
+    for (/*Empty*/; first != last; ++first)
+        futures.push_back(detail::_take_input(*first));
+
+    return detail::_make_when<detail::_When_Any_State, when_any_result<_Sequence>>(custom::move(futures));
+}
+
+template<class... Futures,
+enable_if_t<((detail::_Is_Future_v<remove_cv_ref_t<Futures>> &&
+            is_constructible_v<remove_cv_ref_t<Futures>, Futures>) && ...), bool> = true>
+future<when_any_result<tuple<remove_cv_ref_t<Futures>...>>> when_any(Futures&&... futures)
+{
+    using _Sequence = tuple<remove_cv_ref_t<Futures>...>;
+    return detail::_make_when<detail::_When_Any_State, when_any_result<_Sequence>>(_Sequence(custom::forward<Futures>(futures)...));
+}
+// END when_any
+
+CUSTOM_END
+
+#elif defined _MSC_VER
+#error future not available for MSVC!
+#endif  // __GNUG__
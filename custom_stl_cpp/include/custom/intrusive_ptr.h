@@ -0,0 +1,288 @@
+#pragma once
+#include "custom/utility.h"
+
+#include <atomic>
+
+
+CUSTOM_BEGIN
+
+// Counting policies for intrusive_ref_counter
+struct thread_safe_counter
+{
+    using type = std::atomic<long>;
+
+    static long load(const type& counter) noexcept
+    {
+        return counter.load(std::memory_order_relaxed);
+    }
+
+    static void increment(type& counter) noexcept
+    {
+        counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static long decrement(type& counter) noexcept   // return the new count
+    {
+        return counter.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    }
+};  // END thread_safe_counter
+
+struct thread_unsafe_counter
+{
+    using type = long;
+
+    static long load(const type& counter) noexcept
+    {
+        return counter;
+    }
+
+    static void increment(type& counter) noexcept
+    {
+        ++counter;
+    }
+
+    static long decrement(type& counter) noexcept   // return the new count
+    {
+        return --counter;
+    }
+};  // END thread_unsafe_counter
+
+
+template<class Derived, class CounterPolicy = thread_safe_counter>
+class intrusive_ref_counter     // base class that keeps the reference count inside the object
+{
+// Derived objects are deleted through Derived* when the last intrusive_ptr lets go,
+// so the destructor of intrusive_ref_counter does not need to be virtual.
+
+private:
+    mutable typename CounterPolicy::type _refs = 0;
+
+public:
+    // Main functions
+
+    long use_count() const noexcept
+    {
+        return CounterPolicy::load(_refs);
+    }
+
+protected:
+    // Constructors & Operators
+
+    intrusive_ref_counter() noexcept = default;
+
+    intrusive_ref_counter(const intrusive_ref_counter&) noexcept
+        : _refs(0) { /*Empty*/ }                        // a copy is a new object with its own owners
+
+    intrusive_ref_counter& operator=(const intrusive_ref_counter&) noexcept
+    {
+        return *this;                                   // owners of this object do not change
+    }
+
+    ~intrusive_ref_counter() = default;
+
+private:
+    // Friends
+
+    friend void intrusive_ptr_add_ref(const intrusive_ref_counter* ptr) noexcept
+    {
+        CounterPolicy::increment(ptr->_refs);
+    }
+
+    friend void intrusive_ptr_release(const intrusive_ref_counter* ptr) noexcept
+    {
+        if (CounterPolicy::decrement(ptr->_refs) == 0)
+            delete static_cast<const Derived*>(ptr);
+    }
+};  // END intrusive_ref_counter
+
+
+template<class Type>
+class intrusive_ptr     // one-pointer handle to an object that counts its own references
+{
+// Type must be usable with unqualified calls intrusive_ptr_add_ref(Type*) and intrusive_ptr_release(Type*),
+// e.g. by deriving from intrusive_ref_counter<Type>.
+
+public:
+    using element_type = Type;
+
+private:
+    Type* _ptr = nullptr;
+
+public:
+    // Constructors
+
+    constexpr intrusive_ptr() noexcept = default;
+
+    intrusive_ptr(Type* ptr, bool addRef = true)    // addRef == false adopts a reference already taken
+        : _ptr(ptr)
+    {
+        if (_ptr != nullptr && addRef)
+            intrusive_ptr_add_ref(_ptr);
+    }
+
+    intrusive_ptr(const intrusive_ptr& other)
+        : _ptr(other._ptr)
+    {
+        if (_ptr != nullptr)
+            intrusive_ptr_add_ref(_ptr);
+    }
+
+    template<class Ty, enable_if_t<is_convertible_v<Ty*, Type*>, bool> = true>
+    intrusive_ptr(const intrusive_ptr<Ty>& other)
+        : _ptr(other.get())
+    {
+        if (_ptr != nullptr)
+            intrusive_ptr_add_ref(_ptr);
+    }
+
+    intrusive_ptr(intrusive_ptr&& other) noexcept
+        : _ptr(custom::exchange(other._ptr, nullptr)) { /*Empty*/ }
+
+    template<class Ty, enable_if_t<is_convertible_v<Ty*, Type*>, bool> = true>
+    intrusive_ptr(intrusive_ptr<Ty>&& other) noexcept
+        : _ptr(other.detach()) { /*Empty*/ }
+
+    ~intrusive_ptr()
+    {
+        if (_ptr != nullptr)
+            intrusive_ptr_release(_ptr);
+    }
+
+public:
+    // Operators
+
+    intrusive_ptr& operator=(const intrusive_ptr& other)
+    {
+        intrusive_ptr(other).swap(*this);
+        return *this;
+    }
+
+    template<class Ty, enable_if_t<is_convertible_v<Ty*, Type*>, bool> = true>
+    intrusive_ptr& operator=(const intrusive_ptr<Ty>& other)
+    {
+        intrusive_ptr(other).swap(*this);
+        return *this;
+    }
+
+    intrusive_ptr& operator=(intrusive_ptr&& other) noexcept
+    {
+        intrusive_ptr(custom::move(other)).swap(*this);
+        return *this;
+    }
+
+    template<class Ty, enable_if_t<is_convertible_v<Ty*, Type*>, bool> = true>
+    intrusive_ptr& operator=(intrusive_ptr<Ty>&& other) noexcept
+    {
+        intrusive_ptr(custom::move(other)).swap(*this);
+        return *this;
+    }
+
+    intrusive_ptr& operator=(Type* ptr)
+    {
+        intrusive_ptr(ptr).swap(*this);
+        return *this;
+    }
+
+    Type& operator*() const noexcept
+    {
+        CUSTOM_ASSERT(_ptr != nullptr, "Cannot dereference null intrusive_ptr.");
+        return *_ptr;
+    }
+
+    Type* operator->() const noexcept
+    {
+        CUSTOM_ASSERT(_ptr != nullptr, "Cannot dereference null intrusive_ptr.");
+        return _ptr;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return _ptr != nullptr;
+    }
+
+public:
+    // Main functions
+
+    Type* get() const noexcept
+    {
+        return _ptr;
+    }
+
+    Type* detach() noexcept     // give up ownership without releasing the reference
+    {
+        return custom::exchange(_ptr, nullptr);
+    }
+
+    void reset() noexcept
+    {
+        intrusive_ptr().swap(*this);
+    }
+
+    void reset(Type* ptr, bool addRef = true)
+    {
+        intrusive_ptr(ptr, addRef).swap(*this);
+    }
+
+    void swap(intrusive_ptr& other) noexcept
+    {
+        custom::swap(_ptr, other._ptr);
+    }
+};  // END intrusive_ptr
+
+
+// intrusive_ptr binary operators
+template<class Ty1, class Ty2>
+bool operator==(const intrusive_ptr<Ty1>& left, const intrusive_ptr<Ty2>& right) noexcept
+{
+    return left.get() == right.get();
+}
+
+template<class Ty1, class Ty2>
+bool operator!=(const intrusive_ptr<Ty1>& left, const intrusive_ptr<Ty2>& right) noexcept
+{
+    return !(left == right);
+}
+
+template<class Ty1, class Ty2>
+bool operator==(const intrusive_ptr<Ty1>& left, Ty2* right) noexcept
+{
+    return left.get() == right;
+}
+
+template<class Ty1, class Ty2>
+bool operator!=(const intrusive_ptr<Ty1>& left, Ty2* right) noexcept
+{
+    return !(left == right);
+}
+
+template<class Type>
+bool operator==(const intrusive_ptr<Type>& left, std::nullptr_t) noexcept
+{
+    return left.get() == nullptr;
+}
+
+template<class Type>
+bool operator!=(const intrusive_ptr<Type>& left, std::nullptr_t) noexcept
+{
+    return left.get() != nullptr;
+}
+
+template<class Type>
+void swap(intrusive_ptr<Type>& left, intrusive_ptr<Type>& right) noexcept
+{
+    left.swap(right);
+}
+
+template<class Ty1, class Ty2>
+intrusive_ptr<Ty1> static_pointer_cast(const intrusive_ptr<Ty2>& other)
+{
+    return intrusive_ptr<Ty1>(static_cast<Ty1*>(other.get()));
+}
+
+template<class Ty1, class Ty2>
+intrusive_ptr<Ty1> dynamic_pointer_cast(const intrusive_ptr<Ty2>& other)
+{
+    return intrusive_ptr<Ty1>(dynamic_cast<Ty1*>(other.get()));
+}
+
+CUSTOM_END
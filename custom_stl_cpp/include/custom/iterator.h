@@ -43,6 +43,31 @@ template<class Iterator, class Pointer>
 constexpr bool _Has_Nothrow_Operator_Arrow_v<Iterator, Pointer, false> =
 noexcept(detail::_Fake_Copy_Init<Pointer>(custom::declval<Iterator>().operator->()));
 
+// range access for the *_range container functions
+template<class Range>
+constexpr auto _range_begin(Range& range) -> decltype(range.begin())
+{
+    return range.begin();
+}
+
+template<class Type, size_t Size>
+constexpr Type* _range_begin(Type (&array)[Size]) noexcept
+{
+    return array;
+}
+
+template<class Range>
+constexpr auto _range_end(Range& range) -> decltype(range.end())
+{
+    return range.end();
+}
+
+template<class Type, size_t Size>
+constexpr Type* _range_end(Type (&array)[Size]) noexcept
+{
+    return array + Size;
+}
+
 CUSTOM_DETAIL_END
 
 template<class Container>
@@ -0,0 +1,68 @@
+#pragma once
+
+#if defined __GNUG__
+#include "custom/atomic.h"
+
+
+CUSTOM_BEGIN
+
+class latch                         // single-use countdown, waiters sleep on the counter itself
+{
+private:
+    atomic<int> _counter;           // 4 bytes, so it is the futex word
+
+public:
+    // Constructors & Operators
+
+    explicit latch(const ptrdiff_t expected) noexcept
+        : _counter(static_cast<int>(expected))
+    {
+        CUSTOM_ASSERT(expected >= 0 && expected <= (max)(), "Invalid expected value.");
+    }
+
+    ~latch() noexcept = default;
+
+    latch(const latch&)            = delete;
+    latch& operator=(const latch&) = delete;
+
+public:
+    // Main functions
+
+    static constexpr ptrdiff_t (max)() noexcept
+    {
+        return INT_MAX;
+    }
+
+    void count_down(const ptrdiff_t update = 1) noexcept
+    {
+        CUSTOM_ASSERT(update >= 0 && update <= _counter.load(std::memory_order_relaxed), "Invalid update value.");
+
+        // a waiter may destroy the latch as soon as it reads 0, notify only uses the address
+        if (_counter.fetch_sub(static_cast<int>(update), std::memory_order_release) == update)
+            _counter.notify_all();
+    }
+
+    bool try_wait() const noexcept
+    {
+        return _counter.load(std::memory_order_acquire) == 0;
+    }
+
+    void wait() const noexcept
+    {
+        for (int current = _counter.load(std::memory_order_acquire); current != 0;
+                current = _counter.load(std::memory_order_acquire))
+            _counter.wait(current, std::memory_order_acquire);
+    }
+
+    void arrive_and_wait(const ptrdiff_t update = 1) noexcept
+    {
+        count_down(update);
+        wait();
+    }
+}; // END latch
+
+CUSTOM_END
+
+#elif defined _MSC_VER
+#error NO Latch implementation
+#endif      // __GNUG__ and _MSC_VER
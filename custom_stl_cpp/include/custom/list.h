@@ -4,6 +4,7 @@
 #include "custom/utility.h"
 #include "custom/iterator.h"
 #include "custom/functional.h"
+#include "custom/algorithm.h"
 
 
 CUSTOM_BEGIN
@@ -230,27 +231,53 @@ public:
 		_create_head();
 	}
 
-	list(const size_t newSize, const value_type& value) : list()
+	explicit list(const allocator_type& alloc)
+		: _alloc(alloc)
+	{
+		_create_head();
+	}
+
+	list(const size_t newSize, const value_type& value, const allocator_type& alloc = allocator_type())
+		: list(alloc)
 	{
 		_create_until_size(newSize, value);
 	}
 
-	list(std::initializer_list<value_type> list)
+	list(std::initializer_list<value_type> list, const allocator_type& alloc = allocator_type())
+		: _alloc(alloc)
 	{
+		_create_head();
 		for (const auto& val : list)
 			push_back(val);
 	}
 
-	list(const list& other) : list()
+	list(const list& other)
+		: list(_Alloc_Node_Traits::select_on_container_copy_construction(other._alloc))
+	{
+		_copy(other);
+	}
+
+	list(const list& other, const allocator_type& alloc)
+		: list(alloc)
 	{
 		_copy(other);
 	}
 
-	list(list&& other) noexcept : list()
+	list(list&& other) noexcept
+		: list(other._alloc)
 	{
 		_move(custom::move(other));
 	}
 
+	list(list&& other, const allocator_type& alloc)
+		: list(alloc)
+	{
+		if (_alloc == other._alloc)
+			_move(custom::move(other));
+		else
+			_move_elements(other);
+	}
+
 	~list() noexcept
 	{
 		clear();
@@ -265,18 +292,38 @@ public:
 		if (_data._Head != other._data._Head)
 		{
 			clear();
+
+			if constexpr (_Alloc_Node_Traits::propagate_on_container_copy_assignment::value)
+				if (!(_alloc == other._alloc))		// the head belongs to the old allocator
+				{
+					_free_head();
+					_alloc = other._alloc;
+					_create_head();
+				}
+
 			_copy(other);
 		}
 
 		return *this;
 	}
 
-	list& operator=(list&& other) noexcept
+	list& operator=(list&& other)
+		noexcept(	_Alloc_Node_Traits::propagate_on_container_move_assignment::value ||
+					_Alloc_Node_Traits::is_always_equal::value)
 	{
 		if (_data._Head != other._data._Head)
 		{
 			clear();
-			_move(custom::move(other));
+
+			if constexpr (_Alloc_Node_Traits::propagate_on_container_move_assignment::value)
+			{
+				custom::swap(_alloc, other._alloc);		// heads are exchanged, so are their allocators
+				_move(custom::move(other));
+			}
+			else if (_alloc == other._alloc)
+				_move(custom::move(other));
+			else
+				_move_elements(other);					// nodes can't change owner, move element by element
 		}
 
 		return *this;
@@ -431,6 +478,11 @@ public:
 		return _data._Size == 0;
 	}
 
+	allocator_type get_allocator() const noexcept
+	{
+		return static_cast<allocator_type>(_alloc);
+	}
+
 	void clear()
 	{
 		_delete_until_size(0);
@@ -511,6 +563,8 @@ public:
 			otherFirst._RefData->_Head != otherLast._RefData->_Head)
 			throw std::domain_error("list provided by otherFirst and otherLast must be the same, but different from the one provided by where");
 
+		CUSTOM_ASSERT(_alloc == other._alloc, "Nodes can be spliced only between lists with equal allocators.");
+
 		size_t count = static_cast<size_t>(custom::distance(otherFirst, otherLast));
 
 		if (max_size() - _data._Size < count)
@@ -691,6 +745,14 @@ private:
 		_data._Size = custom::exchange(other._data._Size, 0);	// other list is empty before this
 	}
 
+	void _move_elements(list& other)
+	{
+		for (_NodePtr temp = other._data._Head->_Next; temp != other._data._Head; temp = temp->_Next)
+			emplace_back(custom::move(temp->_Value));
+
+		other.clear();
+	}
+
 	template<class... Args>
 	void _create_until_size(const size_t newSize, Args&&... args)
 	{
@@ -0,0 +1,127 @@
+#pragma once
+#include "custom/memory.h"
+
+#if defined __GNUG__ && !defined NDEBUG
+#include "custom/thread.h"
+#define _CUSTOM_LOCAL_OWNER_CHECK    // thread ids come from custom/thread.h, only GCC-like builds have them
+#endif
+
+
+CUSTOM_BEGIN
+
+CUSTOM_DETAIL_BEGIN
+
+class _Local_Counter        // plain long with the std::atomic<long> operations used by _Basic_Ref_Count
+{
+// Debug builds (GCC-like compilers) remember the thread that created the control block
+// and assert that every count change happens on it.
+
+private:
+    long _value;
+
+#ifdef _CUSTOM_LOCAL_OWNER_CHECK
+    thread::id _owner = this_thread::get_id();
+#endif
+
+public:
+    // Constructors & Operators
+
+    _Local_Counter(const long value) noexcept
+        : _value(value) { /*Empty*/ }
+
+    _Local_Counter(const _Local_Counter&)               = delete;
+    _Local_Counter& operator=(const _Local_Counter&)    = delete;
+
+    long operator++() noexcept
+    {
+        _check_owner();
+        return ++_value;
+    }
+
+    long operator--() noexcept
+    {
+        _check_owner();
+        return --_value;
+    }
+
+    operator long() const noexcept
+    {
+        return _value;
+    }
+
+public:
+    // Main functions
+
+    long load(std::memory_order) const noexcept
+    {
+        return _value;
+    }
+
+    bool compare_exchange_weak(long& expected, const long desired, std::memory_order) noexcept
+    {
+        _check_owner();
+
+        if (_value != expected)
+        {
+            expected = _value;
+            return false;
+        }
+
+        _value = desired;
+        return true;
+    }
+
+private:
+    // Helpers
+
+    void _check_owner() const noexcept
+    {
+#ifdef _CUSTOM_LOCAL_OWNER_CHECK
+        CUSTOM_ASSERT(_owner == this_thread::get_id(), "local_shared_ptr used from a thread other than its owner");
+#endif
+    }
+};  // END _Local_Counter
+
+using _Local_Ref_Count_Base = _Basic_Ref_Count<_Local_Counter>;     // local_shared_ptr, local_weak_ptr
+
+CUSTOM_DETAIL_END
+
+
+// Same interface as shared_ptr, but the counts are plain integers, so copies cost no locked instructions.
+// All owners of one object must live on one thread (checked in debug builds).
+// enable_shared_from_this is not hooked up: its weak_ptr belongs to shared_ptr.
+template<class Type>
+using local_shared_ptr = shared_ptr<Type, detail::_Local_Ref_Count_Base>;
+
+template<class Type>
+using local_weak_ptr = weak_ptr<Type, detail::_Local_Ref_Count_Base>;
+
+
+// build local_shared_ptr
+template<class Ty, class... Args, enable_if_t<!is_array_v<Ty>, bool> = true>
+local_shared_ptr<Ty> make_local_shared(Args&&... args)     // object and control block in one allocation
+{
+    return detail::_Shared_Factory::_make_object<local_shared_ptr<Ty>>(custom::forward<Args>(args)...);
+}
+
+template<class Ty, enable_if_t<is_unbounded_array_v<Ty>, bool> = true>
+local_shared_ptr<Ty> make_local_shared(const size_t size)
+{
+    return detail::_Shared_Factory::_make_array<local_shared_ptr<Ty>>(size, detail::_array_value_init<remove_cv_t<remove_all_extents_t<Ty>>>);
+}
+
+template<class Ty, enable_if_t<is_unbounded_array_v<Ty>, bool> = true>
+local_shared_ptr<Ty> make_local_shared(const size_t size, const remove_extent_t<Ty>& value)
+{
+    return detail::_Shared_Factory::_make_array<local_shared_ptr<Ty>>(size, detail::_array_fill<Ty>(value));
+}
+
+template<class Ty, class Alloc, class... Args, enable_if_t<!is_array_v<Ty>, bool> = true>
+local_shared_ptr<Ty> allocate_local_shared(const Alloc& alloc, Args&&... args)     // object and control block in one allocation from alloc
+{
+    return detail::_Shared_Factory::_allocate_object<local_shared_ptr<Ty>>(alloc, custom::forward<Args>(args)...);
+}
+
+CUSTOM_END
+
+#undef _CUSTOM_LOCAL_OWNER_CHECK
@@ -62,8 +62,11 @@ public:
 	map()
 		:_Base() { /*Empty*/ }
 
-	map(std::initializer_list<value_type> list)
-		:_Base(list) { /*Empty*/ }
+	explicit map(const allocator_type& alloc)
+		:_Base(alloc) { /*Empty*/ }
+
+	map(std::initializer_list<value_type> list, const allocator_type& alloc = allocator_type())
+		:_Base(list, alloc) { /*Empty*/ }
 
 	map(const map& other)
 		:_Base(other) { /*Empty*/ }
@@ -71,6 +74,12 @@ public:
 	map(map&& other) noexcept
 		:_Base(custom::move(other)) { /*Empty*/ }
 
+	map(const map& other, const allocator_type& alloc)
+		:_Base(other, alloc) { /*Empty*/ }
+
+	map(map&& other, const allocator_type& alloc)
+		:_Base(custom::move(other), alloc) { /*Empty*/ }
+
 	~map() { /*Empty*/ }
 
 public:
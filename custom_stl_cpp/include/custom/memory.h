@@ -3,16 +3,30 @@
 #include "custom/utility.h"
 
 #include <atomic>
+#include <cstdint>                  // uint64_t, uintptr_t
+#include <new>                      // std::bad_array_new_length, std::align_val_t
 #include <typeinfo>
 
 CUSTOM_BEGIN
 
-template<class Type>
+CUSTOM_DETAIL_BEGIN
+
+template<class Counter>
+class _Basic_Ref_Count;
+
+using _Ref_Count_Base = _Basic_Ref_Count<std::atomic<long>>;    // shared_ptr, weak_ptr
+
+CUSTOM_DETAIL_END
+
+template<class Type, class RefCountBase = detail::_Ref_Count_Base>     // RefCountBase picks the counter policy
 class shared_ptr;
 
-template<class Type>
+template<class Type, class RefCountBase = detail::_Ref_Count_Base>
 class weak_ptr;
 
+template<class Type>
+struct atomic;
+
 CUSTOM_DETAIL_BEGIN
 
 template<class Type>
@@ -119,22 +133,23 @@ template<class Ty>
 struct _Can_Enable_Shared<Ty, void_t<typename Ty::_Esft_t>>
     : is_convertible<remove_cv_t<Ty>*, typename Ty::_Esft_t*>::type {};
 
-class CUSTOM_NOVTABLE_ATTR _Ref_Count_Base     // Helper base class for ref counting
+template<class Counter>
+class CUSTOM_NOVTABLE_ATTR _Basic_Ref_Count     // Helper base class for ref counting, Counter behaves like std::atomic<long>
 {
 private:
-    std::atomic<long> _uses     = 1;
-    std::atomic<long> _weaks    = 1;
+    Counter _uses   = 1;
+    Counter _weaks  = 1;
 
 protected:
-    _Ref_Count_Base() noexcept = default;    // non-atomic initializations
+    _Basic_Ref_Count() noexcept = default;    // non-atomic initializations
 
 public:
     // Constructors & Operators
     
-    _Ref_Count_Base(const _Ref_Count_Base&)               = delete;
-    _Ref_Count_Base& operator=(const _Ref_Count_Base&)    = delete;
+    _Basic_Ref_Count(const _Basic_Ref_Count&)               = delete;
+    _Basic_Ref_Count& operator=(const _Basic_Ref_Count&)    = delete;
 
-    virtual ~_Ref_Count_Base() { /*Empty*/ }
+    virtual ~_Basic_Ref_Count() { /*Empty*/ }
 
 public:
     // Main functions
@@ -144,6 +159,17 @@ public:
         ++_uses;
     }
 
+    bool incref_nz() noexcept   // increment use count if not zero, return true if successful
+    {
+        long count = _uses.load(std::memory_order_relaxed);
+
+        while (count != 0)
+            if (_uses.compare_exchange_weak(count, count + 1, std::memory_order_relaxed))
+                return true;
+
+        return false;
+    }
+
     void incwref() noexcept
     {
         ++_weaks;
@@ -169,17 +195,18 @@ public:
         return static_cast<long>(_uses);
     }
 
+    virtual void* _get_deleter(const std::type_info& ti) const noexcept = 0;   // used by get_deleter()
+
 private:
     // Helpers
 
-    virtual void* _get_deleter(const std::type_info& ti) const noexcept = 0;
     virtual void _destroy() noexcept                                    = 0;
     virtual void _delete_this() noexcept                                = 0;
-}; // END _Ref_Count_Base
+}; // END _Basic_Ref_Count
 
 
-template<class TypePtr, class Deleter>
-class _Ref_Count_Deleter : public _Ref_Count_Base     // handle reference counting for object with deleter
+template<class TypePtr, class Deleter, class RefCountBase = _Ref_Count_Base>
+class _Ref_Count_Deleter : public RefCountBase     // handle reference counting for object with deleter
 {
 private:
     TypePtr _ptr;
@@ -188,7 +215,7 @@ private:
 public:
 
     explicit _Ref_Count_Deleter(TypePtr ptr, Deleter del)
-        : _Ref_Count_Base(), _ptr(ptr), _deleter(custom::move(del)) { /*Empty*/ }
+        : RefCountBase(), _ptr(ptr), _deleter(custom::move(del)) { /*Empty*/ }
 
 private:
     void* _get_deleter(const std::type_info& ti) const noexcept override
@@ -211,8 +238,8 @@ private:
 }; // END _Ref_Count_Deleter
 
 
-template<class TypePtr, class Deleter, class Alloc>
-class _Ref_Count_Deleter_Alloc : public _Ref_Count_Base     // handle reference counting for object with deleter and allocator
+template<class TypePtr, class Deleter, class Alloc, class RefCountBase = _Ref_Count_Base>
+class _Ref_Count_Deleter_Alloc : public RefCountBase     // handle reference counting for object with deleter and allocator
 {
 private:
     TypePtr _ptr;
@@ -221,7 +248,7 @@ private:
 
 public:
     explicit _Ref_Count_Deleter_Alloc(TypePtr ptr, Deleter del, const Alloc& alloc)
-        : _Ref_Count_Base(), _ptr(ptr), _deleter(custom::move(del)), _alloc(alloc) { /*Empty*/ }
+        : RefCountBase(), _ptr(ptr), _deleter(custom::move(del)), _alloc(alloc) { /*Empty*/ }
 
 private:
     void* _get_deleter(const std::type_info& ti) const noexcept override
@@ -249,15 +276,248 @@ private:
 };  // END _Ref_Count_Deleter_Alloc
 
 
-template<class Type>
+struct _For_Overwrite_Tag     // default-initialize the object (make_shared_for_overwrite)
+{
+    explicit _For_Overwrite_Tag() = default;
+};
+
+template<class Type, class RefCountBase = _Ref_Count_Base>
+class _Ref_Count_Obj : public RefCountBase     // handle reference counting for object stored in the control block
+{
+public:
+    union
+    {
+        remove_cv_t<Type> _Storage;     // constructed by the constructor, destroyed by _destroy()
+    };
+
+public:
+    template<class... Args>
+    explicit _Ref_Count_Obj(Args&&... args)
+        : RefCountBase()
+    {
+        ::new (static_cast<void*>(&_Storage)) remove_cv_t<Type>(custom::forward<Args>(args)...);
+    }
+
+    explicit _Ref_Count_Obj(_For_Overwrite_Tag)
+        : RefCountBase()
+    {
+        ::new (static_cast<void*>(&_Storage)) remove_cv_t<Type>;
+    }
+
+    ~_Ref_Count_Obj() noexcept override { /*Empty*/ }
+
+private:
+    void* _get_deleter(const std::type_info&) const noexcept override
+    {
+        return nullptr;
+    }
+
+    void _destroy() noexcept override   // destroy managed resource
+    {
+        custom::destroy_at(&_Storage);
+    }
+
+    void _delete_this() noexcept override
+    {
+        delete this;
+    }
+};  // END _Ref_Count_Obj
+
+
+template<class Type, class Alloc, class RefCountBase = _Ref_Count_Base>
+class _Ref_Count_Obj_Alloc : public RefCountBase     // handle reference counting for object stored in the control block, with allocator
+{
+private:
+    using _AllocObj         = typename allocator_traits<Alloc>::template rebind_alloc<remove_cv_t<Type>>;
+    using _AllocObjTraits   = allocator_traits<_AllocObj>;
+
+    _AllocObj _alloc;
+
+public:
+    union
+    {
+        remove_cv_t<Type> _Storage;     // constructed by the constructor, destroyed by _destroy()
+    };
+
+public:
+    template<class... Args>
+    explicit _Ref_Count_Obj_Alloc(const Alloc& alloc, Args&&... args)
+        : RefCountBase(), _alloc(alloc)
+    {
+        _AllocObjTraits::construct(_alloc, &_Storage, custom::forward<Args>(args)...);
+    }
+
+    explicit _Ref_Count_Obj_Alloc(const Alloc& alloc, _For_Overwrite_Tag)
+        : RefCountBase(), _alloc(alloc)
+    {
+        ::new (static_cast<void*>(&_Storage)) remove_cv_t<Type>;
+    }
+
+    ~_Ref_Count_Obj_Alloc() noexcept override { /*Empty*/ }
+
+private:
+    void* _get_deleter(const std::type_info&) const noexcept override
+    {
+        return nullptr;
+    }
+
+    void _destroy() noexcept override   // destroy managed resource
+    {
+        _AllocObjTraits::destroy(_alloc, &_Storage);
+    }
+
+    void _delete_this() noexcept override   // destroy self
+    {
+        using _AllocRefCount        = typename allocator_traits<Alloc>::template rebind_alloc<_Ref_Count_Obj_Alloc>;
+        using _AllocRefCountTraits  = allocator_traits<_AllocRefCount>;
+
+        _AllocRefCount alref(_alloc);
+        _AllocRefCountTraits::destroy(alref, this);
+        alref.deallocate(this, 1);
+    }
+};  // END _Ref_Count_Obj_Alloc
+
+
+template<class Type, class RefCountBase = _Ref_Count_Base>
+class _Ref_Count_Array : public RefCountBase     // handle reference counting for array stored after the control block
+{
+// One allocation: [control block | padding | Type[count]].
+// Multidimensional arrays are stored flat, Type is the scalar element.
+
+private:
+    size_t _count;
+
+    explicit _Ref_Count_Array(const size_t count) noexcept
+        : RefCountBase(), _count(count) { /*Empty*/ }
+
+public:
+    ~_Ref_Count_Array() noexcept override { /*Empty*/ }
+
+    template<class Init>
+    static _Ref_Count_Array* _create(const size_t count, Init init)     // init(address, index) constructs one element
+    {
+        if (count > (static_cast<size_t>(-1) - _header_bytes()) / sizeof(Type))
+            throw std::bad_array_new_length();
+
+        const size_t bytes          = _bytes(count);
+        void* const memory          = _allocate_bytes(bytes);
+        _Ref_Count_Array* const rep = ::new (memory) _Ref_Count_Array(count);
+        Type* const first           = rep->_get();
+        size_t constructed          = 0;
+
+        try
+        {
+            for (/*Empty*/; constructed < count; ++constructed)
+                init(first + constructed, constructed);
+        }
+        catch (...)
+        {
+            _destroy_reverse(first, constructed);
+            rep->~_Ref_Count_Array();
+            _deallocate_bytes(memory, bytes);
+            throw;
+        }
+
+        return rep;
+    }
+
+    Type* _get() noexcept
+    {
+        return reinterpret_cast<Type*>(reinterpret_cast<char*>(this) + _header_bytes());
+    }
+
+private:
+    void* _get_deleter(const std::type_info&) const noexcept override
+    {
+        return nullptr;
+    }
+
+    void _destroy() noexcept override   // destroy managed resource
+    {
+        _destroy_reverse(_get(), _count);
+    }
+
+    void _delete_this() noexcept override   // destroy self
+    {
+        const size_t bytes = _bytes(_count);
+
+        this->~_Ref_Count_Array();
+        _deallocate_bytes(this, bytes);
+    }
+
+private:
+    // Helpers
+
+    static constexpr size_t _alignment() noexcept
+    {
+        return alignof(_Ref_Count_Array) > alignof(Type) ? alignof(_Ref_Count_Array) : alignof(Type);
+    }
+
+    static constexpr size_t _header_bytes() noexcept
+    {
+        return (sizeof(_Ref_Count_Array) + alignof(Type) - 1) & ~(alignof(Type) - 1);
+    }
+
+    static constexpr size_t _bytes(const size_t count) noexcept
+    {
+        return _header_bytes() + count * sizeof(Type);
+    }
+
+    static void* _allocate_bytes(const size_t bytes)
+    {
+        if constexpr (_alignment() > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            return ::operator new(bytes, std::align_val_t(_alignment()));
+        else
+            return ::operator new(bytes);
+    }
+
+    static void _deallocate_bytes(void* const ptr, const size_t bytes) noexcept
+    {
+        if constexpr (_alignment() > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            ::operator delete(ptr, bytes, std::align_val_t(_alignment()));
+        else
+            ::operator delete(ptr, bytes);
+    }
+
+    static void _destroy_reverse(Type* const first, size_t count) noexcept   // elements are destroyed in reverse order
+    {
+        while (count > 0)
+            custom::destroy_at(first + --count);
+    }
+};  // END _Ref_Count_Array
+
+
+struct _Shared_Factory     // hand control blocks that own their object to shared pointers (make_shared family)
+{
+    template<class SharedPtr, class Ty, class RefCountBase>
+    static SharedPtr _from_block(Ty* const ptr, RefCountBase* const refCount) noexcept;
+
+    template<class SharedPtr, class... Args>
+    static SharedPtr _make_object(Args&&... args);
+
+    template<class SharedPtr, class Alloc, class... Args>
+    static SharedPtr _allocate_object(const Alloc& alloc, Args&&... args);
+
+    template<class SharedPtr, class Init>
+    static SharedPtr _make_array(const size_t count, Init init);
+};  // END _Shared_Factory
+
+
+template<class Type, class RefCountBase = _Ref_Count_Base>
 class _Shared_Weak_Base        // base class for shared_ptr and weak_ptr
 {
 public:
     using element_type = remove_extent_t<Type>;
 
 protected:
+    using _Ref_Count_Type = RefCountBase;
+
     element_type* _ptr      = nullptr;
-    _Ref_Count_Base* _rep   = nullptr;
+    RefCountBase* _rep      = nullptr;
+
+private:
+    template<class, class>
+    friend class _Shared_Weak_Base;     // converting constructors read the other pointer
 
 public:
     // Constructors & Operators
@@ -284,7 +544,7 @@ public:
     }
 
     template<class Ty>
-    bool owner_before(const _Shared_Weak_Base<Ty>& other) const noexcept
+    bool owner_before(const _Shared_Weak_Base<Ty, RefCountBase>& other) const noexcept
     {
         // compare addresses of manager objects
         return _rep < other._rep;
@@ -324,7 +584,7 @@ protected:
 
     // Common for Shared and Weak ptr
     template<class Ty>
-    void _move_construct(_Shared_Weak_Base<Ty>&& other) noexcept
+    void _move_construct(_Shared_Weak_Base<Ty, RefCountBase>&& other) noexcept
     {
         _ptr = other._ptr;
         _rep = other._rep;
@@ -335,7 +595,7 @@ protected:
 
     // shared_ptr constructor helpers
     template<class Ty>
-    void _copy_construct(const shared_ptr<Ty>& other) noexcept  // Only shared_ptr can copy
+    void _copy_construct(const _Shared_Weak_Base<Ty, RefCountBase>& other) noexcept  // Only shared pointers can copy
     {
         other._incref();
 
@@ -344,7 +604,7 @@ protected:
     }
 
     template<class Ty>
-    void _alias_copy_construct(const shared_ptr<Ty>& other, element_type* ptr) noexcept
+    void _alias_copy_construct(const _Shared_Weak_Base<Ty, RefCountBase>& other, element_type* ptr) noexcept
     {
         other._incref();
 
@@ -353,7 +613,7 @@ protected:
     }
 
     template<class Ty>
-    void _alias_move_construct(shared_ptr<Ty>&& other, element_type* ptr) noexcept
+    void _alias_move_construct(_Shared_Weak_Base<Ty, RefCountBase>&& other, element_type* ptr) noexcept
     {
         _ptr = ptr;
         _rep = other._rep;
@@ -363,15 +623,14 @@ protected:
     }
 
     template<class Ty>
-    bool _construct_from_weak(const weak_ptr<Ty>& other) noexcept
+    bool _construct_from_weak(const _Shared_Weak_Base<Ty, RefCountBase>& other) noexcept
     {
         // implement shared_ptr's constructor from weak_ptr, and weak_ptr::lock()
 
-        if (other._rep)
+        if (other._rep && other._rep->incref_nz())
         {
             _ptr = other._ptr;
             _rep = other._rep;
-            _rep->incref();
 
             return true;
         }
@@ -379,9 +638,18 @@ protected:
         return false;
     }
 
+    template<class SharedPtr>
+    SharedPtr _lock() const noexcept    // implement weak_ptr::lock()
+    {
+        SharedPtr shared;
+        _Shared_Weak_Base& sharedBase = shared;
+        (void)sharedBase._construct_from_weak(*this);
+        return shared;
+    }
+
     // weak_ptr contructor helpers
     template<class Ty>
-    void _weak_construct(const _Shared_Weak_Base<Ty>& other) noexcept
+    void _weak_construct(const _Shared_Weak_Base<Ty, RefCountBase>& other) noexcept
     {
         if (other._rep)
         {
@@ -708,6 +976,11 @@ public:
 
 }; // END unique_ptr[]
 
+template<class Type, class Deleter>
+struct is_trivially_relocatable<unique_ptr<Type, Deleter>>
+    : bool_constant<is_trivially_relocatable_v<typename unique_ptr<Type, Deleter>::pointer> &&
+                    is_trivially_relocatable_v<Deleter>> {};
+
 
 // build unique_ptr
 template<class Ty, class... Args, enable_if_t<!is_array_v<Ty>, bool> = true>
@@ -761,7 +1034,7 @@ public:
     using _Esft_t = enable_shared_from_this;
 
 private:
-    template<class Ty>
+    template<class, class>
     friend class shared_ptr;
 
     mutable weak_ptr<Type> _wptr;
@@ -805,15 +1078,15 @@ protected:
 };  // END enable_shared_from_this
 
 
-template<class Type>
-class shared_ptr : public detail::_Shared_Weak_Base<Type>    // class for reference counted resource management
+template<class Type, class RefCountBase>
+class shared_ptr : public detail::_Shared_Weak_Base<Type, RefCountBase>    // class for reference counted resource management
 {
 private:
-    using _Base         = detail::_Shared_Weak_Base<Type>;
+    using _Base         = detail::_Shared_Weak_Base<Type, RefCountBase>;
 
 public:
     using element_type  = typename _Base::element_type;
-    using weak_type     = weak_ptr<Type>;
+    using weak_type     = weak_ptr<Type, RefCountBase>;
 
 public:
     // Constructors
@@ -884,13 +1157,13 @@ public:
     }
 
     template<class Ty, enable_if_t<detail::_Is_Ptr_Compatible<Ty, Type>::value, bool> = true>
-    shared_ptr(const shared_ptr<Ty>& other) noexcept
+    shared_ptr(const shared_ptr<Ty, RefCountBase>& other) noexcept
     {
         this->_copy_construct(other);
     }
 
     template<class Ty>
-    shared_ptr(const shared_ptr<Ty>& other, element_type* ptr) noexcept // copy construct shared_ptr object that aliases other
+    shared_ptr(const shared_ptr<Ty, RefCountBase>& other, element_type* ptr) noexcept // copy construct shared_ptr object that aliases other
     {
         this->_alias_copy_construct(other, ptr);
     }
@@ -901,19 +1174,19 @@ public:
     }
 
     template<class Ty, enable_if_t<detail::_Is_Ptr_Compatible<Ty, Type>::value, bool> = true>
-    shared_ptr(shared_ptr<Ty>&& other) noexcept
+    shared_ptr(shared_ptr<Ty, RefCountBase>&& other) noexcept
     {
         this->_move_construct(custom::move(other));
     }
 
     template<class Ty>
-    shared_ptr(shared_ptr<Ty>&& other, element_type* ptr) noexcept  // move construct shared_ptr object that aliases other
+    shared_ptr(shared_ptr<Ty, RefCountBase>&& other, element_type* ptr) noexcept  // move construct shared_ptr object that aliases other
     {
         this->_alias_move_construct(custom::move(other), ptr);
     }
 
     template<class Ty, enable_if_t<detail::_Is_Ptr_Compatible<Ty, Type>::value, bool> = true>
-    explicit shared_ptr(const weak_ptr<Ty>& other)  // construct shared_ptr object that owns resource *other
+    explicit shared_ptr(const weak_ptr<Ty, RefCountBase>& other)  // construct shared_ptr object that owns resource *other
     {
         if (!this->_construct_from_weak(other))
             throw std::runtime_error("Bad weak ptr.");
@@ -935,7 +1208,7 @@ public:
         if (ptr)
         {
             const UnqRaw_t raw  = ptr;
-            const auto refCount = new detail::_Ref_Count_Deleter<UnqPointer_t, UnqDeleter_t>(ptr, custom::forward<Del>(unique.get_deleter()));
+            const auto refCount = new detail::_Ref_Count_Deleter<UnqPointer_t, UnqDeleter_t, RefCountBase>(ptr, custom::forward<Del>(unique.get_deleter()));
             _set_ptr_rep_and_enable_shared(raw, refCount);
             unique.release();
         }
@@ -956,7 +1229,7 @@ public:
     }
 
     template<class Ty, enable_if_t<detail::_Is_Ptr_Compatible<Ty, Type>::value, bool> = true>
-    shared_ptr& operator=(const shared_ptr<Ty>& other) noexcept
+    shared_ptr& operator=(const shared_ptr<Ty, RefCountBase>& other) noexcept
     {
         shared_ptr(other).swap(*this);
         return *this;
@@ -969,7 +1242,7 @@ public:
     }
 
     template<class Ty, enable_if_t<detail::_Is_Ptr_Compatible<Ty, Type>::value, bool> = true>
-    shared_ptr& operator=(shared_ptr<Ty>&& other) noexcept
+    shared_ptr& operator=(shared_ptr<Ty, RefCountBase>&& other) noexcept
     {
         shared_ptr(custom::move(other)).swap(*this);
         return *this;
@@ -1063,14 +1336,14 @@ private:
     void _set_pointer_default(const TypePtr ptr, Deleter del)   // take ownership of ptr, deleter
     {
         detail::_Temporary_Owner_Del<TypePtr, Deleter> temp(ptr, del);
-        _set_ptr_rep_and_enable_shared(temp._Ptr, new detail::_Ref_Count_Deleter<TypePtr, Deleter>(temp._Ptr, custom::move(del)));
+        _set_ptr_rep_and_enable_shared(temp._Ptr, new detail::_Ref_Count_Deleter<TypePtr, Deleter, RefCountBase>(temp._Ptr, custom::move(del)));
         temp._CallDeleter = false;
     }
 
     template<class TypePtr, class Deleter, class Alloc>
     void _set_pointer_alloc(const TypePtr ptr, Deleter del, Alloc alloc)    // take ownership of ptr, deleter del, allocator alloc
     {
-        using _RefCountDelAl            = detail::_Ref_Count_Deleter_Alloc<TypePtr, Deleter, Alloc>;
+        using _RefCountDelAl            = detail::_Ref_Count_Deleter_Alloc<TypePtr, Deleter, Alloc, RefCountBase>;
         using _AllocRefCountDelAl       = typename allocator_traits<Alloc>::template rebind_alloc<_RefCountDelAl>;
         using _AllocRefCountDelAlTraits = allocator_traits<_AllocRefCountDelAl>;
 
@@ -1085,13 +1358,14 @@ private:
     }
 
     template<class Ty>
-    void _set_ptr_rep_and_enable_shared(Ty* const ptr, detail::_Ref_Count_Base* const refCount) noexcept    // take ownership of ptr
+    void _set_ptr_rep_and_enable_shared(Ty* const ptr, RefCountBase* const refCount) noexcept    // take ownership of ptr
     {
         this->_ptr = ptr;
         this->_rep = refCount;
 
         // this is for enable_shared_from_this
         if constexpr (conjunction_v<
+                            is_same<RefCountBase, detail::_Ref_Count_Base>,     // its weak_ptr has the default policy
                             negation<is_array<Type>>,
                             negation<is_volatile<Ty>>,
                             detail::_Can_Enable_Shared<Ty>>)
@@ -1099,7 +1373,7 @@ private:
                 ptr->_wptr = shared_ptr<remove_cv_t<Ty>>(*this, const_cast<remove_cv_t<Ty>*>(ptr));
     }
 
-    void _set_ptr_rep_and_enable_shared(std::nullptr_t, detail::_Ref_Count_Base* const refCount) noexcept   // take ownership of nullptr
+    void _set_ptr_rep_and_enable_shared(std::nullptr_t, RefCountBase* const refCount) noexcept   // take ownership of nullptr
     {
         this->_ptr = nullptr;
         this->_rep = refCount;
@@ -1108,34 +1382,155 @@ private:
 private:
     // Friends
 
-    template<class Ty, class... Args>
-    friend enable_if_t<!is_array_v<Ty>, shared_ptr<Ty>> make_shared(Args&&... args);
-
-    template<class Ty, class Alloc, class... Args>
-    friend enable_if_t<!is_array_v<Ty>, shared_ptr<Ty>> allocate_shared(const Alloc& alloc, Args&&... args);
+    friend struct detail::_Shared_Factory;
 
-    template<class Del, class Ty>
-    friend Del* get_deleter(const shared_ptr<Ty>& ptr) noexcept;
+    template<class Del, class Ty, class RefCount>
+    friend Del* get_deleter(const shared_ptr<Ty, RefCount>& ptr) noexcept;
 }; // END shared_ptr
 
-// TODO
+CUSTOM_DETAIL_BEGIN
+
+template<class SharedPtr, class Ty, class RefCountBase>
+SharedPtr _Shared_Factory::_from_block(Ty* const ptr, RefCountBase* const refCount) noexcept
+{
+    SharedPtr result;
+    result._set_ptr_rep_and_enable_shared(ptr, refCount);
+    return result;
+}
+
+template<class SharedPtr, class... Args>
+SharedPtr _Shared_Factory::_make_object(Args&&... args)       // object and control block in one allocation
+{
+    using _RefCountObj = _Ref_Count_Obj<typename SharedPtr::element_type, typename SharedPtr::_Ref_Count_Type>;
+
+    auto refCount = new _RefCountObj(custom::forward<Args>(args)...);
+    return _from_block<SharedPtr>(&refCount->_Storage, refCount);
+}
+
+template<class SharedPtr, class Alloc, class... Args>
+SharedPtr _Shared_Factory::_allocate_object(const Alloc& alloc, Args&&... args)     // same, from alloc
+{
+    using _RefCountObjAl        = _Ref_Count_Obj_Alloc<typename SharedPtr::element_type, Alloc, typename SharedPtr::_Ref_Count_Type>;
+    using _AllocRefCountObjAl   = typename allocator_traits<Alloc>::template rebind_alloc<_RefCountObjAl>;
+
+    _AllocRefCountObjAl alref(alloc);
+    _RefCountObjAl* const refCount = alref.allocate(1);
+
+    try
+    {
+        ::new (static_cast<void*>(refCount)) _RefCountObjAl(alloc, custom::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        alref.deallocate(refCount, 1);
+        throw;
+    }
+
+    return _from_block<SharedPtr>(&refCount->_Storage, refCount);
+}
+
+template<class SharedPtr, class Init>
+SharedPtr _Shared_Factory::_make_array(const size_t count, Init init)     // count elements of SharedPtr::element_type
+{
+    using _Elem             = typename SharedPtr::element_type;
+    using _Scalar           = remove_cv_t<remove_all_extents_t<_Elem>>;
+    using _RefCountArray    = _Ref_Count_Array<_Scalar, typename SharedPtr::_Ref_Count_Type>;
+
+    constexpr size_t scalarsPerElem = sizeof(_Elem) / sizeof(_Scalar);
+
+    if (count > static_cast<size_t>(-1) / scalarsPerElem)
+        throw std::bad_array_new_length();
+
+    _RefCountArray* const refCount = _RefCountArray::_create(count * scalarsPerElem, init);
+    return _from_block<SharedPtr>(reinterpret_cast<_Elem*>(refCount->_get()), refCount);
+}
+
+template<class Type>
+auto _array_fill(const remove_extent_t<Type>& value) noexcept     // copy of value for every element, by scalar
+{
+    using _Scalar = remove_cv_t<remove_all_extents_t<Type>>;
+
+    constexpr size_t scalarsPerElem = sizeof(remove_extent_t<Type>) / sizeof(_Scalar);
+    const _Scalar* const source     = reinterpret_cast<const _Scalar*>(&value);
+
+    return [source](_Scalar* const address, const size_t index)
+            {
+                ::new (static_cast<void*>(address)) _Scalar(source[index % scalarsPerElem]);
+            };
+}
+
+template<class Scalar>
+void _array_value_init(Scalar* const address, size_t) { ::new (static_cast<void*>(address)) Scalar(); }
+
+template<class Scalar>
+void _array_default_init(Scalar* const address, size_t) { ::new (static_cast<void*>(address)) Scalar; }
+
+CUSTOM_DETAIL_END
+
 // build shared_ptr
-template<class Ty, class... Args>
-enable_if_t<!is_array_v<Ty>, shared_ptr<Ty>> make_shared(Args&&... args)
+template<class Ty, class... Args, enable_if_t<!is_array_v<Ty>, bool> = true>
+shared_ptr<Ty> make_shared(Args&&... args)     // object and control block in one allocation
+{
+    return detail::_Shared_Factory::_make_object<shared_ptr<Ty>>(custom::forward<Args>(args)...);
+}
+
+template<class Ty, enable_if_t<is_unbounded_array_v<Ty>, bool> = true>
+shared_ptr<Ty> make_shared(const size_t size)
+{
+    return detail::_Shared_Factory::_make_array<shared_ptr<Ty>>(size, detail::_array_value_init<remove_cv_t<remove_all_extents_t<Ty>>>);
+}
+
+template<class Ty, enable_if_t<is_unbounded_array_v<Ty>, bool> = true>
+shared_ptr<Ty> make_shared(const size_t size, const remove_extent_t<Ty>& value)
+{
+    return detail::_Shared_Factory::_make_array<shared_ptr<Ty>>(size, detail::_array_fill<Ty>(value));
+}
+
+template<class Ty, enable_if_t<is_bounded_array_v<Ty>, bool> = true>
+shared_ptr<Ty> make_shared()
 {
-    return shared_ptr<Ty>(new Ty(custom::forward<Args>(args)...));
+    return detail::_Shared_Factory::_make_array<shared_ptr<Ty>>(extent_v<Ty>, detail::_array_value_init<remove_cv_t<remove_all_extents_t<Ty>>>);
 }
 
-template<class Ty, class Alloc, class... Args>
-enable_if_t<!is_array_v<Ty>, shared_ptr<Ty>> allocate_shared(const Alloc& alloc, Args&&... args)
+template<class Ty, enable_if_t<is_bounded_array_v<Ty>, bool> = true>
+shared_ptr<Ty> make_shared(const remove_extent_t<Ty>& value)
 {
-    return shared_ptr<Ty>();
-    //return shared_ptr<Ty>(alloc, std::forward<Args>(args)...);
+    return detail::_Shared_Factory::_make_array<shared_ptr<Ty>>(extent_v<Ty>, detail::_array_fill<Ty>(value));
+}
+
+template<class Ty, enable_if_t<!is_array_v<Ty>, bool> = true>
+shared_ptr<Ty> make_shared_for_overwrite()
+{
+    return detail::_Shared_Factory::_make_object<shared_ptr<Ty>>(detail::_For_Overwrite_Tag());
+}
+
+template<class Ty, enable_if_t<is_unbounded_array_v<Ty>, bool> = true>
+shared_ptr<Ty> make_shared_for_overwrite(const size_t size)
+{
+    return detail::_Shared_Factory::_make_array<shared_ptr<Ty>>(size, detail::_array_default_init<remove_cv_t<remove_all_extents_t<Ty>>>);
+}
+
+template<class Ty, enable_if_t<is_bounded_array_v<Ty>, bool> = true>
+shared_ptr<Ty> make_shared_for_overwrite()
+{
+    return detail::_Shared_Factory::_make_array<shared_ptr<Ty>>(extent_v<Ty>, detail::_array_default_init<remove_cv_t<remove_all_extents_t<Ty>>>);
+}
+
+template<class Ty, class Alloc, class... Args, enable_if_t<!is_array_v<Ty>, bool> = true>
+shared_ptr<Ty> allocate_shared(const Alloc& alloc, Args&&... args)     // object and control block in one allocation from alloc
+{
+    return detail::_Shared_Factory::_allocate_object<shared_ptr<Ty>>(alloc, custom::forward<Args>(args)...);
+}
+
+template<class Ty, class Alloc, enable_if_t<!is_array_v<Ty>, bool> = true>
+shared_ptr<Ty> allocate_shared_for_overwrite(const Alloc& alloc)
+{
+    return custom::allocate_shared<Ty>(alloc, detail::_For_Overwrite_Tag());
 }
 
 // get_deleter
-template<class Del, class Ty>
-Del* get_deleter(const shared_ptr<Ty>& ptr) noexcept    // return pointer to shared_ptr's deleter object if its type is Del
+template<class Del, class Ty, class RefCountBase>
+Del* get_deleter(const shared_ptr<Ty, RefCountBase>& ptr) noexcept    // return pointer to shared_ptr's deleter object if its type is Del
 {
     if (ptr._rep)
         return static_cast<Del*>(ptr._rep->_get_deleter(typeid(Del)));
@@ -1144,8 +1539,8 @@ Del* get_deleter(const shared_ptr<Ty>& ptr) noexcept    // return pointer to sha
 }
 
 
-template<class Type>
-class weak_ptr : public detail::_Shared_Weak_Base<Type>    // class for pointer to reference counted resource
+template<class Type, class RefCountBase>
+class weak_ptr : public detail::_Shared_Weak_Base<Type, RefCountBase>    // class for pointer to reference counted resource
 {
 public:
     // Constructors
@@ -1158,7 +1553,13 @@ public:
     }
 
     template<class Ty, enable_if_t<detail::_Is_Ptr_Compatible<Ty, Type>::value, bool> = true>
-    weak_ptr(const shared_ptr<Ty>& other) noexcept
+    weak_ptr(const weak_ptr<Ty, RefCountBase>& other) noexcept
+    {
+        this->_weak_construct(other);
+    }
+
+    template<class Ty, enable_if_t<detail::_Is_Ptr_Compatible<Ty, Type>::value, bool> = true>
+    weak_ptr(const shared_ptr<Ty, RefCountBase>& other) noexcept
     {
         this->_weak_construct(other); // shared_ptr keeps resource alive during conversion
     }
@@ -1183,7 +1584,7 @@ public:
     }
 
     template<class Ty, enable_if_t<detail::_Is_Ptr_Compatible<Ty, Type>::value, bool> = true>
-    weak_ptr& operator=(const weak_ptr<Ty>& other) noexcept
+    weak_ptr& operator=(const weak_ptr<Ty, RefCountBase>& other) noexcept
     {
         weak_ptr(other).swap(*this);
         return *this;
@@ -1196,14 +1597,14 @@ public:
     }
 
     template<class Ty, enable_if_t<detail::_Is_Ptr_Compatible<Ty, Type>::value, bool> = true>
-    weak_ptr& operator=(weak_ptr<Ty>&& other) noexcept
+    weak_ptr& operator=(weak_ptr<Ty, RefCountBase>&& other) noexcept
     {
         weak_ptr(custom::move(other)).swap(*this);
         return *this;
     }
 
     template<class Ty, enable_if_t<detail::_Is_Ptr_Compatible<Ty, Type>::value, bool> = true>
-    weak_ptr& operator=(const shared_ptr<Ty>& other) noexcept
+    weak_ptr& operator=(const shared_ptr<Ty, RefCountBase>& other) noexcept
     {
         weak_ptr(other).swap(*this);
         return *this;
@@ -1222,12 +1623,245 @@ public:
         return this->use_count() == 0;
     }
 
-    shared_ptr<Type> lock() const noexcept  // convert to shared_ptr
+    shared_ptr<Type, RefCountBase> lock() const noexcept  // convert to shared_ptr
     {
-        shared_ptr<Type> shared;
-        (void)shared._construct_from_weak(*this);
-        return shared;
+        return this->template _lock<shared_ptr<Type, RefCountBase>>();
     }
 }; // END weak_ptr
 
+template<class Type, class RefCountBase>
+struct is_trivially_relocatable<shared_ptr<Type, RefCountBase>> : true_type {};
+
+template<class Type, class RefCountBase>
+struct is_trivially_relocatable<weak_ptr<Type, RefCountBase>> : true_type {};
+
+
+
+template<class Type>
+struct atomic<shared_ptr<Type>>     // lock-free atomic access to a shared_ptr
+{
+// Split reference counting: the atomic word packs a pointer to an immutable node holding
+// the shared_ptr with a count of readers currently copying out of that node.
+// A reader bumps the count (one fetch_add), copies the shared_ptr and gives its pin back
+// with a CAS while the node is still installed. A writer swaps in a new node and hands the
+// pins of the old one to the node's own counter; the last pinned reader deletes it.
+// Nobody takes a lock: readers and writers only retry CAS loops. Storing a non-empty
+// pointer allocates one node, an empty pointer is a null word.
+// On 64-bit targets the count lives in the top 16 bits, so node addresses must fit in 48 bits:
+// x86-64 with 4-level paging and AArch64 with 48-bit VA and untagged heap pointers.
+// 5-level paging (LA57) heaps, ARM TBI/MTE or other pointer tagging are not supported;
+// _pack() checks every node address and stops the program rather than corrupt it.
+
+public:
+    using value_type = shared_ptr<Type>;
+
+private:
+    struct _Node
+    {
+        shared_ptr<Type> _Value;
+        std::atomic<long> _Internal = 0;    // handed over pins minus returned pins
+
+        explicit _Node(shared_ptr<Type>&& value) noexcept
+            : _Value(custom::move(value)) { /*Empty*/ }
+    };
+
+    static_assert(sizeof(void*) == 4 || sizeof(void*) == 8, "The packed word needs 32 or 64-bit pointers.");
+
+    static constexpr int _COUNT_SHIFT   = sizeof(void*) == 4 ? 32 : 48;    // see the address limits above
+    static constexpr uint64_t _ONE_PIN  = uint64_t{1} << _COUNT_SHIFT;
+    static constexpr uint64_t _PTR_MASK = _ONE_PIN - 1;
+
+    mutable std::atomic<uint64_t> _word = 0;   // pinned by const load()
+
+public:
+    static constexpr bool is_always_lock_free = std::atomic<uint64_t>::is_always_lock_free;
+
+public:
+    // Constructors & Operators
+
+    constexpr atomic() noexcept = default;
+    constexpr atomic(std::nullptr_t) noexcept { /*Empty*/ }
+
+    atomic(shared_ptr<Type> desired)
+        : _word(_pack(_make_node(custom::move(desired)))) { /*Empty*/ }
+
+    atomic(const atomic&)               = delete;
+    atomic& operator=(const atomic&)    = delete;
+
+    ~atomic()
+    {
+        _retire(_word.load(std::memory_order_relaxed));
+    }
+
+    void operator=(shared_ptr<Type> desired)
+    {
+        store(custom::move(desired));
+    }
+
+    void operator=(std::nullptr_t) noexcept
+    {
+        store(nullptr);
+    }
+
+    operator shared_ptr<Type>() const noexcept
+    {
+        return load();
+    }
+
+public:
+    // Main functions
+
+    bool is_lock_free() const noexcept
+    {
+        return _word.is_lock_free();
+    }
+
+    shared_ptr<Type> load(std::memory_order = std::memory_order_seq_cst) const noexcept
+    {
+        _Node* const node = _acquire();
+
+        if (node == nullptr)
+            return shared_ptr<Type>();
+
+        shared_ptr<Type> result = node->_Value;
+        _release(node);
+        return result;
+    }
+
+    void store(shared_ptr<Type> desired, std::memory_order order = std::memory_order_seq_cst)
+    {
+        (void)exchange(custom::move(desired), order);
+    }
+
+    shared_ptr<Type> exchange(shared_ptr<Type> desired, std::memory_order = std::memory_order_seq_cst)
+    {
+        _Node* const newNode    = _make_node(custom::move(desired));
+        const uint64_t old      = _word.exchange(_pack(newNode), std::memory_order_acq_rel);
+
+        _Node* const oldNode    = _node_of(old);
+        shared_ptr<Type> result = oldNode ? oldNode->_Value : shared_ptr<Type>();     // copy, pinned readers may still read it
+        _retire(old);
+        return result;
+    }
+
+    bool compare_exchange_strong(   shared_ptr<Type>& expected, shared_ptr<Type> desired,
+                                    std::memory_order = std::memory_order_seq_cst)
+    {
+        _Node* const newNode = _make_node(custom::move(desired));   // may throw, so before any pin is taken
+
+        for (;;)
+        {
+            _Node* const node = _acquire();
+
+            if (!_equivalent(node, expected))
+            {
+                expected = node ? node->_Value : shared_ptr<Type>();
+                _release(node);
+                delete newNode;
+                return false;
+            }
+
+            if (node == nullptr && newNode == nullptr)  // empty replaced by empty
+                return true;
+
+            uint64_t current = _word.load(std::memory_order_relaxed);
+            while (_node_of(current) == node)
+                if (_word.compare_exchange_weak(current, _pack(newNode), std::memory_order_acq_rel, std::memory_order_relaxed))
+                {
+                    _retire(current);       // our pin travels with the others
+                    _release(node);
+                    return true;
+                }
+
+            _release(node);                 // another value was installed meanwhile, compare again
+        }
+    }
+
+    bool compare_exchange_strong(   shared_ptr<Type>& expected, shared_ptr<Type> desired,
+                                    std::memory_order success, std::memory_order)
+    {
+        return compare_exchange_strong(expected, custom::move(desired), success);
+    }
+
+    bool compare_exchange_weak(     shared_ptr<Type>& expected, shared_ptr<Type> desired,
+                                    std::memory_order order = std::memory_order_seq_cst)
+    {
+        return compare_exchange_strong(expected, custom::move(desired), order);
+    }
+
+    bool compare_exchange_weak(     shared_ptr<Type>& expected, shared_ptr<Type> desired,
+                                    std::memory_order success, std::memory_order)
+    {
+        return compare_exchange_strong(expected, custom::move(desired), success);
+    }
+
+private:
+    // Helpers
+
+    static _Node* _make_node(shared_ptr<Type>&& value)    // empty pointers are stored as a null node
+    {
+        if (!value && value.use_count() == 0)
+            return nullptr;
+
+        return new _Node(custom::move(value));
+    }
+
+    static uint64_t _pack(_Node* const node) noexcept
+    {
+        const uint64_t address = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(node));    // no pins
+        CUSTOM_ASSERT((address & ~_PTR_MASK) == 0, "Node address does not fit the packed word");
+        return address;
+    }
+
+    static _Node* _node_of(const uint64_t word) noexcept
+    {
+        return reinterpret_cast<_Node*>(static_cast<uintptr_t>(word & _PTR_MASK));
+    }
+
+    static bool _equivalent(const _Node* const node, const shared_ptr<Type>& other) noexcept   // same pointer and same owner
+    {
+        if (node == nullptr)
+            return !other && other.use_count() == 0;
+
+        return  node->_Value.get() == other.get() &&
+                !node->_Value.owner_before(other) &&
+                !other.owner_before(node->_Value);
+    }
+
+    _Node* _acquire() const noexcept    // pin the installed node
+    {
+        // Pins on an empty word are never given back and only wrap around in the count bits.
+        const uint64_t old = _word.fetch_add(_ONE_PIN, std::memory_order_acquire);
+        _Node* const node  = _node_of(old);
+
+        CUSTOM_ASSERT(node == nullptr || (old >> _COUNT_SHIFT) + 1 < (uint64_t{1} << (64 - _COUNT_SHIFT)), "Too many concurrent readers");
+        return node;
+    }
+
+    void _release(_Node* const node) const noexcept     // unpin, node was returned by _acquire()
+    {
+        if (node == nullptr)
+            return;
+
+        uint64_t current = _word.load(std::memory_order_relaxed);
+
+        while (_node_of(current) == node)
+            if (_word.compare_exchange_weak(current, current - _ONE_PIN, std::memory_order_release, std::memory_order_relaxed))
+                return;
+
+        // node was swapped out and its pins were (or will be) handed to _Internal
+        if (node->_Internal.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete node;
+    }
+
+    static void _retire(const uint64_t word) noexcept   // word was swapped out, hand its pins to the node
+    {
+        _Node* const node   = _node_of(word);
+        const long pins     = static_cast<long>(word >> _COUNT_SHIFT);
+
+        if (node != nullptr && node->_Internal.fetch_add(pins, std::memory_order_acq_rel) == -pins)
+            delete node;
+    }
+};  // END atomic<shared_ptr>
+
 CUSTOM_END
\ No newline at end of file
@@ -0,0 +1,817 @@
+#pragma once
+#include "custom/_memory_utils.h"
+#include "custom/utility.h"
+#include "custom/bit.h"             // bit_ceil, countr_zero, has_single_bit
+#include "custom/vector.h"
+#include "custom/list.h"
+#include "custom/map.h"
+#include "custom/unordered_map.h"
+
+#include <atomic>
+#include <cstddef>                  // std::max_align_t, std::byte
+#include <cstdint>                  // uintptr_t
+#include <new>                      // std::bad_alloc, std::align_val_t
+
+#if defined __GNUG__
+#include "custom/mutex.h"
+#endif
+
+
+CUSTOM_BEGIN
+
+namespace pmr
+{
+class memory_resource           // Abstract source of memory, used by polymorphic_allocator
+{
+protected:
+    static constexpr size_t _MAX_ALIGN = alignof(std::max_align_t);
+
+public:
+    // Constructors & Operators
+
+    memory_resource()                                   = default;
+    memory_resource(const memory_resource&)             = default;
+    memory_resource& operator=(const memory_resource&)  = default;
+    virtual ~memory_resource()                          = default;
+
+public:
+    // Main functions
+
+    [[nodiscard]] void* allocate(const size_t bytes, const size_t alignment = _MAX_ALIGN)
+    {
+        CUSTOM_ASSERT(custom::has_single_bit(alignment), "Alignment must be a power of 2.");
+        return do_allocate(bytes, alignment);
+    }
+
+    void deallocate(void* ptr, const size_t bytes, const size_t alignment = _MAX_ALIGN)
+    {
+        do_deallocate(ptr, bytes, alignment);
+    }
+
+    bool is_equal(const memory_resource& other) const noexcept
+    {
+        return do_is_equal(other);
+    }
+
+private:
+    virtual void* do_allocate(size_t bytes, size_t alignment)               = 0;
+    virtual void do_deallocate(void* ptr, size_t bytes, size_t alignment)   = 0;
+    virtual bool do_is_equal(const memory_resource& other) const noexcept   = 0;
+};  // END memory_resource
+
+inline bool operator==(const memory_resource& left, const memory_resource& right) noexcept
+{
+    return &left == &right || left.is_equal(right);
+}
+
+inline bool operator!=(const memory_resource& left, const memory_resource& right) noexcept
+{
+    return !(left == right);
+}
+
+
+struct pool_options
+{
+    size_t max_blocks_per_chunk         = 0;    // 0 lets the resource choose
+    size_t largest_required_pool_block  = 0;    // larger requests go straight to upstream
+};  // END pool_options
+
+inline memory_resource* new_delete_resource() noexcept;
+}   // END namespace pmr
+
+
+CUSTOM_DETAIL_BEGIN
+
+class _New_Delete_Resource final : public pmr::memory_resource
+{
+private:
+    void* do_allocate(const size_t bytes, const size_t alignment) override
+    {
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            return ::operator new(bytes, std::align_val_t(alignment));
+
+        return ::operator new(bytes);
+    }
+
+    void do_deallocate(void* ptr, const size_t bytes, const size_t alignment) override
+    {
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            ::operator delete(ptr, bytes, std::align_val_t(alignment));
+        else
+            ::operator delete(ptr, bytes);
+    }
+
+    bool do_is_equal(const pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};  // END _New_Delete_Resource
+
+class _Null_Resource final : public pmr::memory_resource
+{
+private:
+    void* do_allocate(size_t, size_t) override
+    {
+        throw std::bad_alloc();
+    }
+
+    void do_deallocate(void*, size_t, size_t) override { /*Empty*/ }
+
+    bool do_is_equal(const pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};  // END _Null_Resource
+
+
+struct _Pool_Chunk              // footer at the end of a pool chunk, links the chunks for release
+{
+    _Pool_Chunk* _Next;
+    size_t _Bytes;              // whole chunk, footer included
+};
+
+struct _Free_Block              // stored inside a free block
+{
+    _Free_Block* _Next;
+};
+
+class _Pool                     // blocks of one size, cut from chunks that grow geometrically
+{
+public:
+    size_t _BlockSize           = 0;
+    size_t _FirstBlocks         = 0;        // blocks in the first chunk
+    size_t _MaxBlocks           = 0;        // cap for blocks in a chunk
+    size_t _NextBlocks          = 0;        // blocks in the next chunk
+    _Free_Block* _Free          = nullptr;  // freed blocks, reused first
+    char* _Unused               = nullptr;  // never used blocks of the last chunk
+    char* _UnusedEnd            = nullptr;
+    _Pool_Chunk* _Chunks        = nullptr;
+
+    static constexpr size_t _FIRST_CHUNK_BYTES = 1024;
+
+public:
+
+    void _init(const size_t blockSize, const size_t maxBlocks) noexcept
+    {
+        _BlockSize      = blockSize;
+        _MaxBlocks      = maxBlocks;
+        _FirstBlocks    = (custom::min)(maxBlocks, (custom::max)(size_t(1), _FIRST_CHUNK_BYTES / blockSize));
+        _NextBlocks     = _FirstBlocks;
+    }
+
+    void* _allocate(pmr::memory_resource* upstream)
+    {
+        if (_Free != nullptr)
+            return custom::exchange(_Free, _Free->_Next);
+
+        if (_Unused == _UnusedEnd)
+            _add_chunk(upstream);
+
+        void* block = _Unused;
+        _Unused += _BlockSize;
+        return block;
+    }
+
+    void _deallocate(void* ptr) noexcept
+    {
+        _Free_Block* block  = static_cast<_Free_Block*>(ptr);
+        block->_Next        = _Free;
+        _Free               = block;
+    }
+
+    void _release(pmr::memory_resource* upstream) noexcept
+    {
+        while (_Chunks != nullptr)
+        {
+            _Pool_Chunk* chunk  = _Chunks;
+            _Chunks             = chunk->_Next;
+
+            char* base = reinterpret_cast<char*>(chunk + 1) - chunk->_Bytes;
+            upstream->deallocate(base, chunk->_Bytes, _chunk_alignment());
+        }
+
+        _Free       = nullptr;
+        _Unused     = nullptr;
+        _UnusedEnd  = nullptr;
+        _NextBlocks = _FirstBlocks;
+    }
+
+private:
+
+    // blocks are powers of 2, so every block in a chunk keeps the chunk alignment
+    size_t _chunk_alignment() const noexcept
+    {
+        return (custom::min)(_BlockSize, alignof(std::max_align_t));
+    }
+
+    void _add_chunk(pmr::memory_resource* upstream)
+    {
+        const size_t blocksBytes    = _NextBlocks * _BlockSize;
+        const size_t bytes          = blocksBytes + sizeof(_Pool_Chunk);
+        char* base                  = static_cast<char*>(upstream->allocate(bytes, _chunk_alignment()));
+
+        _Chunks     = ::new (static_cast<void*>(base + blocksBytes)) _Pool_Chunk{_Chunks, bytes};
+        _Unused     = base;
+        _UnusedEnd  = base + blocksBytes;
+        _NextBlocks = (custom::min)(2 * _NextBlocks, _MaxBlocks);
+    }
+};  // END _Pool
+
+struct _Oversized_Block         // header in front of an allocation served by upstream
+{
+    _Oversized_Block* _Previous;
+    _Oversized_Block* _Next;
+    void* _Base;                // as returned by upstream
+    size_t _Bytes;
+    size_t _Alignment;
+};
+
+inline std::atomic<pmr::memory_resource*>& _default_resource() noexcept
+{
+    static std::atomic<pmr::memory_resource*> resource = pmr::new_delete_resource();
+    return resource;
+}
+
+CUSTOM_DETAIL_END
+
+
+namespace pmr
+{
+inline memory_resource* new_delete_resource() noexcept
+{
+    static detail::_New_Delete_Resource resource;
+    return &resource;
+}
+
+inline memory_resource* null_memory_resource() noexcept
+{
+    static detail::_Null_Resource resource;
+    return &resource;
+}
+
+inline memory_resource* get_default_resource() noexcept
+{
+    return detail::_default_resource().load(std::memory_order_acquire);
+}
+
+inline memory_resource* set_default_resource(memory_resource* resource) noexcept
+{
+    if (resource == nullptr)
+        resource = new_delete_resource();
+
+    return detail::_default_resource().exchange(resource, std::memory_order_acq_rel);
+}
+
+
+class monotonic_buffer_resource : public memory_resource     // Bump allocator, memory is given back only by release()
+{
+// Serves requests from the current buffer by advancing a pointer; deallocate does nothing.
+// When the buffer is exhausted a bigger one is taken from upstream, so a burst of allocations
+// (e.g. everything one request handler needs) costs a few upstream calls and is freed at once.
+
+private:
+    struct _Chunk               // header at the start of every buffer taken from upstream
+    {
+        _Chunk* _Next;
+        size_t _Bytes;
+    };
+
+    static constexpr size_t _DEFAULT_SIZE       = 1024;
+    static constexpr size_t _GROWTH_FACTOR      = 2;
+
+    memory_resource* _upstream  = nullptr;
+    void* _initialBuffer        = nullptr;  // supplied by the user, never freed
+    size_t _initialSize         = 0;
+    char* _current              = nullptr;
+    size_t _space               = 0;
+    size_t _nextSize            = _DEFAULT_SIZE;
+    _Chunk* _chunks             = nullptr;
+
+public:
+    // Constructors & Operators
+
+    monotonic_buffer_resource()
+        : monotonic_buffer_resource(get_default_resource()) { /*Empty*/ }
+
+    explicit monotonic_buffer_resource(memory_resource* upstream)
+        : _upstream(upstream)
+    {
+        CUSTOM_ASSERT(upstream != nullptr, "Upstream resource is null.");
+    }
+
+    explicit monotonic_buffer_resource(const size_t initialSize)
+        : monotonic_buffer_resource(initialSize, get_default_resource()) { /*Empty*/ }
+
+    monotonic_buffer_resource(const size_t initialSize, memory_resource* upstream)
+        : _upstream(upstream), _nextSize((initialSize != 0) ? initialSize : 1)
+    {
+        CUSTOM_ASSERT(upstream != nullptr, "Upstream resource is null.");
+    }
+
+    monotonic_buffer_resource(void* buffer, const size_t bufferSize)
+        : monotonic_buffer_resource(buffer, bufferSize, get_default_resource()) { /*Empty*/ }
+
+    monotonic_buffer_resource(void* buffer, const size_t bufferSize, memory_resource* upstream)
+        :   _upstream(upstream),
+            _initialBuffer(buffer),
+            _initialSize(bufferSize),
+            _current(static_cast<char*>(buffer)),
+            _space(bufferSize),
+            _nextSize(_next_buffer_size(bufferSize))
+    {
+        CUSTOM_ASSERT(upstream != nullptr, "Upstream resource is null.");
+    }
+
+    monotonic_buffer_resource(const monotonic_buffer_resource&)             = delete;
+    monotonic_buffer_resource& operator=(const monotonic_buffer_resource&)  = delete;
+
+    ~monotonic_buffer_resource() override
+    {
+        release();
+    }
+
+public:
+    // Main functions
+
+    // Give all buffers back to upstream and start over from the initial buffer.
+    // The next buffer gets the size of the last one, so a reused resource needs fewer upstream calls.
+    void release() noexcept
+    {
+        if (_chunks != nullptr)
+            _nextSize = _chunks->_Bytes - sizeof(_Chunk);
+
+        while (_chunks != nullptr)
+        {
+            _Chunk* chunk   = _chunks;
+            _chunks         = chunk->_Next;
+            _upstream->deallocate(chunk, chunk->_Bytes, _MAX_ALIGN);
+        }
+
+        _current    = static_cast<char*>(_initialBuffer);
+        _space      = _initialSize;
+    }
+
+    memory_resource* upstream_resource() const noexcept
+    {
+        return _upstream;
+    }
+
+private:
+    // Helpers
+
+    void* do_allocate(const size_t bytes, const size_t alignment) override
+    {
+        size_t padding = _padding(_current, alignment);
+
+        if (_current == nullptr || padding + bytes > _space)
+        {
+            _add_buffer(bytes, alignment);
+            padding = _padding(_current, alignment);
+        }
+
+        void* ptr   = _current + padding;
+        _current   += padding + bytes;
+        _space     -= padding + bytes;
+
+        return ptr;
+    }
+
+    void do_deallocate(void*, size_t, size_t) override { /*Empty*/ }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    static size_t _padding(const char* ptr, const size_t alignment) noexcept
+    {
+        return static_cast<size_t>(-reinterpret_cast<uintptr_t>(ptr)) & (alignment - 1);
+    }
+
+    static size_t _next_buffer_size(const size_t size) noexcept
+    {
+        return (custom::max)(size * _GROWTH_FACTOR, _DEFAULT_SIZE);
+    }
+
+    void _add_buffer(const size_t bytes, const size_t alignment)
+    {
+        const size_t usable = (custom::max)(_nextSize, bytes + alignment);
+        const size_t total  = sizeof(_Chunk) + usable;
+
+        _Chunk* chunk   = static_cast<_Chunk*>(_upstream->allocate(total, _MAX_ALIGN));
+        chunk->_Next    = _chunks;
+        chunk->_Bytes   = total;
+        _chunks         = chunk;
+
+        _current    = reinterpret_cast<char*>(chunk + 1);
+        _space      = usable;
+        _nextSize   = _next_buffer_size(usable);
+    }
+};  // END monotonic_buffer_resource
+
+
+class unsynchronized_pool_resource : public memory_resource  // Size class pools for a single thread
+{
+// Requests are rounded up to a power of 2 block size and served from that pool's free list.
+// Chunks of blocks come from upstream and are kept until release() or destruction.
+// Requests above largest_required_pool_block (or over-aligned) go straight to upstream.
+
+private:
+    using _Pool             = detail::_Pool;
+    using _Oversized_Block  = detail::_Oversized_Block;
+
+    static constexpr size_t _MIN_BLOCK          = 8;
+    static constexpr size_t _MAX_POOLS          = 18;           // blocks from 8 B to 1 MiB
+    static constexpr size_t _DEFAULT_LARGEST    = 4096;
+    static constexpr size_t _CHUNK_BYTES_LIMIT  = 256 * 1024;   // default cap for a chunk
+
+    memory_resource* _upstream          = nullptr;
+    pool_options _options;
+    size_t _poolCount                   = 0;
+    _Pool _pools[_MAX_POOLS];
+    _Oversized_Block* _oversized        = nullptr;
+
+public:
+    // Constructors & Operators
+
+    unsynchronized_pool_resource()
+        : unsynchronized_pool_resource(pool_options(), get_default_resource()) { /*Empty*/ }
+
+    explicit unsynchronized_pool_resource(memory_resource* upstream)
+        : unsynchronized_pool_resource(pool_options(), upstream) { /*Empty*/ }
+
+    explicit unsynchronized_pool_resource(const pool_options& options)
+        : unsynchronized_pool_resource(options, get_default_resource()) { /*Empty*/ }
+
+    unsynchronized_pool_resource(const pool_options& options, memory_resource* upstream)
+        : _upstream(upstream), _options(_normalize(options))
+    {
+        CUSTOM_ASSERT(upstream != nullptr, "Upstream resource is null.");
+
+        _poolCount = static_cast<size_t>(   custom::countr_zero(_options.largest_required_pool_block) -
+                                            custom::countr_zero(_MIN_BLOCK)) + 1;
+
+        for (size_t i = 0; i < _poolCount; ++i)
+        {
+            const size_t blockSize  = _MIN_BLOCK << i;
+            const size_t maxBlocks  = (_options.max_blocks_per_chunk != 0) ?
+                                        _options.max_blocks_per_chunk :
+                                        (custom::max)(size_t(1), _CHUNK_BYTES_LIMIT / blockSize);
+
+            _pools[i]._init(blockSize, maxBlocks);
+        }
+    }
+
+    unsynchronized_pool_resource(const unsynchronized_pool_resource&)            = delete;
+    unsynchronized_pool_resource& operator=(const unsynchronized_pool_resource&) = delete;
+
+    ~unsynchronized_pool_resource() override
+    {
+        release();
+    }
+
+public:
+    // Main functions
+
+    // Give all chunks and oversized blocks back to upstream, even if not deallocated
+    void release() noexcept
+    {
+        for (size_t i = 0; i < _poolCount; ++i)
+            _pools[i]._release(_upstream);
+
+        while (_oversized != nullptr)
+        {
+            _Oversized_Block* block = _oversized;
+            _oversized              = block->_Next;
+            _upstream->deallocate(block->_Base, block->_Bytes, block->_Alignment);
+        }
+    }
+
+    memory_resource* upstream_resource() const noexcept
+    {
+        return _upstream;
+    }
+
+    pool_options options() const noexcept
+    {
+        return _options;
+    }
+
+private:
+    // Helpers
+
+    void* do_allocate(const size_t bytes, const size_t alignment) override
+    {
+        const size_t index = _pool_index(bytes, alignment);
+
+        if (index < _poolCount)
+            return _pools[index]._allocate(_upstream);
+
+        return _allocate_oversized(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, const size_t bytes, const size_t alignment) override
+    {
+        const size_t index = _pool_index(bytes, alignment);
+
+        if (index < _poolCount)
+            _pools[index]._deallocate(ptr);
+        else
+            _deallocate_oversized(ptr);
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    static pool_options _normalize(pool_options options) noexcept
+    {
+        size_t largest = (options.largest_required_pool_block != 0) ? options.largest_required_pool_block : _DEFAULT_LARGEST;
+        largest = (custom::max)(largest, _MIN_BLOCK);
+        largest = (custom::min)(largest, _MIN_BLOCK << (_MAX_POOLS - 1));
+
+        options.largest_required_pool_block = custom::bit_ceil(largest);
+        return options;
+    }
+
+    // pool for this request or _poolCount if it must go to upstream
+    size_t _pool_index(const size_t bytes, const size_t alignment) const noexcept
+    {
+        const size_t size = (custom::max)((custom::max)(bytes, alignment), _MIN_BLOCK);
+
+        if (size > _options.largest_required_pool_block || alignment > _MAX_ALIGN)
+            return _poolCount;
+
+        return static_cast<size_t>(custom::countr_zero(custom::bit_ceil(size)) - custom::countr_zero(_MIN_BLOCK));
+    }
+
+    void* _allocate_oversized(const size_t bytes, size_t alignment)
+    {
+        alignment               = (custom::max)(alignment, alignof(_Oversized_Block));
+        const size_t offset     = (sizeof(_Oversized_Block) + alignment - 1) & ~(alignment - 1);
+        const size_t total      = offset + bytes;
+        char* base              = static_cast<char*>(_upstream->allocate(total, alignment));
+
+        _Oversized_Block* block = reinterpret_cast<_Oversized_Block*>(base + offset) - 1;
+        ::new (static_cast<void*>(block)) _Oversized_Block{nullptr, _oversized, base, total, alignment};
+
+        if (_oversized != nullptr)
+            _oversized->_Previous = block;
+
+        _oversized = block;
+        return base + offset;
+    }
+
+    void _deallocate_oversized(void* ptr) noexcept
+    {
+        _Oversized_Block* block = static_cast<_Oversized_Block*>(ptr) - 1;
+
+        if (block->_Previous != nullptr)
+            block->_Previous->_Next = block->_Next;
+        else
+            _oversized = block->_Next;
+
+        if (block->_Next != nullptr)
+            block->_Next->_Previous = block->_Previous;
+
+        _upstream->deallocate(block->_Base, block->_Bytes, block->_Alignment);
+    }
+};  // END unsynchronized_pool_resource
+
+
+#if defined __GNUG__
+class synchronized_pool_resource : public memory_resource    // unsynchronized_pool_resource guarded by a mutex
+{
+private:
+    unsynchronized_pool_resource _pools;
+    custom::mutex _mutex;
+
+public:
+    // Constructors & Operators
+
+    synchronized_pool_resource()
+        : _pools() { /*Empty*/ }
+
+    explicit synchronized_pool_resource(memory_resource* upstream)
+        : _pools(upstream) { /*Empty*/ }
+
+    explicit synchronized_pool_resource(const pool_options& options)
+        : _pools(options) { /*Empty*/ }
+
+    synchronized_pool_resource(const pool_options& options, memory_resource* upstream)
+        : _pools(options, upstream) { /*Empty*/ }
+
+    synchronized_pool_resource(const synchronized_pool_resource&)               = delete;
+    synchronized_pool_resource& operator=(const synchronized_pool_resource&)    = delete;
+
+    ~synchronized_pool_resource() override = default;
+
+public:
+    // Main functions
+
+    void release()
+    {
+        custom::lock_guard<custom::mutex> lock(_mutex);
+        _pools.release();
+    }
+
+    memory_resource* upstream_resource() const noexcept
+    {
+        return _pools.upstream_resource();
+    }
+
+    pool_options options() const noexcept
+    {
+        return _pools.options();
+    }
+
+private:
+    // Helpers
+
+    void* do_allocate(const size_t bytes, const size_t alignment) override
+    {
+        custom::lock_guard<custom::mutex> lock(_mutex);
+        return _pools.allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, const size_t bytes, const size_t alignment) override
+    {
+        custom::lock_guard<custom::mutex> lock(_mutex);
+        _pools.deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};  // END synchronized_pool_resource
+#endif  // __GNUG__
+
+
+template<class Type = std::byte>
+class polymorphic_allocator;
+}   // END namespace pmr
+
+
+CUSTOM_DETAIL_BEGIN
+
+// Element is a container that can be given the same resource as the one holding it
+template<class Type, class Alloc, class = void>
+struct _Uses_Polymorphic_Allocator : false_type {};
+
+template<class Type, class Alloc>
+struct _Uses_Polymorphic_Allocator<Type, Alloc, void_t<typename Type::allocator_type>>
+    : bool_constant<is_convertible_v<Alloc, typename Type::allocator_type>> {};
+
+CUSTOM_DETAIL_END
+
+
+namespace pmr
+{
+template<class Type>
+class polymorphic_allocator         // Allocator that forwards to a memory_resource chosen at run time
+{
+public:
+    using value_type = Type;
+
+private:
+    memory_resource* _resource;
+
+public:
+    // Constructors & Operators
+
+    polymorphic_allocator() noexcept
+        : _resource(get_default_resource()) { /*Empty*/ }
+
+    polymorphic_allocator(memory_resource* resource) noexcept
+        : _resource(resource)
+    {
+        CUSTOM_ASSERT(resource != nullptr, "Resource is null.");
+    }
+
+    polymorphic_allocator(const polymorphic_allocator& other) = default;
+
+    template<class Other>
+    polymorphic_allocator(const polymorphic_allocator<Other>& other) noexcept
+        : _resource(other.resource()) { /*Empty*/ }
+
+    polymorphic_allocator& operator=(const polymorphic_allocator&) = delete;     // resources are not propagated
+
+public:
+    // Main functions
+
+    [[nodiscard]] Type* allocate(const size_t count)
+    {
+        if (count > static_cast<size_t>(-1) / sizeof(Type))
+            throw std::bad_array_new_length();
+
+        return static_cast<Type*>(_resource->allocate(count * sizeof(Type), alignof(Type)));
+    }
+
+    void deallocate(Type* address, const size_t count)
+    {
+        _resource->deallocate(address, count * sizeof(Type), alignof(Type));
+    }
+
+    [[nodiscard]] void* allocate_bytes(const size_t bytes, const size_t alignment = alignof(std::max_align_t))
+    {
+        return _resource->allocate(bytes, alignment);
+    }
+
+    void deallocate_bytes(void* ptr, const size_t bytes, const size_t alignment = alignof(std::max_align_t))
+    {
+        _resource->deallocate(ptr, bytes, alignment);
+    }
+
+    template<class Ty>
+    [[nodiscard]] Ty* allocate_object(const size_t count = 1)
+    {
+        if (count > static_cast<size_t>(-1) / sizeof(Ty))
+            throw std::bad_array_new_length();
+
+        return static_cast<Ty*>(allocate_bytes(count * sizeof(Ty), alignof(Ty)));
+    }
+
+    template<class Ty>
+    void deallocate_object(Ty* ptr, const size_t count = 1)
+    {
+        deallocate_bytes(ptr, count * sizeof(Ty), alignof(Ty));
+    }
+
+    template<class Ty, class... Args>
+    [[nodiscard]] Ty* new_object(Args&&... args)
+    {
+        Ty* ptr = allocate_object<Ty>();
+
+        try
+        {
+            construct(ptr, custom::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            deallocate_object(ptr);
+            throw;
+        }
+
+        return ptr;
+    }
+
+    template<class Ty>
+    void delete_object(Ty* ptr)
+    {
+        custom::destroy_at(ptr);
+        deallocate_object(ptr);
+    }
+
+    // Nested pmr containers get this resource too, if they accept a trailing allocator
+    template<class Ty, class... Args>
+    void construct(Ty* const address, Args&&... args)
+    {
+        if constexpr (  detail::_Uses_Polymorphic_Allocator<Ty, polymorphic_allocator>::value &&
+                        is_constructible_v<Ty, Args..., const polymorphic_allocator&>)
+            custom::construct_at(address, custom::forward<Args>(args)..., *this);
+        else
+            custom::construct_at(address, custom::forward<Args>(args)...);
+    }
+
+    polymorphic_allocator select_on_container_copy_construction() const noexcept
+    {
+        return polymorphic_allocator();     // copies use the default resource, like std
+    }
+
+    memory_resource* resource() const noexcept
+    {
+        return _resource;
+    }
+};  // END polymorphic_allocator
+
+template<class Type1, class Type2>
+bool operator==(const polymorphic_allocator<Type1>& left, const polymorphic_allocator<Type2>& right) noexcept
+{
+    return *left.resource() == *right.resource();
+}
+
+template<class Type1, class Type2>
+bool operator!=(const polymorphic_allocator<Type1>& left, const polymorphic_allocator<Type2>& right) noexcept
+{
+    return !(left == right);
+}
+
+
+// Containers using polymorphic_allocator
+
+template<class Type>
+using vector = custom::vector<Type, polymorphic_allocator<Type>>;
+
+template<class Type>
+using list = custom::list<Type, polymorphic_allocator<Type>>;
+
+template<class Key, class Type, class Compare = custom::less<Key>>
+using map = custom::map<Key, Type, Compare, polymorphic_allocator<custom::pair<Key, Type>>>;
+
+template<class Key, class Type, class Hash = custom::hash<Key>, class Compare = custom::equal_to<Key>>
+using unordered_map = custom::unordered_map<Key, Type, Hash, Compare, polymorphic_allocator<custom::pair<Key, Type>>>;
+}   // END namespace pmr
+
+CUSTOM_END
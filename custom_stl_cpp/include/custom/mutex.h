@@ -3,11 +3,99 @@
 #if defined __GNUG__
 #include "custom/_lock.h"
 
+#if defined __linux__
+#include "custom/_futex.h"
+#endif  // __linux__
+
 
 CUSTOM_BEGIN
 
 CUSTOM_DETAIL_BEGIN
 
+#if defined __linux__
+class _Mutex_Base         // 4-byte mutex on a futex word
+{
+// _state is 0 when unlocked, 1 when locked, 2 when locked and a thread may sleep on it
+// ("Futexes Are Tricky", mutex 3). unlock() only enters the kernel in state 2.
+// lock() spins for a short while before sleeping, but only when another core can release
+// the lock meanwhile and nobody is asleep already (a long queue means a long wait).
+
+public:
+    using native_handle_type = _Futex_Word*;
+
+private:
+    friend condition_variable;
+
+    static constexpr int _SPIN_LIMIT = 100;
+
+    _Futex_Word _state = 0;
+
+public:
+    // Constructors & Operators
+
+    _Mutex_Base() noexcept = default;
+    ~_Mutex_Base() = default;
+
+    _Mutex_Base(const _Mutex_Base&)             = delete;
+    _Mutex_Base& operator= (const _Mutex_Base&) = delete;
+
+public:
+    // Main functions
+
+    void lock() noexcept
+    {
+        uint32_t expected = 0;
+        if (!_state.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed))
+            _lock_slow(expected);
+    }
+
+    bool try_lock() noexcept
+    {
+        uint32_t expected = 0;
+        return _state.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock() noexcept
+    {
+        if (_state.exchange(0, std::memory_order_release) == 2)
+            _futex_wake(&_state, 1);
+    }
+
+    native_handle_type native_handle() noexcept
+    {
+        return &_state;
+    }
+
+private:
+    // Helpers
+
+    static int _spin_limit() noexcept
+    {
+        static const int limit = thread::hardware_concurrency() > 1 ? _SPIN_LIMIT : 0;
+        return limit;
+    }
+
+    void _lock_slow(uint32_t state) noexcept
+    {
+        for (int spin = _spin_limit(); spin > 0 && state == 1; --spin)
+        {
+            _cpu_relax();
+            state = _state.load(std::memory_order_relaxed);
+
+            if (state == 0 && _state.compare_exchange_weak(state, 1, std::memory_order_acquire, std::memory_order_relaxed))
+                return;
+        }
+
+        _lock_contended();
+    }
+
+    void _lock_contended() noexcept     // takes the lock in state 2, so the unlock wakes the next sleeper
+    {
+        while (_state.exchange(2, std::memory_order_acquire) != 0)
+            _futex_wait(&_state, 2);
+    }
+}; // END _Mutex_Base
+#else   // __linux__
 class _Mutex_Base         // mutex adaptor for pthread_mutex_t
 {
 public:
@@ -15,7 +103,6 @@ public:
 
 private:
     friend condition_variable;
-    friend condition_variable_any;
 
     pthread_mutex_t _mutex;
     pthread_mutexattr_t _mutexAttr;     // PTHREAD_MUTEX_NORMAL or PTHREAD_MUTEX_RECURSIVE
@@ -23,14 +110,14 @@ private:
 public:
     // Constructors & Operators
 
-    explicit _Mutex_Base(int attributeFlag) noexcept
+    explicit _Mutex_Base(int attributeFlag = PTHREAD_MUTEX_NORMAL) noexcept
     {
         pthread_mutexattr_init(&_mutexAttr);
         pthread_mutexattr_settype(&_mutexAttr, attributeFlag);
         pthread_mutex_init(&_mutex, &_mutexAttr);
     }
 
-    virtual ~_Mutex_Base()
+    ~_Mutex_Base()
     {
         pthread_mutex_destroy(&_mutex);
         pthread_mutexattr_destroy(&_mutexAttr);
@@ -70,6 +157,7 @@ public:
         return _mutex;
     }
 }; // END _Mutex_Base
+#endif  // __linux__
 
 CUSTOM_DETAIL_END
 
@@ -78,16 +166,85 @@ class mutex : public detail::_Mutex_Base
 public:
     // Constructors & Operators
 
-    explicit mutex() noexcept
-        : detail::_Mutex_Base(PTHREAD_MUTEX_NORMAL) { /*Empty*/ }
+    explicit mutex() noexcept = default;
 
     mutex(const mutex&)             = delete;
     mutex& operator= (const mutex&) = delete;
 }; // END mutex
 
 
-class recursive_mutex : public detail::_Mutex_Base
+#if defined __linux__
+class recursive_mutex : private detail::_Mutex_Base     // owner and depth on top of the futex mutex
 {
+public:
+    using native_handle_type = detail::_Mutex_Base::native_handle_type;
+
+private:
+    std::atomic<pthread_t> _owner   = pthread_t{};  // read by other threads only to compare with their own id
+    unsigned int _depth             = 0;            // touched by the owner only
+
+public:
+    // Constructors & Operators
+
+    explicit recursive_mutex() noexcept = default;
+
+    recursive_mutex(const recursive_mutex&)             = delete;
+    recursive_mutex& operator= (const recursive_mutex&) = delete;
+
+public:
+    // Main functions
+
+    void lock()
+    {
+        const pthread_t self = pthread_self();
+        if (_owner.load(std::memory_order_relaxed) != self)
+        {
+            detail::_Mutex_Base::lock();
+            _owner.store(self, std::memory_order_relaxed);
+        }
+        else if (_depth == UINT_MAX)
+            throw std::runtime_error("Resource is busy.");
+
+        ++_depth;
+    }
+
+    bool try_lock() noexcept
+    {
+        const pthread_t self = pthread_self();
+        if (_owner.load(std::memory_order_relaxed) != self)
+        {
+            if (!detail::_Mutex_Base::try_lock())
+                return false;
+
+            _owner.store(self, std::memory_order_relaxed);
+        }
+        else if (_depth == UINT_MAX)
+            return false;
+
+        ++_depth;
+        return true;
+    }
+
+    void unlock() noexcept
+    {
+        if (--_depth == 0)
+        {
+            _owner.store(pthread_t{}, std::memory_order_relaxed);
+            detail::_Mutex_Base::unlock();
+        }
+    }
+
+    native_handle_type native_handle() noexcept
+    {
+        return detail::_Mutex_Base::native_handle();
+    }
+}; // recursive_mutex
+#else   // __linux__
+class recursive_mutex : private detail::_Mutex_Base     // same interface as the futex version
+{
+public:
+    using native_handle_type = detail::_Mutex_Base::native_handle_type;
+
 public:
     // Constructors & Operators
 
@@ -96,10 +253,19 @@ public:
 
     recursive_mutex(const recursive_mutex&)             = delete;
     recursive_mutex& operator= (const recursive_mutex&) = delete;
+
+public:
+    // Main functions
+
+    using detail::_Mutex_Base::lock;
+    using detail::_Mutex_Base::try_lock;
+    using detail::_Mutex_Base::unlock;
+    using detail::_Mutex_Base::native_handle;
 }; // recursive_mutex
+#endif  // __linux__
 
 CUSTOM_END
 
 #elif defined _MSC_VER
 #error NO Mutex implementation
-#endif
\ No newline at end of file
+#endif
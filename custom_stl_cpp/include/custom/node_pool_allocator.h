@@ -0,0 +1,293 @@
+#pragma once
+#include "custom/_memory_utils.h"
+#include "custom/utility.h"
+
+#include <atomic>
+#include <cstdint>                  // uintptr_t
+#include <new>                      // std::bad_array_new_length
+
+
+CUSTOM_BEGIN
+
+CUSTOM_DETAIL_BEGIN
+
+class _Node_Pool            // Slabs of fixed-size nodes, shared by all copies of a node_pool_allocator
+{
+// Each node size gets a size class with its own free list. New slabs grow geometrically
+// and the last one is cut lazily, so a new slab costs one operator new and no writes.
+// Nodes are never returned one by one; the slabs are freed together with the last allocator.
+
+private:
+    struct _Free_Node
+    {
+        _Free_Node* _Next;
+    };
+
+    struct _Slab            // header at the start of every slab
+    {
+        _Slab* _Next;
+        size_t _Bytes;
+    };
+
+public:
+    struct _Size_Class
+    {
+        size_t _NodeSize        = 0;        // 0 marks an unused class
+        size_t _Alignment       = 0;
+        size_t _NextNodes       = 0;        // nodes in the next slab
+        _Free_Node* _Free       = nullptr;  // returned nodes, reused first
+        char* _Unused           = nullptr;  // never used nodes of the last slab
+        char* _UnusedEnd        = nullptr;
+    };
+
+    static constexpr size_t _MAX_CLASSES        = 4;            // containers need one or two node sizes
+    static constexpr size_t _FIRST_SLAB_NODES   = 16;
+    static constexpr size_t _MAX_SLAB_BYTES     = 64 * 1024;
+
+private:
+    std::atomic<size_t> _refs   = 1;
+    _Size_Class _classes[_MAX_CLASSES];
+    _Slab* _slabs               = nullptr;  // all slabs of all classes
+
+public:
+    // Constructors & Operators
+
+    _Node_Pool() = default;
+
+    _Node_Pool(const _Node_Pool&)               = delete;
+    _Node_Pool& operator=(const _Node_Pool&)    = delete;
+
+    ~_Node_Pool()
+    {
+        while (_slabs != nullptr)
+        {
+            _Slab* slab = _slabs;
+            _slabs      = slab->_Next;
+            ::operator delete(slab, slab->_Bytes);
+        }
+    }
+
+public:
+    // Main functions
+
+    void _add_ref() noexcept
+    {
+        _refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void _release() noexcept
+    {
+        if (_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete this;
+    }
+
+    // Class for this node size or nullptr if all classes are taken
+    _Size_Class* _size_class(size_t nodeSize, size_t alignment) noexcept
+    {
+        alignment   = alignment > alignof(_Free_Node) ? alignment : alignof(_Free_Node);
+        nodeSize    = ((nodeSize > sizeof(_Free_Node) ? nodeSize : sizeof(_Free_Node)) + alignment - 1) & ~(alignment - 1);
+
+        for (_Size_Class& sizeClass : _classes)
+        {
+            if (sizeClass._NodeSize == 0)
+            {
+                sizeClass._NodeSize     = nodeSize;
+                sizeClass._Alignment    = alignment;
+                sizeClass._NextNodes    = _FIRST_SLAB_NODES;
+            }
+
+            if (sizeClass._NodeSize == nodeSize && sizeClass._Alignment == alignment)
+                return &sizeClass;
+        }
+
+        return nullptr;
+    }
+
+    void* _allocate(_Size_Class& sizeClass)
+    {
+        if (sizeClass._Free != nullptr)
+            return custom::exchange(sizeClass._Free, sizeClass._Free->_Next);
+
+        if (sizeClass._Unused == sizeClass._UnusedEnd)
+            _add_slab(sizeClass);
+
+        void* node = sizeClass._Unused;
+        sizeClass._Unused += sizeClass._NodeSize;
+        return node;
+    }
+
+    static void _deallocate(_Size_Class& sizeClass, void* ptr) noexcept
+    {
+        _Free_Node* node    = static_cast<_Free_Node*>(ptr);
+        node->_Next         = sizeClass._Free;
+        sizeClass._Free     = node;
+    }
+
+private:
+    // Helpers
+
+    void _add_slab(_Size_Class& sizeClass)
+    {
+        const size_t nodesBytes = sizeClass._NextNodes * sizeClass._NodeSize;
+        const size_t bytes      = sizeof(_Slab) + sizeClass._Alignment + nodesBytes;   // room to align the first node
+
+        _Slab* slab = static_cast<_Slab*>(::operator new(bytes));
+        slab->_Next = _slabs;
+        slab->_Bytes = bytes;
+        _slabs      = slab;
+
+        const uintptr_t first   = reinterpret_cast<uintptr_t>(slab + 1);
+        const uintptr_t aligned = (first + sizeClass._Alignment - 1) & ~(sizeClass._Alignment - 1);
+
+        sizeClass._Unused       = reinterpret_cast<char*>(aligned);
+        sizeClass._UnusedEnd    = sizeClass._Unused + nodesBytes;
+
+        if (2 * nodesBytes <= _MAX_SLAB_BYTES)
+            sizeClass._NextNodes *= 2;
+    }
+};  // END _Node_Pool
+
+CUSTOM_DETAIL_END
+
+
+template<class Type>
+class node_pool_allocator       // Allocator that carves single nodes from slabs owned by the allocator
+{
+// For node based containers: list<T, node_pool_allocator<T>>, map<K, V, Compare, node_pool_allocator<pair<K, V>>> ...
+// Single objects come from the pool, arrays (e.g. hash table buckets) go to operator new.
+// Copies share the pool and the slabs are freed when the last copy is destroyed, so destroying
+// a container releases whole slabs. A container copy gets a fresh pool.
+// The pool is not synchronized: copies must be used from one thread at a time.
+
+public:
+    static_assert(!is_const_v<Type>, "The C++ Standard forbids containers of const elements ");
+
+    using value_type                                = Type;
+    using propagate_on_container_copy_assignment    = false_type;
+    using propagate_on_container_move_assignment    = true_type;    // moved nodes need their pool
+    using propagate_on_container_swap               = true_type;
+    using is_always_equal                           = false_type;
+
+private:
+    template<class>
+    friend class node_pool_allocator;
+
+    using _Size_Class = detail::_Node_Pool::_Size_Class;
+
+    detail::_Node_Pool* _pool   = nullptr;      // null only when moved from
+    _Size_Class* _class         = nullptr;      // cached size class for Type
+
+public:
+    // Constructors & Operators
+
+    node_pool_allocator()
+        : _pool(new detail::_Node_Pool()) { /*Empty*/ }
+
+    node_pool_allocator(const node_pool_allocator& other) noexcept
+        : _pool(other._pool), _class(other._class)
+    {
+        if (_pool != nullptr)
+            _pool->_add_ref();
+    }
+
+    template<class Other>
+    node_pool_allocator(const node_pool_allocator<Other>& other) noexcept
+        : _pool(other._pool)
+    {
+        if (_pool != nullptr)
+            _pool->_add_ref();
+    }
+
+    node_pool_allocator(node_pool_allocator&& other) noexcept
+        : _pool(custom::exchange(other._pool, nullptr)), _class(custom::exchange(other._class, nullptr)) { /*Empty*/ }
+
+    ~node_pool_allocator() noexcept
+    {
+        if (_pool != nullptr)
+            _pool->_release();
+    }
+
+    node_pool_allocator& operator=(const node_pool_allocator& other) noexcept
+    {
+        node_pool_allocator(other).swap(*this);
+        return *this;
+    }
+
+    node_pool_allocator& operator=(node_pool_allocator&& other) noexcept
+    {
+        node_pool_allocator(custom::move(other)).swap(*this);
+        return *this;
+    }
+
+public:
+    // Main functions
+
+    Type* allocate(const size_t count)
+    {
+        static_assert(sizeof(Type) > 0, "Type must be complete before calling allocate");
+
+        if (count == 1)
+            if (_Size_Class* sizeClass = _size_class())
+                return static_cast<Type*>(_pool->_allocate(*sizeClass));
+
+        if (count > static_cast<size_t>(-1) / sizeof(Type))
+            throw std::bad_array_new_length();
+
+        return static_cast<Type*>(::operator new(count * sizeof(Type)));
+    }
+
+    void deallocate(Type* address, const size_t count)
+    {
+        CUSTOM_ASSERT(address != nullptr || count > 0, "Invalid block deallocation");
+
+        if (count == 1)
+            if (_Size_Class* sizeClass = _size_class())
+                return detail::_Node_Pool::_deallocate(*sizeClass, address);
+
+        ::operator delete(address, count * sizeof(Type));
+    }
+
+    node_pool_allocator select_on_container_copy_construction() const noexcept
+    {
+        return node_pool_allocator();
+    }
+
+    void swap(node_pool_allocator& other) noexcept
+    {
+        custom::swap(_pool, other._pool);
+        custom::swap(_class, other._class);
+    }
+
+    template<class Type1, class Type2>
+    friend bool operator==(const node_pool_allocator<Type1>& left, const node_pool_allocator<Type2>& right) noexcept;
+
+private:
+    // Helpers
+
+    _Size_Class* _size_class()
+    {
+        if (_class == nullptr)
+        {
+            if (_pool == nullptr)
+                _pool = new detail::_Node_Pool();
+
+            _class = _pool->_size_class(sizeof(Type), alignof(Type));
+        }
+
+        return _class;
+    }
+};  // END node_pool_allocator
+
+template<class Type1, class Type2>
+bool operator==(const node_pool_allocator<Type1>& left, const node_pool_allocator<Type2>& right) noexcept
+{
+    return left._pool == right._pool;
+}
+
+template<class Type1, class Type2>
+bool operator!=(const node_pool_allocator<Type1>& left, const node_pool_allocator<Type2>& right) noexcept
+{
+    return !(left == right);
+}
+
+CUSTOM_END
@@ -136,6 +136,10 @@ public:
     pair& operator=(const volatile pair&)   = delete;
 }; // END pair
 
+template<class Type1, class Type2>
+struct is_trivially_relocatable<pair<Type1, Type2>>
+    : bool_constant<is_trivially_relocatable_v<Type1> && is_trivially_relocatable_v<Type2>> {};
+
 
 template<class Type1, class Type2>
 constexpr bool operator==(const pair<Type1, Type2>& left, const pair<Type1, Type2>& right)
@@ -1,13 +1,15 @@
 #pragma once
 #include "custom/list.h"
+#include "custom/deque.h"
 #include "custom/vector.h"
 #include "custom/utility.h"
 #include "custom/functional.h"	// for custom::Less
+#include "custom/string.h"		// for priority_queue::_print_graph
 
 
 CUSTOM_BEGIN
 
-template<class Type, class Container = custom::list<Type>>
+template<class Type, class Container = custom::deque<Type>>
 class queue			// queue template implemented as SequenceContainer wrapper
 {
 // The Container must satisfy the requirements of SequenceContainer.
@@ -62,8 +62,11 @@ public:
 	set()
 		:_Base() { /*Empty*/ }
 
-	set(std::initializer_list<value_type> list)
-		:_Base(list) { /*Empty*/ }
+	explicit set(const allocator_type& alloc)
+		:_Base(alloc) { /*Empty*/ }
+
+	set(std::initializer_list<value_type> list, const allocator_type& alloc = allocator_type())
+		:_Base(list, alloc) { /*Empty*/ }
 
 	set(const set& other)
 		: _Base(other) { /*Empty*/ }
@@ -71,6 +74,12 @@ public:
 	set(set&& other) noexcept
 		: _Base(custom::move(other)) { /*Empty*/ }
 
+	set(const set& other, const allocator_type& alloc)
+		: _Base(other, alloc) { /*Empty*/ }
+
+	set(set&& other, const allocator_type& alloc)
+		: _Base(custom::move(other), alloc) { /*Empty*/ }
+
 	~set() { /*Empty*/ }
 
 public:
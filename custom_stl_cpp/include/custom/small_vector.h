@@ -0,0 +1,634 @@
+#pragma once
+#include "custom/vector.h"
+
+
+CUSTOM_BEGIN
+
+template<class Type, size_t InlineCapacity, class Alloc = custom::allocator<Type>>
+class small_vector		// vector Template with the first InlineCapacity elements stored in place
+{
+private:
+	using _Data						= detail::_Vector_Data<Type, Alloc>;		// Members that are modified
+	using _Alloc_Traits				= typename _Data::_Alloc_Traits;
+
+public:
+	static_assert(is_same_v<Type, typename Alloc::value_type>, "Object type and allocator type must be the same!");
+	static_assert(is_object_v<Type>, "Containers require object type!");
+	static_assert(InlineCapacity > 0, "small_vector requires inline capacity, use vector instead!");
+
+	using value_type				= typename _Data::value_type;				// Type for stored values
+	using difference_type			= typename _Data::difference_type;
+	using reference					= typename _Data::reference;
+	using const_reference			= typename _Data::const_reference;
+	using pointer					= typename _Data::pointer;
+	using const_pointer				= typename _Data::const_pointer;
+	using allocator_type			= Alloc;
+	
+	using iterator					= detail::_Vector_Iterator<_Data>;
+	using const_iterator			= detail::_Vector_Const_Iterator<_Data>;
+	using reverse_iterator			= custom::reverse_iterator<iterator>;
+	using const_reverse_iterator	= custom::reverse_iterator<const_iterator>;
+
+private:
+	_Data _data;
+	allocator_type _alloc;
+	alignas(value_type) unsigned char _inline[InlineCapacity * sizeof(value_type)];	// storage until it spills to the heap
+
+public:
+	// Constructors
+
+	small_vector() noexcept
+	{
+		_reset_to_inline();
+	}
+
+	explicit small_vector(const allocator_type& alloc) noexcept
+		: _alloc(alloc)
+	{
+		_reset_to_inline();
+	}
+
+	small_vector(	const size_t newCapacity,
+					const allocator_type& alloc = allocator_type())		// Add multiple default copies Constructor
+		: _alloc(alloc)
+	{
+		_reset_to_inline();
+		realloc(newCapacity);
+	}
+
+	small_vector(	const size_t newCapacity,
+					const value_type& copyValue,
+					const allocator_type& alloc = allocator_type())		// Add multiple copies Constructor
+		: _alloc(alloc)
+	{
+		_reset_to_inline();
+		realloc(newCapacity, copyValue);
+	}
+
+	small_vector(	std::initializer_list<value_type> list,
+					const allocator_type& alloc = allocator_type())
+		: _alloc(alloc)
+	{
+		_reset_to_inline();
+		append_range(list);
+	}
+
+	small_vector(const small_vector& other)
+		: _alloc(_Alloc_Traits::select_on_container_copy_construction(other._alloc))
+	{
+		_reset_to_inline();
+		_copy(other);
+	}
+
+	small_vector(const small_vector& other, const allocator_type& alloc)
+		: _alloc(alloc)
+	{
+		_reset_to_inline();
+		_copy(other);
+	}
+
+	small_vector(small_vector&& other) noexcept(is_nothrow_move_constructible_v<value_type>)
+		: _alloc(other._alloc)
+	{
+		_reset_to_inline();
+		_move(custom::move(other));
+	}
+
+	small_vector(small_vector&& other, const allocator_type& alloc)
+		: _alloc(alloc)
+	{
+		_reset_to_inline();
+
+		if (_alloc == other._alloc)
+			_move(custom::move(other));
+		else
+			_move_elements(other);
+	}
+
+	~small_vector() noexcept
+	{
+		_clean_up_array();
+	}
+
+public:
+	// Operators
+
+	const_reference operator[](const size_t index) const noexcept
+	{
+		CUSTOM_ASSERT(index < size(), "Index out of bounds.");
+		return _data._First[index];
+	}
+
+	reference operator[](const size_t index) noexcept
+	{
+		CUSTOM_ASSERT(index < size(), "Index out of bounds.");
+		return _data._First[index];
+	}
+
+	small_vector& operator=(const small_vector& other)
+	{
+		if (_data._First != other._data._First)
+		{
+			_clean_up_array();
+
+			if constexpr (_Alloc_Traits::propagate_on_container_copy_assignment::value)
+				_alloc = other._alloc;
+
+			_copy(other);
+		}
+
+		return *this;
+	}
+
+	small_vector& operator=(small_vector&& other)
+		noexcept(	(_Alloc_Traits::propagate_on_container_move_assignment::value ||
+					_Alloc_Traits::is_always_equal::value) &&
+					is_nothrow_move_constructible_v<value_type>)
+	{
+		if (_data._First != other._data._First)
+		{
+			_clean_up_array();
+
+			if constexpr (_Alloc_Traits::propagate_on_container_move_assignment::value)
+				_alloc = other._alloc;
+
+			if (_alloc == other._alloc)
+				_move(custom::move(other));
+			else
+				_move_elements(other);		// memory can't change owner, move element by element
+		}
+
+		return *this;
+	}
+
+public:
+	// Main functions
+
+	// Allocate memory (or go back to inline storage if it fits) and move values if needed
+	void reserve(const size_t newCapacity)
+	{
+		size_t newSize = std::min(newCapacity, size());
+
+		if (newCapacity <= InlineCapacity && _is_inline())		// already there, drop what doesn't fit
+		{
+			detail::_destroy_range(_alloc, _data._First + newSize, size() - newSize);
+			_data._Last = _data._First + newSize;
+			return;
+		}
+
+		const bool toInline		= (newCapacity <= InlineCapacity);
+		const size_t capacity	= toInline ? InlineCapacity : newCapacity;
+		value_type* newArray	= toInline ? _inline_begin() : _alloc.allocate(capacity);
+
+		try
+		{
+			detail::_uninitialized_relocate_n(_alloc, _data._First, newSize, newArray);
+		}
+		catch (...)
+		{
+			if (!toInline)
+				_alloc.deallocate(newArray, capacity);
+
+			CUSTOM_RERAISE;
+		}
+
+		detail::_destroy_range(_alloc, _data._First + newSize, size() - newSize);	// elements that don't fit anymore
+		_data._Last = _data._First;									// the rest was relocated
+		_clean_up_array();
+		_data._First	= newArray;
+		_data._Last		= _data._First + newSize;
+		_data._Final	= _data._First + capacity;
+	}
+
+	// Move values inline if they fit, else to memory with capacity equal to size
+	void shrink_to_fit()
+	{
+		reserve(size());
+	}
+
+	// Allocate memory and populate it with default values (delete old)
+	void realloc(const size_t newCapacity)
+	{
+		_clean_up_array();
+		_allocate_empty(newCapacity);
+		detail::_construct_range(_alloc, _data._First, newCapacity);
+		_data._Last = _data._First + newCapacity;
+	}
+
+	// Allocate memory and populate it with given reference (delete old)
+	void realloc(	const size_t newCapacity,
+					const value_type& copyValue)
+	{
+		_clean_up_array();
+		_allocate_empty(newCapacity);
+		detail::_construct_range(_alloc, _data._First, newCapacity, copyValue);
+		_data._Last = _data._First + newCapacity;
+	}
+
+	// Replace content with copies of range elements, allocating at most once for forward ranges
+	template<class Range>
+	void assign_range(Range&& range)
+	{
+		auto first	= detail::_range_begin(range);
+		auto last	= detail::_range_end(range);
+
+		clear();
+
+		if constexpr (is_forward_iterator_v<decltype(first)>)
+		{
+			const size_t count = static_cast<size_t>(custom::distance(first, last));
+
+			if (count > capacity())
+				reserve(count);
+
+			detail::_construct_copies(_alloc, _data._Last, first, count);
+			_data._Last += count;
+		}
+		else
+			detail::_append(_alloc, _data, first, last, _reserver());
+	}
+	
+	// Change size and Construct/Destruct objects with default value if needed
+	void resize(const size_t newSize)
+	{
+		if (newSize < size())
+			detail::_destroy_range(_alloc, _data._First + newSize, size() - newSize);
+		else
+		{
+			if (newSize > capacity())
+				reserve(newSize);
+
+			detail::_construct_range(_alloc, _data._Last, newSize - size());
+		}
+
+		_data._Last = _data._First + newSize;
+	}
+
+	// Change size and Construct/Destruct objects with given reference if needed
+	void resize(const size_t newSize, const value_type& copyValue)
+	{
+		if (newSize < size())
+			detail::_destroy_range(_alloc, _data._First + newSize, size() - newSize);
+		else
+		{
+			if (newSize > capacity())
+				reserve(newSize);
+
+			detail::_construct_range(_alloc, _data._Last, newSize - size(), copyValue);
+		}
+
+		_data._Last = _data._First + newSize;
+	}
+
+	// Change size and default-initialize new objects (trivial types keep indeterminate values)
+	void resize_for_overwrite(const size_t newSize)
+	{
+		if (newSize < size())
+			detail::_destroy_range(_alloc, _data._First + newSize, size() - newSize);
+		else
+		{
+			if (newSize > capacity())
+				reserve(detail::_calculate_growth(_data, newSize));
+
+			custom::uninitialized_default_construct_n(_data._Last, newSize - size());
+		}
+
+		_data._Last = _data._First + newSize;
+	}
+
+	// Construct object using arguments (Args) and add it to the tail
+	template<class... Args>
+	void emplace_back(Args&&... args)
+	{
+		detail::_extend_if_full(_data, _reserver());
+		_Alloc_Traits::construct(_alloc, _data._Last++, custom::forward<Args>(args)...);
+	}
+
+	// Construct object using reference and add it to the tail
+	void push_back(const value_type& copyValue)
+	{
+		emplace_back(copyValue);
+	}
+
+	// Construct object using temporary and add it to the tail
+	void push_back(value_type&& moveValue)
+	{
+		emplace_back(custom::move(moveValue));
+	}
+
+	// Add copies of range elements to the tail, growing at most once for forward ranges.
+	// The range must not refer to elements of this vector.
+	template<class Range>
+	void append_range(Range&& range)
+	{
+		detail::_append(_alloc, _data, detail::_range_begin(range), detail::_range_end(range), _reserver());
+	}
+
+	// Remove last component
+	void pop_back()
+	{
+		if (!empty())
+			_Alloc_Traits::destroy(_alloc, --_data._Last);
+	}
+
+	// Emplace object at where position with given arguments
+	template<class... Args>
+	iterator emplace(const_iterator where, Args&&... args)
+	{
+		size_t index = where.get_index();	// Don't check end()
+		emplace_back();
+
+		for (size_t i = size() - 1; i > index; --i)
+			_data._First[i] = custom::move(_data._First[i - 1]);
+
+		_Alloc_Traits::destroy(_alloc, _data._First + index);
+		_Alloc_Traits::construct(_alloc, _data._First + index, custom::forward<Args>(args)...);
+
+		return iterator(_data._First + index, &_data);
+	}
+
+	// Push copy object at iterator position
+	iterator insert(const_iterator where, const value_type& copyValue)
+	{
+		return emplace(where, copyValue);
+	}
+
+	// Push temporary object at iterator position
+	iterator insert(const_iterator where, value_type&& moveValue)
+	{
+		return emplace(where, custom::move(moveValue));
+	}
+
+	// Push copies of range elements at iterator position and return iterator to the first one.
+	// The range must not refer to elements of this vector.
+	template<class Range>
+	iterator insert_range(const_iterator where, Range&& range)
+	{
+		size_t index	= where.get_index();	// Don't check end()
+		auto first		= detail::_range_begin(range);
+		auto last		= detail::_range_end(range);
+
+		if constexpr (is_forward_iterator_v<decltype(first)>)
+			detail::_insert_counted(_alloc, _data, index, first, static_cast<size_t>(custom::distance(first, last)), _reserver());
+		else
+		{
+			small_vector buffer(_alloc);				// single pass range, count it by storing it
+			detail::_append(buffer._alloc, buffer._data, first, last, buffer._reserver());
+			detail::_insert_counted(_alloc, _data, index, buffer._data._First, buffer.size(), _reserver());
+		}
+
+		return iterator(_data._First + index, &_data);
+	}
+
+	// Remove component at iterator position
+	iterator erase(const_iterator where)
+	{
+		if (where.is_end())
+			throw std::out_of_range("small_vector erase iterator outside range.");
+
+		size_t index = where.get_index();
+		size_t beforeLast = size() - 1;
+
+		for (size_t i = index; i < beforeLast; ++i)
+			_data._First[i] = custom::move(_data._First[i + 1]);
+		pop_back();
+
+		return iterator(_data._First + index, &_data);
+	}
+
+	size_t capacity() const noexcept
+	{
+		return static_cast<size_t>(_data._Final - _data._First);
+	}
+
+	size_t size() const noexcept
+	{
+		return static_cast<size_t>(_data._Last - _data._First);
+	}
+
+	size_t max_size() const noexcept
+	{
+		return (custom::min)(	static_cast<size_t>((numeric_limits<difference_type>::max)()),
+								_Alloc_Traits::max_size(_alloc));
+	}
+
+	// Check if array is empty
+	bool empty() const noexcept
+	{
+		return (_data._First == _data._Last);
+	}
+
+	allocator_type get_allocator() const noexcept
+	{
+		return _alloc;
+	}
+	
+	// Remove ALL components but keep memory
+	void clear()
+	{
+		detail::_destroy_range(_alloc, _data._First, size());
+		_data._Last = _data._First;
+	}
+
+	// Acces object at index with check (read only)
+	const_reference at(const size_t index) const
+	{
+		if (index >= size())
+			throw std::out_of_range("Index out of bounds.");
+
+		return _data._First[index];
+	}
+
+	// Acces object at index with check
+	reference at(const size_t index)
+	{
+		if (index >= size())
+			throw std::out_of_range("Index out of bounds.");
+
+		return _data._First[index];
+	}
+
+	const_reference front() const noexcept
+	{
+		CUSTOM_ASSERT(!empty(), "Container is empty.");
+		return _data._First[0];
+	}
+
+	reference front() noexcept
+	{
+		CUSTOM_ASSERT(!empty(), "Container is empty.");
+		return _data._First[0];
+	}
+
+	const_reference back() const noexcept
+	{
+		CUSTOM_ASSERT(!empty(), "Container is empty.");
+		return _data._Last[-1];
+	}
+
+	reference back() noexcept
+	{
+		CUSTOM_ASSERT(!empty(), "Container is empty.");
+		return _data._Last[-1];
+	}
+
+	const_pointer data() const noexcept
+	{
+		return _data._First;
+	}
+
+	pointer data() noexcept
+	{
+		return _data._First;
+	}
+
+public:
+	// iterator specific functions
+
+	iterator begin() noexcept
+	{
+		return iterator(_data._First, &_data);
+	}
+
+	const_iterator begin() const noexcept
+	{
+		return const_iterator(_data._First, &_data);
+	}
+
+	reverse_iterator rbegin() noexcept
+	{
+		return reverse_iterator(end());
+	}
+
+	const_reverse_iterator rbegin() const noexcept
+	{
+		return const_reverse_iterator(end());
+	}
+
+	iterator end() noexcept
+	{
+		return iterator(_data._Last, &_data);
+	}
+
+	const_iterator end() const noexcept
+	{
+		return const_iterator(_data._Last, &_data);
+	}
+
+	reverse_iterator rend() noexcept
+	{
+		return reverse_iterator(begin());
+	}
+
+	const_reverse_iterator rend() const noexcept
+	{
+		return const_reverse_iterator(begin());
+	}
+
+private:
+	// Helpers
+
+	// Empty inline storage
+	value_type* _inline_begin() noexcept
+	{
+		return reinterpret_cast<value_type*>(_inline);
+	}
+
+	const value_type* _inline_begin() const noexcept
+	{
+		return reinterpret_cast<const value_type*>(_inline);
+	}
+
+	bool _is_inline() const noexcept
+	{
+		return _data._First == _inline_begin();
+	}
+
+	void _reset_to_inline() noexcept
+	{
+		_data._First	= _inline_begin();
+		_data._Last		= _data._First;
+		_data._Final	= _data._First + InlineCapacity;
+	}
+
+	// Point to empty storage for newCapacity elements (current storage must be released)
+	void _allocate_empty(const size_t newCapacity)
+	{
+		if (newCapacity <= InlineCapacity)
+			return;
+
+		_data._First	= _alloc.allocate(newCapacity);
+		_data._Last		= _data._First;
+		_data._Final	= _data._First + newCapacity;
+	}
+
+	void _copy(const small_vector& other)
+	{
+		_allocate_empty(other.size());
+		detail::_construct_copies(_alloc, _data._First, other._data._First, other.size());
+		_data._Last = _data._First + other.size();
+	}
+
+	// Heap memory changes owner, inline elements are relocated (this must be empty and inline)
+	void _move(small_vector&& other) noexcept(is_nothrow_move_constructible_v<value_type>)
+	{
+		if (other._is_inline())
+		{
+			detail::_uninitialized_relocate_n(_alloc, other._data._First, other.size(), _data._First);
+			_data._Last			= _data._First + other.size();
+			other._data._Last	= other._data._First;
+		}
+		else
+		{
+			_data._First 	= other._data._First;
+			_data._Last 	= other._data._Last;
+			_data._Final 	= other._data._Final;
+			other._reset_to_inline();
+		}
+	}
+
+	void _move_elements(small_vector& other)
+	{
+		reserve(other.size());
+		for (size_t i = 0; i < other.size(); ++i)
+			_Alloc_Traits::construct(_alloc, _data._Last++, custom::move(other._data._First[i]));
+
+		other.clear();
+	}
+
+	// Growth callback for the shared array helpers
+	auto _reserver() noexcept
+	{
+		return [this](const size_t newCapacity) { reserve(newCapacity); };
+	}
+
+	// Clear and Deallocate array, going back to inline storage
+	void _clean_up_array()
+	{
+		detail::_destroy_range(_alloc, _data._First, size());
+
+		if (!_is_inline())
+			_alloc.deallocate(_data._First, capacity());
+
+		_reset_to_inline();
+	}
+}; // END small_vector Template
+
+// small_vector binary operators
+template<class _Type, size_t _InlineCapacity, class _Alloc>
+bool operator==(const small_vector<_Type, _InlineCapacity, _Alloc>& left, const small_vector<_Type, _InlineCapacity, _Alloc>& right)
+{
+	if (left.size() != right.size())
+		return false;
+
+	return custom::equal(left.begin(), left.end(), right.begin());
+}
+
+template<class _Type, size_t _InlineCapacity, class _Alloc>
+bool operator!=(const small_vector<_Type, _InlineCapacity, _Alloc>& left, const small_vector<_Type, _InlineCapacity, _Alloc>& right)
+{
+	return !(left == right);
+}
+
+
+CUSTOM_END
@@ -0,0 +1,342 @@
+#pragma once
+#include "custom/vector.h"
+#include "custom/algorithm.h"
+#include "custom/functional.h"
+#include "custom/bit.h"		// countr_one
+#include <cstdint>			// uintptr_t
+
+
+CUSTOM_BEGIN
+
+CUSTOM_DETAIL_BEGIN
+
+template<class Container>
+class _Sorted_Index_Iterator		// walks the implicit tree in order, so values come out sorted
+{
+public:
+	using iterator_category	= bidirectional_iterator_tag;
+	using value_type		= typename Container::value_type;
+	using difference_type	= typename Container::difference_type;
+	using reference			= typename Container::const_reference;
+	using pointer			= typename Container::const_pointer;
+
+	size_t _Node				= 0;		// 1-based tree node, 0 is end
+	const Container* _RefData	= nullptr;
+
+public:
+
+	_Sorted_Index_Iterator() noexcept = default;
+
+	explicit _Sorted_Index_Iterator(size_t node, const Container* data) noexcept
+		:_Node(node), _RefData(data) { /*Empty*/ }
+
+	_Sorted_Index_Iterator& operator++() noexcept
+	{
+		CUSTOM_ASSERT(_Node != 0, "Cannot increment end iterator.");
+
+		const size_t count = _RefData->size();
+		if (2 * _Node + 1 <= count)			// leftmost node of the right subtree
+		{
+			_Node = 2 * _Node + 1;
+			while (2 * _Node <= count)
+				_Node *= 2;
+		}
+		else								// climb while coming from a right child
+		{
+			while (_Node & 1)
+				_Node >>= 1;
+
+			_Node >>= 1;
+		}
+
+		return *this;
+	}
+
+	_Sorted_Index_Iterator operator++(int) noexcept
+	{
+		_Sorted_Index_Iterator temp = *this;
+		++(*this);
+		return temp;
+	}
+
+	_Sorted_Index_Iterator& operator--() noexcept
+	{
+		const size_t count = _RefData->size();
+		if (_Node == 0)						// end goes to the rightmost node
+		{
+			CUSTOM_ASSERT(count != 0, "Cannot decrement begin iterator.");
+			_Node = 1;
+			while (2 * _Node + 1 <= count)
+				_Node = 2 * _Node + 1;
+		}
+		else if (2 * _Node <= count)		// rightmost node of the left subtree
+		{
+			_Node *= 2;
+			while (2 * _Node + 1 <= count)
+				_Node = 2 * _Node + 1;
+		}
+		else								// climb while coming from a left child
+		{
+			while (_Node != 1 && (_Node & 1) == 0)
+				_Node >>= 1;
+
+			CUSTOM_ASSERT(_Node != 1, "Cannot decrement begin iterator.");
+			_Node >>= 1;
+		}
+
+		return *this;
+	}
+
+	_Sorted_Index_Iterator operator--(int) noexcept
+	{
+		_Sorted_Index_Iterator temp = *this;
+		--(*this);
+		return temp;
+	}
+
+	pointer operator->() const noexcept
+	{
+		return pointer_traits<pointer>::pointer_to(**this);
+	}
+
+	reference operator*() const noexcept
+	{
+		CUSTOM_ASSERT(_Node != 0, "Cannot dereference end iterator.");
+		return (*_RefData)[_Node - 1];
+	}
+
+	bool operator==(const _Sorted_Index_Iterator& other) const noexcept
+	{
+		return _Node == other._Node;
+	}
+
+	bool operator!=(const _Sorted_Index_Iterator& other) const noexcept
+	{
+		return !(*this == other);
+	}
+
+	friend void _verify_range(const _Sorted_Index_Iterator& first, const _Sorted_Index_Iterator& last) noexcept
+	{
+		CUSTOM_ASSERT(first._RefData == last._RefData, "sorted_index iterators in range are from different containers");
+	}
+};	// END _Sorted_Index_Iterator
+
+CUSTOM_DETAIL_END
+
+
+template<class Type, class Compare = custom::less<Type>, class Alloc = custom::allocator<Type>>
+class sorted_index		// Read-only sorted lookup table stored in Eytzinger (breadth first tree) order
+{
+// Node k has children 2k and 2k + 1, so a lookup reads a single array top-down
+// and the nodes visited a few levels ahead share cache lines that can be prefetched.
+// Built once from a range, then only searched. Iteration yields the values in sorted order.
+
+private:
+	using _Container				= custom::vector<Type, Alloc>;
+
+public:
+	using value_type				= Type;
+	using key_compare				= Compare;
+	using allocator_type			= Alloc;
+	using difference_type			= typename _Container::difference_type;
+	using reference					= typename _Container::const_reference;
+	using const_reference			= typename _Container::const_reference;
+	using pointer					= typename _Container::const_pointer;
+	using const_pointer				= typename _Container::const_pointer;
+
+	using iterator					= detail::_Sorted_Index_Iterator<_Container>;
+	using const_iterator			= iterator;
+
+private:
+	_Container _tree;
+	key_compare _comp;
+
+	// node k * _PREFETCH_NODES is the first descendant of k that many levels down; a cache line of them
+	static constexpr size_t _PREFETCH_NODES = (64 / sizeof(value_type)) > 0 ? (64 / sizeof(value_type)) : 1;
+
+public:
+	// Constructors
+
+	sorted_index() = default;
+
+	explicit sorted_index(const key_compare& comp)
+		: _comp(comp) { /*Empty*/ }
+
+	template<class InputIt, enable_if_t<is_iterator_v<InputIt>, bool> = true>
+	sorted_index(InputIt first, InputIt last, const key_compare& comp = key_compare())
+		: _comp(comp)
+	{
+		_Container values;
+		for (/*Empty*/; first != last; ++first)
+			values.push_back(*first);
+
+		_build(custom::move(values));
+	}
+
+	sorted_index(std::initializer_list<value_type> list, const key_compare& comp = key_compare())
+		: sorted_index(list.begin(), list.end(), comp) { /*Empty*/ }
+
+	explicit sorted_index(_Container&& values, const key_compare& comp = key_compare())
+		: _comp(comp)
+	{
+		_build(custom::move(values));
+	}
+
+	sorted_index(const sorted_index& other)		= default;
+	sorted_index(sorted_index&& other) noexcept	= default;
+	~sorted_index() noexcept					= default;
+
+public:
+	// Operators
+
+	sorted_index& operator=(const sorted_index& other)		= default;
+	sorted_index& operator=(sorted_index&& other) noexcept	= default;
+
+public:
+	// Main functions
+
+	size_t size() const noexcept
+	{
+		return _tree.size();
+	}
+
+	bool empty() const noexcept
+	{
+		return _tree.empty();
+	}
+
+	key_compare key_comp() const
+	{
+		return _comp;
+	}
+
+	iterator lower_bound(const value_type& key) const
+	{
+		return iterator(_lower_bound_node(key), &_tree);
+	}
+
+	template<class KeyType, class Comp = key_compare, enable_if_t<detail::_Is_Transparent_v<Comp>, bool> = true>
+	iterator lower_bound(const KeyType& key) const
+	{
+		return iterator(_lower_bound_node(key), &_tree);
+	}
+
+	iterator upper_bound(const value_type& key) const
+	{
+		return iterator(_upper_bound_node(key), &_tree);
+	}
+
+	template<class KeyType, class Comp = key_compare, enable_if_t<detail::_Is_Transparent_v<Comp>, bool> = true>
+	iterator upper_bound(const KeyType& key) const
+	{
+		return iterator(_upper_bound_node(key), &_tree);
+	}
+
+	iterator find(const value_type& key) const
+	{
+		return iterator(_find_node(key), &_tree);
+	}
+
+	template<class KeyType, class Comp = key_compare, enable_if_t<detail::_Is_Transparent_v<Comp>, bool> = true>
+	iterator find(const KeyType& key) const
+	{
+		return iterator(_find_node(key), &_tree);
+	}
+
+	bool contains(const value_type& key) const
+	{
+		return _find_node(key) != 0;
+	}
+
+	template<class KeyType, class Comp = key_compare, enable_if_t<detail::_Is_Transparent_v<Comp>, bool> = true>
+	bool contains(const KeyType& key) const
+	{
+		return _find_node(key) != 0;
+	}
+
+public:
+	// iterator specific functions
+
+	iterator begin() const noexcept
+	{
+		size_t node = _tree.empty() ? 0 : 1;
+		while (2 * node <= _tree.size() && node != 0)
+			node *= 2;
+
+		return iterator(node, &_tree);
+	}
+
+	iterator end() const noexcept
+	{
+		return iterator(0, &_tree);
+	}
+
+private:
+	// Helpers
+
+	void _build(_Container&& values)
+	{
+		custom::sort(values.begin(), values.end(), _comp);
+
+		const size_t count = values.size();
+		custom::vector<size_t> ranks(count);		// ranks[k - 1] is the sorted position of node k
+		size_t next = 0;
+		_assign_ranks(ranks, 1, next);
+
+		_tree.clear();
+		_tree.reserve(count);
+		for (size_t node = 0; node < count; ++node)
+			_tree.push_back(custom::move(values[ranks[node]]));
+	}
+
+	static void _assign_ranks(custom::vector<size_t>& ranks, const size_t node, size_t& next)
+	{
+		// in order traversal hands out the sorted positions
+		if (node > ranks.size())
+			return;
+
+		_assign_ranks(ranks, 2 * node, next);
+		ranks[node - 1] = next++;
+		_assign_ranks(ranks, 2 * node + 1, next);
+	}
+
+	// Descends left while !goRight; the answer is the last node where the path turned left
+	template<class GoRight>
+	size_t _descend(GoRight goRight) const
+	{
+		const size_t count = _tree.size();
+		if (count == 0)
+			return 0;
+
+		const uintptr_t base = reinterpret_cast<uintptr_t>(_tree.data());
+		size_t node = 1;
+		while (node <= count)
+		{
+			CUSTOM_PREFETCH(reinterpret_cast<const void*>(base + (node * _PREFETCH_NODES - 1) * sizeof(value_type)));
+			node = 2 * node + static_cast<size_t>(goRight(_tree[node - 1]));
+		}
+
+		return node >> (custom::countr_one(node) + 1);
+	}
+
+	template<class KeyType>
+	size_t _lower_bound_node(const KeyType& key) const
+	{
+		return _descend([this, &key](const value_type& value) { return static_cast<bool>(_comp(value, key)); });
+	}
+
+	template<class KeyType>
+	size_t _upper_bound_node(const KeyType& key) const
+	{
+		return _descend([this, &key](const value_type& value) { return !static_cast<bool>(_comp(key, value)); });
+	}
+
+	template<class KeyType>
+	size_t _find_node(const KeyType& key) const
+	{
+		const size_t node = _lower_bound_node(key);
+		return (node != 0 && !static_cast<bool>(_comp(key, _tree[node - 1]))) ? node : 0;
+	}
+};	// END sorted_index
+
+CUSTOM_END
@@ -74,9 +74,21 @@ template<class Type, class Alloc, class Traits>
 struct hash<basic_string<Type, Alloc, Traits>>
 : detail::_Base_Hash_Enabler<basic_string<Type, Alloc, Traits>, is_char_v<Type>>	// used by unordered_map, unordered_set
 {
-	static size_t compute_hash(const basic_string<Type, Alloc, Traits>& key) noexcept
+	using is_transparent = int;		// lookup with basic_string_view or const Type* doesn't build a temporary string
+
+	static size_t compute_hash(const basic_string_view<Type, Traits>& key) noexcept
+	{
+		return detail::_hash_array_representation(key.data(), key.size());
+	}
+
+	size_t operator()(const basic_string_view<Type, Traits>& key) const noexcept	// basic_string converts implicitly
+	{
+		return compute_hash(key);
+	}
+
+	size_t operator()(const Type* key) const noexcept
 	{
-		return detail::_hash_array_representation(key.c_str(), key.size());
+		return compute_hash(basic_string_view<Type, Traits>(key));
 	}
 };
 
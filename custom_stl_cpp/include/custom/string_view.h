@@ -46,6 +46,8 @@ template<class Type, class Traits>
 struct hash<basic_string_view<Type, Traits>>
 : detail::_Base_Hash_Enabler<basic_string_view<Type, Traits>, is_char_v<Type>>	// used by unordered_map, unordered_set
 {
+	using is_transparent = int;		// basic_string and const Type* convert to basic_string_view without allocation
+
 	static size_t compute_hash(const basic_string_view<Type, Traits>& key) noexcept
 	{
 		return detail::_hash_array_representation(key.data(), key.size());
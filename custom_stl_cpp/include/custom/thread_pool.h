@@ -0,0 +1,670 @@
+#pragma once
+
+#if defined __GNUG__
+#include "custom/thread.h"
+#include "custom/atomic.h"
+#include "custom/mutex.h"
+#include "custom/deque.h"
+#include "custom/intrusive_ptr.h"
+
+#include <atomic>
+#include <exception>
+
+
+CUSTOM_BEGIN
+
+class thread_pool;
+
+CUSTOM_DETAIL_BEGIN
+
+class _Pool_Task : public intrusive_ref_counter<_Pool_Task>     // unit of work queued in a thread_pool
+{
+public:
+    std::atomic<bool> _Ready = false;
+
+    virtual ~_Pool_Task() = default;
+
+    virtual void _run() noexcept = 0;
+
+protected:
+    void _make_ready() noexcept
+    {
+        _Ready.store(true, std::memory_order_release);
+        _Ready.notify_all();
+    }
+};  // END _Pool_Task
+
+template<class Result>
+class _Pool_Task_Result : public _Pool_Task     // result slot shared by the task and its handle
+{
+private:
+    union { Result _value; };   // constructed only when the callable returns
+    bool _hasValue = false;
+    std::exception_ptr _exception;
+
+public:
+    _Pool_Task_Result() noexcept { /*Empty*/ }
+
+    ~_Pool_Task_Result() override
+    {
+        if (_hasValue)
+            _value.~Result();
+    }
+
+    template<class Func>
+    void _store(Func& func) noexcept
+    {
+        try
+        {
+            ::new(static_cast<void*>(&_value)) Result(func());
+            _hasValue = true;
+        }
+        catch (...)
+        {
+            _exception = std::current_exception();
+        }
+
+        _make_ready();
+    }
+
+    Result _get()
+    {
+        if (_exception)
+            std::rethrow_exception(_exception);
+
+        return custom::move(_value);
+    }
+};  // END _Pool_Task_Result
+
+template<>
+class _Pool_Task_Result<void> : public _Pool_Task
+{
+private:
+    std::exception_ptr _exception;
+
+public:
+    template<class Func>
+    void _store(Func& func) noexcept
+    {
+        try
+        {
+            func();
+        }
+        catch (...)
+        {
+            _exception = std::current_exception();
+        }
+
+        _make_ready();
+    }
+
+    void _get()
+    {
+        if (_exception)
+            std::rethrow_exception(_exception);
+    }
+};  // END _Pool_Task_Result<void>
+
+template<class Result, class Func>
+class _Pool_Task_Impl : public _Pool_Task_Result<Result>    // task and callable in a single allocation
+{
+private:
+    Func _func;
+
+public:
+    template<class Fn>
+    explicit _Pool_Task_Impl(Fn&& func)
+        : _func(custom::forward<Fn>(func)) { /*Empty*/ }
+
+    void _run() noexcept override
+    {
+        this->_store(_func);
+    }
+};  // END _Pool_Task_Impl
+
+template<class Type>
+class _Work_Stealing_Deque     // Chase-Lev deque: the owner pushes and pops at the bottom, thieves steal from the top
+{
+// Pointers only. The ring grows when full, and old rings stay alive until
+// the deque dies because a thief may still be reading from one of them.
+// The seq_cst accesses on _top and _bottom take the place of the fences in the paper.
+
+private:
+    struct _Ring
+    {
+        size_t _Mask;
+        unique_ptr<std::atomic<Type>[]> _Cells;
+        unique_ptr<_Ring> _Previous;
+
+        explicit _Ring(const size_t capacity)
+            : _Mask(capacity - 1), _Cells(new std::atomic<Type>[capacity]) { /*Empty*/ }
+
+        size_t capacity() const noexcept
+        {
+            return _Mask + 1;
+        }
+
+        Type load(const ptrdiff_t index) const noexcept
+        {
+            return _Cells[static_cast<size_t>(index) & _Mask].load(std::memory_order_relaxed);
+        }
+
+        void store(const ptrdiff_t index, const Type value) noexcept
+        {
+            _Cells[static_cast<size_t>(index) & _Mask].store(value, std::memory_order_relaxed);
+        }
+    };  // END _Ring
+
+    static constexpr size_t _INITIAL_CAPACITY = 64;
+
+    alignas(_CACHE_LINE_SIZE) std::atomic<ptrdiff_t> _top       = 0;
+    alignas(_CACHE_LINE_SIZE) std::atomic<ptrdiff_t> _bottom    = 0;
+    std::atomic<_Ring*> _ring;
+    unique_ptr<_Ring> _ringOwner;
+
+public:
+    // Constructors & Operators
+
+    _Work_Stealing_Deque()
+        : _ringOwner(new _Ring(_INITIAL_CAPACITY))
+    {
+        _ring.store(_ringOwner.get(), std::memory_order_relaxed);
+    }
+
+    _Work_Stealing_Deque(const _Work_Stealing_Deque&)               = delete;
+    _Work_Stealing_Deque& operator=(const _Work_Stealing_Deque&)    = delete;
+
+public:
+    // Main functions
+
+    void push(const Type value)    // owner only
+    {
+        const ptrdiff_t bottom  = _bottom.load(std::memory_order_relaxed);
+        const ptrdiff_t top     = _top.load(std::memory_order_acquire);
+        _Ring* ring             = _ring.load(std::memory_order_relaxed);
+
+        if (static_cast<size_t>(bottom - top) >= ring->capacity())
+            ring = _grow(ring, top, bottom);
+
+        ring->store(bottom, value);
+        _bottom.store(bottom + 1, std::memory_order_seq_cst);  // seq_cst pairs with the sleepers check in thread_pool
+    }
+
+    Type pop() noexcept            // owner only, nullptr when empty
+    {
+        const ptrdiff_t bottom  = _bottom.load(std::memory_order_relaxed) - 1;
+        _Ring* ring             = _ring.load(std::memory_order_relaxed);
+        _bottom.store(bottom, std::memory_order_seq_cst);
+        ptrdiff_t top           = _top.load(std::memory_order_seq_cst);
+
+        if (top > bottom)       // empty
+        {
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        Type value = ring->load(bottom);
+        if (top == bottom)      // last element, race the thieves for it
+        {
+            if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                value = nullptr;
+
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        return value;
+    }
+
+    Type steal() noexcept          // any thread, nullptr when empty or when another thread won
+    {
+        ptrdiff_t top           = _top.load(std::memory_order_seq_cst);
+        const ptrdiff_t bottom  = _bottom.load(std::memory_order_seq_cst);
+
+        if (top >= bottom)
+            return nullptr;
+
+        const Type value = _ring.load(std::memory_order_acquire)->load(top);
+        if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+
+        return value;
+    }
+
+    bool empty() const noexcept
+    {
+        return _bottom.load(std::memory_order_seq_cst) <= _top.load(std::memory_order_seq_cst);
+    }
+
+private:
+    // Helpers
+
+    _Ring* _grow(_Ring* ring, const ptrdiff_t top, const ptrdiff_t bottom)
+    {
+        unique_ptr<_Ring> bigger(new _Ring(ring->capacity() * 2));
+        for (ptrdiff_t index = top; index < bottom; ++index)
+            bigger->store(index, ring->load(index));
+
+        bigger->_Previous   = custom::move(_ringOwner);
+        _ringOwner          = custom::move(bigger);
+        _ring.store(_ringOwner.get(), std::memory_order_release);
+
+        return _ringOwner.get();
+    }
+};  // END _Work_Stealing_Deque
+
+struct _Pool_Worker_Context     // which pool, and which of its workers, the current thread is
+{
+    thread_pool* _Pool  = nullptr;
+    size_t _Index       = 0;
+};
+
+inline _Pool_Worker_Context& _current_pool_worker() noexcept
+{
+    static thread_local _Pool_Worker_Context context;
+    return context;
+}
+
+CUSTOM_DETAIL_END
+
+
+template<class Result>
+class task_handle   // one-shot handle to the result of thread_pool::submit
+{
+private:
+    intrusive_ptr<detail::_Pool_Task_Result<Result>> _task;
+
+    friend thread_pool;
+
+public:
+    // Constructors & Operators
+
+    task_handle() noexcept = default;
+
+private:
+    explicit task_handle(intrusive_ptr<detail::_Pool_Task_Result<Result>> task) noexcept
+        : _task(custom::move(task)) { /*Empty*/ }
+
+public:
+    // Main functions
+
+    bool valid() const noexcept
+    {
+        return _task != nullptr;
+    }
+
+    bool is_ready() const noexcept
+    {
+        CUSTOM_ASSERT(valid(), "Task handle has no task.");
+        return _task->_Ready.load(std::memory_order_acquire);
+    }
+
+    void wait() const;      // defined after thread_pool
+
+    Result get()            // waits, then gives the result (or rethrows) and leaves the handle empty
+    {
+        wait();
+        const intrusive_ptr<detail::_Pool_Task_Result<Result>> task = custom::move(_task);
+        return task->_get();
+    }
+};  // END task_handle
+
+
+class thread_pool   // fixed set of workers with a work-stealing deque each
+{
+// Tasks submitted from a worker go to the bottom of its own deque,
+// tasks from other threads go to a shared injection queue.
+// A worker looks in its own deque first, then in the injection queue,
+// then steals from the top of the other deques. Idle workers park on _epoch.
+
+private:
+    using _Task_Ptr = detail::_Pool_Task*;      // queued tasks hold one reference each
+
+    struct alignas(detail::_CACHE_LINE_SIZE) _Worker
+    {
+        detail::_Work_Stealing_Deque<_Task_Ptr> _Tasks;
+        thread _Thread;
+    };
+
+    size_t _workerCount = 0;
+    unique_ptr<_Worker[]> _workers;
+
+    mutex _injectMutex;
+    deque<_Task_Ptr> _injected;                             // guarded by _injectMutex
+    std::atomic<size_t> _injectedCount  = 0;
+
+    alignas(detail::_CACHE_LINE_SIZE) std::atomic<uint32_t> _epoch     = 0;   // bumped to wake parked workers
+    std::atomic<uint32_t> _sleepers     = 0;
+    std::atomic<bool> _stop             = false;
+
+public:
+    // Constructors & Operators
+
+    explicit thread_pool(const size_t workerCount = thread::hardware_concurrency())
+        :   _workerCount(workerCount > 0 ? workerCount : 1),
+            _workers(new _Worker[_workerCount])
+    {
+        try
+        {
+            for (size_t index = 0; index < _workerCount; ++index)
+                _workers[index]._Thread = thread(&thread_pool::_worker_loop, this, index);
+        }
+        catch (...)
+        {
+            _shut_down();
+            CUSTOM_RERAISE;
+        }
+    }
+
+    ~thread_pool()  // runs every queued task before returning
+    {
+        _shut_down();
+    }
+
+    thread_pool(const thread_pool&)             = delete;
+    thread_pool& operator=(const thread_pool&)  = delete;
+
+public:
+    // Main functions
+
+    static thread_pool& default_pool()  // shared pool used by the parallel algorithms, started on first use
+    {
+        static thread_pool pool;
+        return pool;
+    }
+
+    size_t worker_count() const noexcept
+    {
+        return _workerCount;
+    }
+
+    template<class Func, class... Args>
+    auto submit(Func&& func, Args&&... args)
+    {
+        auto call = [func = custom::forward<Func>(func), ...args = custom::forward<Args>(args)]() mutable -> decltype(auto)
+        {
+            return custom::invoke(custom::move(func), custom::move(args)...);
+        };
+
+        using _Result   = decay_t<decltype(call())>;
+        using _Task     = detail::_Pool_Task_Impl<_Result, decltype(call)>;
+
+        intrusive_ptr<detail::_Pool_Task_Result<_Result>> task(new _Task(custom::move(call)));
+        _push(task.get());
+
+        return task_handle<_Result>(custom::move(task));
+    }
+
+    // Calls func(index) for every index in [first, last) and returns when all calls are done.
+    // The range is split in halves until a piece has at most grain indices (0 picks a grain
+    // from the worker count). The calling thread works too. The first exception is rethrown
+    // once every running piece has finished, the pieces not yet started are skipped.
+    template<class Integer, class Func,
+    enable_if_t<is_integral_v<Integer>, bool> = true>
+    void parallel_for(const Integer first, const Integer last, Func func, size_t grain = 0)
+    {
+        if (!(first < last))
+            return;
+
+        const size_t count = static_cast<size_t>(last - first);
+        if (grain == 0)
+            grain = count / (_workerCount * _AUTO_GRAIN_PIECES) + 1;
+
+        _Range_Control control;
+        _Range_Task<Integer, Func>::_execute(this, &control, &func, first, last, grain);
+        _wait_for(control._Pending);
+
+        if (control._Failed.load(std::memory_order_relaxed))
+            std::rethrow_exception(control._Exception);
+    }
+
+private:
+    // parallel_for
+
+    static constexpr size_t _AUTO_GRAIN_PIECES = 8;     // pieces per worker, so uneven pieces balance out
+
+    struct _Range_Control
+    {
+        std::atomic<size_t> _Pending    = 1;        // the caller's own piece until it is done
+        std::atomic<bool> _Failed       = false;
+        std::exception_ptr _Exception;              // written by the first failing piece only
+    };
+
+    template<class Integer, class Func>
+    class _Range_Task : public detail::_Pool_Task
+    {
+    private:
+        thread_pool* _pool;
+        _Range_Control* _control;
+        Func* _func;
+        Integer _first;
+        Integer _last;
+        size_t _grain;
+
+    public:
+        _Range_Task(thread_pool* pool, _Range_Control* control, Func* func,
+                    const Integer first, const Integer last, const size_t grain) noexcept
+            :   _pool(pool), _control(control), _func(func),
+                _first(first), _last(last), _grain(grain) { /*Empty*/ }
+
+        void _run() noexcept override
+        {
+            _execute(_pool, _control, _func, _first, _last, _grain);
+        }
+
+        static void _execute(   thread_pool* pool, _Range_Control* control, Func* func,
+                                const Integer first, Integer last, const size_t grain) noexcept
+        {
+            try
+            {
+                while (static_cast<size_t>(last - first) > grain)   // hand the upper half to the thieves
+                {
+                    const Integer middle = static_cast<Integer>(first + (last - first) / 2);
+
+                    intrusive_ptr<detail::_Pool_Task> half(new _Range_Task(pool, control, func, middle, last, grain));
+                    control->_Pending.fetch_add(1, std::memory_order_relaxed);
+
+                    try
+                    {
+                        pool->_push(half.get());
+                    }
+                    catch (...)
+                    {
+                        control->_Pending.fetch_sub(1, std::memory_order_relaxed);  // never queued, run by nobody
+                        CUSTOM_RERAISE;
+                    }
+
+                    last = middle;
+                }
+
+                for (Integer index = first; index != last; ++index)
+                {
+                    if (control->_Failed.load(std::memory_order_relaxed))
+                        break;
+
+                    (*func)(index);
+                }
+            }
+            catch (...)
+            {
+                if (!control->_Failed.exchange(true, std::memory_order_relaxed))
+                    control->_Exception = std::current_exception();
+            }
+
+            if (control->_Pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                control->_Pending.notify_all();
+        }
+    };  // END _Range_Task
+
+    template<class Result>
+    friend class task_handle;
+
+private:
+    // Helpers
+
+    void _push(_Task_Ptr task)
+    {
+        intrusive_ptr_add_ref(task);    // owned by the queue until a worker takes it
+        detail::_Pool_Worker_Context& context = detail::_current_pool_worker();
+
+        try
+        {
+            if (context._Pool == this)
+                _workers[context._Index]._Tasks.push(task);
+            else
+            {
+                lock_guard<mutex> lock(_injectMutex);
+                _injected.push_back(task);
+                _injectedCount.fetch_add(1, std::memory_order_seq_cst);
+            }
+        }
+        catch (...)
+        {
+            intrusive_ptr_release(task);
+            CUSTOM_RERAISE;
+        }
+
+        if (_sleepers.load(std::memory_order_seq_cst) > 0)
+        {
+            _epoch.fetch_add(1, std::memory_order_seq_cst);
+            _epoch.notify_one();
+        }
+    }
+
+    _Task_Ptr _take_injected() noexcept
+    {
+        if (_injectedCount.load(std::memory_order_seq_cst) == 0)
+            return nullptr;
+
+        lock_guard<mutex> lock(_injectMutex);
+        if (_injected.empty())
+            return nullptr;
+
+        _Task_Ptr task = _injected.front();
+        _injected.pop_front();
+        _injectedCount.fetch_sub(1, std::memory_order_relaxed);
+
+        return task;
+    }
+
+    _Task_Ptr _find_task() noexcept     // own deque, injection queue, then the other deques
+    {
+        detail::_Pool_Worker_Context& context = detail::_current_pool_worker();
+        const bool isWorker = context._Pool == this;
+
+        if (isWorker)
+            if (_Task_Ptr task = _workers[context._Index]._Tasks.pop())
+                return task;
+
+        if (_Task_Ptr task = _take_injected())
+            return task;
+
+        const size_t start = isWorker ? context._Index + 1 : 0;
+        for (size_t offset = 0; offset < _workerCount; ++offset)
+        {
+            _Worker& victim = _workers[(start + offset) % _workerCount];
+            if (isWorker && &victim == &_workers[context._Index])
+                continue;
+
+            if (_Task_Ptr task = victim._Tasks.steal())
+                return task;
+        }
+
+        return nullptr;
+    }
+
+    static void _run_task(_Task_Ptr task) noexcept
+    {
+        const intrusive_ptr<detail::_Pool_Task> owner(task, false);     // adopt the queue reference
+        task->_run();
+    }
+
+    bool _run_one() noexcept    // runs one queued task on the calling thread, false if none was found
+    {
+        if (_Task_Ptr task = _find_task())
+        {
+            _run_task(task);
+            return true;
+        }
+
+        return false;
+    }
+
+    template<class Type>
+    void _wait_for(std::atomic<Type>& pending) noexcept    // helps until pending drops to 0
+    {
+        for (Type value = pending.load(std::memory_order_acquire); value != 0; value = pending.load(std::memory_order_acquire))
+            if (!_run_one())
+                pending.wait(value, std::memory_order_acquire);
+    }
+
+    void _wait_ready(detail::_Pool_Task& task) noexcept
+    {
+        while (!task._Ready.load(std::memory_order_acquire))
+            if (!_run_one())
+                task._Ready.wait(false, std::memory_order_acquire);
+    }
+
+    void _worker_loop(const size_t index) noexcept
+    {
+        detail::_Pool_Worker_Context& context   = detail::_current_pool_worker();
+        context._Pool                           = this;
+        context._Index                          = index;
+
+        for (;;)
+        {
+            if (_run_one())
+                continue;
+
+            const uint32_t epoch = _epoch.load(std::memory_order_seq_cst);
+            _sleepers.fetch_add(1, std::memory_order_seq_cst);
+
+            if (_Task_Ptr task = _find_task())      // a push may have missed the sleeper count
+            {
+                _sleepers.fetch_sub(1, std::memory_order_relaxed);
+                _run_task(task);
+                continue;
+            }
+
+            if (_stop.load(std::memory_order_seq_cst))
+            {
+                _sleepers.fetch_sub(1, std::memory_order_relaxed);
+                break;
+            }
+
+            _epoch.wait(epoch, std::memory_order_seq_cst);
+            _sleepers.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        context = detail::_Pool_Worker_Context{};
+    }
+
+    void _shut_down() noexcept
+    {
+        _stop.store(true, std::memory_order_seq_cst);
+        _epoch.fetch_add(1, std::memory_order_seq_cst);
+        _epoch.notify_all();
+
+        for (size_t index = 0; index < _workerCount; ++index)
+            if (_workers[index]._Thread.joinable())
+                _workers[index]._Thread.join();
+    }
+};  // END thread_pool
+
+
+template<class Result>
+void task_handle<Result>::wait() const      // workers of the pool run other tasks while waiting
+{
+    CUSTOM_ASSERT(valid(), "Task handle has no task.");
+
+    thread_pool* pool = detail::_current_pool_worker()._Pool;
+    if (pool != nullptr)
+        pool->_wait_ready(*_task);
+    else
+        _task->_Ready.wait(false, std::memory_order_acquire);
+}
+
+CUSTOM_END
+
+#elif defined _MSC_VER
+#error thread_pool not available for MSVC!
+#endif  // __GNUG__
@@ -310,6 +310,12 @@ struct is_trivially_copyable;
 template<class Ty>
 constexpr bool is_trivially_copyable_v = is_trivially_copyable<Ty>::value;
 
+template<class Ty>
+struct is_trivially_relocatable;    // memcpy to a new address + forgetting the source == move + destroy
+
+template<class Ty>
+constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<Ty>::value;
+
 // TODO: check trivial type traits
 
 template<class Ty>
@@ -1246,6 +1252,13 @@ struct is_trivial : bool_constant<__is_trivially_constructible(Ty) && __is_trivi
 template<class Ty>
 struct is_trivially_copyable : bool_constant<__is_trivially_copyable(Ty)> {};
 
+// Specialize for types whose objects don't depend on their own address to opt in
+template<class Ty>
+struct is_trivially_relocatable : bool_constant<__is_trivially_copyable(Ty)> {};
+
+template<class Ty, size_t Size>
+struct is_trivially_relocatable<Ty[Size]> : is_trivially_relocatable<Ty> {};
+
 template<class Ty>
 struct is_standard_layout : bool_constant<__is_standard_layout(Ty)> {};
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "custom/_hash_table.h"
+#include "custom/_flat_hash_table.h"
 
 CUSTOM_BEGIN
 
@@ -66,8 +67,11 @@ public:
 	unordered_map()
 		:_Base() { /*Empty*/ }
 
-	unordered_map(const size_t buckets)
-		:_Base(buckets) { /*Empty*/ }
+	explicit unordered_map(const allocator_type& alloc)
+		:_Base(alloc) { /*Empty*/ }
+
+	unordered_map(const size_t buckets, const allocator_type& alloc = allocator_type())
+		:_Base(buckets, alloc) { /*Empty*/ }
 
 	unordered_map(std::initializer_list<value_type> list)
 		:_Base(list) { /*Empty*/ }
@@ -78,6 +82,12 @@ public:
 	unordered_map(unordered_map&& other) noexcept
 		:_Base(custom::move(other)) { /*Empty*/ }
 
+	unordered_map(const unordered_map& other, const allocator_type& alloc)
+		:_Base(other, alloc) { /*Empty*/ }
+
+	unordered_map(unordered_map&& other, const allocator_type& alloc)
+		:_Base(custom::move(other), alloc) { /*Empty*/ }
+
 	~unordered_map() = default;
 
 public:
@@ -99,7 +109,7 @@ public:
 		return *this;
 	}
 
-	unordered_map& operator=(unordered_map&& other) noexcept
+	unordered_map& operator=(unordered_map&& other) noexcept(noexcept(_Base::operator=(custom::move(other))))
 	{
 		_Base::operator=(custom::move(other));
 		return *this;
@@ -131,4 +141,107 @@ public:
 	}
 }; // END unordered_map
 
+template<class Key, class Type,
+class Hash 		= custom::hash<Key>,
+class Compare 	= custom::equal_to<Key>,
+class Alloc 	= custom::allocator<custom::pair<Key, Type>>>
+class flat_unordered_map : public detail::_Flat_Hash_Table<detail::_Umap_Traits<Key, Type, Hash, Compare, Alloc>>	// flat_unordered_map Template with open addressing
+{
+private:
+	using _Base = detail::_Flat_Hash_Table<detail::_Umap_Traits<Key, Type, Hash, Compare, Alloc>>;
+
+public:
+	static_assert(is_same_v<pair<Key, Type>, typename Alloc::value_type>, "Object type and allocator type must be the same!");
+	static_assert(is_object_v<Key>, "Containers require object type!");
+
+	using key_type 			= typename _Base::key_type;
+	using mapped_type 		= typename _Base::mapped_type;
+	using hasher 			= typename _Base::hasher;
+	using key_compare		= typename _Base::key_compare;
+	using value_type 		= typename _Base::value_type;
+	using reference 		= typename _Base::reference;
+	using const_reference 	= typename _Base::const_reference;
+	using pointer 			= typename _Base::pointer;
+	using const_pointer		= typename _Base::const_pointer;
+	using allocator_type 	= typename _Base::allocator_type;
+
+	using iterator			= typename _Base::iterator;
+	using const_iterator 	= typename _Base::const_iterator;
+
+public:
+	// Constructors
+
+	flat_unordered_map()
+		:_Base() { /*Empty*/ }
+
+	flat_unordered_map(const size_t buckets)
+		:_Base(buckets) { /*Empty*/ }
+
+	flat_unordered_map(std::initializer_list<value_type> list)
+		:_Base()
+	{
+		this->reserve(list.size());
+		for (const auto& val : list)
+			this->emplace(val);
+	}
+
+	flat_unordered_map(const flat_unordered_map& other)
+		:_Base(other) { /*Empty*/ }
+
+	flat_unordered_map(flat_unordered_map&& other) noexcept
+		:_Base(custom::move(other)) { /*Empty*/ }
+
+	~flat_unordered_map() = default;
+
+public:
+	// Operators
+
+	mapped_type& operator[](const key_type& key)	// Access value or create new one with key and assignment
+	{
+		return this->_try_emplace(key).first->second;
+	}
+
+	mapped_type& operator[](key_type&& key)
+	{
+		return this->_try_emplace(custom::move(key)).first->second;
+	}
+
+	flat_unordered_map& operator=(const flat_unordered_map& other)
+	{
+		_Base::operator=(other);
+		return *this;
+	}
+
+	flat_unordered_map& operator=(flat_unordered_map&& other) noexcept
+	{
+		_Base::operator=(custom::move(other));
+		return *this;
+	}
+
+public:
+	// Main functions
+
+	template<class... Args>
+	pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)	// Force construction with known key and given arguments for object
+	{
+		return this->_try_emplace(key, custom::forward<Args>(args)...);
+	}
+
+	template<class... Args>
+	pair<iterator, bool> try_emplace(key_type&& key, Args&&... args)
+	{
+		return this->_try_emplace(custom::move(key), custom::forward<Args>(args)...);
+	}
+
+	const mapped_type& at(const key_type& key) const	// Access value at key with check
+	{
+		return this->_at(key);
+	}
+
+	mapped_type& at(const key_type& key)
+	{
+		return this->_at(key);
+	}
+}; // END flat_unordered_map
+
 CUSTOM_END
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include "custom/_hash_table.h"
+#include "custom/_flat_hash_table.h"
 
 CUSTOM_BEGIN
 
@@ -66,8 +67,11 @@ public:
 	unordered_set()
 		:_Base() { /*Empty*/ }
 
-	unordered_set(const size_t buckets)
-		:_Base(buckets) { /*Empty*/ }
+	explicit unordered_set(const allocator_type& alloc)
+		:_Base(alloc) { /*Empty*/ }
+
+	unordered_set(const size_t buckets, const allocator_type& alloc = allocator_type())
+		:_Base(buckets, alloc) { /*Empty*/ }
 
 	unordered_set(std::initializer_list<value_type> list)
 		:_Base(list) { /*Empty*/ }
@@ -78,6 +82,12 @@ public:
 	unordered_set(unordered_set&& other) noexcept
 		:_Base(custom::move(other)) { /*Empty*/ }
 
+	unordered_set(const unordered_set& other, const allocator_type& alloc)
+		:_Base(other, alloc) { /*Empty*/ }
+
+	unordered_set(unordered_set&& other, const allocator_type& alloc)
+		:_Base(custom::move(other), alloc) { /*Empty*/ }
+
 	~unordered_set() = default;
 	
 public:
@@ -89,11 +99,79 @@ public:
 		return *this;
 	}
 
-	unordered_set& operator=(unordered_set&& other) noexcept
+	unordered_set& operator=(unordered_set&& other) noexcept(noexcept(_Base::operator=(custom::move(other))))
 	{
 		_Base::operator=(custom::move(other));
 		return *this;
 	}
 }; // END unordered_set
 
+template<class Key,
+class Hash 		= custom::hash<Key>,
+class Compare 	= custom::equal_to<Key>,
+class Alloc 	= custom::allocator<Key>>
+class flat_unordered_set : public detail::_Flat_Hash_Table<detail::_Uset_Traits<Key, Hash, Compare, Alloc>>		// flat_unordered_set Template with open addressing
+{
+private:
+	using _Base = detail::_Flat_Hash_Table<detail::_Uset_Traits<Key, Hash, Compare, Alloc>>;
+
+public:
+	static_assert(is_same_v<Key, typename Alloc::value_type>, "Object type and Allocator type must be the same!");
+	static_assert(is_object_v<Key>, "Containers require object type!");
+
+	using key_type			= typename _Base::key_type;
+	using mapped_type		= typename _Base::mapped_type;
+	using hasher			= typename _Base::hasher;
+	using key_compare		= typename _Base::key_compare;
+	using value_type		= typename _Base::value_type;
+	using reference			= typename _Base::reference;
+	using const_reference	= typename _Base::const_reference;
+	using pointer			= typename _Base::pointer;
+	using const_pointer		= typename _Base::const_pointer;
+	using allocator_type	= typename _Base::allocator_type;
+
+	using iterator			= typename _Base::iterator;
+	using const_iterator	= typename _Base::const_iterator;
+
+public:
+	// Constructors
+
+	flat_unordered_set()
+		:_Base() { /*Empty*/ }
+
+	flat_unordered_set(const size_t buckets)
+		:_Base(buckets) { /*Empty*/ }
+
+	flat_unordered_set(std::initializer_list<value_type> list)
+		:_Base()
+	{
+		this->reserve(list.size());
+		for (const auto& val : list)
+			this->emplace(val);
+	}
+
+	flat_unordered_set(const flat_unordered_set& other)
+		:_Base(other) { /*Empty*/ }
+
+	flat_unordered_set(flat_unordered_set&& other) noexcept
+		:_Base(custom::move(other)) { /*Empty*/ }
+
+	~flat_unordered_set() = default;
+	
+public:
+	// Operators
+
+	flat_unordered_set& operator=(const flat_unordered_set& other)
+	{
+		_Base::operator=(other);
+		return *this;
+	}
+
+	flat_unordered_set& operator=(flat_unordered_set&& other) noexcept
+	{
+		_Base::operator=(custom::move(other));
+		return *this;
+	}
+}; // END flat_unordered_set
+
 CUSTOM_END
\ No newline at end of file
@@ -132,6 +132,31 @@ public:
 		return !(*this == other);
 	}
 
+	constexpr difference_type operator-(const _Vector_Const_Iterator& other) const noexcept
+	{
+		return _Ptr - other._Ptr;
+	}
+
+	constexpr bool operator<(const _Vector_Const_Iterator& other) const noexcept
+	{
+		return _Ptr < other._Ptr;
+	}
+
+	constexpr bool operator>(const _Vector_Const_Iterator& other) const noexcept
+	{
+		return other < *this;
+	}
+
+	constexpr bool operator<=(const _Vector_Const_Iterator& other) const noexcept
+	{
+		return !(other < *this);
+	}
+
+	constexpr bool operator>=(const _Vector_Const_Iterator& other) const noexcept
+	{
+		return !(*this < other);
+	}
+
 public:
 
 	// Get the position for the element in array from iterator
@@ -230,6 +255,8 @@ public:
 		return temp;
 	}
 
+	using _Base::operator-;
+
 	constexpr pointer operator->() const noexcept
 	{
 		return const_cast<pointer>(_Base::operator->());
@@ -246,6 +273,183 @@ public:
     }
 }; // END _Vector_Iterator
 
+// Element pointer behind contiguous iterators, used to copy ranges in bulk
+template<class Type>
+constexpr Type* _unwrap_contiguous(Type* ptr) noexcept
+{
+	return ptr;
+}
+
+template<class VecData>
+constexpr auto _unwrap_contiguous(const _Vector_Const_Iterator<VecData>& iter) noexcept
+{
+	return iter._Ptr;
+}
+
+template<class Iter, class = void>
+constexpr bool _Is_Contiguous_Iterator_v = false;
+
+template<class Iter>
+constexpr bool _Is_Contiguous_Iterator_v<Iter, void_t<decltype(_unwrap_contiguous(custom::declval<const Iter&>()))>> = true;
+
+// Array helpers shared by vector and small_vector, which differ only in where the array lives.
+// Helpers that may need more room call grow(newCapacity), which must keep the elements in data.
+template<class Alloc, class Type>
+constexpr void _construct_range(Alloc& al, Type* const address, const size_t length)
+{
+	for (size_t i = 0; i < length; ++i)
+		allocator_traits<Alloc>::construct(al, address + i);
+}
+
+template<class Alloc, class Type>
+constexpr void _construct_range(Alloc& al, Type* const address, const size_t length, const Type& value)
+{
+	for (size_t i = 0; i < length; ++i)
+		allocator_traits<Alloc>::construct(al, address + i, value);
+}
+
+template<class Alloc, class Type>
+constexpr void _destroy_range(Alloc& al, Type* address, const size_t length)
+{
+	for (size_t i = 0; i < length; ++i)
+		allocator_traits<Alloc>::destroy(al, address + i);
+}
+
+// 50% more capacity, or exactly what is required if that is not enough
+template<class Type, class Alloc>
+constexpr size_t _calculate_growth(const _Vector_Data<Type, Alloc>& data, const size_t requiredCapacity) noexcept
+{
+	const size_t capacity	= static_cast<size_t>(data._Final - data._First);
+	const size_t geometric	= capacity + capacity / 2 + 1;
+	return (geometric < requiredCapacity) ? requiredCapacity : geometric;
+}
+
+// Reserve 50% more capacity when full
+template<class Type, class Alloc, class Grow>
+constexpr void _extend_if_full(_Vector_Data<Type, Alloc>& data, Grow grow)
+{
+	if (data._Last == data._Final)
+		grow(_calculate_growth(data, static_cast<size_t>(data._Last - data._First) + 1));
+}
+
+// Copy construct count elements starting at first into uninitialized memory at address
+template<class Alloc, class Type, class ForwardIt>
+constexpr void _construct_copies(Alloc& al, Type* const address, ForwardIt first, const size_t count)
+{
+	using _Source_Type = remove_cv_t<typename iterator_traits<ForwardIt>::value_type>;
+
+	if constexpr (	_Is_Contiguous_Iterator_v<ForwardIt> &&
+					is_same_v<_Source_Type, Type> &&
+					_Is_Bitwise_Copyable_v<Alloc>)
+		if (!is_constant_evaluated())
+		{
+			if (count > 0)
+				::memcpy(	static_cast<void*>(address),
+							static_cast<const void*>(_unwrap_contiguous(first)),
+							count * sizeof(Type));
+			return;
+		}
+
+	size_t constructed = 0;
+	try
+	{
+		for (/*Empty*/; constructed < count; ++constructed, ++first)
+			allocator_traits<Alloc>::construct(al, address + constructed, *first);
+	}
+	catch (...)
+	{
+		_destroy_range(al, address, constructed);
+		CUSTOM_RERAISE;
+	}
+}
+
+// Copy [first, last) to the tail, growing at most once for forward iterators
+template<class Alloc, class Type, class InputIt, class Grow>
+constexpr void _append(Alloc& al, _Vector_Data<Type, Alloc>& data, InputIt first, InputIt last, Grow grow)
+{
+	if constexpr (is_forward_iterator_v<InputIt>)
+	{
+		const size_t count = static_cast<size_t>(custom::distance(first, last));
+
+		if (count > static_cast<size_t>(data._Final - data._Last))
+			grow(_calculate_growth(data, static_cast<size_t>(data._Last - data._First) + count));
+
+		_construct_copies(al, data._Last, first, count);
+		data._Last += count;
+	}
+	else
+		for (/*Empty*/; first != last; ++first)
+		{
+			_extend_if_full(data, grow);
+			allocator_traits<Alloc>::construct(al, data._Last++, *first);
+		}
+}
+
+// Open a gap of count elements at index and fill it with copies from first
+template<class Alloc, class Type, class ForwardIt, class Grow>
+constexpr void _insert_counted(Alloc& al, _Vector_Data<Type, Alloc>& data, const size_t index, ForwardIt first, const size_t count, Grow grow)
+{
+	using _Alloc_Traits = allocator_traits<Alloc>;
+
+	if (count == 0)
+		return;
+
+	if (count > static_cast<size_t>(data._Final - data._Last))
+		grow(_calculate_growth(data, static_cast<size_t>(data._Last - data._First) + count));		// grow once, the tail is shifted below
+
+	Type* const where		= data._First + index;
+	Type* const oldLast		= data._Last;
+	const size_t tailSize	= static_cast<size_t>(oldLast - where);
+
+	if constexpr (_Is_Bitwise_Relocatable_v<Alloc>)
+		if (!is_constant_evaluated())
+		{
+			if (tailSize > 0)
+				::memmove(static_cast<void*>(where + count), static_cast<const void*>(where), tailSize * sizeof(Type));
+
+			try
+			{
+				_construct_copies(al, where, first, count);
+			}
+			catch (...)
+			{
+				if (tailSize > 0)
+					::memmove(static_cast<void*>(where), static_cast<const void*>(where + count), tailSize * sizeof(Type));
+
+				CUSTOM_RERAISE;
+			}
+
+			data._Last += count;
+			return;
+		}
+
+	if (count <= tailSize)
+	{
+		// last count elements move into uninitialized memory, the rest shifts inside the array
+		for (size_t i = 0; i < count; ++i)
+			_Alloc_Traits::construct(al, oldLast + i, custom::move(*(oldLast - count + i)));
+
+		data._Last += count;
+		custom::move_backward(where, oldLast - count, oldLast);
+
+		for (Type* current = where; current != where + count; ++current, ++first)
+			*current = *first;
+	}
+	else
+	{
+		// new elements past the old end are constructed, the whole tail moves into uninitialized memory
+		ForwardIt middle = custom::next(first, static_cast<typename iterator_traits<ForwardIt>::difference_type>(tailSize));
+		_construct_copies(al, oldLast, middle, count - tailSize);
+		data._Last += count - tailSize;
+
+		for (size_t i = 0; i < tailSize; ++i, ++data._Last)
+			_Alloc_Traits::construct(al, data._Last, custom::move(where[i]));
+
+		for (Type* current = where; current != oldLast; ++current, ++first)
+			*current = *first;
+	}
+}
+
 CUSTOM_DETAIL_END
 
 
@@ -287,18 +491,30 @@ public:
 		reserve(_DEFAULT_CAPACITY);
 	}
 
-	constexpr vector(const size_t newCapacity)								// Add multiple default copies Constructor
+	constexpr explicit vector(const allocator_type& alloc)
+		: _alloc(alloc)
+	{
+		reserve(_DEFAULT_CAPACITY);
+	}
+
+	constexpr vector(	const size_t newCapacity,
+						const allocator_type& alloc = allocator_type())		// Add multiple default copies Constructor
+		: _alloc(alloc)
 	{
 		realloc(newCapacity);
 	}
 
 	constexpr vector(	const size_t newCapacity,
-						const value_type& copyValue)						// Add multiple copies Constructor
+						const value_type& copyValue,
+						const allocator_type& alloc = allocator_type())		// Add multiple copies Constructor
+		: _alloc(alloc)
 	{
 		realloc(newCapacity, copyValue);
 	}
 
-	constexpr vector(std::initializer_list<value_type> list)
+	constexpr vector(	std::initializer_list<value_type> list,
+						const allocator_type& alloc = allocator_type())
+		: _alloc(alloc)
 	{
 		reserve(list.size());
 		for (const auto& val : list)
@@ -306,15 +522,32 @@ public:
 	}
 
 	constexpr vector(const vector& other)
+		: _alloc(_Alloc_Traits::select_on_container_copy_construction(other._alloc))
+	{
+		_copy(other);
+	}
+
+	constexpr vector(const vector& other, const allocator_type& alloc)
+		: _alloc(alloc)
 	{
 		_copy(other);
 	}
 
 	constexpr vector(vector&& other) noexcept
+		: _alloc(other._alloc)
 	{
 		_move(custom::move(other));
 	}
 
+	constexpr vector(vector&& other, const allocator_type& alloc)
+		: _alloc(alloc)
+	{
+		if (_alloc == other._alloc)
+			_move(custom::move(other));
+		else
+			_move_elements(other);
+	}
+
 	constexpr ~vector() noexcept
 	{
 		_clean_up_array();
@@ -340,18 +573,31 @@ public:
 		if (_data._First != other._data._First)
 		{
 			_clean_up_array();
+
+			if constexpr (_Alloc_Traits::propagate_on_container_copy_assignment::value)
+				_alloc = other._alloc;
+
 			_copy(other);
 		}
 
 		return *this;
 	}
 
-	constexpr vector& operator=(vector&& other) noexcept
+	constexpr vector& operator=(vector&& other)
+		noexcept(	_Alloc_Traits::propagate_on_container_move_assignment::value ||
+					_Alloc_Traits::is_always_equal::value)
 	{
 		if (_data._First != other._data._First)
 		{
 			_clean_up_array();
-			_move(custom::move(other));
+
+			if constexpr (_Alloc_Traits::propagate_on_container_move_assignment::value)
+				_alloc = other._alloc;
+
+			if (_alloc == other._alloc)
+				_move(custom::move(other));
+			else
+				_move_elements(other);		// memory can't change owner, move element by element
 		}
 
 		return *this;
@@ -366,9 +612,18 @@ public:
 		size_t newSize 			= std::min(newCapacity, size());
 		value_type* newArray 	= _alloc.allocate(newCapacity);
 
-		for (size_t i = 0; i < newSize; ++i)
-			_Alloc_Traits::construct(_alloc, &newArray[i], custom::move(_data._First[i]));
+		try
+		{
+			detail::_uninitialized_relocate_n(_alloc, _data._First, newSize, newArray);
+		}
+		catch (...)
+		{
+			_alloc.deallocate(newArray, newCapacity);
+			CUSTOM_RERAISE;
+		}
 
+		detail::_destroy_range(_alloc, _data._First + newSize, size() - newSize);	// elements that don't fit anymore
+		_data._Last = _data._First;									// the rest was relocated
 		_clean_up_array();
 		_data._First	= newArray;
 		_data._Last		= _data._First + newSize;
@@ -389,7 +644,7 @@ public:
 		_data._First	= _alloc.allocate(newCapacity);
 		_data._Last		= _data._First + newCapacity;
 		_data._Final	= _data._First + newCapacity;
-		_construct_range(_data._First, newCapacity);
+		detail::_construct_range(_alloc, _data._First, newCapacity);
 	}
 
 	// Allocate memory and populate it with given reference (delete old)
@@ -401,20 +656,43 @@ public:
 		_data._First	= _alloc.allocate(newCapacity);
 		_data._Last		= _data._First + newCapacity;
 		_data._Final	= _data._First + newCapacity;
-		_construct_range(_data._First, newCapacity, copyValue);
+		detail::_construct_range(_alloc, _data._First, newCapacity, copyValue);
+	}
+
+	// Replace content with copies of range elements, allocating at most once for forward ranges
+	template<class Range>
+	constexpr void assign_range(Range&& range)
+	{
+		auto first	= detail::_range_begin(range);
+		auto last	= detail::_range_end(range);
+
+		clear();
+
+		if constexpr (is_forward_iterator_v<decltype(first)>)
+		{
+			const size_t count = static_cast<size_t>(custom::distance(first, last));
+
+			if (count > capacity())
+				reserve(count);
+
+			detail::_construct_copies(_alloc, _data._Last, first, count);
+			_data._Last += count;
+		}
+		else
+			detail::_append(_alloc, _data, first, last, _reserver());
 	}
 	
 	// Change size and Construct/Destruct objects with default value if needed
 	constexpr void resize(const size_t newSize)
 	{
 		if (newSize < size())
-			_destroy_range(_data._First + newSize, size() - newSize);
+			detail::_destroy_range(_alloc, _data._First + newSize, size() - newSize);
 		else
 		{
 			if (newSize > capacity())
 				reserve(newSize);
 
-			_construct_range(_data._Last, newSize - size());
+			detail::_construct_range(_alloc, _data._Last, newSize - size());
 		}
 
 		_data._Last = _data._First + newSize;
@@ -424,13 +702,29 @@ public:
 	constexpr void resize(const size_t newSize, const value_type& copyValue)
 	{
 		if (newSize < size())
-			_destroy_range(_data._First + newSize, size() - newSize);
+			detail::_destroy_range(_alloc, _data._First + newSize, size() - newSize);
 		else
 		{
 			if (newSize > capacity())
 				reserve(newSize);
 
-			_construct_range(_data._Last, newSize - size(), copyValue);
+			detail::_construct_range(_alloc, _data._Last, newSize - size(), copyValue);
+		}
+
+		_data._Last = _data._First + newSize;
+	}
+
+	// Change size and default-initialize new objects (trivial types keep indeterminate values)
+	constexpr void resize_for_overwrite(const size_t newSize)
+	{
+		if (newSize < size())
+			detail::_destroy_range(_alloc, _data._First + newSize, size() - newSize);
+		else
+		{
+			if (newSize > capacity())
+				reserve(detail::_calculate_growth(_data, newSize));
+
+			custom::uninitialized_default_construct_n(_data._Last, newSize - size());
 		}
 
 		_data._Last = _data._First + newSize;
@@ -440,7 +734,7 @@ public:
 	template<class... Args>
 	constexpr void emplace_back(Args&&... args)
 	{
-		_extend_if_full();
+		detail::_extend_if_full(_data, _reserver());
 		_Alloc_Traits::construct(_alloc, _data._Last++, custom::forward<Args>(args)...);
 	}
 
@@ -456,6 +750,14 @@ public:
 		emplace_back(custom::move(moveValue));
 	}
 
+	// Add copies of range elements to the tail, growing at most once for forward ranges.
+	// The range must not refer to elements of this vector.
+	template<class Range>
+	constexpr void append_range(Range&& range)
+	{
+		detail::_append(_alloc, _data, detail::_range_begin(range), detail::_range_end(range), _reserver());
+	}
+
 	// Remove last component
 	constexpr void pop_back()
 	{
@@ -491,6 +793,27 @@ public:
 		return emplace(where, custom::move(moveValue));
 	}
 
+	// Push copies of range elements at iterator position and return iterator to the first one.
+	// The range must not refer to elements of this vector.
+	template<class Range>
+	constexpr iterator insert_range(const_iterator where, Range&& range)
+	{
+		size_t index	= where.get_index();	// Don't check end()
+		auto first		= detail::_range_begin(range);
+		auto last		= detail::_range_end(range);
+
+		if constexpr (is_forward_iterator_v<decltype(first)>)
+			detail::_insert_counted(_alloc, _data, index, first, static_cast<size_t>(custom::distance(first, last)), _reserver());
+		else
+		{
+			vector buffer(_alloc);				// single pass range, count it by storing it
+			detail::_append(buffer._alloc, buffer._data, first, last, buffer._reserver());
+			detail::_insert_counted(_alloc, _data, index, buffer._data._First, buffer.size(), _reserver());
+		}
+
+		return iterator(_data._First + index, &_data);
+	}
+
 	// Remove component at iterator position
 	constexpr iterator erase(const_iterator where)
 	{
@@ -528,11 +851,16 @@ public:
 	{
 		return (_data._First == _data._Last);
 	}
+
+	constexpr allocator_type get_allocator() const noexcept
+	{
+		return _alloc;
+	}
 	
 	// Remove ALL components but keep memory
 	constexpr void clear()
 	{
-		_destroy_range(_data._First, size());
+		detail::_destroy_range(_alloc, _data._First, size());
 		_data._Last = _data._First;
 	}
 
@@ -578,12 +906,12 @@ public:
 		return _data._Last[-1];
 	}
 
-	constexpr const_reference data() const noexcept
+	constexpr const_pointer data() const noexcept
 	{
 		return _data._First;
 	}
 
-	constexpr reference data() noexcept
+	constexpr pointer data() noexcept
 	{
 		return _data._First;
 	}
@@ -653,29 +981,19 @@ private:
 		_data._Final 	= custom::exchange(other._data._Final, nullptr);
 	}
 
-	constexpr void _construct_range(value_type* const address, const size_t length)
+	constexpr void _move_elements(vector& other)
 	{
-		for (size_t i = 0; i < length; ++i)
-			_Alloc_Traits::construct(_alloc, address + i);
-	}
+		reserve(other.size());
+		for (size_t i = 0; i < other.size(); ++i)
+			_Alloc_Traits::construct(_alloc, _data._Last++, custom::move(other._data._First[i]));
 
-	constexpr void _construct_range(value_type* const address, const size_t length, const value_type& value)
-	{
-		for (size_t i = 0; i < length; ++i)
-			_Alloc_Traits::construct(_alloc, address + i, value);
+		other.clear();
 	}
 
-	constexpr void _destroy_range(value_type* address, const size_t length)
+	// Growth callback for the shared array helpers
+	constexpr auto _reserver() noexcept
 	{
-		for (size_t i = 0; i < length; ++i)
-			_Alloc_Traits::destroy(_alloc, address + i);
-	}
-
-	// Reserve 50% more capacity when full
-	constexpr void _extend_if_full()
-	{
-		if (_data._Last == _data._Final)
-			reserve(capacity() + capacity() / 2 + 1);
+		return [this](const size_t newCapacity) { reserve(newCapacity); };
 	}
 
 	// Clear and Deallocate array
@@ -683,7 +1001,7 @@ private:
 	{
 		if (_data._First != nullptr)
 		{
-			_destroy_range(_data._First, size());
+			detail::_destroy_range(_alloc, _data._First, size());
 			_alloc.deallocate(_data._First, capacity());
 			_data._First	= nullptr;
 			_data._Last		= nullptr;
@@ -692,6 +1010,9 @@ private:
 	}
 }; // END vector Template
 
+template<class Type, class Alloc>
+struct is_trivially_relocatable<vector<Type, Alloc>> : is_trivially_relocatable<Alloc> {};
+
 
 // vector binary operators
 template<class _Type, class _Alloc>
@@ -0,0 +1,303 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "custom/vector.h"
+#include "custom/list.h"
+#include "custom/algorithm.h"   // unit to be tested
+#include "custom/execution.h"
+
+
+// IMPORTANT
+// Prefix all suites and fixtures with "CustomAlgorithm_". Used in ctest run.
+
+
+// Sizes around the insertion sort and merge run cutoffs, keys with many and with few duplicates
+static const size_t _SIZES[]    = {0, 1, 2, 3, 15, 16, 17, 31, 32, 33, 64, 100, 1000, 5000};
+static const unsigned _MODS[]   = {3, 1000000};
+
+
+TEST(CustomAlgorithm_Sort, sort_matches_std)
+{
+    std::mt19937 gen(42);
+
+    for (size_t size : _SIZES)
+        for (unsigned mod : _MODS)
+        {
+            custom::vector<int> values;
+            std::vector<int> expected;
+            for (size_t i = 0; i < size; ++i)
+            {
+                values.push_back(static_cast<int>(gen() % mod));
+                expected.push_back(values.back());
+            }
+
+            custom::sort(values.begin(), values.end());
+            std::sort(expected.begin(), expected.end());
+
+            ASSERT_TRUE(custom::is_sorted(values.begin(), values.end()));
+            for (size_t i = 0; i < size; ++i)
+                ASSERT_EQ(values[i], expected[i]);
+        }
+}
+
+
+TEST(CustomAlgorithm_Sort, sort_adversarial_inputs)
+{
+    constexpr int size = 20000;
+    custom::vector<int> sorted, reversed, organPipe;
+
+    for (int i = 0; i < size; ++i)
+    {
+        sorted.push_back(i);
+        reversed.push_back(size - i);
+        organPipe.push_back(i < size / 2 ? i : size - i);
+    }
+
+    custom::sort(sorted.begin(), sorted.end());
+    custom::sort(reversed.begin(), reversed.end(), custom::less<>{});
+    custom::sort(organPipe.begin(), organPipe.end());
+
+    EXPECT_TRUE(custom::is_sorted(sorted.begin(), sorted.end()));
+    EXPECT_TRUE(custom::is_sorted(reversed.begin(), reversed.end()));
+    EXPECT_TRUE(custom::is_sorted(organPipe.begin(), organPipe.end()));
+}
+
+
+TEST(CustomAlgorithm_Sort, stable_sort_keeps_order_of_equal_keys)
+{
+    struct _Item { int key; size_t order; };
+    auto byKey = [](const _Item& left, const _Item& right) { return left.key < right.key; };
+
+    std::mt19937 gen(7);
+
+    for (size_t size : _SIZES)
+        for (unsigned mod : _MODS)
+        {
+            std::vector<_Item> items(size);
+            for (size_t i = 0; i < size; ++i)
+                items[i] = {static_cast<int>(gen() % mod), i};
+
+            std::vector<_Item> expected = items;
+            custom::stable_sort(items.data(), items.data() + size, byKey);
+            std::stable_sort(expected.begin(), expected.end(), byKey);
+
+            for (size_t i = 0; i < size; ++i)
+            {
+                ASSERT_EQ(items[i].key, expected[i].key);
+                ASSERT_EQ(items[i].order, expected[i].order);
+            }
+        }
+}
+
+
+TEST(CustomAlgorithm_Sort, stable_sort_throwing_compare_keeps_elements)
+{
+    std::mt19937 gen(11);
+    std::vector<std::string> original(300);
+    for (auto& value : original)    // long enough to live on the heap, so a lost element leaks
+        value = "element-with-a-long-heap-payload-" + std::to_string(gen() % 1000);
+
+    size_t comparisons = 0;
+    auto counting = [&comparisons](const std::string& left, const std::string& right) { ++comparisons; return left < right; };
+
+    std::vector<std::string> sorted = original;
+    custom::stable_sort(sorted.data(), sorted.data() + sorted.size(), counting);
+    const size_t total = comparisons;
+
+    std::vector<std::string> expected = original;
+    std::sort(expected.begin(), expected.end());
+
+    for (size_t limit = 0; limit < total; limit += total / 60 + 1)        // throw while sorting the runs and while merging them
+    {
+        size_t left = limit;
+        auto throwing = [&left](const std::string& a, const std::string& b)
+        {
+            if (left-- == 0)
+                throw std::runtime_error("compare");
+
+            return a < b;
+        };
+
+        std::vector<std::string> values = original;
+        EXPECT_THROW(custom::stable_sort(values.data(), values.data() + values.size(), throwing), std::runtime_error);
+
+        std::sort(values.begin(), values.end());    // still the same elements, only reordered
+        ASSERT_EQ(values, expected);
+    }
+}
+
+
+TEST(CustomAlgorithm_Sort, partial_sort_and_nth_element)
+{
+    std::mt19937 gen(3);
+
+    for (size_t size : _SIZES)
+    {
+        if (size == 0)
+            continue;
+
+        std::vector<int> values(size);
+        for (auto& value : values)
+            value = static_cast<int>(gen() % 100);
+
+        std::vector<int> expected = values;
+        std::sort(expected.begin(), expected.end());
+        const size_t middle = size / 3;
+
+        std::vector<int> partial = values;
+        custom::partial_sort(partial.data(), partial.data() + middle, partial.data() + size);
+        for (size_t i = 0; i < middle; ++i)
+            ASSERT_EQ(partial[i], expected[i]);
+
+        std::vector<int> nth = values;
+        custom::nth_element(nth.data(), nth.data() + middle, nth.data() + size);
+        ASSERT_EQ(nth[middle], expected[middle]);
+        for (size_t i = 0; i < size; ++i)
+            ASSERT_TRUE(i < middle ? nth[i] <= nth[middle] : nth[i] >= nth[middle]);
+    }
+}
+
+
+TEST(CustomAlgorithm_Heap, push_pop_sort_heap)
+{
+    custom::vector<int> heap;
+    for (int value : {5, 1, 9, 3, 7, 2, 8, 6, 4, 0})
+    {
+        heap.push_back(value);
+        custom::push_heap(heap.begin(), heap.end());
+        ASSERT_TRUE(custom::is_heap(heap.begin(), heap.end()));
+    }
+
+    EXPECT_EQ(heap.front(), 9);
+
+    custom::pop_heap(heap.begin(), heap.end());
+    EXPECT_EQ(heap.back(), 9);
+    EXPECT_TRUE(custom::is_heap(heap.begin(), heap.end() - 1));
+
+    custom::make_heap(heap.begin(), heap.end());
+    custom::sort_heap(heap.begin(), heap.end());
+    for (int i = 0; i < 10; ++i)
+        EXPECT_EQ(heap[i], i);
+}
+
+
+TEST(CustomAlgorithm_BinarySearch, bounds_match_std)
+{
+    std::mt19937 gen(11);
+
+    for (size_t size : _SIZES)
+        for (unsigned mod : {3u, 50u})
+        {
+            std::vector<int> expected(size);
+            for (auto& value : expected)
+                value = static_cast<int>(gen() % mod);
+
+            std::sort(expected.begin(), expected.end());
+
+            custom::vector<int> values;
+            for (int value : expected)
+                values.push_back(value);
+
+            for (int key = -1; key <= static_cast<int>(mod); ++key)
+            {
+                const auto lower = std::lower_bound(expected.begin(), expected.end(), key) - expected.begin();
+                const auto upper = std::upper_bound(expected.begin(), expected.end(), key) - expected.begin();
+
+                ASSERT_EQ(custom::lower_bound(values.begin(), values.end(), key) - values.begin(), lower);
+                ASSERT_EQ(custom::upper_bound(values.begin(), values.end(), key) - values.begin(), upper);
+
+                auto range = custom::equal_range(values.begin(), values.end(), key);
+                ASSERT_EQ(range.first - values.begin(), lower);
+                ASSERT_EQ(range.second - values.begin(), upper);
+
+                ASSERT_EQ(custom::binary_search(values.begin(), values.end(), key), lower != upper);
+            }
+        }
+}
+
+
+TEST(CustomAlgorithm_BinarySearch, forward_iterators_and_comparator)
+{
+    custom::list<int> descending;
+    for (int value : {9, 7, 7, 5, 3, 1})
+        descending.push_back(value);
+
+    auto greater = [](int left, int right) { return left > right; };
+
+    EXPECT_EQ(custom::distance(descending.begin(), custom::lower_bound(descending.begin(), descending.end(), 7, greater)), 1);
+    EXPECT_EQ(custom::distance(descending.begin(), custom::upper_bound(descending.begin(), descending.end(), 7, greater)), 3);
+    EXPECT_TRUE(custom::binary_search(descending.begin(), descending.end(), 3, greater));
+    EXPECT_FALSE(custom::binary_search(descending.begin(), descending.end(), 4, greater));
+}
+
+
+TEST(CustomAlgorithm_Parallel, reductions_match_sequential)
+{
+    for (size_t size : {0, 1, 2047, 100000})
+    {
+        std::vector<long> values(size);
+        for (size_t i = 0; i < size; ++i)
+            values[i] = static_cast<long>(i % 97) - 40;
+
+        const long* first   = values.data();
+        const long* last    = values.data() + size;
+        const long sum      = std::accumulate(values.begin(), values.end(), 0L);
+        auto positive       = [](long value) { return value > 0; };
+
+        EXPECT_EQ(custom::reduce(custom::execution::par, first, last), sum);
+        EXPECT_EQ(custom::reduce(custom::execution::seq, first, last, 5L), sum + 5);
+        EXPECT_EQ(custom::reduce(custom::execution::par_unseq, first, last, 0L, custom::plus<>{}), sum);
+        EXPECT_EQ(custom::transform_reduce(custom::execution::par, first, last, first, 0L),
+                  std::inner_product(values.begin(), values.end(), values.begin(), 0L));
+        EXPECT_EQ(custom::transform_reduce(custom::execution::par, first, last, 1L, custom::plus<>{}, [](long value) { return 2 * value; }),
+                  1 + 2 * sum);
+        EXPECT_EQ(custom::count_if(custom::execution::par, first, last, positive),
+                  std::count_if(values.begin(), values.end(), positive));
+    }
+}
+
+
+TEST(CustomAlgorithm_Parallel, transforms_and_scans_match_sequential)
+{
+    for (size_t size : {0, 1, 2047, 100000})
+    {
+        std::vector<long> values(size);
+        for (size_t i = 0; i < size; ++i)
+            values[i] = static_cast<long>(i % 31) - 10;
+
+        const long* first = values.data();
+        const long* last  = values.data() + size;
+        std::vector<long> result(size), expected(size);
+
+        custom::transform(custom::execution::par, first, last, result.data(), [](long value) { return 3 * value; });
+        std::transform(values.begin(), values.end(), expected.begin(), [](long value) { return 3 * value; });
+        EXPECT_EQ(result, expected);
+
+        custom::inclusive_scan(custom::execution::par, first, last, result.data());
+        std::inclusive_scan(values.begin(), values.end(), expected.begin());
+        EXPECT_EQ(result, expected);
+
+        custom::inclusive_scan(custom::execution::par, first, last, result.data(), custom::plus<>{}, 7L);
+        std::inclusive_scan(values.begin(), values.end(), expected.begin(), std::plus<>{}, 7L);
+        EXPECT_EQ(result, expected);
+
+        custom::exclusive_scan(custom::execution::par, first, last, result.data(), 3L);
+        std::exclusive_scan(values.begin(), values.end(), expected.begin(), 3L);
+        EXPECT_EQ(result, expected);
+
+        result = values;    // in place
+        custom::exclusive_scan(custom::execution::par, result.data(), result.data() + size, result.data(), 3L);
+        EXPECT_EQ(result, expected);
+
+        std::atomic<long> visited = 0;
+        custom::for_each(custom::execution::par, first, last, [&visited](long) { ++visited; });
+        EXPECT_EQ(visited.load(), static_cast<long>(size));
+    }
+}
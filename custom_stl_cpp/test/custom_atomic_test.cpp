@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <vector>
+
+#include "custom/barrier.h"
+#include "custom/latch.h"
+#include "custom/atomic.h"      // unit to be tested
+
+
+// IMPORTANT
+// Prefix all suites and fixtures with "CustomAtomic_". Used in ctest run.
+
+
+template<class Type>
+static void _hand_off_values(const Type first, const Type second)
+{
+    custom::atomic<Type> value(first);
+    custom::atomic<int> seen = 0;
+
+    custom::thread waiter([&value, &seen, first]()
+    {
+        value.wait(first);
+        seen.store(1);
+        seen.notify_one();
+    });
+
+    value.store(second);
+    value.notify_one();
+    seen.wait(0);
+    waiter.join();
+
+    EXPECT_EQ(seen.load(), 1);
+}
+
+struct _Two_Shorts
+{
+    short _A, _B;
+};
+
+
+TEST(CustomAtomic_Atomic, wait_and_notify)
+{
+    _hand_off_values<int>(0, 1);                    // sleeps on the object
+    _hand_off_values<char>('a', 'b');               // sleeps on a bucket
+    _hand_off_values<uint64_t>(1, uint64_t{1} << 40);
+    _hand_off_values<_Two_Shorts>({1, 2}, {1, 3});  // compared bytewise
+
+    custom::atomic<int> value = 5;
+    value.wait(4);                                  // returns at once, values differ
+    value.notify_all();                             // nobody waits
+    EXPECT_EQ(++value, 6);
+}
+
+
+TEST(CustomAtomic_Atomic, notify_all_wakes_everyone)
+{
+    custom::atomic<long> go = 0;
+    custom::atomic<int> awake = 0;
+    std::vector<custom::thread> threads;
+
+    for (int t = 0; t < 6; ++t)
+        threads.emplace_back([&go, &awake]()
+        {
+            go.wait(0);
+            ++awake;
+        });
+
+    go.store(1);
+    go.notify_all();
+
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(awake.load(), 6);
+}
+
+
+TEST(CustomAtomic_Latch, count_down_and_wait)
+{
+    custom::latch done(4);
+    custom::atomic<int> work = 0;
+    std::vector<custom::thread> threads;
+
+    EXPECT_FALSE(done.try_wait());
+
+    for (int t = 0; t < 3; ++t)
+        threads.emplace_back([&done, &work]()
+        {
+            ++work;
+            done.count_down();
+        });
+
+    done.arrive_and_wait();     // the fourth participant
+    EXPECT_TRUE(done.try_wait());
+    EXPECT_EQ(work.load(), 3);
+
+    for (auto& thread : threads)
+        thread.join();
+
+    custom::latch batch(3);
+    batch.count_down(3);
+    batch.wait();
+    EXPECT_TRUE(batch.try_wait());
+}
+
+
+TEST(CustomAtomic_Barrier, phases_and_completion)
+{
+    constexpr int threadCount   = 4;
+    constexpr int phaseCount    = 200;
+
+    int completions = 0;
+    int counters[threadCount] = {};
+    bool inStep = true;
+
+    auto completion = [&]() noexcept
+    {
+        for (int counter : counters)    // every participant finished the phase
+            inStep = inStep && counter == completions + 1;
+
+        ++completions;
+    };
+
+    custom::barrier<decltype(completion)> sync(threadCount, completion);
+    std::vector<custom::thread> threads;
+
+    for (int t = 0; t < threadCount; ++t)
+        threads.emplace_back([&sync, &counters, t]()
+        {
+            for (int phase = 0; phase < phaseCount; ++phase)
+            {
+                ++counters[t];
+                sync.arrive_and_wait();
+            }
+        });
+
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(completions, phaseCount);
+    EXPECT_TRUE(inStep);
+}
+
+
+TEST(CustomAtomic_Barrier, split_arrive_and_drop)
+{
+    custom::barrier<> sync(3);
+    custom::atomic<int> phasesSeen = 0;
+
+    custom::thread leaver([&sync]()
+    {
+        sync.arrive_and_wait();
+        sync.arrive_and_drop();     // the next phases only need two
+    });
+
+    custom::thread stayer([&sync, &phasesSeen]()
+    {
+        for (int phase = 0; phase < 5; ++phase)
+        {
+            auto token = sync.arrive();
+            sync.wait(custom::move(token));
+            ++phasesSeen;
+        }
+    });
+
+    for (int phase = 0; phase < 5; ++phase)
+        sync.arrive_and_wait();
+
+    leaver.join();
+    stayer.join();
+
+    EXPECT_EQ(phasesSeen.load(), 5);
+
+    custom::barrier<> single(1);
+    auto token = single.arrive();       // completes the phase by itself
+    single.wait(custom::move(token));
+    EXPECT_EQ(custom::barrier<>::max(), INT_MAX);
+}
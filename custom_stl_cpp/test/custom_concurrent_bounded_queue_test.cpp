@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <vector>
+
+#include "custom/string.h"
+#include "custom/thread.h"
+#include "custom/concurrent_bounded_queue.h"    // unit to be tested
+
+
+// IMPORTANT
+// Prefix all suites and fixtures with "CustomConcurrentQueue_". Used in ctest run.
+
+
+TEST(CustomConcurrentQueue_Single, fifo_full_and_empty)
+{
+    custom::concurrent_bounded_queue<int> queue(3);     // rounded up to 4
+    EXPECT_EQ(queue.capacity(), 4);
+    EXPECT_TRUE(queue.empty());
+
+    int value = -1;
+    EXPECT_FALSE(queue.try_pop(value));
+    EXPECT_EQ(value, -1);
+
+    for (int round = 0; round < 3; ++round)    // wraps the ring several times
+    {
+        for (int i = 0; i < 4; ++i)
+            EXPECT_TRUE(queue.try_push(round * 10 + i));
+
+        EXPECT_FALSE(queue.try_push(99));
+        EXPECT_EQ(queue.size(), 4);
+
+        for (int i = 0; i < 4; ++i)
+        {
+            EXPECT_TRUE(queue.try_pop(value));
+            EXPECT_EQ(value, round * 10 + i);
+        }
+
+        EXPECT_FALSE(queue.try_pop(value));
+    }
+
+    custom::concurrent_bounded_queue<int> tiny(0);
+    EXPECT_EQ(tiny.capacity(), 2);
+}
+
+
+TEST(CustomConcurrentQueue_Single, owns_its_elements)
+{
+    auto marker = custom::make_shared<int>(7);
+
+    {
+        custom::concurrent_bounded_queue<custom::shared_ptr<int>> queue(8);
+        EXPECT_TRUE(queue.try_push(marker));
+        EXPECT_TRUE(queue.try_emplace(marker));
+        queue.emplace(marker);
+        EXPECT_EQ(marker.use_count(), 4);
+
+        custom::shared_ptr<int> out;
+        queue.pop(out);
+        EXPECT_EQ(*out, 7);
+        out.reset();
+        EXPECT_EQ(marker.use_count(), 3);
+    }   // the two left are destroyed with the queue
+
+    EXPECT_EQ(marker.use_count(), 1);
+
+    custom::concurrent_bounded_queue<custom::string> strings(2);
+    custom::string text = "moved in";
+    strings.push(custom::move(text));
+    EXPECT_TRUE(strings.try_emplace("xxx"));      // built before a slot is claimed
+
+    custom::string out;
+    strings.pop(out);
+    EXPECT_EQ(out, "moved in");
+    strings.pop(out);
+    EXPECT_EQ(out, "xxx");
+}
+
+
+TEST(CustomConcurrentQueue_Threads, blocking_producers_and_consumers)
+{
+    constexpr int producerCount = 4;
+    constexpr int consumerCount = 3;
+    constexpr int perProducer   = 20000;
+
+    custom::concurrent_bounded_queue<long> queue(4);   // small, so both sides block often
+    std::vector<custom::thread> threads;
+    std::vector<long> sums(consumerCount, 0);
+    std::vector<int> orderBroken(consumerCount, 0);
+
+    for (int p = 0; p < producerCount; ++p)
+        threads.emplace_back([&queue, p]()
+        {
+            for (long i = 0; i < perProducer; ++i)
+                queue.push(p * perProducer + i);
+        });
+
+    for (int c = 0; c < consumerCount; ++c)
+        threads.emplace_back([&queue, &sums, &orderBroken, c]()
+        {
+            long last[producerCount];
+            for (long& value : last)
+                value = -1;
+
+            for (;;)
+            {
+                long value;
+                queue.pop(value);
+                if (value < 0)
+                    return;
+
+                const int producer = static_cast<int>(value / perProducer);
+                orderBroken[c] += value <= last[producer];     // one producer's items come out in order
+                last[producer] = value;
+                sums[c] += value;
+            }
+        });
+
+    for (int p = 0; p < producerCount; ++p)
+        threads[p].join();
+
+    for (int c = 0; c < consumerCount; ++c)
+        queue.push(-1);
+
+    for (int c = 0; c < consumerCount; ++c)
+        threads[producerCount + c].join();
+
+    long total = 0;
+    for (int c = 0; c < consumerCount; ++c)
+    {
+        total += sums[c];
+        EXPECT_EQ(orderBroken[c], 0);
+    }
+
+    const long count = long{producerCount} * perProducer;
+    EXPECT_EQ(total, count * (count - 1) / 2);
+    EXPECT_TRUE(queue.empty());
+}
+
+
+TEST(CustomConcurrentQueue_Threads, try_operations_race)
+{
+    custom::concurrent_bounded_queue<int> queue(64);
+    custom::atomic<long> pushed = 0;
+    custom::atomic<long> popped = 0;
+    std::vector<custom::thread> threads;
+
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([&queue, &pushed, &popped]()
+        {
+            int value;
+            for (int i = 0; i < 20000; ++i)
+            {
+                if (queue.try_push(i))
+                    pushed += i;
+
+                if (queue.try_pop(value))
+                    popped += value;
+            }
+        });
+
+    for (auto& thread : threads)
+        thread.join();
+
+    int value;
+    while (queue.try_pop(value))
+        popped += value;
+
+    EXPECT_EQ(pushed.load(), popped.load());
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <deque>
+
+#include "custom/string.h"
+#include "custom/queue.h"
+#include "custom/deque.h"   // unit to be tested
+
+
+// IMPORTANT
+// Prefix all suites and fixtures with "CustomDeque_". Used in ctest run.
+
+
+// Counts block allocations to check that blocks are reused
+template<class Type>
+struct CountingAllocator : custom::allocator<Type>
+{
+    using value_type = Type;
+
+    static inline size_t allocations = 0;
+
+    CountingAllocator() = default;
+
+    template<class Other>
+    CountingAllocator(const CountingAllocator<Other>&) noexcept { /*Empty*/ }
+
+    Type* allocate(const size_t count)
+    {
+        ++allocations;
+        return custom::allocator<Type>::allocate(count);
+    }
+};
+
+
+TEST(CustomDeque_Init, block_size_from_type)
+{
+    EXPECT_EQ(custom::deque<char>::block_size(), 4096);
+    EXPECT_EQ(custom::deque<int>::block_size(), 1024);
+    EXPECT_EQ(custom::deque<custom::string>::block_size(), custom::bit_floor(4096 / sizeof(custom::string)));
+
+    struct Large { char bytes[1000]; };
+    EXPECT_EQ(custom::deque<Large>::block_size(), 16);
+
+    using SmallBlocks = custom::deque<int, custom::allocator<int>, 4>;
+    EXPECT_EQ(SmallBlocks::block_size(), 4);
+}
+
+
+TEST(CustomDeque_Operations, matches_std_deque)
+{
+    custom::deque<int, custom::allocator<int>, 4> small;  // many blocks and map growths
+    custom::deque<int> large;
+    std::deque<int> expected;
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        if (i % 3 == 0)
+        {
+            small.push_front(i);
+            large.push_front(i);
+            expected.push_front(i);
+        }
+        else
+        {
+            small.push_back(i);
+            large.push_back(i);
+            expected.push_back(i);
+        }
+
+        if (i % 7 == 0)
+        {
+            small.pop_front();
+            large.pop_front();
+            expected.pop_front();
+        }
+    }
+
+    ASSERT_EQ(small.size(), expected.size());
+    ASSERT_EQ(large.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        ASSERT_EQ(small[i], expected[i]);
+        ASSERT_EQ(large[i], expected[i]);
+    }
+
+    large.shrink_to_fit();
+    for (size_t i = 0; i < expected.size(); ++i)
+        ASSERT_EQ(large[i], expected[i]);
+}
+
+
+TEST(CustomDeque_Operations, fifo_reuses_blocks)
+{
+    using Deque = custom::deque<int, CountingAllocator<int>, 16>;
+
+    Deque fifo;
+    for (int i = 0; i < 1000; ++i)
+        fifo.push_back(i);
+
+    for (int i = 1000; i < 1016; ++i)       // shifting by a block makes the window straddle one more block
+    {
+        fifo.pop_front();
+        fifo.push_back(i);
+    }
+
+    const size_t allocationsAfterFill = CountingAllocator<int>::allocations;
+
+    for (int i = 1016; i < 100000; ++i)     // steady state queue
+    {
+        ASSERT_EQ(fifo.front(), i - 1000);
+        fifo.pop_front();
+        fifo.push_back(i);
+    }
+
+    EXPECT_EQ(CountingAllocator<int>::allocations, allocationsAfterFill);
+
+    fifo.clear();
+    for (int i = 0; i < 1000; ++i)
+        fifo.push_back(i);
+
+    EXPECT_EQ(CountingAllocator<int>::allocations, allocationsAfterFill);
+}
+
+
+TEST(CustomDeque_Operations, queue_over_deque)
+{
+    custom::queue<custom::string> queue;
+
+    for (int i = 0; i < 3000; ++i)
+        queue.push(custom::string("a string that does not fit in place"));
+
+    while (!queue.empty())
+    {
+        EXPECT_EQ(queue.front(), "a string that does not fit in place");
+        queue.pop();
+    }
+}
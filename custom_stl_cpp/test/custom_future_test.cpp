@@ -0,0 +1,307 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "custom/thread_pool.h"
+#include "custom/future.h"      // unit to be tested
+
+
+// IMPORTANT
+// Prefix all suites and fixtures with "CustomFuture_". Used in ctest run.
+
+
+TEST(CustomFuture_Promise, value_reference_and_void)
+{
+    custom::promise<std::string> text;
+    custom::future<std::string> textFuture = text.get_future();
+    EXPECT_FALSE(textFuture.is_ready());
+
+    custom::thread producer([&text]() { text.set_value("from thread"); });
+    EXPECT_EQ(textFuture.get(), "from thread");
+    EXPECT_FALSE(textFuture.valid());
+    producer.join();
+
+    int target = 1;
+    custom::promise<int&> reference;
+    auto referenceFuture = reference.get_future();
+    reference.set_value(target);
+    referenceFuture.get() = 5;
+    EXPECT_EQ(target, 5);
+
+    custom::promise<void> signal;
+    auto signalFuture = signal.get_future();
+    EXPECT_EQ(signalFuture.wait_for(custom::chrono::milliseconds(1)), custom::future_status::timeout);
+    signal.set_value();
+    EXPECT_EQ(signalFuture.wait_for(custom::chrono::milliseconds(1)), custom::future_status::ready);
+    signalFuture.get();
+
+    custom::promise<std::unique_ptr<int>> moveOnly;
+    auto moveOnlyFuture = moveOnly.get_future();
+    moveOnly.set_value(std::make_unique<int>(3));
+    EXPECT_EQ(*moveOnlyFuture.get(), 3);
+}
+
+
+TEST(CustomFuture_Promise, errors)
+{
+    custom::promise<int> value;
+    auto future = value.get_future();
+
+    try
+    {
+        (void)value.get_future();
+        FAIL() << "second get_future must throw";
+    }
+    catch (const custom::future_error& error)
+    {
+        EXPECT_EQ(error.code(), custom::future_errc::future_already_retrieved);
+    }
+
+    value.set_exception(std::make_exception_ptr(std::runtime_error("failed")));
+    EXPECT_THROW(value.set_value(1), custom::future_error);
+    EXPECT_THROW(future.get(), std::runtime_error);
+
+    custom::future<int> orphan;
+    {
+        custom::promise<int> dropped;
+        orphan = dropped.get_future();
+    }
+
+    try
+    {
+        (void)orphan.get();
+        FAIL() << "a dropped promise must break its future";
+    }
+    catch (const custom::future_error& error)
+    {
+        EXPECT_EQ(error.code(), custom::future_errc::broken_promise);
+    }
+
+    custom::promise<int> source;
+    custom::promise<int> moved = custom::move(source);
+    EXPECT_THROW(source.set_value(1), custom::future_error);    // no_state
+    moved.set_value(2);
+}
+
+
+TEST(CustomFuture_SharedFuture, many_readers)
+{
+    custom::promise<int> value;
+    custom::shared_future<int> shared = value.get_future().share();
+    std::atomic<int> sum = 0;
+
+    custom::thread first([shared, &sum]() { sum += shared.get(); });
+    custom::thread second([shared, &sum]() { sum += shared.get(); });
+
+    value.set_value(21);
+    first.join();
+    second.join();
+
+    EXPECT_EQ(sum.load(), 42);
+    EXPECT_EQ(shared.get(), 21);
+    EXPECT_TRUE(shared.valid());
+}
+
+
+TEST(CustomFuture_PackagedTask, call_and_reset)
+{
+    custom::packaged_task<int(int, int)> add([](int a, int b) { return a + b; });
+    auto first = add.get_future();
+
+    add(2, 3);
+    EXPECT_EQ(first.get(), 5);
+    EXPECT_THROW(add(1, 1), custom::future_error);      // already satisfied
+
+    add.reset();
+    auto second = add.get_future();
+    custom::thread worker(custom::move(add), 10, 20);
+    EXPECT_EQ(second.get(), 30);
+    worker.join();
+
+    custom::packaged_task<void()> fails([]() { throw std::logic_error("bad"); });
+    auto failed = fails.get_future();
+    fails();
+    EXPECT_THROW(failed.get(), std::logic_error);
+
+    custom::future<void> abandoned;
+    {
+        custom::packaged_task<void()> never([]() { /*Empty*/ });
+        abandoned = never.get_future();
+    }
+    EXPECT_THROW(abandoned.get(), custom::future_error);
+}
+
+
+TEST(CustomFuture_Async, policies)
+{
+    auto onThread = custom::async(custom::launch::async, [](std::string word) { return word + word; }, std::string("ab"));
+    EXPECT_EQ(onThread.get(), "abab");
+
+    bool ran = false;
+    auto deferred = custom::async(custom::launch::deferred, [&ran]() { ran = true; return 7; });
+    EXPECT_EQ(deferred.wait_for(custom::chrono::milliseconds(0)), custom::future_status::deferred);
+    EXPECT_FALSE(ran);
+    EXPECT_EQ(deferred.get(), 7);
+    EXPECT_TRUE(ran);
+
+    auto throws = custom::async([]() -> int { throw std::out_of_range("range"); });
+    EXPECT_THROW(throws.get(), std::out_of_range);
+
+    std::atomic<bool> finished = false;
+    {
+        auto dropped = custom::async(custom::launch::async, [&finished]()
+        {
+            custom::this_thread::sleep_for(custom::chrono::milliseconds(10));
+            finished = true;
+        });
+    }
+    EXPECT_TRUE(finished.load());       // the last future joined the thread
+}
+
+
+TEST(CustomFuture_Then, chains_without_blocking)
+{
+    custom::promise<int> start;
+    auto result = start.get_future()
+        .then([](custom::future<int> ready) { return ready.get() * 2; })
+        .then([](custom::future<int> ready) { return std::to_string(ready.get()); })
+        .then([](custom::future<std::string> ready) { return ready.get() + "!"; });
+
+    EXPECT_FALSE(result.is_ready());
+    start.set_value(21);
+    EXPECT_TRUE(result.is_ready());      // ran on the thread that set the value
+    EXPECT_EQ(result.get(), "42!");
+
+    auto already = custom::make_ready_future(5).then([](custom::future<int> ready) { return ready.get() + 1; });
+    EXPECT_EQ(already.get(), 6);
+
+    custom::promise<int> failing;
+    auto recovered = failing.get_future()
+        .then([](custom::future<int> ready) { return ready.get() + 1; })     // rethrows, skipped
+        .then([](custom::future<int> ready)
+        {
+            try
+            {
+                return ready.get();
+            }
+            catch (const std::runtime_error&)
+            {
+                return -1;
+            }
+        });
+
+    failing.set_exception(std::make_exception_ptr(std::runtime_error("rpc failed")));
+    EXPECT_EQ(recovered.get(), -1);
+
+    custom::promise<int> shared;
+    custom::shared_future<int> sharedFuture = shared.get_future().share();
+    auto plusOne    = sharedFuture.then([](custom::shared_future<int> ready) { return ready.get() + 1; });
+    auto plusTwo    = sharedFuture.then([](custom::shared_future<int> ready) { return ready.get() + 2; });
+    shared.set_value(10);
+    EXPECT_EQ(plusOne.get() + plusTwo.get(), 23);
+}
+
+
+TEST(CustomFuture_Then, on_executor)
+{
+    custom::thread_pool pool(2);
+    custom::promise<int> start;
+
+    auto onPool = start.get_future().then(pool, [](custom::future<int> ready)
+    {
+        return ready.get() + 1;
+    });
+
+    start.set_value(1);
+    EXPECT_EQ(onPool.get(), 2);
+
+    auto chained = custom::make_ready_future(std::string("x"))
+        .then(pool, [](custom::future<std::string> ready) { return ready.get() + "y"; })
+        .then(pool, [](custom::future<std::string> ready) { return ready.get() + "z"; });
+    EXPECT_EQ(chained.get(), "xyz");
+}
+
+
+TEST(CustomFuture_When, all_and_any)
+{
+    custom::vector<custom::promise<int>> calls(8);
+    custom::vector<custom::future<int>> pending;
+    for (auto& call : calls)
+        pending.push_back(call.get_future());
+
+    auto all = custom::when_all(pending.begin(), pending.end()).then(
+        [](custom::future<custom::vector<custom::future<int>>> ready)
+        {
+            int sum = 0;
+            for (auto& reply : ready.get())
+                sum += reply.get();
+
+            return sum;
+        });
+
+    for (int i = 7; i >= 0; --i)
+    {
+        EXPECT_FALSE(all.is_ready());
+        calls[i].set_value(i);
+    }
+    EXPECT_EQ(all.get(), 28);
+
+    custom::promise<int> slow;
+    custom::promise<std::string> fast;
+    auto any = custom::when_any(slow.get_future(), fast.get_future());
+    fast.set_value("fast");
+
+    auto first = any.get();
+    EXPECT_EQ(first.index, 1u);
+    EXPECT_EQ(custom::get<1>(first.futures).get(), "fast");
+    EXPECT_FALSE(custom::get<0>(first.futures).is_ready());
+    slow.set_value(0);
+
+    auto mixed = custom::when_all(custom::make_ready_future(1), custom::make_ready_future().share());
+    auto values = mixed.get();
+    EXPECT_EQ(custom::get<0>(values).get(), 1);
+
+    auto shared = custom::make_ready_future(3).share();
+    auto owned  = custom::make_ready_future(4);
+    auto both   = custom::when_all(shared, custom::move(owned)).get();
+    EXPECT_TRUE(shared.valid());
+    EXPECT_EQ(shared.get(), 3);
+    EXPECT_EQ(custom::get<1>(both).get(), 4);
+
+    auto lvalueFuture = [](auto& input) { return requires { custom::when_all(input); }; };
+    auto lvalueShared = custom::make_ready_future().share();
+    EXPECT_FALSE(lvalueFuture(owned));
+    EXPECT_TRUE(lvalueFuture(lvalueShared));
+
+    custom::vector<custom::future<int>> none;
+    EXPECT_TRUE(custom::when_all(none.begin(), none.end()).get().empty());
+    EXPECT_EQ(custom::when_any(none.begin(), none.end()).get().index, static_cast<size_t>(-1));
+    EXPECT_TRUE(custom::when_all().is_ready());
+}
+
+
+TEST(CustomFuture_When, fan_out_from_threads)
+{
+    custom::thread_pool pool(4);
+    custom::vector<custom::promise<int>> calls(100);
+    custom::vector<custom::future<int>> replies;
+    for (auto& call : calls)
+        replies.push_back(call.get_future());
+
+    auto total = custom::when_all(replies.begin(), replies.end()).then(pool,
+        [](custom::future<custom::vector<custom::future<int>>> ready)
+        {
+            int sum = 0;
+            for (auto& reply : ready.get())
+                sum += reply.get();
+
+            return sum;
+        });
+
+    pool.parallel_for(0, 100, [&calls](int index) { calls[index].set_value(index); }, 1);
+    EXPECT_EQ(total.get(), 4950);
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "custom/intrusive_ptr.h"   // unit to be tested
+
+
+// IMPORTANT
+// Prefix all suites and fixtures with "CustomIntrusivePtr_". Used in ctest run.
+
+
+struct _Message : custom::intrusive_ref_counter<_Message>
+{
+    static inline int destroyed = 0;
+
+    std::string text;
+
+    explicit _Message(std::string text) : text(custom::move(text)) { /*Empty*/ }
+    virtual ~_Message() { ++destroyed; }
+};
+
+struct _Tagged_Message : _Message
+{
+    int tag = 0;
+
+    _Tagged_Message(std::string text, int tag) : _Message(custom::move(text)), tag(tag) { /*Empty*/ }
+};
+
+struct _Local_Node : custom::intrusive_ref_counter<_Local_Node, custom::thread_unsafe_counter>
+{
+    custom::intrusive_ptr<_Local_Node> next;
+};
+
+
+TEST(CustomIntrusivePtr_Ownership, count_lives_in_the_object)
+{
+    static_assert(sizeof(custom::intrusive_ptr<_Message>) == sizeof(_Message*));
+
+    _Message::destroyed = 0;
+    {
+        custom::intrusive_ptr<_Message> first(new _Message("hello"));
+        EXPECT_EQ(first->use_count(), 1);
+
+        custom::intrusive_ptr<_Message> second = first;
+        EXPECT_EQ(first->use_count(), 2);
+        EXPECT_TRUE(first == second);
+
+        custom::intrusive_ptr<_Message> fromRaw(second.get());     // the count travels with the object
+        EXPECT_EQ(first->use_count(), 3);
+
+        custom::intrusive_ptr<_Message> moved = custom::move(second);
+        EXPECT_EQ(second, nullptr);
+        EXPECT_EQ(first->use_count(), 3);
+
+        _Message* raw = moved.detach();
+        EXPECT_EQ(first->use_count(), 3);
+        moved.reset(raw, false);                                    // adopt the detached reference
+        EXPECT_EQ(first->use_count(), 3);
+    }
+    EXPECT_EQ(_Message::destroyed, 1);
+
+    {
+        custom::intrusive_ptr<_Message> base = new _Tagged_Message("tagged", 5);
+        auto tagged = custom::dynamic_pointer_cast<_Tagged_Message>(base);
+        EXPECT_EQ(tagged->tag, 5);
+        EXPECT_EQ(base->use_count(), 2);
+
+        _Tagged_Message copy(*tagged);                              // a copy starts with no owners
+        EXPECT_EQ(copy.use_count(), 0);
+    }
+    EXPECT_EQ(_Message::destroyed, 3);
+}
+
+
+TEST(CustomIntrusivePtr_Ownership, unsafe_counter_chain)
+{
+    custom::intrusive_ptr<_Local_Node> head(new _Local_Node());
+    for (int i = 0; i < 100; ++i)
+    {
+        custom::intrusive_ptr<_Local_Node> node(new _Local_Node());
+        node->next  = head;
+        head        = node;
+    }
+
+    EXPECT_EQ(head->use_count(), 1);
+    EXPECT_EQ(head->next->use_count(), 1);
+    head.reset();
+}
+
+
+TEST(CustomIntrusivePtr_Ownership, safe_counter_across_threads)
+{
+    _Message::destroyed = 0;
+    custom::intrusive_ptr<_Message> shared(new _Message("shared"));
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([shared]()
+        {
+            for (int i = 0; i < 10000; ++i)
+            {
+                custom::intrusive_ptr<_Message> copy = shared;
+                ASSERT_EQ(copy->text, "shared");
+            }
+        });
+
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(shared->use_count(), 1);
+    shared.reset();
+    EXPECT_EQ(_Message::destroyed, 1);
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <string>
+
+#include "custom/local_shared_ptr.h"    // unit to be tested
+
+
+// IMPORTANT
+// Prefix all suites and fixtures with "CustomLocalSharedPtr_". Used in ctest run.
+
+
+struct _Base_Message
+{
+    static inline int destroyed = 0;
+
+    int id = 0;
+
+    virtual ~_Base_Message() { ++destroyed; }
+};
+
+struct _Derived_Message : _Base_Message
+{
+    std::string text;
+};
+
+
+TEST(CustomLocalSharedPtr_Ownership, counts_and_conversions)
+{
+    _Base_Message::destroyed = 0;
+
+    custom::local_weak_ptr<_Base_Message> weak;
+    {
+        custom::local_shared_ptr<_Derived_Message> derived = custom::make_local_shared<_Derived_Message>();
+        derived->text = "hello";
+
+        custom::local_shared_ptr<_Base_Message> base = derived;
+        custom::local_shared_ptr<std::string> alias(derived, &derived->text);
+        weak = base;
+
+        EXPECT_EQ(derived.use_count(), 3);
+        EXPECT_EQ(*alias, "hello");
+        EXPECT_EQ(weak.lock().get(), base.get());
+
+        custom::local_shared_ptr<_Base_Message> moved = custom::move(base);
+        EXPECT_FALSE(base);
+        EXPECT_EQ(moved.use_count(), 3);
+    }
+
+    EXPECT_TRUE(weak.expired());
+    EXPECT_FALSE(weak.lock());
+    EXPECT_EQ(_Base_Message::destroyed, 1);
+    EXPECT_THROW(custom::local_shared_ptr<_Base_Message>{weak}, std::runtime_error);
+}
+
+
+TEST(CustomLocalSharedPtr_Ownership, deleters_and_arrays)
+{
+    int deleted = 0;
+    {
+        custom::local_shared_ptr<int> ptr(new int(4), [&deleted](int* p) { ++deleted; delete p; });
+        custom::local_shared_ptr<int> copy = ptr;
+        ptr.reset();
+        EXPECT_EQ(deleted, 0);
+        EXPECT_TRUE(copy.unique());
+    }
+    EXPECT_EQ(deleted, 1);
+
+    custom::local_shared_ptr<int> fromUnique(custom::make_unique<int>(9));
+    EXPECT_EQ(*fromUnique, 9);
+
+    auto values = custom::make_local_shared<int[]>(4, 7);
+    EXPECT_EQ(values[3], 7);
+
+    custom::local_shared_ptr<long[]> raw(new long[3]{1, 2, 3});
+    EXPECT_EQ(raw[2], 3);
+
+    auto allocated = custom::allocate_local_shared<std::string>(custom::allocator<std::string>(), "text");
+    EXPECT_EQ(*allocated, "text");
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <string>
+#include <type_traits>
+
+#include "custom/map.h"     // unit to be tested
+
+
+// IMPORTANT
+// Prefix all suites and fixtures with "CustomMap_". Used in ctest run.
+
+
+struct _Version             // ordered by major, then minor
+{
+    int major;
+    int minor;
+};
+
+struct _Major               // lookup key, cannot be converted to _Version
+{
+    int value;
+};
+
+static_assert(!std::is_convertible_v<_Major, _Version>);
+
+bool operator<(const _Version& left, const _Version& right)
+{
+    return left.major != right.major ? left.major < right.major : left.minor < right.minor;
+}
+
+bool operator<(const _Version& left, const _Major& right) { return left.major < right.value; }
+bool operator<(const _Major& left, const _Version& right) { return left.value < right.major; }
+
+
+TEST(CustomMap_Heterogeneous, transparent_lookup)
+{
+    custom::map<_Version, std::string, custom::less<>> releases;
+    releases[{1, 0}] = "first";
+    releases[{2, 0}] = "second";
+    releases[{2, 1}] = "patch";
+    releases[{2, 5}] = "late patch";
+    releases[{4, 0}] = "fourth";
+
+    // _Major only compares the major number, so it is equivalent to a whole range
+    EXPECT_TRUE(releases.contains(_Major{2}));
+    EXPECT_FALSE(releases.contains(_Major{3}));
+    EXPECT_EQ(releases.count(_Major{2}), 3);
+    EXPECT_EQ(releases.count(_Major{0}), 0);
+
+    auto range = releases.equal_range(_Major{2});
+    EXPECT_EQ(custom::distance(range.first, range.second), 3);
+    EXPECT_EQ(range.first->second, "second");
+    EXPECT_EQ(range.second->second, "fourth");
+
+    auto found = releases.find(_Major{4});
+    ASSERT_NE(found, releases.end());
+    EXPECT_EQ(found->second, "fourth");
+    EXPECT_EQ(releases.find(_Major{3}), releases.end());
+    EXPECT_EQ(releases.find(_Major{5}), releases.end());
+
+    EXPECT_EQ(releases.lower_bound(_Major{3})->second, "fourth");
+    EXPECT_EQ(releases.upper_bound(_Major{1})->second, "second");
+    EXPECT_EQ(releases.lower_bound(_Major{9}), releases.end());
+
+    const auto& constReleases = releases;
+    EXPECT_EQ(constReleases.find(_Major{1})->second, "first");
+    EXPECT_EQ(constReleases.lower_bound(_Major{2})->first.minor, 0);
+
+    // full keys still work with the transparent comparator
+    EXPECT_EQ(releases.find(_Version{2, 1})->second, "patch");
+    EXPECT_EQ(releases.count(_Version{2, 2}), 0);
+}
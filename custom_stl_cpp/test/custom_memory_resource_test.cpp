@@ -0,0 +1,263 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "custom/memory_resource.h"     // unit to be tested
+
+
+// IMPORTANT
+// Prefix all suites and fixtures with "CustomMemoryResource_". Used in ctest run.
+
+
+// Upstream that counts what is outstanding
+class _Counting_Resource : public custom::pmr::memory_resource
+{
+public:
+    size_t allocations  = 0;
+    size_t outstanding  = 0;    // bytes
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        ++allocations;
+        outstanding += bytes;
+        return custom::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override
+    {
+        outstanding -= bytes;
+        custom::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const custom::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+
+static bool _is_aligned(const void* ptr, size_t alignment)
+{
+    return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+}
+
+
+TEST(CustomMemoryResource_Monotonic, uses_initial_buffer_then_grows)
+{
+    alignas(64) unsigned char buffer[256];
+    _Counting_Resource upstream;
+
+    {
+        custom::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), &upstream);
+
+        void* first     = arena.allocate(10, 1);
+        void* second    = arena.allocate(32, 32);
+        EXPECT_EQ(first, buffer);
+        EXPECT_TRUE(_is_aligned(second, 32));
+        EXPECT_EQ(upstream.allocations, 0u);
+
+        for (int i = 0; i < 100; ++i)
+            EXPECT_TRUE(_is_aligned(arena.allocate(24, 8), 8));
+
+        EXPECT_GT(upstream.allocations, 0u);
+        EXPECT_LT(upstream.allocations, 5u);    // buffers grow geometrically
+
+        arena.release();
+        EXPECT_EQ(upstream.outstanding, 0u);
+        EXPECT_EQ(arena.allocate(10, 1), buffer);
+    }
+
+    EXPECT_EQ(upstream.outstanding, 0u);
+}
+
+
+TEST(CustomMemoryResource_Pool, reuses_blocks_and_releases_everything)
+{
+    _Counting_Resource upstream;
+    custom::pmr::pool_options options;
+    options.largest_required_pool_block = 256;
+
+    {
+        custom::pmr::unsynchronized_pool_resource pool(options, &upstream);
+        EXPECT_EQ(pool.options().largest_required_pool_block, 256u);
+
+        void* block = pool.allocate(40, 8);
+        pool.deallocate(block, 40, 8);
+        EXPECT_EQ(pool.allocate(64, 8), block);     // same size class, reused
+
+        const size_t allocations = upstream.allocations;
+        std::vector<void*> blocks;
+        for (int i = 0; i < 1000; ++i)
+        {
+            blocks.push_back(pool.allocate(16, 16));
+            EXPECT_TRUE(_is_aligned(blocks.back(), 16));
+        }
+
+        EXPECT_LT(upstream.allocations - allocations, 10u);     // chunks, not blocks
+
+        for (void* ptr : blocks)
+            pool.deallocate(ptr, 16, 16);
+
+        void* large = pool.allocate(1000, 64);      // above the largest pool, served by upstream
+        EXPECT_TRUE(_is_aligned(large, 64));
+        (void)pool.allocate(5000, 8);               // never deallocated, freed by release
+
+        pool.deallocate(large, 1000, 64);
+        pool.release();
+        EXPECT_EQ(upstream.outstanding, 0u);
+    }
+
+    EXPECT_EQ(upstream.outstanding, 0u);
+}
+
+
+TEST(CustomMemoryResource_Pool, synchronized_pool_from_threads)
+{
+    _Counting_Resource upstream;
+
+    {
+        custom::pmr::synchronized_pool_resource pool(&upstream);
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < 4; ++t)
+            threads.emplace_back([&pool, t]()
+            {
+                custom::pmr::vector<int> values(&pool);
+                for (int i = 0; i < 10000; ++i)
+                    values.push_back(i * t);
+
+                for (int i = 0; i < 10000; ++i)
+                    ASSERT_EQ(values[i], i * t);
+            });
+
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    EXPECT_EQ(upstream.outstanding, 0u);
+}
+
+
+TEST(CustomMemoryResource_Containers, allocate_from_the_resource)
+{
+    alignas(16) unsigned char buffer[64 * 1024];
+    custom::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), custom::pmr::null_memory_resource());
+
+    custom::pmr::vector<int> values(&arena);
+    custom::pmr::list<int> items(&arena);
+    custom::pmr::map<int, int> ordered(&arena);
+    custom::pmr::unordered_map<int, int> hashed(&arena);
+
+    for (int i = 0; i < 200; ++i)
+    {
+        values.push_back(i);
+        items.push_back(i);
+        ordered[i] = i;
+        hashed[i] = i;
+    }
+
+    EXPECT_EQ(values.get_allocator().resource(), &arena);
+    EXPECT_EQ(items.get_allocator().resource(), &arena);
+    EXPECT_EQ(ordered.get_allocator().resource(), &arena);
+    EXPECT_EQ(hashed.get_allocator().resource(), &arena);
+
+    EXPECT_EQ(values.size(), 200u);
+    EXPECT_EQ(items.back(), 199);
+    EXPECT_EQ(ordered.at(150), 150);
+    EXPECT_EQ(hashed.at(42), 42);
+
+    custom::pmr::vector<custom::pmr::vector<int>> nested(&arena);    // inner vectors get the same resource
+    nested.emplace_back();
+    nested.back().push_back(7);
+    EXPECT_EQ(nested.back().get_allocator().resource(), &arena);
+}
+
+
+TEST(CustomMemoryResource_Containers, move_between_resources)
+{
+    _Counting_Resource first, second;
+
+    custom::pmr::vector<int> source(&first);
+    custom::pmr::unordered_map<int, int> sourceMap(&first);
+    for (int i = 0; i < 100; ++i)
+    {
+        source.push_back(i);
+        sourceMap[i] = i;
+    }
+
+    custom::pmr::vector<int> sameResource(custom::move(source), &first);    // memory is stolen
+    EXPECT_EQ(sameResource.size(), 100u);
+
+    custom::pmr::vector<int> target(&second);
+    target = custom::move(sameResource);                                    // elements are moved
+    EXPECT_EQ(target.get_allocator().resource(), &second);
+    EXPECT_EQ(target.size(), 100u);
+    EXPECT_EQ(target[99], 99);
+
+    custom::pmr::unordered_map<int, int> targetMap(&second);
+    targetMap = custom::move(sourceMap);
+    EXPECT_EQ(targetMap.size(), 100u);
+    EXPECT_TRUE(sourceMap.empty());
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(targetMap.at(i), i);
+
+    custom::pmr::map<int, int> ordered(&first);
+    ordered[1] = 1;
+    custom::pmr::map<int, int> copy(ordered, &second);
+    EXPECT_EQ(copy.get_allocator().resource(), &second);
+    EXPECT_EQ(copy.at(1), 1);
+}
+
+
+TEST(CustomMemoryResource_Containers, move_assign_between_arenas)
+{
+    // different resources do not propagate, the move allocates and may throw
+    static_assert(!std::is_nothrow_move_assignable_v<custom::pmr::unordered_map<int, int>>);
+    static_assert(std::is_nothrow_move_assignable_v<custom::unordered_map<int, int>>);
+
+    custom::pmr::monotonic_buffer_resource firstArena;
+    custom::pmr::monotonic_buffer_resource secondArena;
+
+    custom::pmr::unordered_map<int, int> source(&firstArena);
+    for (int i = 0; i < 50; ++i)
+        source[i] = 2 * i;
+
+    custom::pmr::unordered_map<int, int> target(&secondArena);
+    target[-1] = -1;
+
+    target = custom::move(source);                  // nodes and buckets come from secondArena
+    EXPECT_EQ(target.get_allocator().resource(), &secondArena);
+    EXPECT_EQ(target.size(), 50u);
+    EXPECT_FALSE(target.contains(-1));
+
+    for (int i = 0; i < 50; ++i)
+        EXPECT_EQ(target.at(i), 2 * i);
+
+    target[50] = 100;                               // still usable after the move
+    EXPECT_EQ(target.size(), 51u);
+}
+
+
+TEST(CustomMemoryResource_Default, set_and_get_default_resource)
+{
+    _Counting_Resource counting;
+
+    custom::pmr::memory_resource* previous = custom::pmr::set_default_resource(&counting);
+    EXPECT_EQ(previous, custom::pmr::new_delete_resource());
+
+    {
+        custom::pmr::vector<int> values;
+        values.push_back(1);
+        EXPECT_EQ(values.get_allocator().resource(), &counting);
+        EXPECT_GT(counting.allocations, 0u);
+    }
+
+    EXPECT_EQ(counting.outstanding, 0u);
+    EXPECT_EQ(custom::pmr::set_default_resource(nullptr), &counting);
+    EXPECT_EQ(custom::pmr::get_default_resource(), custom::pmr::new_delete_resource());
+}
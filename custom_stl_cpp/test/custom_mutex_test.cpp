@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <vector>
+
+#include "custom/condition_variable.h"
+#include "custom/counting_semaphore.h"
+#include "custom/mutex.h"       // unit to be tested
+
+
+// IMPORTANT
+// Prefix all suites and fixtures with "CustomMutex_". Used in ctest run.
+
+
+TEST(CustomMutex_Mutex, exclusion_under_contention)
+{
+#if defined __linux__
+    static_assert(sizeof(custom::mutex) == 4);
+#endif
+
+    custom::mutex mutex;
+    long counter = 0;
+    std::vector<custom::thread> threads;
+
+    for (int t = 0; t < 8; ++t)
+        threads.emplace_back([&mutex, &counter]()
+        {
+            for (int i = 0; i < 20000; ++i)
+            {
+                custom::lock_guard<custom::mutex> lock(mutex);
+                ++counter;
+            }
+        });
+
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(counter, 8 * 20000);
+
+    EXPECT_TRUE(mutex.try_lock());
+    EXPECT_FALSE(mutex.try_lock());
+    mutex.unlock();
+}
+
+
+TEST(CustomMutex_Mutex, recursive_depth)
+{
+    custom::recursive_mutex mutex;
+    mutex.lock();
+    mutex.lock();
+    EXPECT_TRUE(mutex.try_lock());
+
+    std::atomic<bool> otherGot = true;
+    custom::thread other([&mutex, &otherGot]() { otherGot = mutex.try_lock(); });
+    other.join();
+    EXPECT_FALSE(otherGot.load());
+
+    mutex.unlock();
+    mutex.unlock();
+    mutex.unlock();
+
+    custom::thread after([&mutex, &otherGot]()
+    {
+        otherGot = mutex.try_lock();
+        if (otherGot)
+            mutex.unlock();
+    });
+    after.join();
+    EXPECT_TRUE(otherGot.load());
+}
+
+
+TEST(CustomMutex_ConditionVariable, notify_one_and_all)
+{
+    custom::mutex mutex;
+    custom::condition_variable cv;
+    int ready   = 0;
+    int woken   = 0;
+    std::vector<custom::thread> waiters;
+
+    for (int t = 0; t < 6; ++t)
+        waiters.emplace_back([&]()
+        {
+            custom::unique_lock<custom::mutex> lock(mutex);
+            cv.wait(lock, [&ready]() { return ready > 0; });
+            --ready;
+            ++woken;
+        });
+
+    {
+        custom::lock_guard<custom::mutex> lock(mutex);
+        ready = 1;
+    }
+    cv.notify_one();
+
+    for (;;)    // exactly one waiter may pass
+    {
+        custom::lock_guard<custom::mutex> lock(mutex);
+        if (woken == 1)
+            break;
+    }
+
+    {
+        custom::lock_guard<custom::mutex> lock(mutex);
+        ready = 5;
+    }
+    cv.notify_all();    // the rest go through the requeue path
+
+    for (auto& waiter : waiters)
+        waiter.join();
+
+    EXPECT_EQ(woken, 6);
+    EXPECT_EQ(ready, 0);
+}
+
+
+TEST(CustomMutex_ConditionVariable, ping_pong_and_timeouts)
+{
+    custom::mutex mutex;
+    custom::condition_variable cv;
+    int turn = 0;
+
+    custom::thread other([&]()
+    {
+        for (int round = 0; round < 1000; ++round)
+        {
+            custom::unique_lock<custom::mutex> lock(mutex);
+            cv.wait(lock, [&turn]() { return turn == 1; });
+            turn = 0;
+            cv.notify_all();
+        }
+    });
+
+    for (int round = 0; round < 1000; ++round)
+    {
+        custom::unique_lock<custom::mutex> lock(mutex);
+        turn = 1;
+        cv.notify_one();
+        cv.wait(lock, [&turn]() { return turn == 0; });
+    }
+    other.join();
+
+    custom::unique_lock<custom::mutex> lock(mutex);
+    EXPECT_EQ(cv.wait_for(lock, custom::chrono::milliseconds(5)), custom::cv_status::timeout);
+    EXPECT_FALSE(cv.wait_for(lock, custom::chrono::milliseconds(1), []() { return false; }));
+    EXPECT_TRUE(lock.owns_lock());
+}
+
+
+TEST(CustomMutex_ConditionVariable, destroyed_right_after_notify_all)
+{
+    for (int round = 0; round < 50; ++round)
+    {
+        custom::mutex mutex;
+        auto* cv    = new custom::condition_variable;
+        bool done   = false;
+        int ready   = 0;
+        std::vector<custom::thread> waiters;
+
+        for (int t = 0; t < 4; ++t)
+            waiters.emplace_back([&]()
+            {
+                custom::unique_lock<custom::mutex> lock(mutex);
+                ++ready;
+                while (!done)
+                    cv->wait(lock);
+            });
+
+        for (;;)    // every waiter is registered on the cv
+        {
+            custom::lock_guard<custom::mutex> lock(mutex);
+            if (ready == 4)
+                break;
+        }
+
+        {
+            custom::lock_guard<custom::mutex> lock(mutex);
+            done = true;
+            cv->notify_all();
+            delete cv;      // allowed: all waiters are notified, they only block on the mutex now
+        }
+
+        for (auto& waiter : waiters)
+            waiter.join();
+    }
+}
+
+
+TEST(CustomMutex_TimedMutex, try_lock_for)
+{
+    custom::timed_mutex mutex;
+    mutex.lock();
+
+    std::atomic<bool> got = true;
+    custom::thread other([&mutex, &got]() { got = mutex.try_lock_for(custom::chrono::milliseconds(5)); });
+    other.join();
+    EXPECT_FALSE(got.load());
+
+    mutex.unlock();
+    EXPECT_TRUE(mutex.try_lock_for(custom::chrono::milliseconds(5)));
+    mutex.unlock();
+}
+
+
+TEST(CustomMutex_Semaphore, release_many_at_once)
+{
+    custom::counting_semaphore<> slots(0);
+    std::atomic<int> passed = 0;
+    std::vector<custom::thread> threads;
+
+    for (int t = 0; t < 8; ++t)
+        threads.emplace_back([&slots, &passed]()
+        {
+            slots.acquire();
+            ++passed;
+        });
+
+    slots.release(5);
+    while (passed.load() < 5)
+        custom::this_thread::yield();
+
+    EXPECT_FALSE(slots.try_acquire());
+    slots.release(3);
+
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(passed.load(), 8);
+    EXPECT_FALSE(slots.try_acquire_for(custom::chrono::milliseconds(2)));
+
+    custom::binary_semaphore signal(1);
+    EXPECT_TRUE(signal.try_acquire());
+    EXPECT_FALSE(signal.try_acquire());
+    signal.release();
+    EXPECT_TRUE(signal.try_acquire_for(custom::chrono::milliseconds(1)));
+}
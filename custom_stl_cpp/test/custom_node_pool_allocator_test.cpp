@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <set>
+#include <string>
+
+#include "custom/list.h"
+#include "custom/forward_list.h"
+#include "custom/map.h"
+#include "custom/unordered_map.h"
+#include "custom/node_pool_allocator.h"     // unit to be tested
+
+
+// IMPORTANT
+// Prefix all suites and fixtures with "CustomNodePool_". Used in ctest run.
+
+
+template<class Type>
+using _Pool_Alloc = custom::node_pool_allocator<Type>;
+
+
+TEST(CustomNodePool_Containers, behave_like_default_allocator)
+{
+    custom::list<std::string, _Pool_Alloc<std::string>> items;
+    custom::forward_list<int, _Pool_Alloc<int>> singly;
+    custom::map<int, std::string, custom::less<int>, _Pool_Alloc<custom::pair<int, std::string>>> ordered;
+    custom::unordered_map<int, int, custom::hash<int>, custom::equal_to<int>, _Pool_Alloc<custom::pair<int, int>>> hashed;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        items.push_back(std::to_string(i));
+        singly.push_front(i);
+        ordered[i] = std::to_string(i);
+        hashed[i] = i;
+    }
+
+    for (int i = 0; i < 1000; i += 2)
+    {
+        items.pop_front();
+        singly.pop_front();
+        ordered.erase(i);
+        hashed.erase(i);
+    }
+
+    EXPECT_EQ(items.size(), 500u);
+    EXPECT_EQ(items.front(), "500");
+    EXPECT_EQ(singly.front(), 499);
+    EXPECT_EQ(ordered.size(), 500u);
+    EXPECT_EQ(ordered.at(999), "999");
+    EXPECT_EQ(hashed.size(), 500u);
+    EXPECT_EQ(hashed.at(1), 1);
+    EXPECT_FALSE(hashed.contains(2));
+}
+
+
+TEST(CustomNodePool_Allocator, freed_nodes_are_reused)
+{
+    custom::list<int, _Pool_Alloc<int>> items;
+    std::set<const int*> addresses;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        items.push_back(i);
+        addresses.insert(&items.back());
+    }
+
+    items.clear();
+
+    for (int i = 0; i < 100; ++i)
+    {
+        items.push_back(i);
+        EXPECT_TRUE(addresses.count(&items.back()) == 1);
+    }
+}
+
+
+TEST(CustomNodePool_Allocator, copies_share_the_pool)
+{
+    _Pool_Alloc<int> alloc;
+    custom::list<int, _Pool_Alloc<int>> first(alloc);
+    custom::list<int, _Pool_Alloc<int>> second(alloc);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        first.push_back(i);
+        second.push_back(10 + i);
+    }
+
+    EXPECT_TRUE(first.get_allocator() == second.get_allocator());
+
+    first.splice(first.end(), second);      // same pool, nodes change owner
+    EXPECT_EQ(first.size(), 20u);
+    EXPECT_TRUE(second.empty());
+
+    custom::list<int, _Pool_Alloc<int>> copy(first);
+    EXPECT_TRUE(copy.get_allocator() != first.get_allocator());     // a copy owns a fresh pool
+    EXPECT_EQ(copy.back(), 19);
+}
+
+
+TEST(CustomNodePool_Allocator, move_assignment_takes_the_pool)
+{
+    using _Map = custom::map<int, int, custom::less<int>, _Pool_Alloc<custom::pair<int, int>>>;
+
+    _Map target;
+    target[-1] = -1;
+
+    {
+        _Map source;
+        for (int i = 0; i < 100; ++i)
+            source[i] = i;
+
+        target = custom::move(source);
+    }   // source destroyed, its nodes live on in target
+
+    EXPECT_EQ(target.size(), 100u);
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(target.at(i), i);
+}
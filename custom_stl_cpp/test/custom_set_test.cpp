@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <string>
+#include <type_traits>
+
+#include "custom/set.h"     // unit to be tested
+
+
+// IMPORTANT
+// Prefix all suites and fixtures with "CustomSet_". Used in ctest run.
+
+
+struct _Employee            // ordered by id only
+{
+    int id;
+    std::string name;
+};
+
+struct _Employee_Id         // lookup key, cannot be converted to _Employee
+{
+    int value;
+};
+
+static_assert(!std::is_convertible_v<_Employee_Id, _Employee>);
+
+bool operator<(const _Employee& left, const _Employee& right) { return left.id < right.id; }
+bool operator<(const _Employee& left, const _Employee_Id& right) { return left.id < right.value; }
+bool operator<(const _Employee_Id& left, const _Employee& right) { return left.value < right.id; }
+
+
+TEST(CustomSet_Heterogeneous, transparent_lookup)
+{
+    custom::set<_Employee, custom::less<>> staff;
+    staff.emplace(_Employee{7, "Ada"});
+    staff.emplace(_Employee{3, "Grace"});
+    staff.emplace(_Employee{11, "Linus"});
+
+    auto found = staff.find(_Employee_Id{3});
+    ASSERT_NE(found, staff.end());
+    EXPECT_EQ(found->name, "Grace");
+    EXPECT_EQ(staff.find(_Employee_Id{5}), staff.end());
+    EXPECT_EQ(staff.find(_Employee_Id{12}), staff.end());
+
+    EXPECT_TRUE(staff.contains(_Employee_Id{11}));
+    EXPECT_FALSE(staff.contains(_Employee_Id{1}));
+    EXPECT_EQ(staff.count(_Employee_Id{7}), 1);
+    EXPECT_EQ(staff.count(_Employee_Id{8}), 0);
+
+    EXPECT_EQ(staff.lower_bound(_Employee_Id{4})->name, "Ada");
+    EXPECT_EQ(staff.lower_bound(_Employee_Id{7})->name, "Ada");
+    EXPECT_EQ(staff.upper_bound(_Employee_Id{7})->name, "Linus");
+    EXPECT_EQ(staff.lower_bound(_Employee_Id{20}), staff.end());
+
+    auto hit = staff.equal_range(_Employee_Id{7});
+    EXPECT_EQ(custom::distance(hit.first, hit.second), 1);
+    EXPECT_EQ(hit.first->name, "Ada");
+
+    auto miss = staff.equal_range(_Employee_Id{8});
+    EXPECT_EQ(miss.first, miss.second);
+    EXPECT_EQ(miss.first->name, "Linus");
+
+    const auto& constStaff = staff;
+    EXPECT_EQ(constStaff.find(_Employee_Id{11})->name, "Linus");
+    EXPECT_EQ(constStaff.count(_Employee_Id{3}), 1);
+}
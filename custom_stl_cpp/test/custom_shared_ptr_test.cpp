@@ -0,0 +1,279 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "custom/memory.h"      // unit to be tested
+
+
+// IMPORTANT
+// Prefix all suites and fixtures with "CustomSharedPtr_". Used in ctest run.
+
+
+struct _Alloc_Stats
+{
+    int allocations     = 0;
+    int deallocations   = 0;
+};
+
+template<class Type>
+struct _Counting_Alloc
+{
+    using value_type = Type;
+
+    _Alloc_Stats* stats;
+
+    explicit _Counting_Alloc(_Alloc_Stats* stats) noexcept
+        : stats(stats) { /*Empty*/ }
+
+    template<class Other>
+    _Counting_Alloc(const _Counting_Alloc<Other>& other) noexcept
+        : stats(other.stats) { /*Empty*/ }
+
+    Type* allocate(size_t count)
+    {
+        ++stats->allocations;
+        return static_cast<Type*>(::operator new(count * sizeof(Type)));
+    }
+
+    void deallocate(Type* ptr, size_t count)
+    {
+        ++stats->deallocations;
+        ::operator delete(ptr, count * sizeof(Type));
+    }
+};
+
+// Records construction and destruction order
+struct _Tracked
+{
+    static inline std::vector<int> destroyed;
+    static inline int alive         = 0;
+    static inline int throwAfter    = -1;   // constructions left before one throws, -1 never
+
+    int id;
+
+    _Tracked() : _Tracked(alive) { /*Empty*/ }
+
+    explicit _Tracked(int id)
+        : id(id)
+    {
+        if (throwAfter == 0)
+            throw std::runtime_error("construction failed");
+
+        if (throwAfter > 0)
+            --throwAfter;
+
+        ++alive;
+    }
+
+    _Tracked(const _Tracked& other) : _Tracked(other.id) { /*Empty*/ }
+
+    ~_Tracked()
+    {
+        --alive;
+        destroyed.push_back(id);
+    }
+};
+
+struct _Self_Aware : custom::enable_shared_from_this<_Self_Aware>
+{
+    int value = 0;
+
+    explicit _Self_Aware(int value) : value(value) { /*Empty*/ }
+};
+
+
+TEST(CustomSharedPtr_MakeShared, object_lives_in_control_block)
+{
+    _Tracked::destroyed.clear();
+
+    custom::weak_ptr<_Tracked> weak;
+    {
+        custom::shared_ptr<_Tracked> ptr = custom::make_shared<_Tracked>(7);
+        custom::shared_ptr<_Tracked> copy = ptr;
+        weak = ptr;
+
+        EXPECT_EQ(ptr->id, 7);
+        EXPECT_EQ(ptr.use_count(), 2);
+        EXPECT_EQ(custom::get_deleter<custom::default_delete<_Tracked>>(ptr), nullptr);
+    }
+
+    EXPECT_TRUE(weak.expired());        // object destroyed, control block kept by weak
+    EXPECT_THAT(_Tracked::destroyed, testing::ElementsAre(7));
+
+    auto self = custom::make_shared<const _Self_Aware>(3);
+    EXPECT_EQ(self->shared_from_this().get(), self.get());
+    EXPECT_EQ(self.use_count(), 1);
+
+    auto raw = custom::make_shared_for_overwrite<int>();
+    *raw = 5;
+    EXPECT_EQ(*raw, 5);
+}
+
+
+TEST(CustomSharedPtr_MakeShared, arrays)
+{
+    auto zeros = custom::make_shared<int[]>(5);
+    for (int i = 0; i < 5; ++i)
+        EXPECT_EQ(zeros[i], 0);
+
+    auto words = custom::make_shared<std::string[3]>("word");
+    EXPECT_EQ(words[0], "word");
+    EXPECT_EQ(words[2], "word");
+
+    auto rows = custom::make_shared<int[][2]>(3, {1, 2});
+    EXPECT_EQ(rows[0][0], 1);
+    EXPECT_EQ(rows[2][1], 2);
+
+    struct _Wide { alignas(64) char bytes[64]; };
+    auto wide = custom::make_shared<_Wide[]>(4);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(wide.get()) % 64, 0u);
+
+    auto buffer = custom::make_shared_for_overwrite<char[]>(100);
+    buffer[99] = 'x';
+    EXPECT_EQ(buffer[99], 'x');
+
+    _Tracked::destroyed.clear();
+    {
+        auto tracked = custom::make_shared<_Tracked[3]>(_Tracked(9));
+        EXPECT_EQ(tracked[1].id, 9);
+    }
+    EXPECT_EQ(_Tracked::destroyed.size(), 4u);      // temporary and 3 elements
+}
+
+
+TEST(CustomSharedPtr_MakeShared, failed_element_construction_cleans_up)
+{
+    _Tracked::destroyed.clear();
+    _Tracked::alive         = 0;
+    _Tracked::throwAfter    = 3;
+
+    EXPECT_THROW((void)custom::make_shared<_Tracked[]>(5), std::runtime_error);
+    EXPECT_EQ(_Tracked::alive, 0);
+    EXPECT_THAT(_Tracked::destroyed, testing::ElementsAre(2, 1, 0));     // reverse order
+
+    _Tracked::throwAfter = 0;
+    EXPECT_THROW((void)custom::make_shared<_Tracked>(1), std::runtime_error);
+    _Tracked::throwAfter = -1;
+}
+
+
+TEST(CustomSharedPtr_AllocateShared, single_allocation_through_allocator)
+{
+    _Alloc_Stats stats;
+    _Counting_Alloc<int> alloc(&stats);
+
+    custom::weak_ptr<std::string> weak;
+    {
+        auto ptr = custom::allocate_shared<std::string>(alloc, 20, 'a');
+        weak = ptr;
+
+        EXPECT_EQ(*ptr, std::string(20, 'a'));
+        EXPECT_EQ(stats.allocations, 1);
+    }
+
+    EXPECT_TRUE(weak.expired());
+    EXPECT_EQ(stats.deallocations, 0);      // the weak_ptr keeps the block
+
+    weak.reset();
+    EXPECT_EQ(stats.deallocations, 1);
+
+    auto self = custom::allocate_shared<_Self_Aware>(alloc, 4);
+    EXPECT_EQ(self->weak_from_this().lock().get(), self.get());
+
+    auto raw = custom::allocate_shared_for_overwrite<long>(alloc);
+    *raw = 1;
+    EXPECT_EQ(stats.allocations, 3);
+}
+
+
+struct _Config
+{
+    static inline std::atomic<int> alive = 0;
+
+    int version;
+    int checksum;     // always -version
+
+    explicit _Config(int version) : version(version), checksum(-version) { ++alive; }
+    ~_Config() { --alive; }
+};
+
+
+TEST(CustomSharedPtr_Atomic, load_store_exchange_compare)
+{
+    custom::atomic<custom::shared_ptr<int>> value;
+    EXPECT_FALSE(value.load());
+
+    auto first = custom::make_shared<int>(1);
+    value.store(first);
+    EXPECT_EQ(value.load().get(), first.get());
+    EXPECT_EQ(first.use_count(), 2);
+
+    auto old = value.exchange(custom::make_shared<int>(2));
+    EXPECT_EQ(old.get(), first.get());
+    EXPECT_EQ(first.use_count(), 2);    // first and old, the atomic let go
+
+    custom::shared_ptr<int> expected = first;
+    EXPECT_FALSE(value.compare_exchange_strong(expected, custom::make_shared<int>(3)));
+    EXPECT_EQ(*expected, 2);            // updated to the current value
+
+    EXPECT_TRUE(value.compare_exchange_strong(expected, first));
+    EXPECT_EQ(*value.load(), 1);
+
+    custom::shared_ptr<int> alias(first, first.get());
+    expected = custom::make_shared<int>(1);     // same value, other owner
+    EXPECT_FALSE(value.compare_exchange_weak(expected, nullptr));
+    EXPECT_TRUE(value.compare_exchange_weak(alias, nullptr));
+    EXPECT_FALSE(value.load());
+    EXPECT_EQ(first.use_count(), 4);    // first, old, alias and expected from the failed exchange
+}
+
+
+TEST(CustomSharedPtr_Atomic, readers_see_whole_snapshots)
+{
+    {
+        custom::atomic<custom::shared_ptr<_Config>> config(custom::make_shared<_Config>(0));
+        std::atomic<bool> done = false;
+        std::vector<std::thread> readers;
+
+        for (int t = 0; t < 4; ++t)
+            readers.emplace_back([&config, &done]()
+            {
+                int last = 0;
+                while (!done.load())
+                {
+                    custom::shared_ptr<_Config> snapshot = config.load();
+                    ASSERT_EQ(snapshot->checksum, -snapshot->version);
+                    ASSERT_GE(snapshot->version, last);     // a single writer only moves forward
+                    last = snapshot->version;
+                }
+            });
+
+        for (int version = 1; version <= 2000; ++version)
+        {
+            if (version % 2 == 0)
+                config.store(custom::make_shared<_Config>(version));
+            else
+            {
+                custom::shared_ptr<_Config> expected = config.load();
+                while (!config.compare_exchange_weak(expected, custom::make_shared<_Config>(version)))
+                    { /*Empty*/ }
+            }
+
+            if (version % 100 == 0)
+                std::this_thread::yield();
+        }
+
+        done = true;
+        for (auto& reader : readers)
+            reader.join();
+
+        EXPECT_EQ(config.load()->version, 2000);
+    }
+
+    EXPECT_EQ(_Config::alive.load(), 0);    // every replaced snapshot was freed
+}
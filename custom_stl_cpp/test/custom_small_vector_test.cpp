@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "custom/string.h"
+#include "custom/small_vector.h"    // unit to be tested
+
+
+// IMPORTANT
+// Prefix all suites and fixtures with "CustomSmallVector_". Used in ctest run.
+
+
+template<class Type>
+struct _Counting_Alloc
+{
+    using value_type = Type;
+
+    static inline int allocations = 0;
+
+    _Counting_Alloc() noexcept = default;
+
+    template<class Other>
+    _Counting_Alloc(const _Counting_Alloc<Other>&) noexcept { /*Empty*/ }
+
+    Type* allocate(size_t count)
+    {
+        ++allocations;
+        return static_cast<Type*>(::operator new(count * sizeof(Type)));
+    }
+
+    void deallocate(Type* ptr, size_t count)
+    {
+        ::operator delete(ptr, count * sizeof(Type));
+    }
+
+    bool operator==(const _Counting_Alloc&) const noexcept { return true; }
+};
+
+
+TEST(CustomSmallVector_Storage, inline_until_spill)
+{
+    using _Small = custom::small_vector<int, 4, _Counting_Alloc<int>>;
+
+    _Counting_Alloc<int>::allocations = 0;
+
+    _Small values = {1, 2, 3};
+    EXPECT_EQ(values.capacity(), 4);
+    values.push_back(4);
+    EXPECT_EQ(_Counting_Alloc<int>::allocations, 0);
+
+    values.push_back(5);                    // spills
+    EXPECT_EQ(_Counting_Alloc<int>::allocations, 1);
+    EXPECT_GT(values.capacity(), 4);
+    EXPECT_THAT(values, testing::ElementsAre(1, 2, 3, 4, 5));
+
+    values.pop_back();
+    values.pop_back();
+    values.shrink_to_fit();                 // back inline
+    EXPECT_EQ(values.capacity(), 4);
+    EXPECT_THAT(values, testing::ElementsAre(1, 2, 3));
+
+    values.reserve(2);                      // like vector, reserve below size drops elements
+    EXPECT_THAT(values, testing::ElementsAre(1, 2));
+    EXPECT_EQ(_Counting_Alloc<int>::allocations, 1);
+}
+
+
+TEST(CustomSmallVector_Storage, copy_and_move)
+{
+    custom::small_vector<custom::string, 2> small = {"a", "b"};
+    custom::small_vector<custom::string, 2> large = {"a", "b", "c"};
+
+    auto smallCopy = small;
+    auto largeCopy = large;
+    EXPECT_TRUE(smallCopy == small);
+    EXPECT_TRUE(largeCopy == large);
+
+    const custom::string* largeData = large.data();
+    auto largeMoved = custom::move(large);
+    EXPECT_EQ(largeMoved.data(), largeData);   // heap buffer changed owner
+    EXPECT_TRUE(large.empty());
+    EXPECT_EQ(large.capacity(), 2);
+
+    auto smallMoved = custom::move(small);      // inline elements are moved one by one
+    EXPECT_TRUE(smallMoved == smallCopy);
+    EXPECT_TRUE(small.empty());
+
+    smallMoved = largeMoved;
+    EXPECT_TRUE(smallMoved == largeCopy);
+    largeMoved = custom::move(smallCopy);
+    EXPECT_THAT(largeMoved, testing::ElementsAre("a", "b"));
+}
+
+
+TEST(CustomSmallVector_Operations, vector_api)
+{
+    custom::small_vector<int, 8> values(3, 7);
+    EXPECT_THAT(values, testing::ElementsAre(7, 7, 7));
+
+    values.insert(values.begin(), 1);
+    values.emplace(values.begin() + 2, 2);
+    values.erase(values.end() - 1);
+    EXPECT_THAT(values, testing::ElementsAre(1, 7, 2, 7));
+
+    int batch[] = {10, 11, 12, 13, 14, 15};
+    values.append_range(batch);
+    values.insert_range(values.begin() + 1, batch);
+    EXPECT_EQ(values.size(), 16);
+    EXPECT_EQ(values[1], 10);
+    EXPECT_EQ(values.back(), 15);
+
+    values.assign_range(custom::vector<int>({4, 5}));
+    EXPECT_THAT(values, testing::ElementsAre(4, 5));
+
+    values.resize(5);
+    values.resize_for_overwrite(6);
+    values[5] = 9;
+    EXPECT_EQ(values.at(5), 9);
+    EXPECT_EQ(values[4], 0);
+    EXPECT_THROW(values.at(6), std::out_of_range);
+
+    custom::small_vector<int, 8>::const_iterator it = values.begin();
+    EXPECT_EQ(*(it + 1), 5);
+    EXPECT_EQ(*values.rbegin(), 9);
+
+    values.clear();
+    EXPECT_TRUE(values.empty());
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "custom/string.h"
+#include "custom/sorted_index.h"    // unit to be tested
+
+
+// IMPORTANT
+// Prefix all suites and fixtures with "CustomSortedIndex_". Used in ctest run.
+
+
+TEST(CustomSortedIndex_Init, iterates_in_sorted_order)
+{
+    custom::sorted_index<int> index = {5, 3, 9, 1, 7, 3};
+    const int expected[] = {1, 3, 3, 5, 7, 9};
+
+    ASSERT_EQ(index.size(), 6);
+
+    size_t position = 0;
+    for (int value : index)
+        EXPECT_EQ(value, expected[position++]);
+
+    auto it = index.end();
+    for (size_t i = 6; i > 0; --i)
+        EXPECT_EQ(*--it, expected[i - 1]);
+
+    EXPECT_EQ(it, index.begin());
+}
+
+
+TEST(CustomSortedIndex_Init, empty_index)
+{
+    custom::sorted_index<int> index;
+
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.begin(), index.end());
+    EXPECT_EQ(index.lower_bound(1), index.end());
+    EXPECT_FALSE(index.contains(1));
+}
+
+
+TEST(CustomSortedIndex_Lookup, bounds_match_std)
+{
+    std::mt19937 gen(5);
+
+    for (size_t size : {1, 2, 3, 7, 8, 9, 100, 1000})
+    {
+        std::vector<int> expected(size);
+        for (auto& value : expected)
+            value = static_cast<int>(gen() % 200);
+
+        custom::sorted_index<int> index(expected.data(), expected.data() + size);
+        std::sort(expected.begin(), expected.end());
+
+        for (int key = -1; key <= 200; ++key)
+        {
+            const auto lower = std::lower_bound(expected.begin(), expected.end(), key);
+            const auto upper = std::upper_bound(expected.begin(), expected.end(), key);
+
+            auto indexLower = index.lower_bound(key);
+            auto indexUpper = index.upper_bound(key);
+
+            ASSERT_EQ(indexLower == index.end(), lower == expected.end());
+            ASSERT_EQ(indexUpper == index.end(), upper == expected.end());
+            if (lower != expected.end())
+            {
+                ASSERT_EQ(*indexLower, *lower);
+            }
+
+            if (upper != expected.end())
+            {
+                ASSERT_EQ(*indexUpper, *upper);
+            }
+
+            ASSERT_EQ(index.contains(key), lower != upper);
+            ASSERT_EQ(index.find(key) != index.end(), lower != upper);
+        }
+    }
+}
+
+
+TEST(CustomSortedIndex_Lookup, transparent_compare)
+{
+    custom::sorted_index<custom::string, custom::less<>> index = {"gamma", "alpha", "beta"};
+
+    EXPECT_TRUE(index.contains("beta"));
+    EXPECT_FALSE(index.contains("delta"));
+    EXPECT_EQ(*index.lower_bound("b"), "beta");
+    EXPECT_EQ(*index.begin(), "alpha");
+}
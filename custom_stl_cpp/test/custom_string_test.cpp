@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <string>
+#include <random>
+
+#include "custom/utility.h"
+#include "custom/string_view.h"
+#include "custom/string.h"   // unit to be tested
+
+
+// IMPORTANT
+// Prefix all suites and fixtures with "CustomString_". Used in ctest run.
+
+
+TEST(CustomString_Init, default_init)
+{
+    custom::string custom_string_instance;
+    EXPECT_EQ(custom_string_instance.size(), 0);
+    EXPECT_EQ(custom_string_instance.capacity(), 15);   // in place capacity
+    EXPECT_STREQ(custom_string_instance.c_str(), "");
+}
+
+
+TEST(CustomString_Init, short_and_long_init)
+{
+    custom::string short_string = "log.tag";
+    custom::string long_string  = "a string that does not fit in place";
+
+    EXPECT_EQ(short_string.capacity(), 15);
+    EXPECT_STREQ(short_string.c_str(), "log.tag");
+    EXPECT_EQ(long_string.size(), 35);
+    EXPECT_STREQ(long_string.c_str(), "a string that does not fit in place");
+}
+
+
+TEST(CustomString_Operations, grow_and_shrink)
+{
+    custom::string custom_string_instance;
+
+    for (int i = 0; i < 40; ++i)
+        custom_string_instance.push_back(static_cast<char>('a' + i % 26));
+
+    EXPECT_EQ(custom_string_instance.size(), 40);
+    EXPECT_GE(custom_string_instance.capacity(), 40);
+    EXPECT_EQ(custom_string_instance[39], 'n');
+
+    custom_string_instance.erase(10, 30);
+    custom_string_instance.shrink_to_fit();     // back in place
+
+    EXPECT_EQ(custom_string_instance.capacity(), 15);
+    EXPECT_STREQ(custom_string_instance.c_str(), "abcdefghij");
+}
+
+
+TEST(CustomString_Operations, copy_move_swap)
+{
+    custom::string short_string = "short";
+    custom::string long_string  = "a string that does not fit in place";
+
+    custom::string short_copy = short_string;
+    custom::string long_copy  = long_string;
+    EXPECT_TRUE(short_copy == short_string);
+    EXPECT_TRUE(long_copy == long_string);
+
+    custom::string short_moved = custom::move(short_copy);
+    custom::string long_moved  = custom::move(long_copy);
+    EXPECT_TRUE(short_copy.empty());
+    EXPECT_TRUE(long_copy.empty());
+    EXPECT_STREQ(short_moved.c_str(), "short");
+    EXPECT_STREQ(long_moved.c_str(), "a string that does not fit in place");
+
+    short_moved.swap(long_moved);
+    EXPECT_STREQ(short_moved.c_str(), "a string that does not fit in place");
+    EXPECT_STREQ(long_moved.c_str(), "short");
+
+    short_moved = long_moved;                   // heap to in place
+    EXPECT_STREQ(short_moved.c_str(), "short");
+    EXPECT_EQ(short_moved.capacity(), 15);
+}
+
+
+// Checks the vectorized search kernels against std on random strings over a small alphabet,
+// with lengths that cross the SSE2/AVX2 block sizes.
+template<class CharT>
+static void _check_search_against_std()
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> letter(0, 3);
+    auto random_string = [&](size_t len)
+    {
+        std::basic_string<CharT> str;
+        for (size_t i = 0; i < len; ++i)
+            str.push_back(static_cast<CharT>('a' + letter(gen)));
+        return str;
+    };
+
+    for (size_t len = 0; len < 100; ++len)
+    {
+        std::basic_string<CharT> std_hay = random_string(len);
+        custom::basic_string_view<CharT> custom_hay(std_hay.data(), std_hay.size());
+
+        for (size_t needleLen = 1; needleLen < 6; ++needleLen)
+        {
+            std::basic_string<CharT> needle = random_string(needleLen);
+
+            for (size_t pos = 0; pos <= len; pos += 7)
+            {
+                ASSERT_EQ(custom_hay.find(needle.data(), pos, needle.size()), std_hay.find(needle, pos));
+                ASSERT_EQ(custom_hay.rfind(needle.data(), pos, needle.size()), std_hay.rfind(needle, pos));
+                ASSERT_EQ(custom_hay.find_first_of(needle.data(), pos, needle.size()), std_hay.find_first_of(needle, pos));
+            }
+        }
+
+        ASSERT_EQ(custom::char_traits<CharT>::length(std_hay.c_str()), len);
+
+        std::basic_string<CharT> other = std_hay;
+        if (len > 0)
+            other[len / 2] = static_cast<CharT>((sizeof(CharT) == 1) ? 'z' : 0x100);   // 0x100 has a low first byte (wrong sign for memcmp)
+
+        ASSERT_EQ(custom_hay.compare(custom::basic_string_view<CharT>(other.data(), other.size())) < 0, std_hay.compare(other) < 0);
+    }
+}
+
+
+TEST(CustomString_Search, matches_std)
+{
+    _check_search_against_std<char>();
+    _check_search_against_std<char16_t>();
+    _check_search_against_std<char32_t>();
+}
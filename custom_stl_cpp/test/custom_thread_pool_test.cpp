@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "custom/thread_pool.h"     // unit to be tested
+
+
+// IMPORTANT
+// Prefix all suites and fixtures with "CustomThreadPool_". Used in ctest run.
+
+
+static int _fibonacci(custom::thread_pool& pool, int n)      // every level waits on a task of the same pool
+{
+    if (n < 2)
+        return n;
+
+    auto left = pool.submit(_fibonacci, custom::ref(pool), n - 1);
+    const int right = _fibonacci(pool, n - 2);
+
+    return left.get() + right;
+}
+
+
+TEST(CustomThreadPool_Submit, results_and_exceptions)
+{
+    custom::thread_pool pool(3);
+    EXPECT_EQ(pool.worker_count(), 3u);
+
+    auto sum    = pool.submit([](int a, int b) { return a + b; }, 2, 3);
+    auto text   = pool.submit([](std::string prefix) { return prefix + "!"; }, std::string("done"));
+    auto fails  = pool.submit([]() -> int { throw std::runtime_error("task failed"); });
+
+    std::atomic<int> calls = 0;
+    auto nothing = pool.submit([&calls]() { ++calls; });
+
+    EXPECT_EQ(sum.get(), 5);
+    EXPECT_FALSE(sum.valid());
+    EXPECT_EQ(text.get(), "done!");
+    EXPECT_THROW(fails.get(), std::runtime_error);
+
+    nothing.wait();
+    EXPECT_TRUE(nothing.is_ready());
+    nothing.get();
+    EXPECT_EQ(calls.load(), 1);
+
+    custom::task_handle<int> empty;
+    EXPECT_FALSE(empty.valid());
+}
+
+
+TEST(CustomThreadPool_Submit, nested_waits_do_not_deadlock)
+{
+    custom::thread_pool single(1);      // the only worker has to run what it waits for
+    EXPECT_EQ(single.submit(_fibonacci, custom::ref(single), 15).get(), 610);
+
+    custom::thread_pool pool(4);
+    EXPECT_EQ(pool.submit(_fibonacci, custom::ref(pool), 18).get(), 2584);
+}
+
+
+TEST(CustomThreadPool_Submit, destructor_drains_queue)
+{
+    std::atomic<int> done = 0;
+    {
+        custom::thread_pool pool(2);
+        for (int i = 0; i < 1000; ++i)
+            (void)pool.submit([&done]() { ++done; });
+    }
+
+    EXPECT_EQ(done.load(), 1000);
+}
+
+
+TEST(CustomThreadPool_ParallelFor, every_index_once)
+{
+    custom::thread_pool pool(4);
+    std::vector<std::atomic<int>> hits(10000);
+
+    pool.parallel_for(0, 10000, [&hits](int index) { ++hits[index]; });
+    for (auto& hit : hits)
+        ASSERT_EQ(hit.load(), 1);
+
+    pool.parallel_for(size_t(0), hits.size(), [&hits](size_t index) { ++hits[index]; }, 7);
+    for (auto& hit : hits)
+        ASSERT_EQ(hit.load(), 2);
+
+    int untouched = 0;
+    pool.parallel_for(5, 5, [&untouched](int) { ++untouched; });
+    pool.parallel_for(5, 2, [&untouched](int) { ++untouched; });
+    EXPECT_EQ(untouched, 0);
+
+    std::atomic<long> negative = 0;
+    pool.parallel_for(-100, 100, [&negative](int index) { negative += index; }, 3);
+    EXPECT_EQ(negative.load(), -100);
+}
+
+
+TEST(CustomThreadPool_ParallelFor, nested_and_from_tasks)
+{
+    custom::thread_pool pool(3);
+    std::atomic<int> total = 0;
+
+    auto outer = pool.submit([&pool, &total]()
+    {
+        pool.parallel_for(0, 64, [&pool, &total](int)
+        {
+            pool.parallel_for(0, 64, [&total](int) { ++total; }, 4);
+        }, 1);
+    });
+
+    outer.get();
+    EXPECT_EQ(total.load(), 64 * 64);
+}
+
+
+TEST(CustomThreadPool_ParallelFor, first_exception_is_rethrown)
+{
+    custom::thread_pool pool(2);
+    std::atomic<int> calls = 0;
+
+    EXPECT_THROW(pool.parallel_for(0, 100000, [&calls](int index)
+    {
+        ++calls;
+        if (index == 500)
+            throw std::out_of_range("index 500");
+    }, 100), std::out_of_range);
+
+    EXPECT_LT(calls.load(), 100000);    // pieces started after the failure are skipped
+
+    int after = 0;
+    pool.parallel_for(0, 10, [&after](int) { ++after; }, 100);   // still usable, single piece runs inline
+    EXPECT_EQ(after, 10);
+}
+
+
+TEST(CustomThreadPool_Stealing, busy_worker_tasks_get_stolen)
+{
+    custom::thread_pool pool(4);
+    std::atomic<int> started = 0;
+    std::atomic<bool> release = false;
+
+    // one task floods its own deque, the other workers can only reach those tasks by stealing
+    auto producer = pool.submit([&pool, &started, &release]()
+    {
+        std::vector<custom::task_handle<void>> handles;
+        for (int i = 0; i < 3; ++i)
+            handles.push_back(pool.submit([&started, &release]()
+            {
+                ++started;
+                while (!release.load())
+                    custom::this_thread::yield();
+            }));
+
+        while (started.load() < 3)      // the producer itself never pops them
+            custom::this_thread::yield();
+
+        release = true;
+        for (auto& handle : handles)
+            handle.get();
+    });
+
+    producer.get();
+    EXPECT_EQ(started.load(), 3);
+}
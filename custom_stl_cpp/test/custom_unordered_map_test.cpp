@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <random>
+#include <vector>
+
 #include "custom/string.h"
+#include "custom/string_view.h"
 #include "custom/unordered_map.h"   // unit to be tested
 
 
@@ -78,3 +82,351 @@ TEST_F(CustomUnorderedMap_Operations, contains)
     EXPECT_TRUE(this->_custom_umap_instance.contains(0));   // key 0 is found
     EXPECT_FALSE(this->_custom_umap_instance.contains(5));  // key 5 is not found
 }
+
+
+class CustomUnorderedMap_FlatOperations : public ::testing::Test
+{
+protected:
+    custom::flat_unordered_map<int, std::string> _custom_flat_umap_instance;
+
+protected:
+
+    void SetUp() override
+    {
+        _custom_flat_umap_instance[0] = "Default";
+        _custom_flat_umap_instance[1] = "FlatUMap";
+        _custom_flat_umap_instance[2] = "Values";
+    }
+
+    void TearDown() override
+    {
+        _custom_flat_umap_instance.clear();
+    }
+};  // END CustomUnorderedMap_FlatOperations
+
+
+TEST_F(CustomUnorderedMap_FlatOperations, copy_assign_operator)
+{
+    custom::flat_unordered_map<int, std::string> other;
+
+    EXPECT_FALSE(this->_custom_flat_umap_instance == other);
+    other = this->_custom_flat_umap_instance;
+    EXPECT_TRUE(this->_custom_flat_umap_instance == other);
+}
+
+
+TEST_F(CustomUnorderedMap_FlatOperations, move_assign_operator)
+{
+    custom::flat_unordered_map<int, std::string> other;
+    other[3] = "";
+    other[4] = "";
+    other[7] = "";
+
+    custom::flat_unordered_map<int, std::string> other_copy = other;
+
+    EXPECT_FALSE(this->_custom_flat_umap_instance == other);
+    this->_custom_flat_umap_instance = custom::move(other);
+    EXPECT_TRUE(other.empty());                                     // moved-from is empty
+    EXPECT_EQ(other.begin(), other.end());
+    EXPECT_TRUE(this->_custom_flat_umap_instance == other_copy);    // equal to original
+}
+
+
+TEST_F(CustomUnorderedMap_FlatOperations, find_and_erase)
+{
+    EXPECT_NE(this->_custom_flat_umap_instance.find(0), this->_custom_flat_umap_instance.end());
+    EXPECT_EQ(this->_custom_flat_umap_instance.find(5), this->_custom_flat_umap_instance.end());
+
+    this->_custom_flat_umap_instance.erase(0);
+
+    EXPECT_FALSE(this->_custom_flat_umap_instance.contains(0));
+    EXPECT_TRUE(this->_custom_flat_umap_instance.contains(1));
+    EXPECT_EQ(this->_custom_flat_umap_instance.size(), 2);
+    EXPECT_THROW(this->_custom_flat_umap_instance.at(0), std::out_of_range);
+}
+
+
+TEST_F(CustomUnorderedMap_FlatOperations, grow_and_iterate)
+{
+    constexpr int count = 10000;
+    custom::flat_unordered_map<int, int> flat;
+
+    for (int i = 0; i < count; ++i)
+        flat.try_emplace(i, 2 * i);
+
+    EXPECT_EQ(flat.size(), count);
+    EXPECT_LE(flat.load_factor(), flat.max_load_factor());
+
+    // erase half of the keys so that tombstones are reused by later inserts
+    for (int i = 0; i < count; i += 2)
+        flat.erase(i);
+
+    for (int i = count; i < count + count / 2; ++i)
+        flat.try_emplace(i, 2 * i);
+
+    size_t iterated = 0;
+    for (const auto& val : flat)
+    {
+        EXPECT_EQ(val.second, 2 * val.first);
+        ++iterated;
+    }
+
+    EXPECT_EQ(iterated, flat.size());
+    EXPECT_EQ(flat.size(), count);
+
+    for (int i = 0; i < count; ++i)
+        EXPECT_EQ(flat.contains(i), (i % 2) == 1);
+}
+
+
+TEST(CustomUnorderedMap_Incremental, rehash_during_operations)
+{
+    constexpr int count = 5000;
+    custom::unordered_map<int, int> umap;
+    umap.incremental_rehash(true);
+
+    for (int i = 0; i < count; ++i)
+    {
+        umap.try_emplace(i, i);
+
+        // all previous keys are reachable while buckets migrate
+        if (i % 97 == 0)
+        {
+            for (int j = 0; j <= i; ++j)
+                ASSERT_TRUE(umap.contains(j));
+        }
+
+        // every element is accounted for in exactly one bucket
+        if (i % 251 == 0)
+        {
+            size_t total = 0;
+            for (size_t b = 0; b < umap.bucket_count(); ++b)
+                total += umap.bucket_size(b);
+
+            ASSERT_EQ(total, umap.size());
+        }
+    }
+
+    for (int i = 0; i < count; i += 3)
+        umap.erase(i);
+
+    size_t iterated = 0;
+    for (const auto& val : umap)
+    {
+        EXPECT_NE(val.first % 3, 0);
+        ++iterated;
+    }
+
+    EXPECT_EQ(iterated, umap.size());
+
+    custom::unordered_map<int, int> copy = umap;
+    EXPECT_TRUE(copy == umap);
+
+    umap.incremental_rehash(false);     // completes any pending migration
+    EXPECT_TRUE(copy == umap);
+}
+
+
+TEST(CustomUnorderedMap_Heterogeneous, transparent_find)
+{
+    using Key = custom::string;
+    custom::unordered_map<Key, int, custom::hash<Key>, custom::equal_to<>> umap;
+    custom::flat_unordered_map<Key, int, custom::hash<Key>, custom::equal_to<>> flatUmap;
+
+    umap["alpha"]       = 1;
+    umap["beta"]        = 2;
+    flatUmap["alpha"]   = 1;
+    flatUmap["beta"]    = 2;
+
+    // string_view and const char* are hashed directly, no temporary custom::string is built
+    custom::string_view view = "beta";
+    EXPECT_EQ(umap.find(view)->second, 2);
+    EXPECT_EQ(flatUmap.find(view)->second, 2);
+    EXPECT_TRUE(umap.contains("alpha"));
+    EXPECT_TRUE(flatUmap.contains("alpha"));
+    EXPECT_EQ(umap.count("gamma"), 0);
+    EXPECT_EQ(flatUmap.count("gamma"), 0);
+
+    auto range = umap.equal_range(view);
+    EXPECT_EQ(custom::distance(range.first, range.second), 1);
+    EXPECT_TRUE(flatUmap.equal_range("gamma").first == flatUmap.end());
+
+    // hashing a key through any representation gives the same value
+    EXPECT_EQ(custom::hash<Key>{}(Key("alpha")), custom::hash<Key>{}("alpha"));
+    EXPECT_EQ(custom::hash<Key>{}(Key("alpha")), custom::hash<custom::string_view>{}("alpha"));
+}
+
+
+struct _Fragile_Value       // copy throws once the countdown reaches zero
+{
+    static inline int live          = 0;
+    static inline int copiesLeft    = -1;
+
+    int value = 0;
+
+    _Fragile_Value(int v = 0) : value(v) { ++live; }
+    _Fragile_Value(_Fragile_Value&& other) noexcept : value(other.value) { ++live; }
+
+    _Fragile_Value(const _Fragile_Value& other) : value(other.value)
+    {
+        if (copiesLeft == 0)
+            throw std::runtime_error("copy");
+
+        --copiesLeft;
+        ++live;
+    }
+
+    _Fragile_Value& operator=(const _Fragile_Value&) = default;
+
+    ~_Fragile_Value() { --live; }
+};
+
+struct _Fragile_Hash        // hashing throws once the countdown reaches zero
+{
+    static inline int hashesLeft = -1;
+
+    size_t operator()(const int key) const
+    {
+        if (hashesLeft == 0)
+            throw std::runtime_error("hash");
+
+        --hashesLeft;
+        return custom::hash<int>{}(key);
+    }
+};
+
+
+TEST(CustomUnorderedMap_FlatExceptions, throwing_copy_leaves_no_garbage)
+{
+    {
+        using FlatMap = custom::flat_unordered_map<int, _Fragile_Value>;
+
+        FlatMap source;
+        for (int i = 0; i < 40; ++i)
+            source.try_emplace(i, i);
+
+        _Fragile_Value::copiesLeft = 20;
+        EXPECT_THROW(FlatMap{source}, std::runtime_error);
+        EXPECT_EQ(_Fragile_Value::live, 40);    // the partial copy was rolled back
+
+        FlatMap target;
+        target.try_emplace(100, 100);
+
+        _Fragile_Value::copiesLeft = 20;
+        EXPECT_THROW(target = source, std::runtime_error);
+        EXPECT_EQ(target.size(), 0);            // emptied, but still usable
+
+        _Fragile_Value::copiesLeft = -1;
+        target.try_emplace(1, 1);
+        target = source;
+        EXPECT_EQ(target.size(), 40);
+        EXPECT_EQ(target.at(39).value, 39);
+    }
+
+    EXPECT_EQ(_Fragile_Value::live, 0);
+}
+
+
+TEST(CustomUnorderedMap_FlatExceptions, throwing_hash_during_rehash)
+{
+    {
+        custom::flat_unordered_map<int, _Fragile_Value, _Fragile_Hash> flat;
+        for (int i = 0; i < 40; ++i)
+            flat.try_emplace(i, i);
+
+        const size_t buckets = flat.bucket_count();
+
+        _Fragile_Hash::hashesLeft = 10;
+        EXPECT_THROW(flat.rehash(4 * buckets), std::runtime_error);
+        _Fragile_Hash::hashesLeft = -1;
+
+        EXPECT_EQ(flat.bucket_count(), buckets);    // the old arrays are kept
+        EXPECT_EQ(_Fragile_Value::live, static_cast<int>(flat.size()));
+
+        size_t iterated = 0;
+        for (const auto& val : flat)
+        {
+            EXPECT_TRUE(flat.contains(val.first));
+            ++iterated;
+        }
+
+        EXPECT_EQ(iterated, flat.size());
+
+        for (int i = 100; i < 200; ++i)             // keeps working and growing
+            flat.try_emplace(i, i);
+
+        EXPECT_EQ(flat.at(150).value, 150);
+    }
+
+    EXPECT_EQ(_Fragile_Value::live, 0);
+}
+
+
+template<class Group>
+static void _expect_group_matches_portable(const custom::detail::_Ctrl_Type* ctrl)
+{
+    using Portable  = custom::detail::_Flat_Group_Portable;
+    using Mask      = typename Group::_Mask_Type;
+
+    // a wide group covers several portable groups, their masks are concatenated
+    auto portable = [ctrl](auto matcher)
+    {
+        Mask mask = 0;
+        for (size_t part = 0; part < Group::WIDTH / Portable::WIDTH; ++part)
+            mask |= static_cast<Mask>(matcher(Portable(ctrl + part * Portable::WIDTH))) << (part * Portable::WIDTH);
+
+        return mask;
+    };
+
+    const Group group(ctrl);
+
+    EXPECT_EQ(group.match_empty(), portable([](const Portable& p) { return p.match_empty(); }));
+    EXPECT_EQ(group.match_empty_or_deleted(), portable([](const Portable& p) { return p.match_empty_or_deleted(); }));
+
+    for (int h2 = 0; h2 < 128; ++h2)
+        EXPECT_EQ(group.match(static_cast<custom::detail::_Ctrl_Type>(h2)),
+                  portable([h2](const Portable& p) { return p.match(static_cast<custom::detail::_Ctrl_Type>(h2)); }));
+
+    EXPECT_EQ(group.match(custom::detail::_CTRL_DELETED), portable([](const Portable& p) { return p.match(custom::detail::_CTRL_DELETED); }));
+    EXPECT_EQ(group.match(custom::detail::_CTRL_SENTINEL), portable([](const Portable& p) { return p.match(custom::detail::_CTRL_SENTINEL); }));
+}
+
+
+TEST(CustomUnorderedMap_FlatGroup, simd_matches_portable)
+{
+    using namespace custom::detail;
+
+    constexpr size_t capacity = 128;
+    std::mt19937 engine(2024);
+    std::uniform_int_distribution<int> pick(0, 15);
+
+    // capacity control bytes and the sentinel, as the table allocates them
+    std::vector<_Ctrl_Type> ctrl(capacity + 1);
+
+    for (int round = 0; round < 20; ++round)
+    {
+        for (size_t i = 0; i < capacity; ++i)
+        {
+            const int roll = pick(engine);
+            ctrl[i] =   roll < 4 ? _CTRL_EMPTY :
+                        roll < 7 ? _CTRL_DELETED :
+                        roll < 8 ? _CTRL_SENTINEL :
+                        static_cast<_Ctrl_Type>(roll * 13 % 128);      // few distinct h2 values, so matches repeat
+        }
+
+        ctrl[capacity] = _CTRL_SENTINEL;
+
+#if defined CUSTOM_FLAT_GROUP_SSE2
+        // every start position, up to the group that ends on the sentinel
+        for (size_t offset = 0; offset + _Flat_Group_SSE2::WIDTH <= ctrl.size(); ++offset)
+            _expect_group_matches_portable<_Flat_Group_SSE2>(ctrl.data() + offset);
+#endif
+
+#if defined CUSTOM_FLAT_GROUP_AVX2
+        for (size_t offset = 0; offset + _Flat_Group_AVX2::WIDTH <= ctrl.size(); ++offset)
+            _expect_group_matches_portable<_Flat_Group_AVX2>(ctrl.data() + offset);
+#endif
+
+        _expect_group_matches_portable<_Flat_Group>(ctrl.data() + capacity - _Flat_Group::WIDTH);   // the last group the table probes
+    }
+}
@@ -78,3 +78,26 @@ TEST_F(CustomUnorderedSet_Operations, contains)
     EXPECT_TRUE(this->_custom_uset_instance.contains("Default"));   // "Default" is found
     EXPECT_FALSE(this->_custom_uset_instance.contains("NotFound")); // NotFound is not found
 }
+
+
+TEST(CustomUnorderedSet_Flat, emplace_find_erase)
+{
+    custom::flat_unordered_set<custom::string> flat = {"Default", "FlatUSet", "Values"};
+
+    EXPECT_EQ(flat.size(), 3);
+    EXPECT_NE(flat.find("FlatUSet"), flat.end());
+
+    flat.emplace("Values");     // already present
+    EXPECT_EQ(flat.size(), 3);
+
+    flat.erase("Default");
+    EXPECT_FALSE(flat.contains("Default"));
+    EXPECT_EQ(flat.size(), 2);
+
+    custom::flat_unordered_set<custom::string> other = flat;
+    EXPECT_TRUE(flat == other);
+
+    flat.clear();
+    EXPECT_TRUE(flat.empty());
+    EXPECT_EQ(flat.begin(), flat.end());
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include "custom/memory.h"
 #include "custom/string.h"
 #include "custom/tuple.h"
 #include "custom/vector.h"   // unit to be tested
@@ -288,3 +289,162 @@ TEST_F(CustomVector_Operations, operator_index_death)
     EXPECT_TRUE(this->_custom_vector_instance.empty());
     EXPECT_DEATH_IF_SUPPORTED(this->_custom_vector_instance[0], "");
 }
+
+
+// ===========================================================================================
+
+
+// Counts moves, opted in as trivially relocatable
+struct _Relocatable_Handle
+{
+    static inline int moves = 0;
+
+    int value;
+
+    explicit _Relocatable_Handle(int value) : value(value) { /*Empty*/ }
+    _Relocatable_Handle(_Relocatable_Handle&& other) noexcept : value(other.value) { ++moves; }
+    _Relocatable_Handle& operator=(_Relocatable_Handle&& other) noexcept { value = other.value; ++moves; return *this; }
+};
+
+template<>
+struct custom::is_trivially_relocatable<_Relocatable_Handle> : custom::true_type {};
+
+// Single pass iterator over an int array
+struct _Input_Iterator
+{
+    using iterator_category = custom::input_iterator_tag;
+    using value_type        = int;
+    using difference_type   = ptrdiff_t;
+    using pointer           = const int*;
+    using reference         = const int&;
+
+    const int* ptr;
+
+    reference operator*() const { return *ptr; }
+    _Input_Iterator& operator++() { ++ptr; return *this; }
+    bool operator==(const _Input_Iterator& other) const { return ptr == other.ptr; }
+    bool operator!=(const _Input_Iterator& other) const { return ptr != other.ptr; }
+};
+
+struct _Input_Range
+{
+    const int* first;
+    const int* last;
+
+    _Input_Iterator begin() const { return {first}; }
+    _Input_Iterator end() const { return {last}; }
+};
+
+
+TEST_F(CustomVector_Operations, append_range_grows_once)
+{
+    custom::vector<int> batch;
+    for (int i = 0; i < 100; ++i)
+        batch.push_back(i);
+
+    this->_custom_vector_instance.append_range(batch);
+    EXPECT_EQ(this->_custom_vector_instance.size(), 103);
+    EXPECT_EQ(this->_custom_vector_instance.capacity(), 103);   // exactly what was required
+    EXPECT_EQ(this->_custom_vector_instance[3], 0);
+    EXPECT_EQ(this->_custom_vector_instance.back(), 99);
+
+    int raw[] = {7, 8};
+    this->_custom_vector_instance.append_range(raw);
+    EXPECT_EQ(this->_custom_vector_instance.back(), 8);
+
+    int values[] = {5, 6, 7};
+    this->_custom_vector_instance.clear();
+    this->_custom_vector_instance.append_range(_Input_Range{values, values + 3});
+    EXPECT_TRUE(this->_custom_vector_instance == custom::vector<int>({5, 6, 7}));
+}
+
+
+TEST_F(CustomVector_Operations, insert_and_assign_range)
+{
+    int values[] = {7, 8};
+
+    auto it = this->_custom_vector_instance.insert_range(this->_custom_vector_instance.begin() + 1, values);
+    EXPECT_EQ(*it, 7);
+    EXPECT_TRUE(this->_custom_vector_instance == custom::vector<int>({1, 7, 8, 2, 3}));
+
+    this->_custom_vector_instance.insert_range(this->_custom_vector_instance.end(), _Input_Range{values, values + 2});
+    EXPECT_TRUE(this->_custom_vector_instance == custom::vector<int>({1, 7, 8, 2, 3, 7, 8}));
+
+    this->_custom_vector_instance.assign_range(custom::vector<int>({4, 5}));
+    EXPECT_TRUE(this->_custom_vector_instance == custom::vector<int>({4, 5}));
+}
+
+
+TEST(CustomVector_Range, insert_range_non_trivial_elements)
+{
+    custom::vector<custom::string> words = {"a", "b", "c", "d"};
+    custom::vector<custom::string> few = {"x"};
+    custom::vector<custom::string> many = {"p", "q", "r"};
+
+    words.reserve(20);
+    words.insert_range(words.begin() + 1, few);         // fewer new elements than shifted ones
+    words.insert_range(words.begin() + 4, many);        // more new elements than shifted ones
+    EXPECT_TRUE(words == custom::vector<custom::string>({"a", "x", "b", "c", "p", "q", "r", "d"}));
+
+    words.insert_range(words.begin(), many);            // grows
+    EXPECT_EQ(words.size(), 11);
+    EXPECT_EQ(words[0], "p");
+    EXPECT_EQ(words[3], "a");
+    EXPECT_EQ(words.back(), "d");
+
+    words.assign_range(few);
+    EXPECT_TRUE(words == few);
+}
+
+
+TEST(CustomVector_Range, resize_for_overwrite)
+{
+    custom::vector<int> values = {1, 2};
+    values.resize_for_overwrite(1000);
+    EXPECT_EQ(values.size(), 1000);
+    EXPECT_EQ(values[1], 2);
+
+    values[999] = 5;
+    EXPECT_EQ(values.back(), 5);
+
+    values.resize_for_overwrite(1);
+    EXPECT_EQ(values.size(), 1);
+    EXPECT_EQ(values[0], 1);
+}
+
+
+TEST(CustomVector_Range, trivially_relocatable_growth)
+{
+    static_assert(custom::is_trivially_relocatable_v<int[4]>);
+    static_assert(custom::is_trivially_relocatable_v<custom::string>);
+    static_assert(custom::is_trivially_relocatable_v<custom::unique_ptr<int>>);
+    static_assert(custom::is_trivially_relocatable_v<custom::shared_ptr<int>>);
+    static_assert(custom::is_trivially_relocatable_v<custom::vector<custom::string>>);
+    static_assert(custom::is_trivially_relocatable_v<custom::pair<custom::string, int>>);
+
+    _Relocatable_Handle::moves = 0;
+    custom::vector<_Relocatable_Handle> handles;
+    for (int i = 0; i < 100; ++i)
+        handles.emplace_back(i);
+
+    EXPECT_EQ(_Relocatable_Handle::moves, 0);   // every growth was a memcpy
+    EXPECT_EQ(handles[99].value, 99);
+
+    custom::vector<custom::string> words;
+    for (int i = 0; i < 50; ++i)
+        words.push_back(i % 2 == 0 ? "short" : "a string too long for the inline buffer");
+
+    const char* heapChars = words[1].c_str();
+    words.reserve(200);
+    EXPECT_EQ(words[1].c_str(), heapChars);     // the heap buffer changed owner, not content
+    EXPECT_EQ(words[0], "short");
+    EXPECT_EQ(words[49], "a string too long for the inline buffer");
+
+    custom::vector<custom::unique_ptr<int>> owners;
+    for (int i = 0; i < 20; ++i)
+        owners.push_back(custom::make_unique<int>(i));
+
+    owners.insert(owners.begin(), custom::make_unique<int>(-1));
+    EXPECT_EQ(*owners[0], -1);
+    EXPECT_EQ(*owners[20], 19);
+}